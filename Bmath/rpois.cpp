@@ -74,7 +74,7 @@ namespace Rmath{
 
 double rpois_mt(BOOM::RNG &rng, double mu){
   std::poisson_distribution<unsigned int> dist(mu);
-  return dist(rng.generator());
+  return rng.draw(dist);
 }
 
 double rpois(double mu)
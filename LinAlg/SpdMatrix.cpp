@@ -342,10 +342,16 @@ namespace BOOM {
   }
 
   void SpdMatrix::fix_near_symmetry() {
-    for (int i = 0; i < nrow(); ++i) {
-      for (int j = 0; j < i; ++j) {
-        double value = .5 * (unchecked(i, j) + unchecked(j, i));
-        unchecked(i, j) = unchecked(j, i) = value;
+    // This is called once per time point by the Kalman filters, so it works
+    // with the raw column-major data rather than calling unchecked().
+    int n = nrow();
+    double *elements = data();
+    for (int j = 0; j < n; ++j) {
+      double *column = elements + j * n;
+      for (int i = j + 1; i < n; ++i) {
+        double &transpose_element(elements[j + i * n]);
+        double value = .5 * (column[i] + transpose_element);
+        column[i] = transpose_element = value;
       }
     }
   }
@@ -0,0 +1,194 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/UpdatableCholesky.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  UpdatableCholesky::UpdatableCholesky(int initial_capacity)
+      : capacity_(0), dim_(0) {
+    reserve(initial_capacity);
+  }
+
+  bool UpdatableCholesky::decompose(const SpdMatrix &A) {
+    clear();
+    reserve(A.nrow());
+    Vector column;
+    for (int j = 0; j < A.nrow(); ++j) {
+      column.resize(j + 1);
+      for (int i = 0; i <= j; ++i) {
+        column[i] = A(i, j);
+      }
+      if (!append(column)) {
+        clear();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool UpdatableCholesky::append(const ConstVectorView &column) {
+    if (column.size() != dim_ + 1) {
+      report_error("Wrong sized column passed to UpdatableCholesky::append.");
+    }
+    // The new row of L is the solution to L * l = a, where a is the
+    // off-diagonal part of the new column.
+    Vector new_row(ConstVectorView(column, 0, dim_));
+    Lsolve_inplace(VectorView(new_row));
+    double diagonal = column[dim_] - new_row.normsq();
+    // A diagonal element that is small relative to the original diagonal means
+    // the new column is (numerically) a linear combination of the old ones.
+    double tolerance = std::numeric_limits<double>::epsilon() * (dim_ + 1)
+        * std::fabs(column[dim_]);
+    if (!(diagonal > tolerance) || !std::isfinite(diagonal)) {
+      return false;
+    }
+    reserve(dim_ + 1);
+    for (int j = 0; j < dim_; ++j) {
+      L(dim_, j) = new_row[j];
+    }
+    L(dim_, dim_) = std::sqrt(diagonal);
+    ++dim_;
+    return true;
+  }
+
+  void UpdatableCholesky::remove(int position) {
+    if (position < 0 || position >= dim_) {
+      report_error("Illegal position passed to UpdatableCholesky::remove.");
+    }
+    // Partition L as
+    //   L11   0    0
+    //   l21  d     0
+    //   L31  l32  L33
+    // Removing the middle row and column of A leaves
+    //   L11   0
+    //   L31  L33'
+    // where L33' * L33'^T = L33 * L33^T + l32 * l32^T.
+    int trailing = dim_ - position - 1;
+    Vector x(trailing);
+    for (int i = 0; i < trailing; ++i) {
+      x[i] = L(position + 1 + i, position);
+    }
+
+    // Shift L31 up by one row.
+    for (int j = 0; j < position; ++j) {
+      for (int i = position; i < dim_ - 1; ++i) {
+        L(i, j) = L(i + 1, j);
+      }
+    }
+    // Shift the lower triangle of L33 up and to the left.
+    for (int j = position; j < dim_ - 1; ++j) {
+      for (int i = j; i < dim_ - 1; ++i) {
+        L(i, j) = L(i + 1, j + 1);
+      }
+    }
+    --dim_;
+
+    // Rank-one update of the trailing block.
+    for (int k = 0; k < trailing; ++k) {
+      int col = position + k;
+      double Lkk = L(col, col);
+      double r = std::hypot(Lkk, x[k]);
+      double c = r / Lkk;
+      double s = x[k] / Lkk;
+      L(col, col) = r;
+      for (int i = k + 1; i < trailing; ++i) {
+        double &Lik(L(position + i, col));
+        Lik = (Lik + s * x[i]) / c;
+        x[i] = c * x[i] - s * Lik;
+      }
+    }
+  }
+
+  double UpdatableCholesky::logdet() const {
+    double ans = 0;
+    for (int i = 0; i < dim_; ++i) {
+      ans += std::log(L(i, i));
+    }
+    return 2 * ans;
+  }
+
+  void UpdatableCholesky::Lsolve_inplace(VectorView b) const {
+    if (b.size() != dim_) {
+      report_error("Wrong sized argument to "
+                   "UpdatableCholesky::Lsolve_inplace.");
+    }
+    for (int j = 0; j < dim_; ++j) {
+      b[j] /= L(j, j);
+      double bj = b[j];
+      for (int i = j + 1; i < dim_; ++i) {
+        b[i] -= L(i, j) * bj;
+      }
+    }
+  }
+
+  void UpdatableCholesky::LTsolve_inplace(VectorView b) const {
+    if (b.size() != dim_) {
+      report_error("Wrong sized argument to "
+                   "UpdatableCholesky::LTsolve_inplace.");
+    }
+    for (int j = dim_ - 1; j >= 0; --j) {
+      double value = b[j];
+      for (int i = j + 1; i < dim_; ++i) {
+        value -= L(i, j) * b[i];
+      }
+      b[j] = value / L(j, j);
+    }
+  }
+
+  Vector UpdatableCholesky::solve(const ConstVectorView &b) const {
+    Vector ans(b);
+    Lsolve_inplace(VectorView(ans));
+    LTsolve_inplace(VectorView(ans));
+    return ans;
+  }
+
+  Matrix UpdatableCholesky::getL() const {
+    Matrix ans(dim_, dim_, 0.0);
+    for (int j = 0; j < dim_; ++j) {
+      for (int i = j; i < dim_; ++i) {
+        ans(i, j) = L(i, j);
+      }
+    }
+    return ans;
+  }
+
+  SpdMatrix UpdatableCholesky::original_matrix() const {
+    SpdMatrix ans(dim_, 0.0);
+    ans.add_outer(getL());
+    return ans;
+  }
+
+  void UpdatableCholesky::reserve(int dimension) {
+    if (dimension <= capacity_) return;
+    int new_capacity = std::max<int>(dimension, 2 * capacity_);
+    std::vector<double> new_data(new_capacity * new_capacity, 0.0);
+    for (int j = 0; j < dim_; ++j) {
+      for (int i = j; i < dim_; ++i) {
+        new_data[i + j * new_capacity] = L(i, j);
+      }
+    }
+    data_.swap(new_data);
+    capacity_ = new_capacity;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,116 @@
+#ifndef BOOM_LINALG_UPDATABLE_CHOLESKY_HPP_
+#define BOOM_LINALG_UPDATABLE_CHOLESKY_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+
+namespace BOOM {
+
+  // The lower Cholesky triangle L of a symmetric positive definite matrix A =
+  // L * L^T, where A can grow or shrink by one row and column at a time.
+  //
+  // Appending a row/column to A costs O(k^2), where k is the current dimension,
+  // as does removing an arbitrary row/column.  Computing the factorization from
+  // scratch would cost O(k^3).  This is the workhorse for spike-and-slab
+  // samplers, where each proposed flip of an inclusion indicator adds or
+  // removes a single variable from the included block of X'X.
+  //
+  // Rows and columns are kept in the order in which they were appended, which
+  // need not be the order of the variables in the full matrix.  Callers that
+  // need to map between the two orders must track the mapping themselves.
+  class UpdatableCholesky {
+   public:
+    // Args:
+    //   initial_capacity: A hint about the largest dimension the represented
+    //     matrix is expected to attain.  Storage grows automatically if the
+    //     hint is exceeded.
+    explicit UpdatableCholesky(int initial_capacity = 0);
+
+    // The number of rows (and columns) in the represented matrix.
+    int dim() const { return dim_; }
+
+    // Discard the decomposition, leaving a 0 x 0 matrix.  Storage is retained.
+    void clear() { dim_ = 0; }
+
+    // Replace the current decomposition with the decomposition of A.
+    //
+    // Returns:
+    //   true if A was positive definite.  If false is returned then *this is
+    //   left representing an empty matrix.
+    bool decompose(const SpdMatrix &A);
+
+    // Add a row and column to the end of the represented matrix.
+    //
+    // Args:
+    //   column: A vector of length dim() + 1.  The first dim() elements are
+    //     the off-diagonal elements of the new column (in the current order of
+    //     the represented matrix).  The final element is the new diagonal
+    //     element.
+    //
+    // Returns:
+    //   true if the enlarged matrix is positive definite.  If false is
+    //   returned then *this is unchanged.
+    bool append(const ConstVectorView &column);
+
+    // Remove row and column 'position' from the represented matrix.  The
+    // trailing block of the decomposition is repaired by a rank-one update, so
+    // positive definiteness is preserved.
+    void remove(int position);
+
+    // The natural log of the determinant of the represented matrix.  The
+    // determinant of an empty matrix is 1, so its log is 0.
+    double logdet() const;
+
+    // Replace b with L^{-1} b.  The length of b must match dim().
+    void Lsolve_inplace(VectorView b) const;
+
+    // Replace b with L^{-T} b.  The length of b must match dim().
+    void LTsolve_inplace(VectorView b) const;
+
+    // Returns A^{-1} b.
+    Vector solve(const ConstVectorView &b) const;
+
+    // The lower Cholesky triangle, as a dim() x dim() matrix with zeros above
+    // the diagonal.
+    Matrix getL() const;
+
+    // The represented matrix, L * L^T.
+    SpdMatrix original_matrix() const;
+
+   private:
+    // Grow the storage so it can hold a matrix of at least the requested
+    // dimension.  Existing elements are preserved.
+    void reserve(int dimension);
+
+    double &L(int i, int j) { return data_[i + j * capacity_]; }
+    const double &L(int i, int j) const { return data_[i + j * capacity_]; }
+
+    // Elements are stored column-major in a capacity_ x capacity_ buffer.  Only
+    // the leading dim_ x dim_ lower triangle is meaningful.
+    std::vector<double> data_;
+    int capacity_;
+    int dim_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_LINALG_UPDATABLE_CHOLESKY_HPP_
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "LinAlg/Cholesky.hpp"
+#include "LinAlg/UpdatableCholesky.hpp"
+#include "LinAlg/Selector.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class UpdatableCholeskyTest : public ::testing::Test {
+   protected:
+    UpdatableCholeskyTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Builds the decomposition one column at a time and checks it against the
+  // standard Cholesky decomposition.
+  TEST_F(UpdatableCholeskyTest, Append) {
+    SpdMatrix spd(6);
+    spd.randomize();
+
+    UpdatableCholesky cholesky;
+    EXPECT_EQ(0, cholesky.dim());
+    EXPECT_DOUBLE_EQ(0.0, cholesky.logdet());
+    EXPECT_TRUE(cholesky.decompose(spd));
+    EXPECT_EQ(6, cholesky.dim());
+
+    Cholesky reference(spd);
+    EXPECT_TRUE(MatrixEquals(cholesky.getL(), reference.getL()))
+        << "Updatable: " << endl << cholesky.getL()
+        << "Reference: " << endl << reference.getL();
+    EXPECT_TRUE(MatrixEquals(cholesky.original_matrix(), spd));
+    EXPECT_NEAR(cholesky.logdet(), reference.logdet(), 1e-8);
+
+    Vector b(6);
+    b.randomize();
+    EXPECT_TRUE(VectorEquals(cholesky.solve(b), reference.solve(b)));
+
+    // A column that would make the matrix singular is rejected, and the
+    // decomposition is left unchanged.
+    Vector column(7);
+    VectorView(column, 0, 6) = spd.col(0);
+    column[6] = spd(0, 0);
+    EXPECT_FALSE(cholesky.append(column));
+    EXPECT_EQ(6, cholesky.dim());
+    EXPECT_TRUE(MatrixEquals(cholesky.original_matrix(), spd));
+  }
+
+  // Removes rows and columns from the middle, beginning, and end of the
+  // represented matrix.
+  TEST_F(UpdatableCholeskyTest, Remove) {
+    SpdMatrix spd(7);
+    spd.randomize();
+    UpdatableCholesky cholesky(2);
+    EXPECT_TRUE(cholesky.decompose(spd));
+
+    Selector included(7, true);
+    std::vector<int> order = {3, 0, 6, 1};
+    for (int variable : order) {
+      int position = included.INDX(variable);
+      included.drop(variable);
+      cholesky.remove(position);
+      SpdMatrix expected = included.select(spd);
+      EXPECT_EQ(expected.nrow(), cholesky.dim());
+      EXPECT_TRUE(MatrixEquals(cholesky.original_matrix(), expected))
+          << "After removing variable " << variable << endl
+          << "Expected: " << endl << expected
+          << "Found: " << endl << cholesky.original_matrix();
+      EXPECT_NEAR(cholesky.logdet(), expected.logdet(), 1e-8);
+    }
+
+    // Add a variable back in.  It goes at the end.
+    Vector column(cholesky.dim() + 1);
+    for (int i = 0; i < included.nvars(); ++i) {
+      column[i] = spd(included.indx(i), 3);
+    }
+    column.back() = spd(3, 3);
+    EXPECT_TRUE(cholesky.append(column));
+    std::vector<int> positions;
+    for (int i = 0; i < included.nvars(); ++i) {
+      positions.push_back(included.indx(i));
+    }
+    positions.push_back(3);
+    SpdMatrix expected(positions.size());
+    for (int i = 0; i < positions.size(); ++i) {
+      for (int j = 0; j < positions.size(); ++j) {
+        expected(i, j) = spd(positions[i], positions[j]);
+      }
+    }
+    EXPECT_TRUE(MatrixEquals(cholesky.original_matrix(), expected));
+  }
+
+}  // namespace
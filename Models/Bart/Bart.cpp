@@ -21,9 +21,11 @@
 #include <cmath>
 #include <cstdlib>
 #include <iterator>
+#include <memory>
 
 #include "Models/Bart/Bart.hpp"
 #include "Models/Bart/ResidualRegressionData.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
@@ -32,6 +34,42 @@
 namespace BOOM {
   namespace Bart {
     namespace {
+      // Nodes with fewer observations than this per thread compute their
+      // sufficient statistics serially.  Below this size the cost of
+      // dispatching work to the thread pool exceeds the savings.
+      const int minimum_observations_per_shard = 10000;
+
+      // Calls 'method' on each leaf in 'leaves', with the leaves divided
+      // into one contiguous group per thread.
+      void call_on_leaves(const std::set<TreeNode *> &leaves,
+                          ThreadWorkerPool *pool, void (TreeNode::*method)()) {
+        int number_of_groups =
+            pool ? std::min<int>(pool->number_of_threads(), leaves.size()) : 0;
+        if (number_of_groups <= 1) {
+          for (TreeNode *leaf : leaves) {
+            (leaf->*method)();
+          }
+          return;
+        }
+        std::vector<TreeNode *> leaf_vector(leaves.begin(), leaves.end());
+        std::vector<std::future<void>> futures;
+        int group_size = leaf_vector.size() / number_of_groups;
+        for (int i = 0; i < number_of_groups; ++i) {
+          int begin = i * group_size;
+          int end = (i + 1 == number_of_groups) ? leaf_vector.size()
+                                                : begin + group_size;
+          futures.emplace_back(pool->submit(
+              [&leaf_vector, method, begin, end]() {
+                for (int j = begin; j < end; ++j) {
+                  (leaf_vector[j]->*method)();
+                }
+              }));
+        }
+        for (auto &future : futures) {
+          future.get();
+        }
+      }
+
       inline void remove_node_and_descendants_from_set(
           TreeNode *node, std::set<TreeNode *> &set_of_nodes) {
         if (!node) {
@@ -735,14 +773,43 @@ namespace BOOM {
     }
 
     //----------------------------------------------------------------------
-    const SufficientStatisticsBase &TreeNode::compute_suf() {
+    const SufficientStatisticsBase &TreeNode::compute_suf(
+        ThreadWorkerPool *pool) {
       if (!!suf_) {
         suf_->clear();
       } else {
         report_error("Sufficient statistics object was never allocated.");
       }
-      for (int i = 0; i < data_.size(); ++i) {
-        suf_->update(*(data_[i]));
+      int nobs = data_.size();
+      int nshards = pool ? std::min<int>(
+          pool->number_of_threads(), nobs / minimum_observations_per_shard)
+                         : 0;
+      if (nshards <= 1) {
+        for (int i = 0; i < nobs; ++i) {
+          suf_->update(*(data_[i]));
+        }
+        return *suf_;
+      }
+
+      std::vector<std::unique_ptr<SufficientStatisticsBase>> shards;
+      std::vector<std::future<void>> futures;
+      int shard_size = nobs / nshards;
+      for (int s = 0; s < nshards; ++s) {
+        int begin = s * shard_size;
+        int end = (s + 1 == nshards) ? nobs : begin + shard_size;
+        shards.emplace_back(suf_->create());
+        SufficientStatisticsBase *shard = shards.back().get();
+        futures.emplace_back(pool->submit([this, shard, begin, end]() {
+          for (int i = begin; i < end; ++i) {
+            shard->update(*(data_[i]));
+          }
+        }));
+      }
+      for (auto &future : futures) {
+        future.get();
+      }
+      for (const auto &shard : shards) {
+        suf_->combine(*shard);
       }
       return *suf_;
     }
@@ -1052,6 +1119,16 @@ namespace BOOM {
       }
     }
 
+    //----------------------------------------------------------------------
+    void Tree::remove_mean_effect(ThreadWorkerPool *pool) {
+      call_on_leaves(leaves_, pool, &TreeNode::remove_mean_effect);
+    }
+
+    //----------------------------------------------------------------------
+    void Tree::replace_mean_effect(ThreadWorkerPool *pool) {
+      call_on_leaves(leaves_, pool, &TreeNode::replace_mean_effect);
+    }
+
     //----------------------------------------------------------------------
     std::ostream &Tree::print(std::ostream &out) const { return root_->print(out); }
 
@@ -33,6 +33,8 @@
 
 namespace BOOM {
 
+  class ThreadWorkerPool;
+
   namespace Bart {
     class TreeNode;
     class VariableSummaryImpl;
@@ -67,6 +69,13 @@ namespace BOOM {
       // Add relevant functions of data to the sufficient statistics
       // being modeled.
       virtual void update(const ResidualRegressionData &data) = 0;
+
+      // Add the sufficient statistics in rhs to *this.  It is an error
+      // (resulting in an exception) to combine sufficient statistics of
+      // different concrete types.  This allows sufficient statistics to
+      // be accumulated over disjoint subsets of data in parallel.
+      virtual void combine(const SufficientStatisticsBase &rhs) = 0;
+
       virtual SufficientStatisticsBase *create() const {
         SufficientStatisticsBase *ans = clone();
         ans->clear();
@@ -402,10 +411,15 @@ namespace BOOM {
       // Re-compute sufficient statistics based on the current values
       // of the residuals assigned to this node.
       //
-      // TODO: Check whether this is a bottleneck, and if
-      // so whether it can be made more efficient using an
-      // "is_current" observer.
-      const SufficientStatisticsBase &compute_suf();
+      // Args:
+      //   pool: If non-NULL and the pool has threads, and the node has
+      //     enough data to make it worthwhile, the data are split into
+      //     one shard per thread.  Each shard accumulates its own
+      //     partial sufficient statistics, which are merged using
+      //     combine() in shard order, so the result does not depend on
+      //     the timing of the threads.
+      const SufficientStatisticsBase &compute_suf(
+          ThreadWorkerPool *pool = nullptr);
 
       // The vector of data associated with this node.
       const std::vector<ResidualRegressionData *> &data() const;
@@ -592,6 +606,14 @@ namespace BOOM {
       // each leaf's mean effect from the residuals for that leaf.
       void replace_mean_effect();
 
+      // Versions of remove_mean_effect() and replace_mean_effect()
+      // that spread the leaves across the threads in 'pool'.  The
+      // leaves partition the data, so each residual is modified by
+      // exactly one thread.  If pool is NULL or has no threads these
+      // are the same as the serial versions.
+      void remove_mean_effect(ThreadWorkerPool *pool);
+      void replace_mean_effect(ThreadWorkerPool *pool);
+
       std::ostream &print(std::ostream &out) const;
 
       // For serialization purposes, the tree can be stored as a
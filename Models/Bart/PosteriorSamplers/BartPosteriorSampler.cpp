@@ -18,6 +18,9 @@
 */
 
 #include "Models/Bart/PosteriorSamplers/BartPosteriorSampler.hpp"
+#include <algorithm>
+#include <memory>
+#include <numeric>
 #include "LinAlg/Selector.hpp"
 #include "Models/Bart/ResidualRegressionData.hpp"
 #include "Samplers/ScalarSliceSampler.hpp"
@@ -299,6 +302,51 @@ namespace BOOM {
     move_probabilities_[CHANGE_CUTPOINT] = probability;
   }
 
+  //----------------------------------------------------------------------
+  void BartPosteriorSamplerBase::set_number_of_threads(int number_of_threads) {
+    pool_.set_number_of_threads(number_of_threads <= 1 ? 0 : number_of_threads);
+  }
+
+  //----------------------------------------------------------------------
+  const std::vector<int> &BartPosteriorSamplerBase::presorted_index(
+      int variable) {
+    ensure_presorted(variable);
+    return presorted_index_[variable];
+  }
+
+  const std::vector<double> &BartPosteriorSamplerBase::presorted_values(
+      int variable) {
+    ensure_presorted(variable);
+    return presorted_values_[variable];
+  }
+
+  void BartPosteriorSamplerBase::ensure_presorted(int variable) {
+    if (presorted_index_.size() != model_->number_of_variables()) {
+      presorted_index_.assign(model_->number_of_variables(),
+                              std::vector<int>());
+      presorted_values_.assign(model_->number_of_variables(),
+                               std::vector<double>());
+    }
+    std::vector<int> &index(presorted_index_[variable]);
+    if (index.size() == residual_size()) {
+      return;
+    }
+    std::vector<double> column(residual_size());
+    for (int i = 0; i < residual_size(); ++i) {
+      column[i] = residual(i)->x()[variable];
+    }
+    index.resize(residual_size());
+    std::iota(index.begin(), index.end(), 0);
+    std::stable_sort(
+        index.begin(), index.end(),
+        [&column](int i, int j) { return column[i] < column[j]; });
+    std::vector<double> &values(presorted_values_[variable]);
+    values.resize(residual_size());
+    for (int i = 0; i < residual_size(); ++i) {
+      values[i] = column[index[i]];
+    }
+  }
+
   //----------------------------------------------------------------------
   double BartPosteriorSamplerBase::logpri() const {
     // Implementing logpri would involve a sum over trees of
@@ -324,7 +372,7 @@ namespace BOOM {
   double BartPosteriorSamplerBase::subtree_log_integrated_likelihood(
       Bart::TreeNode *node) const {
     if (node->is_leaf()) {
-      return log_integrated_likelihood(node->compute_suf());
+      return log_integrated_likelihood(node->compute_suf(thread_pool()));
     } else {
       return subtree_log_integrated_likelihood(node->left_child()) +
              subtree_log_integrated_likelihood(node->right_child());
@@ -337,8 +385,11 @@ namespace BOOM {
     if (residual_size() != model_->sample_size()) {
       clear_residuals();
       clear_data_from_trees();
+      presorted_index_.clear();
+      presorted_values_.clear();
       for (int i = 0; i < model_->sample_size(); ++i) {
         Bart::ResidualRegressionData *data = create_and_store_residual(i);
+        data->set_index(i);
         for (int j = 0; j < model_->number_of_trees(); ++j) {
           model_->tree(j)->populate_data(data);
         }
@@ -358,7 +409,7 @@ namespace BOOM {
 
   //----------------------------------------------------------------------
   void BartPosteriorSamplerBase::modify_tree(Tree *tree) {
-    tree->remove_mean_effect();
+    tree->remove_mean_effect(thread_pool());
     modify_tree_structure(tree);
     draw_terminal_means_and_adjust_residuals(tree);
   }
@@ -473,7 +524,7 @@ namespace BOOM {
 
     double log_likelihood_ratio =
         subtree_log_integrated_likelihood(branch_root) -
-        log_integrated_likelihood(branch_root->compute_suf());
+        log_integrated_likelihood(branch_root->compute_suf(thread_pool()));
 
     int depth = branch_root->depth();
     double log_prior_ratio = -log_probability_of_no_split(depth);
@@ -638,10 +689,11 @@ namespace BOOM {
     int original_number_of_leaves = tree->number_of_leaves() - 1;
     int depth = leaf->depth();
 
+    ThreadWorkerPool *pool = thread_pool();
     double log_likelihood_ratio =
-        log_integrated_likelihood(leaf->left_child()->compute_suf()) +
-        log_integrated_likelihood(leaf->right_child()->compute_suf()) -
-        log_integrated_likelihood(leaf->compute_suf());
+        log_integrated_likelihood(leaf->left_child()->compute_suf(pool)) +
+        log_integrated_likelihood(leaf->right_child()->compute_suf(pool)) -
+        log_integrated_likelihood(leaf->compute_suf(pool));
 
     // The prior_ratio omits a factor of p(variable, cutpoint) that
     // cancels with the transition distribution.
@@ -758,16 +810,123 @@ namespace BOOM {
     MH_accounting_.record_acceptance("slice_cutpoint");
   }
 
+  //----------------------------------------------------------------------
+  CutpointLogLikelihoodTable::CutpointLogLikelihoodTable(
+      BartPosteriorSamplerBase *sampler, const TreeNode *node,
+      ThreadWorkerPool *pool)
+      : sampler_(sampler) {
+    std::vector<SortedObservation> sorted_data = sort_data(sampler, node);
+    // group_start[k] is the position in sorted_data of the first
+    // observation with the k'th smallest distinct value.
+    std::vector<int> group_start;
+    for (int i = 0; i < sorted_data.size(); ++i) {
+      double value = sorted_data[i].value;
+      if (i == 0 || value != distinct_values_.back()) {
+        distinct_values_.push_back(value);
+        group_start.push_back(i);
+      }
+    }
+    group_start.push_back(sorted_data.size());
+    int number_of_groups = distinct_values_.size();
+    left_log_likelihood_.resize(number_of_groups + 1);
+    right_log_likelihood_.resize(number_of_groups + 1);
+
+    auto left_sweep = [&]() {
+      std::unique_ptr<Bart::SufficientStatisticsBase> suf(
+          sampler_->create_suf());
+      left_log_likelihood_[0] = sampler_->log_integrated_likelihood(*suf);
+      for (int k = 0; k < number_of_groups; ++k) {
+        for (int i = group_start[k]; i < group_start[k + 1]; ++i) {
+          suf->update(*sorted_data[i].data);
+        }
+        left_log_likelihood_[k + 1] =
+            sampler_->log_integrated_likelihood(*suf);
+      }
+    };
+    auto right_sweep = [&]() {
+      std::unique_ptr<Bart::SufficientStatisticsBase> suf(
+          sampler_->create_suf());
+      right_log_likelihood_[number_of_groups] =
+          sampler_->log_integrated_likelihood(*suf);
+      for (int k = number_of_groups - 1; k >= 0; --k) {
+        for (int i = group_start[k]; i < group_start[k + 1]; ++i) {
+          suf->update(*sorted_data[i].data);
+        }
+        right_log_likelihood_[k] = sampler_->log_integrated_likelihood(*suf);
+      }
+    };
+    if (pool && !pool->no_threads()) {
+      std::future<void> left = pool->submit(left_sweep);
+      right_sweep();
+      left.get();
+    } else {
+      left_sweep();
+      right_sweep();
+    }
+  }
+
+  double CutpointLogLikelihoodTable::operator()(double cutpoint) const {
+    int number_to_left =
+        std::upper_bound(distinct_values_.begin(), distinct_values_.end(),
+                         cutpoint) -
+        distinct_values_.begin();
+    return left_log_likelihood_[number_to_left] +
+           right_log_likelihood_[number_to_left];
+  }
+
+  // Sorting the node's data directly costs O(n log n).  Filtering the
+  // sampler's presorted index costs O(N), where N is the total sample
+  // size, so that is used for nodes holding a large fraction of the data.
+  std::vector<CutpointLogLikelihoodTable::SortedObservation>
+  CutpointLogLikelihoodTable::sort_data(BartPosteriorSamplerBase *sampler,
+                                        const TreeNode *node) {
+    const std::vector<ResidualRegressionData *> &data(node->data());
+    int variable = node->variable_index();
+    int sample_size = data.size();
+    int total_sample_size = sampler->residual_size();
+    std::vector<SortedObservation> ans;
+    ans.reserve(sample_size);
+    if (sample_size * log2(sample_size + 1.0) < total_sample_size) {
+      for (const ResidualRegressionData *data_point : data) {
+        ans.push_back({data_point->x()[variable], data_point});
+      }
+      std::stable_sort(ans.begin(), ans.end());
+    } else {
+      std::vector<bool> in_node(total_sample_size, false);
+      for (const ResidualRegressionData *data_point : data) {
+        in_node[data_point->index()] = true;
+      }
+      const std::vector<int> &index(sampler->presorted_index(variable));
+      const std::vector<double> &values(sampler->presorted_values(variable));
+      for (int i = 0; i < index.size(); ++i) {
+        if (in_node[index[i]]) {
+          ans.push_back({values[i], sampler->residual(index[i])});
+        }
+      }
+    }
+    return ans;
+  }
+
   //----------------------------------------------------------------------
   class ContinuousCutpointLogLikelihood {
    public:
-    ContinuousCutpointLogLikelihood(BartPosteriorSamplerBase *sampler,
-                                    TreeNode *node, double lower_cutpoint_bound,
-                                    double upper_cutpoint_bound)
+    // Args:
+    //   sampler:  The sampler that owns the tree containing 'node'.
+    //   node:  The node whose cutpoint is being sampled.
+    //   lower_cutpoint_bound:  The smallest legal cutpoint.
+    //   upper_cutpoint_bound:  The largest legal cutpoint.
+    //   table: If non-NULL, log likelihoods are looked up in the table
+    //     rather than computed by re-assigning the node's data.  In
+    //     that case the node itself is not modified.
+    ContinuousCutpointLogLikelihood(
+        BartPosteriorSamplerBase *sampler, TreeNode *node,
+        double lower_cutpoint_bound, double upper_cutpoint_bound,
+        const CutpointLogLikelihoodTable *table = nullptr)
         : sampler_(sampler),
           node_(node),
           lower_cutpoint_bound_(lower_cutpoint_bound),
-          upper_cutpoint_bound_(upper_cutpoint_bound) {}
+          upper_cutpoint_bound_(upper_cutpoint_bound),
+          table_(table) {}
 
     double operator()(double cutpoint) {
       if (cutpoint < lower_cutpoint_bound_) {
@@ -775,6 +934,9 @@ namespace BOOM {
       } else if (cutpoint > upper_cutpoint_bound_) {
         return negative_infinity();
       }
+      if (table_) {
+        return (*table_)(cutpoint);
+      }
       node_->set_variable_and_cutpoint(node_->variable_index(), cutpoint);
       node_->refresh_subtree_data();
       return sampler_->subtree_log_integrated_likelihood(node_);
@@ -785,6 +947,7 @@ namespace BOOM {
     TreeNode *node_;
     double lower_cutpoint_bound_;
     double upper_cutpoint_bound_;
+    const CutpointLogLikelihoodTable *table_;
   };
 
   void BartPosteriorSamplerBase::slice_sample_continuous_cutpoint(
@@ -792,7 +955,12 @@ namespace BOOM {
     int variable = node->variable_index();
     const VariableSummary &variable_summary(model_->variable_summary(variable));
     Vector range = variable_summary.get_cutpoint_range(node);
-    ContinuousCutpointLogLikelihood logf(this, node, range[0], range[1]);
+    std::unique_ptr<CutpointLogLikelihoodTable> table;
+    if (node->has_no_grandchildren()) {
+      table.reset(new CutpointLogLikelihoodTable(this, node, thread_pool()));
+    }
+    ContinuousCutpointLogLikelihood logf(this, node, range[0], range[1],
+                                         table.get());
     ScalarSliceSampler slice(logf);
     slice.set_limits(range[0], range[1]);
     double cutpoint = slice.draw(node->cutpoint());
@@ -815,11 +983,16 @@ namespace BOOM {
       return;
     }
 
+    std::unique_ptr<CutpointLogLikelihoodTable> table;
+    if (node->has_no_grandchildren()) {
+      table.reset(new CutpointLogLikelihoodTable(this, node, thread_pool()));
+    }
     double logf_slice =
         subtree_log_integrated_likelihood(node) - rexp_mt(rng(), 1.0);
     Selector possible_cutpoint_positions(potential_cutpoint_values.size(),
                                          true);
     double logp = logf_slice - 1;
+    double cutpoint = node->cutpoint();
     while (logp < logf_slice && possible_cutpoint_positions.nvars() > 0) {
       int pos = possible_cutpoint_positions.random_included_position(rng());
       if (pos < 0) {
@@ -827,10 +1000,14 @@ namespace BOOM {
             "Something went wrong when sampling cutpoints in "
             "'slice_sample_discrete_cutpoint'");
       }
-      double cutpoint = potential_cutpoint_values[pos];
-      node->set_variable_and_cutpoint(variable, cutpoint);
-      node->refresh_subtree_data();
-      logp = subtree_log_integrated_likelihood(node);
+      cutpoint = potential_cutpoint_values[pos];
+      if (table) {
+        logp = (*table)(cutpoint);
+      } else {
+        node->set_variable_and_cutpoint(variable, cutpoint);
+        node->refresh_subtree_data();
+        logp = subtree_log_integrated_likelihood(node);
+      }
       possible_cutpoint_positions.drop(pos);
     }
     if (logp < logf_slice && possible_cutpoint_positions.nvars() == 0) {
@@ -838,6 +1015,10 @@ namespace BOOM {
           "Ran out of choices for cutpoints when slice sampling "
           "a discrete variable.");
     }
+    if (table) {
+      node->set_variable_and_cutpoint(variable, cutpoint);
+      node->refresh_subtree_data();
+    }
   }
 
   //----------------------------------------------------------------------
@@ -848,8 +1029,10 @@ namespace BOOM {
       Bart::TreeNode *leaf = *it;
       double mean = draw_mean(leaf);
       leaf->set_mean(mean);
-      leaf->replace_mean_effect();
     }
+    // The leaves partition the data, so the residuals can be adjusted
+    // after all the means have been drawn.
+    tree->replace_mean_effect(thread_pool());
   }
 
   //----------------------------------------------------------------------
@@ -1001,13 +1184,14 @@ namespace BOOM {
     double proposal_loglike = 0;
     for (Bart::Tree::ConstNodeSetIterator it = proposal->leaf_begin();
          it != proposal->leaf_end(); ++it) {
-      proposal_loglike += log_integrated_likelihood((*it)->compute_suf());
+      proposal_loglike +=
+          log_integrated_likelihood((*it)->compute_suf(thread_pool()));
     }
 
     // Any root will do here, since they all start with the same set
     // of data.
-    double current_loglike =
-        complete_data_log_likelihood(proposal->root()->compute_suf());
+    double current_loglike = complete_data_log_likelihood(
+        proposal->root()->compute_suf(thread_pool()));
 
     double log_numerator = proposal_loglike + proposal_log_prior -
                            log_proposal_transition_probability;
@@ -1133,12 +1317,12 @@ namespace BOOM {
     // Compute the likelihood contributions for the proposal and the
     // current model.
 
-    double current_loglike =
-        complete_data_log_likelihood(stump->root()->compute_suf());
+    double current_loglike = complete_data_log_likelihood(
+        stump->root()->compute_suf(thread_pool()));
 
     stump->remove_mean_effect();
-    double proposal_loglike =
-        complete_data_log_likelihood(stump->root()->compute_suf());
+    double proposal_loglike = complete_data_log_likelihood(
+        stump->root()->compute_suf(thread_pool()));
 
     double log_numerator = proposal_loglike + proposal_log_prior -
                            log_proposal_transition_probability;
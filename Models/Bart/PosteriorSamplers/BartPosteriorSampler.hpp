@@ -20,10 +20,13 @@
 #ifndef BART_POSTERIOR_SAMPLER_BASE_HPP_
 #define BART_POSTERIOR_SAMPLER_BASE_HPP_
 
+#include <vector>
+
 #include "Models/Bart/Bart.hpp"
 #include "Models/GaussianModel.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Samplers/MoveAccounting.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "cpputil/math_utils.hpp"
 
 namespace BOOM {
@@ -122,6 +125,16 @@ namespace BOOM {
     // distribution.
     void set_default_move_probabilities();
 
+    // Use the specified number of threads to compute sufficient
+    // statistics for large leaves, to adjust residuals for the mean
+    // effects of the leaves in each tree, and to build the tables
+    // used to slice sample cutpoints.  The MCMC moves themselves are
+    // made serially, so a single seeding RNG drives the whole chain.
+    // Args:
+    //   number_of_threads: The number of worker threads.  Values less
+    //     than 2 turn off threading.
+    void set_number_of_threads(int number_of_threads);
+
     // Sets the vector of move probabilities to move_probs, which must
     // have the same number of elements as the TreeStructureMoveType
     // enum.
@@ -136,6 +149,9 @@ namespace BOOM {
     // they have been created and placed where they need to be, and
     // calls to modify tree.
     void draw() override;
+    const MoveAccounting *mh_accounting() const override {
+      return &MH_accounting_;
+    }
 
     // Returns a draw of the mean parameter for the given leaf,
     // conditional on the tree structure and the data assigned to
@@ -283,11 +299,31 @@ namespace BOOM {
     bool assign_random_split_rule_from_subset(Bart::TreeNode *leaf,
                                               Selector &included_variables);
 
+    // Returns the indices of the residuals, ordered by the value of
+    // the specified predictor variable.  The ordering is computed
+    // the first time it is requested, and reused until the residuals
+    // are rebuilt by check_residuals().
+    const std::vector<int> &presorted_index(int variable);
+
+    // The values of the specified predictor variable in the order given
+    // by presorted_index(variable).
+    const std::vector<double> &presorted_values(int variable);
+
    protected:
     // Removes all pointers to residuals_ from the trees owned by
     // model_.
     void clear_data_from_trees();
 
+    // Compute the presorted index and values for 'variable', if they
+    // are not already current.
+    void ensure_presorted(int variable);
+
+    // The thread pool to pass to operations that can use it, or NULL
+    // if threading is turned off.
+    ThreadWorkerPool *thread_pool() const {
+      return pool_.no_threads() ? nullptr : &pool_;
+    }
+
     //----------------------------------------------------------------------
     // Compute the log of the Metropolis-Hastings ratio for the split
     // move.  The log ratio for the prune_split move is -1 times this
@@ -334,6 +370,66 @@ namespace BOOM {
     // The vector of move_probabilities_ must be the same length as
     // the number of elements in the MoveType enum.
     Vector move_probabilities_;
+
+    // Mutable so that const members computing log likelihoods can
+    // dispatch work to it.
+    mutable ThreadWorkerPool pool_;
+
+    // presorted_index_[v] is either empty (not yet computed) or the
+    // residual indices ordered by predictor v.  presorted_values_[v]
+    // holds the corresponding values of predictor v.
+    std::vector<std::vector<int>> presorted_index_;
+    std::vector<std::vector<double>> presorted_values_;
+  };
+
+  //======================================================================
+  // The log integrated likelihood of a node whose children are both
+  // leaves, as a function of the node's cutpoint on a fixed variable.
+  // The node's data are sorted by the splitting variable, and the
+  // sufficient statistics for each child are accumulated in a single
+  // left-to-right (for the left child) or right-to-left (for the right
+  // child) sweep.  The log likelihood for any cutpoint is then a table
+  // lookup, instead of a pass through the data to re-assign
+  // observations to children and recompute their sufficient statistics.
+  class CutpointLogLikelihoodTable {
+   public:
+    // Args:
+    //   sampler:  The sampler supplying log_integrated_likelihood().
+    //   node: An interior node with no grandchildren.  Its variable
+    //     index determines the variable being split.
+    //   pool: If non-NULL and the pool has threads, the two sweeps run
+    //     in parallel.
+    CutpointLogLikelihoodTable(BartPosteriorSamplerBase *sampler,
+                               const Bart::TreeNode *node,
+                               ThreadWorkerPool *pool);
+
+    // Returns the log integrated likelihood of the node's subtree if
+    // the node's cutpoint were set to 'cutpoint'.  Observations with
+    // x[variable] <= cutpoint fall to the left child.
+    double operator()(double cutpoint) const;
+
+   private:
+    struct SortedObservation {
+      double value;
+      const Bart::ResidualRegressionData *data;
+      bool operator<(const SortedObservation &rhs) const {
+        return value < rhs.value;
+      }
+    };
+
+    // Returns the node's data sorted by the node's splitting variable.
+    static std::vector<SortedObservation> sort_data(
+        BartPosteriorSamplerBase *sampler, const Bart::TreeNode *node);
+
+    BartPosteriorSamplerBase *sampler_;
+    std::vector<double> distinct_values_;
+
+    // left_log_likelihood_[k] is the log integrated likelihood of the
+    // observations with the k smallest distinct values.
+    // right_log_likelihood_[k] is the log integrated likelihood of the
+    // remaining observations.
+    std::vector<double> left_log_likelihood_;
+    std::vector<double> right_log_likelihood_;
   };
 
 }  // namespace BOOM
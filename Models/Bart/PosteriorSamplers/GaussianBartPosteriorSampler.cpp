@@ -19,6 +19,7 @@
 
 #include "Models/Bart/PosteriorSamplers/GaussianBartPosteriorSampler.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -35,6 +36,16 @@ namespace BOOM {
       suf.update(*this);
     }
 
+    void GaussianBartSufficientStatistics::combine(
+        const SufficientStatisticsBase &rhs) {
+      const GaussianBartSufficientStatistics *gaussian_rhs =
+          dynamic_cast<const GaussianBartSufficientStatistics *>(&rhs);
+      if (!gaussian_rhs) {
+        report_error("Attempt to combine incompatible sufficient statistics.");
+      }
+      suf_.combine(gaussian_rhs->suf_);
+    }
+
   }  // namespace Bart
 
   const double GaussianBartPosteriorSampler::log_2_pi(1.83787706640935);
@@ -61,7 +72,7 @@ namespace BOOM {
     double sigsq = model_->sigsq();
     const Bart::GaussianBartSufficientStatistics &suf(
         dynamic_cast<const Bart::GaussianBartSufficientStatistics &>(
-            leaf->compute_suf()));
+            leaf->compute_suf(thread_pool())));
     double ivar = suf.n() / sigsq + 1.0 / mean_prior_variance();
     double mean = (suf.sum() / sigsq) / ivar;
     double sd = sqrt(1.0 / ivar);
@@ -85,6 +85,23 @@ namespace BOOM {
       information_weighted_sum_of_squared_predictions_ += info * pred * pred;
     }
 
+    void LogitSufficientStatistics::combine(
+        const SufficientStatisticsBase &rhs) {
+      const LogitSufficientStatistics *logit_rhs =
+          dynamic_cast<const LogitSufficientStatistics *>(&rhs);
+      if (!logit_rhs) {
+        report_error("Attempt to combine incompatible sufficient statistics.");
+      }
+      sum_of_information_ += logit_rhs->sum_of_information_;
+      information_weighted_prediction_ +=
+          logit_rhs->information_weighted_prediction_;
+      information_weighted_sum_ += logit_rhs->information_weighted_sum_;
+      information_weighted_sum_of_observation_times_prediction_ +=
+          logit_rhs->information_weighted_sum_of_observation_times_prediction_;
+      information_weighted_sum_of_squared_predictions_ +=
+          logit_rhs->information_weighted_sum_of_squared_predictions_;
+    }
+
     double LogitSufficientStatistics::sum_of_information() const {
       return sum_of_information_;
     }
@@ -147,7 +164,7 @@ namespace BOOM {
   double LogitBartPosteriorSampler::draw_mean(Bart::TreeNode *leaf) {
     const Bart::LogitSufficientStatistics &suf(
         dynamic_cast<const Bart::LogitSufficientStatistics &>(
-            leaf->compute_suf()));
+            leaf->compute_suf(thread_pool())));
     double prior_variance = mean_prior_variance();
     double ivar = (1.0 / prior_variance) + suf.sum_of_information();
     double posterior_mean = suf.information_weighted_residual_sum() / ivar;
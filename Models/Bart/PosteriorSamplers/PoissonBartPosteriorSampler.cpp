@@ -20,6 +20,7 @@
 #include "Models/Bart/PosteriorSamplers/PoissonBartPosteriorSampler.hpp"
 #include "Models/Glm/PosteriorSamplers/poisson_mixture_approximation_table.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -121,6 +122,20 @@ namespace BOOM {
         weighted_sum_of_squared_residuals_ += weight * square(residual);
       }
     }
+
+    //----------------------------------------------------------------------
+    void PoissonSufficientStatistics::combine(
+        const SufficientStatisticsBase &rhs) {
+      const PoissonSufficientStatistics *poisson_rhs =
+          dynamic_cast<const PoissonSufficientStatistics *>(&rhs);
+      if (!poisson_rhs) {
+        report_error("Attempt to combine incompatible sufficient statistics.");
+      }
+      sum_of_weights_ += poisson_rhs->sum_of_weights_;
+      weighted_sum_of_residuals_ += poisson_rhs->weighted_sum_of_residuals_;
+      weighted_sum_of_squared_residuals_ +=
+          poisson_rhs->weighted_sum_of_squared_residuals_;
+    }
   }  // namespace Bart
 
   //======================================================================
@@ -146,7 +161,7 @@ namespace BOOM {
   double PoissonBartPosteriorSampler::draw_mean(Bart::TreeNode *leaf) {
     const Bart::PoissonSufficientStatistics &suf(
         dynamic_cast<const Bart::PoissonSufficientStatistics &>(
-            leaf->compute_suf()));
+            leaf->compute_suf(thread_pool())));
     double ivar = suf.sum_of_weights() + 1.0 / mean_prior_variance();
     double posterior_mean = suf.weighted_sum_of_residuals() / ivar;
     double posterior_sd = sqrt(1.0 / ivar);
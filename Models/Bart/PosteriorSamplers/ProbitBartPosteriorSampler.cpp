@@ -76,6 +76,17 @@ namespace BOOM {
       sum_ += data.sum_of_residuals();
     }
 
+    void ProbitSufficientStatistics::combine(
+        const SufficientStatisticsBase &rhs) {
+      const ProbitSufficientStatistics *probit_rhs =
+          dynamic_cast<const ProbitSufficientStatistics *>(&rhs);
+      if (!probit_rhs) {
+        report_error("Attempt to combine incompatible sufficient statistics.");
+      }
+      n_ += probit_rhs->n_;
+      sum_ += probit_rhs->sum_;
+    }
+
     int ProbitSufficientStatistics::sample_size() const { return n_; }
 
     double ProbitSufficientStatistics::sum() const { return sum_; }
@@ -104,7 +115,7 @@ namespace BOOM {
   double ProbitBartPosteriorSampler::draw_mean(Bart::TreeNode *leaf) {
     const Bart::ProbitSufficientStatistics &suf(
         dynamic_cast<const Bart::ProbitSufficientStatistics &>(
-            leaf->compute_suf()));
+            leaf->compute_suf(thread_pool())));
     double prior_variance = mean_prior_variance();
     double ivar = suf.sample_size() + (1.0 / prior_variance);
     double posterior_mean = suf.sum() / ivar;
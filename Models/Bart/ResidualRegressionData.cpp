@@ -24,7 +24,7 @@ namespace BOOM {
   namespace Bart {
 
     ResidualRegressionData::ResidualRegressionData(const VectorData *x)
-        : predictor_(x) {}
+        : predictor_(x), index_(-1) {}
 
     //----------------------------------------------------------------------
     const Vector &ResidualRegressionData::x() const {
@@ -74,8 +74,14 @@ namespace BOOM {
       virtual void add_to_probit_suf(ProbitSufficientStatistics &suf) const;
       virtual void add_to_logit_suf(LogitSufficientStatistics &suf) const;
 
+      // The position of this observation in the posterior sampler's
+      // vector of residuals, or -1 if it has not been assigned.
+      int index() const { return index_; }
+      void set_index(int index) { index_ = index; }
+
      private:
       const VectorData *predictor_;
+      int index_;
     };
 
   }  // namespace Bart
@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+#include "Models/Bart/GaussianBartModel.hpp"
+#include "Models/Bart/PosteriorSamplers/GaussianBartPosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class BartPosteriorSamplerTest : public ::testing::Test {
+   protected:
+    BartPosteriorSamplerTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // Simulate 'sample_size' observations, and build a single tree model
+    // with a sampler.  The first predictor takes 40 distinct values, so it
+    // has many ties.  The second is continuous.
+    void build_model(int sample_size) {
+      Matrix x(sample_size, 2);
+      Vector y(sample_size);
+      for (int i = 0; i < sample_size; ++i) {
+        x(i, 0) = random_int(0, 39) / 4.0;
+        x(i, 1) = runif();
+        y[i] = (x(i, 0) > 5 ? 3.0 : -1.0) + 2 * x(i, 1) + rnorm();
+      }
+      model_.reset(new GaussianBartModel(1, y, x));
+      model_->finalize_data();
+      sampler_.reset(new GaussianBartPosteriorSampler(
+          model_.get(), 1.0, 3.0, 2.0, .95, 2.0, PointMassPrior(1)));
+      model_->set_method(sampler_);
+      sampler_->check_residuals();
+    }
+
+    // Compare the tabulated log likelihood of 'node' with the log
+    // likelihood obtained by re-assigning the data, at each distinct value
+    // of the node's variable, and at points between and beyond them.
+    void check_table(Bart::TreeNode *node, ThreadWorkerPool *pool) {
+      int variable = node->variable_index();
+      double original_cutpoint = node->cutpoint();
+      std::vector<double> cutpoints;
+      for (const auto *data_point : node->data()) {
+        cutpoints.push_back(data_point->x()[variable]);
+      }
+      std::sort(cutpoints.begin(), cutpoints.end());
+      cutpoints.erase(std::unique(cutpoints.begin(), cutpoints.end()),
+                      cutpoints.end());
+      ASSERT_GT(cutpoints.size(), 2);
+      int number_of_values = cutpoints.size();
+      for (int i = 1; i < number_of_values; ++i) {
+        cutpoints.push_back(.5 * (cutpoints[i - 1] + cutpoints[i]));
+      }
+      cutpoints.push_back(cutpoints[0] - 1);
+      cutpoints.push_back(cutpoints[number_of_values - 1] + 1);
+
+      CutpointLogLikelihoodTable table(sampler_.get(), node, pool);
+      for (double cutpoint : cutpoints) {
+        double tabulated = table(cutpoint);
+        node->set_variable_and_cutpoint(variable, cutpoint);
+        node->refresh_subtree_data();
+        double direct = sampler_->subtree_log_integrated_likelihood(node);
+        if (std::isfinite(direct)) {
+          EXPECT_NEAR(direct, tabulated, 1e-8 * fabs(direct))
+              << "cutpoint " << cutpoint;
+        } else {
+          // Cutpoints outside the range of the data leave a child empty.
+          EXPECT_EQ(direct, tabulated) << "cutpoint " << cutpoint;
+        }
+      }
+      node->set_variable_and_cutpoint(variable, original_cutpoint);
+      node->refresh_subtree_data();
+    }
+
+    Ptr<GaussianBartModel> model_;
+    Ptr<GaussianBartPosteriorSampler> sampler_;
+  };
+
+  TEST_F(BartPosteriorSamplerTest, CutpointTableMatchesDirectLikelihood) {
+    build_model(2000);
+    Bart::Tree *tree = model_->tree(0);
+    Bart::TreeNode *root = tree->root();
+    // The root's left child holds a small fraction of the data, so its
+    // table sorts the node's own data.  The right child holds most of the
+    // data, so its table filters the sampler's presorted index.
+    root->set_variable_and_cutpoint(1, .05);
+    tree->grow(root);
+    Bart::TreeNode *small_node = root->left_child();
+    Bart::TreeNode *large_node = root->right_child();
+    small_node->set_variable_and_cutpoint(0, 2.0);
+    tree->grow(small_node);
+    large_node->set_variable_and_cutpoint(0, 5.0);
+    tree->grow(large_node);
+    ASSERT_TRUE(small_node->has_no_grandchildren());
+    ASSERT_TRUE(large_node->has_no_grandchildren());
+    ASSERT_LT(small_node->sample_size() * log2(small_node->sample_size() + 1),
+              sampler_->residual_size());
+    ASSERT_GE(large_node->sample_size() * log2(large_node->sample_size() + 1),
+              sampler_->residual_size());
+
+    ThreadWorkerPool pool(2);
+    for (Bart::TreeNode *node : {small_node, large_node}) {
+      check_table(node, nullptr);
+      check_table(node, &pool);
+    }
+
+    // A continuous splitting variable, where every value is distinct.
+    large_node->set_variable_and_cutpoint(1, .5);
+    large_node->refresh_subtree_data();
+    check_table(large_node, &pool);
+  }
+
+  TEST_F(BartPosteriorSamplerTest, ThreadedSufficientStatisticsMatchSerial) {
+    // Large enough that the root is split into several shards.
+    build_model(50000);
+    Bart::TreeNode *root = model_->tree(0)->root();
+    ASSERT_EQ(50000, root->sample_size());
+
+    const auto &serial_suf =
+        dynamic_cast<const Bart::GaussianBartSufficientStatistics &>(
+            root->compute_suf());
+    double n = serial_suf.n();
+    double sum = serial_suf.sum();
+    double sumsq = serial_suf.sumsq();
+    double serial_loglike = sampler_->log_integrated_likelihood(serial_suf);
+
+    for (int nthreads : {1, 2, 4}) {
+      ThreadWorkerPool pool(nthreads);
+      const auto &threaded_suf =
+          dynamic_cast<const Bart::GaussianBartSufficientStatistics &>(
+              root->compute_suf(&pool));
+      EXPECT_EQ(n, threaded_suf.n()) << nthreads << " threads";
+      // The shards are summed in a different order than the serial pass, so
+      // the results agree to rounding error.
+      EXPECT_NEAR(sum, threaded_suf.sum(), 1e-10 * sumsq)
+          << nthreads << " threads";
+      EXPECT_NEAR(sumsq, threaded_suf.sumsq(), 1e-10 * sumsq)
+          << nthreads << " threads";
+      EXPECT_NEAR(serial_loglike,
+                  sampler_->log_integrated_likelihood(threaded_suf),
+                  1e-8 * fabs(serial_loglike))
+          << nthreads << " threads";
+
+      // The shards are merged in order, so the threaded result does not
+      // depend on the timing of the threads.
+      double threaded_sum = threaded_suf.sum();
+      double threaded_sumsq = threaded_suf.sumsq();
+      root->compute_suf(&pool);
+      EXPECT_EQ(threaded_sum, threaded_suf.sum());
+      EXPECT_EQ(threaded_sumsq, threaded_suf.sumsq());
+    }
+  }
+
+}  // namespace
@@ -20,8 +20,10 @@
 #ifndef BOOM_MODELS_DATA_TYPES_H
 #define BOOM_MODELS_DATA_TYPES_H
 
+#include <atomic>
 #include <cmath>
 #include <map>  // for STL's map container
+#include <memory>
 #include <string>
 #include <vector>
 // The iostream include is needed for templated display() to compile across
@@ -41,29 +43,53 @@
 
 namespace BOOM {
 
+  // Data objects are often created in very large numbers (one per
+  // observation), so the base class is kept small.  In particular, the
+  // collection of observers is only allocated if someone actually observes
+  // the object.  An unobserved Data object costs a virtual table pointer, a
+  // reference count, a missing data flag, and a NULL pointer.
   class Data {  // abstract base class
    public:
-    RefCounted rc_;
-    void up_count() { rc_.up_count(); }
-    void down_count() { rc_.down_count(); }
-    unsigned int ref_count() { return rc_.ref_count(); }
+    void up_count() { ++reference_count_; }
+    void down_count() { --reference_count_; }
+    unsigned int ref_count() { return reference_count_; }
 
     enum missing_status { observed = 0, completely_missing, partly_missing };
 
-    Data() : missing_flag(observed) {}
+    Data() : reference_count_(0), missing_flag(observed) {}
     // When copying Data, the observers should not be copied.
     Data(const Data &rhs)
-        : missing_flag(rhs.missing_flag),
-          signals_() {}
+        : reference_count_(0),
+          missing_flag(rhs.missing_flag) {}
+
+    // Assignment copies the missing data status, but neither the reference
+    // count nor the observers.  Observers watch an object, not a value.
+    Data &operator=(const Data &rhs) {
+      missing_flag = rhs.missing_flag;
+      return *this;
+    }
+
     virtual Data *clone() const = 0;
-    virtual ~Data() {signals_.clear();}
+    virtual ~Data() {}
     virtual std::ostream &display(std::ostream &) const = 0;
     missing_status missing() const;
     void set_missing_status(missing_status m);
+    // An observer may add or remove observers (including itself) while it
+    // is being signaled.  Observers removed during a signal are not called,
+    // and are erased once the outermost call to signal() finishes.
     void signal() {
-      for (auto &it : signals_) {
-        it.second();
+      if (!signals_) return;
+      ObserverList &list(*signals_);
+      ++list.signal_depth;
+      try {
+        for (auto &it : list.observers) {
+          if (!it.second.removed) it.second.callback();
+        }
+      } catch (...) {
+        finish_signal();
+        throw;
       }
+      finish_signal();
     }
     // TODO: This implementation of the observer pattern is broken by
     // assignment.  When an object is created from an old object by assignment,
@@ -74,21 +100,84 @@ namespace BOOM {
     // from the set of signals.  This fix will require making changes to all the
     // classes that use the current observer scheme.
     void add_observer(void *owner, const std::function<void(void)> &f) {
-      signals_.insert(std::make_pair(owner, f));
+      if (!signals_) {
+        signals_.reset(new ObserverList);
+      }
+      signals_->observers.insert(std::make_pair(owner, Observer{f, false}));
     }
 
+    // While a signal is in progress the observers are only marked as
+    // removed, because signal() may be iterating over them.
     void remove_observer(void *owner) {
-      signals_.erase(owner);
+      if (!signals_) return;
+      if (signals_->signal_depth > 0) {
+        auto range = signals_->observers.equal_range(owner);
+        for (auto it = range.first; it != range.second; ++it) {
+          it->second.removed = true;
+        }
+      } else {
+        signals_->observers.erase(owner);
+        if (signals_->observers.empty()) signals_.reset();
+      }
     }
 
     // Remove all observers.
-    void clear_observers() { signals_.clear(); }
+    void clear_observers() {
+      if (!signals_) return;
+      if (signals_->signal_depth > 0) {
+        for (auto &it : signals_->observers) {
+          it.second.removed = true;
+        }
+      } else {
+        signals_.reset();
+      }
+    }
+
+    // Returns true if at least one observer is watching this object.
+    bool has_observers() const {
+      if (!signals_) return false;
+      for (const auto &it : signals_->observers) {
+        if (!it.second.removed) return true;
+      }
+      return false;
+    }
+
     friend void intrusive_ptr_add_ref(Data *d);
     friend void intrusive_ptr_release(Data *d);
 
    private:
+    struct Observer {
+      std::function<void(void)> callback;
+      // Set by remove_observer() when it is called during a signal.
+      bool removed;
+    };
+
+    struct ObserverList {
+      std::multimap<void *, Observer> observers;
+      // The number of calls to signal() in progress.
+      int signal_depth = 0;
+    };
+
+    // Called at the end of signal().  When the outermost signal finishes,
+    // the observers that were removed while it ran are erased.
+    void finish_signal() {
+      if (--signals_->signal_depth > 0) return;
+      auto &observers(signals_->observers);
+      for (auto it = observers.begin(); it != observers.end(); ) {
+        if (it->second.removed) {
+          it = observers.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      if (observers.empty()) signals_.reset();
+    }
+
+    std::atomic<unsigned int> reference_count_;
     missing_status missing_flag;
-    std::multimap<void *, std::function<void(void)>>  signals_;
+
+    // Allocated on demand by add_observer().  NULL if there are no observers.
+    std::unique_ptr<ObserverList> signals_;
   };
   //======================================================================
   std::ostream &operator<<(std::ostream &out, const Data &d);
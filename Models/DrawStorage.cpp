@@ -0,0 +1,396 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/DrawStorage.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include "Models/ModelTypes.hpp"
+#include "cpputil/report_error.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BOOM {
+
+  namespace {
+    const char draw_file_magic[8] = {'B', 'O', 'O', 'M', 'D', 'R', 'A', 'W'};
+    const std::uint32_t draw_file_version = 1;
+
+    struct DrawFileHeader {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t bytes_per_value;
+      std::int64_t dimension;
+      std::int64_t number_of_draws;
+      std::int64_t thin;
+      char unused[24];
+    };
+    static_assert(sizeof(DrawFileHeader) == 64,
+                  "The draw file header must be 64 bytes.");
+
+    const std::int64_t header_size = sizeof(DrawFileHeader);
+
+    std::int64_t bytes_per_value(DrawStorage::Precision precision) {
+      return static_cast<std::int64_t>(precision);
+    }
+
+    void report_system_error(const std::string &operation,
+                             const std::string &filename) {
+      std::ostringstream err;
+      err << "Could not " << operation << " draw file " << filename << ": "
+          << std::strerror(errno);
+      report_error(err.str());
+    }
+  }  // namespace
+
+  //===========================================================================
+  void DrawFileWriter::write(const ConstVectorView &draw) {
+    if (file_descriptor_ < 0) {
+      report_error("Attempt to write to a closed DrawFileWriter.");
+    }
+    if (draw.size() != dimension_) {
+      std::ostringstream err;
+      err << "DrawFileWriter expected a draw of dimension " << dimension_
+          << " but got one of dimension " << draw.size() << ".";
+      report_error(err.str());
+    }
+    if (number_of_calls_++ % thin_ != 0) {
+      return;
+    }
+    if (precision_ == DrawStorage::Precision::FLOAT32) {
+      for (int i = 0; i < dimension_; ++i) {
+        float_buffer_[i] = static_cast<float>(draw[i]);
+      }
+      write_bytes(reinterpret_cast<const char *>(float_buffer_.data()),
+                  dimension_ * sizeof(float));
+    } else if (draw.stride() == 1) {
+      write_bytes(reinterpret_cast<const char *>(draw.data()),
+                  dimension_ * sizeof(double));
+    } else {
+      for (int i = 0; i < dimension_; ++i) {
+        double value = draw[i];
+        write_bytes(reinterpret_cast<const char *>(&value), sizeof(double));
+      }
+    }
+    ++number_of_draws_;
+  }
+
+  void DrawFileWriter::write(const Model &model) {
+    write(ConstVectorView(model.vectorize_params()));
+  }
+
+  void DrawFileWriter::write_bytes(const char *data, std::int64_t size) {
+    while (size > 0) {
+      if (window_position_ == window_size_) {
+        advance_window();
+      }
+      std::int64_t n = std::min(size, window_size_ - window_position_);
+      std::memcpy(window_ + window_position_, data, n);
+      window_position_ += n;
+      data += n;
+      size -= n;
+    }
+  }
+
+  //===========================================================================
+  Vector DrawFileReader::draw(std::int64_t i) const {
+    Vector ans(dimension_);
+    read_draw(i, VectorView(ans));
+    return ans;
+  }
+
+  void DrawFileReader::read_draw(std::int64_t i, VectorView ans) const {
+    if (ans.size() != dimension_) {
+      report_error("Wrong sized argument passed to DrawFileReader::read_draw.");
+    }
+    const char *address = draw_address(i);
+    if (precision_ == DrawStorage::Precision::FLOAT32) {
+      const float *values = reinterpret_cast<const float *>(address);
+      for (int j = 0; j < dimension_; ++j) ans[j] = values[j];
+    } else {
+      const double *values = reinterpret_cast<const double *>(address);
+      for (int j = 0; j < dimension_; ++j) ans[j] = values[j];
+    }
+  }
+
+  void DrawFileReader::set_model_parameters(std::int64_t i,
+                                            Model &model) const {
+    model.unvectorize_params(draw(i));
+  }
+
+  Matrix DrawFileReader::draws(std::int64_t begin, std::int64_t end) const {
+    if (begin < 0 || end > number_of_draws_ || begin > end) {
+      report_error("Illegal range of draws requested from DrawFileReader.");
+    }
+    Matrix ans(end - begin, dimension_);
+    for (std::int64_t i = begin; i < end; ++i) {
+      read_draw(i, ans.row(i - begin));
+    }
+    return ans;
+  }
+
+  Vector DrawFileReader::component(int index) const {
+    if (index < 0 || index >= dimension_) {
+      report_error("Component index out of range in DrawFileReader.");
+    }
+    Vector ans(number_of_draws_);
+    std::int64_t offset = index * bytes_per_value(precision_);
+    for (std::int64_t i = 0; i < number_of_draws_; ++i) {
+      const char *address = draw_address(i) + offset;
+      if (precision_ == DrawStorage::Precision::FLOAT32) {
+        ans[i] = *reinterpret_cast<const float *>(address);
+      } else {
+        ans[i] = *reinterpret_cast<const double *>(address);
+      }
+    }
+    return ans;
+  }
+
+  const char *DrawFileReader::draw_address(std::int64_t i) const {
+    if (i < 0 || i >= number_of_draws_) {
+      std::ostringstream err;
+      err << "Draw " << i << " requested from a file containing "
+          << number_of_draws_ << " draws.";
+      report_error(err.str());
+    }
+    return data_ + header_size + i * dimension_ * bytes_per_value(precision_);
+  }
+
+#ifndef _WIN32
+  //===========================================================================
+  DrawFileWriter::DrawFileWriter(const std::string &filename, int dimension,
+                                 DrawStorage::Precision precision, int thin,
+                                 double chunk_size_in_megabytes)
+      : filename_(filename),
+        dimension_(dimension),
+        precision_(precision),
+        thin_(thin),
+        chunk_size_(0),
+        file_descriptor_(-1),
+        number_of_calls_(0),
+        number_of_draws_(0),
+        window_(nullptr),
+        window_offset_(0),
+        window_size_(0),
+        window_position_(0) {
+    if (dimension_ <= 0) {
+      report_error("DrawFileWriter needs a positive dimension.");
+    }
+    if (thin_ < 1) {
+      report_error("The thinning interval must be at least 1.");
+    }
+    if (precision_ == DrawStorage::Precision::FLOAT32) {
+      float_buffer_.resize(dimension_);
+    }
+    // The window is mapped at offsets that are multiples of chunk_size_, so
+    // it must be a whole number of pages.
+    std::int64_t page_size = sysconf(_SC_PAGESIZE);
+    std::int64_t requested = std::lround(chunk_size_in_megabytes * 1048576);
+    chunk_size_ = std::max<std::int64_t>(
+        page_size, (requested + page_size - 1) / page_size * page_size);
+
+    file_descriptor_ = ::open(filename_.c_str(), O_RDWR | O_CREAT | O_TRUNC,
+                              0644);
+    if (file_descriptor_ < 0) {
+      report_system_error("create", filename_);
+    }
+    write_header();
+    // The first window starts at the beginning of the file, and the first
+    // draw is written just past the header.
+    window_size_ = 0;
+    advance_window();
+    window_position_ = header_size;
+  }
+
+  DrawFileWriter::~DrawFileWriter() {
+    // Errors are not reported from the destructor.
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  void DrawFileWriter::flush() {
+    if (file_descriptor_ < 0) return;
+    write_header();
+    if (window_ && msync(window_, window_size_, MS_ASYNC) != 0) {
+      report_system_error("flush", filename_);
+    }
+  }
+
+  void DrawFileWriter::close() {
+    if (file_descriptor_ < 0) return;
+    write_header();
+    unmap_window();
+    std::int64_t final_size = header_size + number_of_draws_ * dimension_ *
+        bytes_per_value(precision_);
+    int status = ftruncate(file_descriptor_, final_size);
+    ::close(file_descriptor_);
+    file_descriptor_ = -1;
+    if (status != 0) {
+      report_system_error("resize", filename_);
+    }
+  }
+
+  void DrawFileWriter::advance_window() {
+    unmap_window();
+    window_offset_ += window_size_;
+    if (ftruncate(file_descriptor_, window_offset_ + chunk_size_) != 0) {
+      report_system_error("extend", filename_);
+    }
+    void *address = mmap(nullptr, chunk_size_, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, file_descriptor_, window_offset_);
+    if (address == MAP_FAILED) {
+      report_system_error("map", filename_);
+    }
+    window_ = static_cast<char *>(address);
+    window_size_ = chunk_size_;
+    window_position_ = 0;
+  }
+
+  void DrawFileWriter::unmap_window() {
+    if (window_) {
+      munmap(window_, window_size_);
+      window_ = nullptr;
+    }
+  }
+
+  void DrawFileWriter::write_header() {
+    DrawFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, draw_file_magic, sizeof(header.magic));
+    header.version = draw_file_version;
+    header.bytes_per_value = bytes_per_value(precision_);
+    header.dimension = dimension_;
+    header.number_of_draws = number_of_draws_;
+    header.thin = thin_;
+    if (pwrite(file_descriptor_, &header, sizeof(header), 0) !=
+        static_cast<ssize_t>(sizeof(header))) {
+      report_system_error("write the header of", filename_);
+    }
+  }
+
+  //===========================================================================
+  DrawFileReader::DrawFileReader(const std::string &filename)
+      : filename_(filename),
+        dimension_(0),
+        precision_(DrawStorage::Precision::FLOAT64),
+        thin_(1),
+        number_of_draws_(0),
+        file_descriptor_(-1),
+        data_(nullptr),
+        mapped_size_(0) {
+    file_descriptor_ = ::open(filename_.c_str(), O_RDONLY);
+    if (file_descriptor_ < 0) {
+      report_system_error("open", filename_);
+    }
+    DrawFileHeader header;
+    if (pread(file_descriptor_, &header, sizeof(header), 0) !=
+            static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, draw_file_magic, sizeof(header.magic)) !=
+            0 ||
+        header.version != draw_file_version ||
+        (header.bytes_per_value != 4 && header.bytes_per_value != 8)) {
+      ::close(file_descriptor_);
+      report_error(filename_ + " is not a valid draw file.");
+    }
+    dimension_ = header.dimension;
+    precision_ = static_cast<DrawStorage::Precision>(header.bytes_per_value);
+    thin_ = header.thin;
+    number_of_draws_ = header.number_of_draws;
+
+    struct stat file_status;
+    std::int64_t required_size = header_size + number_of_draws_ *
+        dimension_ * bytes_per_value(precision_);
+    if (fstat(file_descriptor_, &file_status) != 0 ||
+        file_status.st_size < required_size) {
+      ::close(file_descriptor_);
+      report_error(filename_ + " is shorter than its header claims.");
+    }
+    mapped_size_ = required_size;
+    void *address = mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED,
+                         file_descriptor_, 0);
+    if (address == MAP_FAILED) {
+      ::close(file_descriptor_);
+      report_system_error("map", filename_);
+    }
+    data_ = static_cast<const char *>(address);
+  }
+
+  DrawFileReader::~DrawFileReader() {
+    if (data_) {
+      munmap(const_cast<char *>(data_), mapped_size_);
+    }
+    if (file_descriptor_ >= 0) {
+      ::close(file_descriptor_);
+    }
+  }
+
+#else
+  //===========================================================================
+  // Memory mapped draw files are not supported on Windows.
+  DrawFileWriter::DrawFileWriter(const std::string &filename, int dimension,
+                                 DrawStorage::Precision precision, int thin,
+                                 double chunk_size_in_megabytes)
+      : filename_(filename),
+        dimension_(dimension),
+        precision_(precision),
+        thin_(thin),
+        chunk_size_(0),
+        file_descriptor_(-1),
+        number_of_calls_(0),
+        number_of_draws_(0),
+        window_(nullptr),
+        window_offset_(0),
+        window_size_(0),
+        window_position_(0) {
+    report_error("DrawFileWriter is not supported on this platform.");
+  }
+
+  DrawFileWriter::~DrawFileWriter() {}
+  void DrawFileWriter::flush() {}
+  void DrawFileWriter::close() {}
+  void DrawFileWriter::advance_window() {}
+  void DrawFileWriter::unmap_window() {}
+  void DrawFileWriter::write_header() {}
+
+  DrawFileReader::DrawFileReader(const std::string &filename)
+      : filename_(filename),
+        dimension_(0),
+        precision_(DrawStorage::Precision::FLOAT64),
+        thin_(1),
+        number_of_draws_(0),
+        file_descriptor_(-1),
+        data_(nullptr),
+        mapped_size_(0) {
+    report_error("DrawFileReader is not supported on this platform.");
+  }
+
+  DrawFileReader::~DrawFileReader() {}
+#endif  // _WIN32
+
+}  // namespace BOOM
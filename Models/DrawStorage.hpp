@@ -0,0 +1,190 @@
+#ifndef BOOM_MODELS_DRAW_STORAGE_HPP_
+#define BOOM_MODELS_DRAW_STORAGE_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+
+namespace BOOM {
+
+  class Model;
+
+  // MCMC draws can be streamed to a binary file on disk rather than held in
+  // an in-memory matrix with one row per iteration.  The file is written
+  // through a memory mapped window that moves through the file in fixed size
+  // chunks, so the memory used by the writer does not depend on the number
+  // of iterations.  The reader maps the file read-only and lets the operating
+  // system page in only the draws that are actually visited.
+  //
+  // File layout: a 64 byte header followed by the draws in iteration order,
+  // each stored as 'dimension' contiguous values in native byte order.
+  // Values are stored either as doubles or (to halve the file size) as
+  // floats.
+  //
+  // Memory mapping requires POSIX.  On other platforms the constructors
+  // report an error.
+  namespace DrawStorage {
+    enum class Precision { FLOAT32 = 4, FLOAT64 = 8 };
+  }  // namespace DrawStorage
+
+  //===========================================================================
+  // Writes MCMC draws to a file.
+  //
+  // Typical use:
+  //   DrawFileWriter writer("draws.bin", model->vectorize_params().size());
+  //   for (int i = 0; i < niter; ++i) {
+  //     model->sample_posterior();
+  //     writer.write(*model);
+  //   }
+  //   writer.close();
+  class DrawFileWriter {
+   public:
+    // Args:
+    //   filename: The name of the file to write.  Any existing file is
+    //     overwritten.
+    //   dimension: The number of values in each draw.
+    //   precision: The format used to store each value.
+    //   thin: Only every 'thin'th call to write() is recorded.  The first
+    //     call is always recorded.
+    //   chunk_size_in_megabytes: The size of the memory mapped window used
+    //     for writing.  The file grows one chunk at a time.
+    DrawFileWriter(const std::string &filename, int dimension,
+                   DrawStorage::Precision precision =
+                       DrawStorage::Precision::FLOAT64,
+                   int thin = 1, double chunk_size_in_megabytes = 16);
+
+    // Calls close().
+    ~DrawFileWriter();
+
+    DrawFileWriter(const DrawFileWriter &rhs) = delete;
+    DrawFileWriter &operator=(const DrawFileWriter &rhs) = delete;
+
+    // Record a draw, subject to thinning.
+    void write(const ConstVectorView &draw);
+
+    // Record the vectorized parameters of the model, subject to thinning.
+    void write(const Model &model);
+
+    // Update the draw count in the file header and ask the operating system
+    // to write any dirty pages to disk.  After flush() the draws written so
+    // far can be read by a DrawFileReader, even if writing continues.
+    void flush();
+
+    // Flush the draws, truncate the file to its final size, and close it.
+    // No further writes are possible.  Calling close() more than once is
+    // harmless.
+    void close();
+
+    int dimension() const { return dimension_; }
+
+    // The number of draws recorded in the file (i.e. after thinning).
+    std::int64_t number_of_draws() const { return number_of_draws_; }
+
+   private:
+    // Copy 'size' bytes to the file at the current write position, advancing
+    // the mapped window as needed.
+    void write_bytes(const char *data, std::int64_t size);
+
+    // Release the current window, grow the file by a chunk, and map the new
+    // chunk starting at window_offset_ + window_size_.
+    void advance_window();
+    void unmap_window();
+    void write_header();
+
+    std::string filename_;
+    int dimension_;
+    DrawStorage::Precision precision_;
+    int thin_;
+    std::int64_t chunk_size_;
+    int file_descriptor_;
+
+    // The number of calls to write(), before thinning.
+    std::int64_t number_of_calls_;
+    std::int64_t number_of_draws_;
+
+    // The mapped window covers file bytes [window_offset_, window_offset_ +
+    // window_size_).  The next byte is written to window_offset_ +
+    // window_position_.
+    char *window_;
+    std::int64_t window_offset_;
+    std::int64_t window_size_;
+    std::int64_t window_position_;
+
+    // Workspace for converting draws to single precision.
+    std::vector<float> float_buffer_;
+  };
+
+  //===========================================================================
+  // Reads draws from a file written by DrawFileWriter.
+  class DrawFileReader {
+   public:
+    // Args:
+    //   filename:  The name of a file created by a DrawFileWriter.
+    explicit DrawFileReader(const std::string &filename);
+    ~DrawFileReader();
+
+    DrawFileReader(const DrawFileReader &rhs) = delete;
+    DrawFileReader &operator=(const DrawFileReader &rhs) = delete;
+
+    int dimension() const { return dimension_; }
+    std::int64_t number_of_draws() const { return number_of_draws_; }
+    DrawStorage::Precision precision() const { return precision_; }
+
+    // The thinning interval used when the file was written.
+    int thin() const { return thin_; }
+
+    // Returns draw i, converted to double precision if needed.
+    Vector draw(std::int64_t i) const;
+
+    // Copy draw i into 'ans', which must have size dimension().
+    void read_draw(std::int64_t i, VectorView ans) const;
+
+    // Set the parameters of 'model' to draw i.
+    void set_model_parameters(std::int64_t i, Model &model) const;
+
+    // Returns draws [begin, end) as the rows of a matrix.  This is the way to
+    // bring a manageable block of draws into memory, e.g. to compute
+    // summaries one block at a time.
+    Matrix draws(std::int64_t begin, std::int64_t end) const;
+
+    // Returns component 'index' of every draw.  The result holds
+    // number_of_draws() values, but the file is read one page at a time.
+    Vector component(int index) const;
+
+   private:
+    const char *draw_address(std::int64_t i) const;
+
+    std::string filename_;
+    int dimension_;
+    DrawStorage::Precision precision_;
+    int thin_;
+    std::int64_t number_of_draws_;
+    int file_descriptor_;
+    const char *data_;
+    std::int64_t mapped_size_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_MODELS_DRAW_STORAGE_HPP_
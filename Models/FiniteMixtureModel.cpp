@@ -21,6 +21,7 @@
 #include "cpputil/lse.hpp"
 #include "distributions.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <stdexcept>
 
@@ -28,6 +29,10 @@ namespace BOOM {
 
   namespace {
     using FMM = BOOM::FiniteMixtureModel;
+
+    // The number of observations whose component densities are evaluated
+    // together by the EM algorithm.
+    const int em_block_size = 256;
   }
 
   FMM::FiniteMixtureModel(const Ptr<MixtureComponent> &mixture_component,
@@ -90,6 +95,9 @@ namespace BOOM {
     const std::vector<Ptr<MixtureComponent> > &mod(mixture_components_);
     Ptr<MultinomialModel> mix(mixing_dist_);
     clear_component_data();
+    // Evaluate the component densities for the whole data set at once.  The
+    // rows are overwritten with class membership probabilities below.
+    fill_log_density_matrix(mod, d, 0, n, class_membership_probabilities_);
     for (uint i = 0; i < n; ++i) {
       Ptr<Data> dp = d[i];
       Ptr<CategoricalData> cd = hvec[i];
@@ -97,7 +105,7 @@ namespace BOOM {
         wsp_ = logpi_;
       } else if (which_mixture_component(i) > 0) {
         int source = which_mixture_component(i);
-        last_loglike_ += mod[source]->pdf(dp.get(), true);
+        last_loglike_ += class_membership_probabilities_(i, source);
         class_membership_probabilities_.row(i) = 0;
         class_membership_probabilities_(i, source) = 1.0;
         cd->set(source);
@@ -105,9 +113,8 @@ namespace BOOM {
         mod[source]->add_data(dp);
         continue;
       } else {
-        for (uint s = 0; s < S; ++s) {
-          wsp_[s] = logpi_[s] + mod[s]->pdf(dp.get(), true);
-        }
+        wsp_ = class_membership_probabilities_.row(i);
+        wsp_ += logpi_;
       }
       last_loglike_ += lse(wsp_);
       wsp_.normalize_logprob();
@@ -269,13 +276,18 @@ namespace BOOM {
 
     const Vector &log_pi(logpi());
     Vector wsp(S);
+    Matrix log_densities;
     double ans = 0;
 
-    for (uint i = 0; i < n; ++i) {
-      for (uint s = 0; s < S; ++s) {
-        wsp[s] = log_pi[s] + mixture_component(s)->pdf(d[i].get(), true);
+    for (uint begin = 0; begin < n; begin += em_block_size) {
+      uint end = std::min<uint>(n, begin + em_block_size);
+      fill_log_density_matrix(mixture_components(), d, begin, end,
+                              log_densities);
+      for (uint i = begin; i < end; ++i) {
+        wsp = log_densities.row(i - begin);
+        wsp += log_pi;
+        ans += lse(wsp);
       }
-      ans += lse(wsp);
     }
     return ans;
   }
@@ -299,10 +311,15 @@ namespace BOOM {
     const std::vector<Ptr<Data> > &data(dat());
     double ans = 0;
     const Vector &log_pi(logpi());
+    Matrix log_densities;
     for (int i = 0; i < data.size(); ++i) {
-      for (int s = 0; s < number_of_mixture_components(); ++s) {
-        wsp[s] = log_pi[s] + mixture_component(s)->pdf(data[i].get(), true);
+      if (i % em_block_size == 0) {
+        int end = std::min<int>(data.size(), i + em_block_size);
+        fill_log_density_matrix(mixture_components(), data, i, end,
+                                log_densities);
       }
+      wsp = log_densities.row(i % em_block_size);
+      wsp += log_pi;
       double total = lse(wsp);
       ans += total;
       double normalizing_constant = 0;
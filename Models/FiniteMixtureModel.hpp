@@ -70,6 +70,9 @@ namespace BOOM {
 
     Ptr<MixtureComponent> mixture_component(int s);
     const MixtureComponent *mixture_component(int s) const;
+    const std::vector<Ptr<MixtureComponent>> &mixture_components() const {
+      return mixture_components_;
+    }
 
     // Returns a matrix of class membership probabilities for each
     // observation.  The table of membership probabilities is
@@ -158,6 +158,38 @@ namespace BOOM {
     return logscale ? ans : exp(ans);
   }
 
+  void GaussianModelBase::fill_log_density(const std::vector<Ptr<Data>> &data,
+                                           int begin, int end,
+                                           VectorView ans) const {
+    if (ans.stride() != 1) {
+      MixtureComponent::fill_log_density(data, begin, end, ans);
+      return;
+    }
+    int n = end - begin;
+    if (ans.size() != n) {
+      report_error("Wrong size output argument in fill_log_density.");
+    }
+    const double mean = mu();
+    const double constant = -Constants::log_root_2pi - log(sigma());
+    const double scale = -0.5 / sigsq();
+    double *y = ans.data();
+    std::vector<int> missing;
+    for (int i = 0; i < n; ++i) {
+      const Data *data_point = data[begin + i].get();
+      if (data_point->missing()) {
+        missing.push_back(i);
+        y[i] = mean;
+      } else {
+        y[i] = DAT(data_point)->value();
+      }
+    }
+    for (int i = 0; i < n; ++i) {
+      double centered = y[i] - mean;
+      y[i] = constant + scale * centered * centered;
+    }
+    for (int i : missing) y[i] = 0.0;
+  }
+
   double GaussianModelBase::Logp(double x, double &g, double &h,
                                  uint nd) const {
     double m = mu();
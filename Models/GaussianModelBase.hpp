@@ -107,6 +107,8 @@ namespace BOOM {
 
     double pdf(const Ptr<Data> &dp, bool logscale) const override;
     double pdf(const Data *dp, bool logscale) const override;
+    void fill_log_density(const std::vector<Ptr<Data>> &data, int begin,
+                          int end, VectorView ans) const override;
     double Logp(double x, double &g, double &h, uint nd) const override;
     double Logp(const Vector &x, Vector &g, Matrix &h, uint nd) const;
 
@@ -17,6 +17,7 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 #include "Models/Glm/BinomialLogitModel.hpp"
+#include <sstream>
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
@@ -39,13 +40,24 @@ namespace BOOM {
 
   BLM::BinomialLogitModel(const Matrix &X, const Vector &y, const Vector &n)
       : ParamPolicy(new GlmCoefs(X.ncol())), log_alpha_(0) {
-    int nr = nrow(X);
-    for (int i = 0; i < nr; ++i) {
-      uint yi = lround(y[i]);
-      uint ni = lround(n[i]);
-      NEW(BinomialRegressionData, dp)(yi, ni, X.row(i));
-      add_data(dp);
+    if (y.size() != n.size()) {
+      report_error("The vectors of successes and trials must be the same "
+                   "length.");
     }
+    Vector successes(y.size());
+    Vector trials(n.size());
+    for (int i = 0; i < y.size(); ++i) {
+      successes[i] = lround(y[i]);
+      trials[i] = lround(n[i]);
+      if (successes[i] < 0 || trials[i] < successes[i]) {
+        std::ostringstream err;
+        err << "Observation " << i << " has " << successes[i]
+            << " successes in " << trials[i] << " trials.  Successes must "
+            << "be between 0 and the number of trials.";
+        report_error(err.str());
+      }
+    }
+    set_columnar_data(new ColumnarRegressionData(X, successes, trials));
   }
 
   BLM::BinomialLogitModel(const BLM &rhs)
@@ -143,7 +155,6 @@ namespace BOOM {
 
   double BLM::log_likelihood(const Vector &beta, Vector *g, Matrix *h,
                              bool initialize_derivs) const {
-    const BLM::DatasetType &data(dat());
     if (initialize_derivs) {
       if (g) {
         g->resize(beta.size());
@@ -157,18 +168,15 @@ namespace BOOM {
     double ans = 0;
     bool all_coefficients_included = (xdim() == beta.size());
     const Selector &inc(coef().inc());
-    for (int i = 0; i < data.size(); ++i) {
-      // y and n had been defined as uint's but y-n*p was computing
-      // -n, which overflowed
-      double y = data[i]->y();
-      double n = data[i]->n();
-      const Vector &x(data[i]->x());
+    // y and n had been defined as uint's but y-n*p was computing -n, which
+    // overflowed
+    auto add_observation = [&](double y, double n, const ConstVectorView &x) {
       Vector reduced_x;
       if (!all_coefficients_included) {
         reduced_x = inc.select(x);
       }
-      ConstVectorView X(all_coefficients_included ? x : reduced_x);
-
+      ConstVectorView X(all_coefficients_included ? x
+                                                  : ConstVectorView(reduced_x));
       double eta = beta.dot(X) - log_alpha_;
       double p = logit_inv(eta);
       double loglike = dbinom(y, n, p, true);
@@ -179,6 +187,18 @@ namespace BOOM {
           h->add_outer(X, X, -n * p * (1 - p));  // h += -npq * x x^T
         }
       }
+    };
+
+    if (has_columnar_data()) {
+      const ColumnarRegressionData &data(columnar_data());
+      for (int i = 0; i < data.nobs(); ++i) {
+        add_observation(data.y(i), data.weight(i), data.x(i));
+      }
+    } else {
+      const BLM::DatasetType &data(dat());
+      for (int i = 0; i < data.size(); ++i) {
+        add_observation(data[i]->y(), data[i]->n(), data[i]->x());
+      }
     }
     return ans;
   }
@@ -191,6 +211,15 @@ namespace BOOM {
   }
 
   SpdMatrix BLM::xtx() const {
+    if (has_columnar_data()) {
+      const ColumnarRegressionData &data(columnar_data());
+      SpdMatrix ans(data.xdim());
+      for (int i = 0; i < data.nobs(); ++i) {
+        ans.add_outer(data.x(i), data.weight(i), false);
+      }
+      ans.reflect();
+      return ans;
+    }
     const std::vector<Ptr<BinomialRegressionData> > &d(dat());
     uint n = d.size();
     uint p = d[0]->xdim();
@@ -203,6 +232,12 @@ namespace BOOM {
     return ans;
   }
 
+  Ptr<BinomialRegressionData> BLM::make_observation(
+      const ColumnarRegressionData &data, int i) const {
+    return new BinomialRegressionData(data.y(i), data.weight(i),
+                                      Vector(data.x(i)));
+  }
+
   void BLM::set_nonevent_sampling_prob(double alpha) {
     if (alpha <= 0 || alpha > 1) {
       ostringstream err;
@@ -21,8 +21,8 @@
 #include "uint.hpp"
 #include "Models/EmMixtureComponent.hpp"
 #include "Models/Glm/BinomialRegressionData.hpp"
+#include "Models/Glm/ColumnarRegressionData.hpp"
 #include "Models/Glm/Glm.hpp"
-#include "Models/Policies/IID_DataPolicy.hpp"
 #include "Models/Policies/ParamPolicy_1.hpp"
 #include "Models/Policies/PriorPolicy.hpp"
 #include "TargetFun/TargetFun.hpp"
@@ -30,12 +30,16 @@
 
 namespace BOOM {
   // Logistic regression model with binomial (binned) training data.
-  class BinomialLogitModel : public GlmModel,
-                             public NumOptModel,
-                             public ParamPolicy_1<GlmCoefs>,
-                             public IID_DataPolicy<BinomialRegressionData>,
-                             public PriorPolicy,
-                             virtual public MixtureComponent {
+  //
+  // Data can be held either as individual BinomialRegressionData objects, or
+  // in a ColumnarRegressionData where the weights are the numbers of trials.
+  class BinomialLogitModel
+      : public GlmModel,
+        public NumOptModel,
+        public ParamPolicy_1<GlmCoefs>,
+        public ColumnarRegressionDataPolicy<BinomialRegressionData>,
+        public PriorPolicy,
+        virtual public MixtureComponent {
    public:
     explicit BinomialLogitModel(uint beta_dim, bool include_all = true);
     explicit BinomialLogitModel(const Vector &beta);
@@ -44,6 +48,12 @@ namespace BOOM {
     // coefficient vector with another model.
     explicit BinomialLogitModel(const Ptr<GlmCoefs> &beta);
 
+    // Build a model with columnar data.  No intercept is added to X.
+    //
+    // Args:
+    //   X: The design matrix, with observations in rows.
+    //   y: The number of successes for each observation.
+    //   n: The number of trials for each observation.
     BinomialLogitModel(const Matrix &X, const Vector &y, const Vector &n);
     BinomialLogitModel(const BinomialLogitModel &);
     BinomialLogitModel *clone() const override;
@@ -66,7 +76,7 @@ namespace BOOM {
     virtual double logp(double y, double n, const Vector &x,
                         bool logscale) const;
     virtual double logp_1(bool y, const Vector &x, bool logscale) const;
-    int number_of_observations() const override { return dat().size(); }
+    int number_of_observations() const override { return sample_size(); }
 
     // In the following, beta refers to the set of nonzero "included"
     // coefficients.
@@ -83,6 +93,10 @@ namespace BOOM {
     void set_nonevent_sampling_prob(double alpha);
     double log_alpha() const;
 
+   protected:
+    Ptr<BinomialRegressionData> make_observation(
+        const ColumnarRegressionData &data, int i) const override;
+
    private:
     double log_alpha_;  // see comments in logistic_regression_model
   };
@@ -0,0 +1,42 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/Glm/ColumnarRegressionData.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  ColumnarRegressionData::ColumnarRegressionData(const Matrix &predictors,
+                                                 const Vector &response,
+                                                 const Vector &weights)
+      : transposed_predictors_(predictors.transpose()),
+        response_(response),
+        weights_(weights) {
+    if (response_.size() != predictors.nrow()) {
+      report_error("The number of rows in the predictor matrix must match the "
+                   "length of the response vector.");
+    }
+    if (weights_.empty()) {
+      weights_.assign(response_.size(), 1.0);
+    } else if (weights_.size() != response_.size()) {
+      report_error("The weight vector must be the same length as the response "
+                   "vector.");
+    }
+  }
+
+}  // namespace BOOM
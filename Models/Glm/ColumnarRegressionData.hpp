@@ -0,0 +1,227 @@
+#ifndef BOOM_GLM_COLUMNAR_REGRESSION_DATA_HPP_
+#define BOOM_GLM_COLUMNAR_REGRESSION_DATA_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "Models/Policies/IID_DataPolicy.hpp"
+#include "cpputil/Ptr.hpp"
+#include "cpputil/RefCounted.hpp"
+
+namespace BOOM {
+
+  // A read-only, contiguous store for the data in a regression model: a
+  // predictor matrix, a response vector, and a vector of weights (e.g. the
+  // number of trials in a binomial regression, or the exposure in a Poisson
+  // regression).
+  //
+  // Storing observations as a vector of Ptr<RegressionData> costs a heap
+  // allocation, a reference count, and a map of observers for each row, and
+  // scatters the rows throughout memory.  Here the predictors for all
+  // observations live in one block, with each observation's predictors
+  // contiguous, so loops over observations touch memory with stride 1.
+  //
+  // Objects of this class are immutable once built, so they can be shared
+  // between copies of a model.
+  class ColumnarRegressionData : private RefCounted {
+   public:
+    // Args:
+    //   predictors: The design matrix, with observations in rows.
+    //   response: The vector of responses.  Its length must match the number
+    //     of rows in 'predictors'.
+    //   weights: The per-observation weights.  If empty, all weights are 1.
+    //     Otherwise its length must match the number of rows in 'predictors'.
+    ColumnarRegressionData(const Matrix &predictors, const Vector &response,
+                           const Vector &weights = Vector());
+
+    int nobs() const { return response_.size(); }
+    int xdim() const { return transposed_predictors_.nrow(); }
+
+    // The predictors for observation i, as a contiguous view.
+    ConstVectorView x(int i) const { return transposed_predictors_.col(i); }
+    double y(int i) const { return response_[i]; }
+    double weight(int i) const { return weights_[i]; }
+
+    const Vector &response() const { return response_; }
+    const Vector &weights() const { return weights_; }
+
+    // The design matrix, with observations in rows.  This is a copy.
+    Matrix predictors() const { return transposed_predictors_.transpose(); }
+
+   private:
+    // Observations are stored in columns, so that each observation occupies a
+    // contiguous block of memory.
+    Matrix transposed_predictors_;
+    Vector response_;
+    Vector weights_;
+
+    friend void intrusive_ptr_add_ref(ColumnarRegressionData *d) {
+      d->up_count();
+    }
+    friend void intrusive_ptr_release(ColumnarRegressionData *d) {
+      d->down_count();
+      if (d->ref_count() == 0) delete d;
+    }
+  };
+
+  //===========================================================================
+  // A data policy for regression models that can hold their data either in a
+  // ColumnarRegressionData object or, as in IID_DataPolicy, as a vector of
+  // individual observations.
+  //
+  // When columnar data is present, model code and data imputers should
+  // iterate over columnar_data() directly.  Code that calls dat() still works:
+  // the first call converts the columnar data to individual observations,
+  // after which the individual observations are the only copy of the data.
+  // This conversion is one-way, because the individual observations can be
+  // modified through the Ptr's returned by dat().  Adding or removing single
+  // observations also triggers the conversion.
+  //
+  // Classes using this policy must implement make_observation().
+  template <class D>
+  class ColumnarRegressionDataPolicy : public IID_DataPolicy<D> {
+   public:
+    typedef IID_DataPolicy<D> Base;
+    typedef ColumnarRegressionDataPolicy<D> DataPolicy;
+
+    ColumnarRegressionDataPolicy() {}
+    ColumnarRegressionDataPolicy(const ColumnarRegressionDataPolicy &rhs)
+        : Model(rhs),
+          Base(rhs),
+          columns_(rhs.columns_),
+          observations_(rhs.observations_) {}
+    ColumnarRegressionDataPolicy &operator=(
+        const ColumnarRegressionDataPolicy &rhs) {
+      if (&rhs != this) {
+        Base::operator=(rhs);
+        columns_ = rhs.columns_;
+        observations_ = rhs.observations_;
+      }
+      return *this;
+    }
+
+    // Replace any existing data with 'data'.
+    void set_columnar_data(const Ptr<ColumnarRegressionData> &data) {
+      clear_data();
+      columns_ = data;
+      this->signal();
+    }
+
+    // Returns true iff the data are currently held in columnar form.
+    bool has_columnar_data() const { return !!columns_; }
+
+    // The columnar data.  Only valid if has_columnar_data() is true.
+    const ColumnarRegressionData &columnar_data() const { return *columns_; }
+
+    // A pointer to the columnar data, which is NULL if has_columnar_data() is
+    // false.  Holding the pointer keeps the data alive even if the model later
+    // converts to individual observations.
+    Ptr<ColumnarRegressionData> columnar_data_ptr() const { return columns_; }
+
+    long sample_size() const {
+      if (columns_) return columns_->nobs();
+      return observations_.empty() ? Base::sample_size()
+                                   : observations_.size();
+    }
+
+    std::vector<Ptr<D>> &dat() override {
+      absorb_observations();
+      return Base::dat();
+    }
+    const std::vector<Ptr<D>> &dat() const override {
+      build_observations();
+      return observations_.empty() ? Base::dat() : observations_;
+    }
+
+    void clear_data() override {
+      columns_.reset();
+      observations_.clear();
+      Base::clear_data();
+    }
+
+    using Base::add_data;
+    void add_data(const Ptr<D> &dp) override {
+      absorb_observations();
+      Base::add_data(dp);
+    }
+
+    void remove_data(const Ptr<Data> &dp) override {
+      absorb_observations();
+      Base::remove_data(dp);
+    }
+
+    void combine_data(const Model &other, bool just_suf = true) override {
+      absorb_observations();
+      const DataPolicy *columnar = dynamic_cast<const DataPolicy *>(&other);
+      if (columnar) {
+        const std::vector<Ptr<D>> &other_data(columnar->dat());
+        std::vector<Ptr<D>> &data(Base::dat());
+        data.insert(data.end(), other_data.begin(), other_data.end());
+      } else {
+        Base::combine_data(other, just_suf);
+      }
+    }
+
+   protected:
+    // Build observation i from the columnar data.
+    virtual Ptr<D> make_observation(const ColumnarRegressionData &data,
+                                    int i) const = 0;
+
+   private:
+    // If the data are held in columnar form, replace them with individual
+    // observations in observations_.  Observers are not notified, because the
+    // data have not changed.
+    void build_observations() const {
+      if (!columns_) return;
+      observations_.reserve(columns_->nobs());
+      for (int i = 0; i < columns_->nobs(); ++i) {
+        observations_.push_back(make_observation(*columns_, i));
+      }
+      columns_.reset();
+    }
+
+    // Move any individual observations built by build_observations() into
+    // the base class, where the non-const methods expect to find them.
+    void absorb_observations() {
+      build_observations();
+      if (observations_.empty()) return;
+      std::vector<Ptr<D>> &data(Base::dat());
+      data.insert(data.end(), observations_.begin(), observations_.end());
+      observations_.clear();
+    }
+
+    // The data can be held in three forms: as columns_, as observations_, or
+    // in the base class.  At most one of the three is non-empty.
+    //
+    // columns_ and observations_ form a lazily built cache.  The first call
+    // to the const dat() converts columns_ to observations_, so that it can
+    // return a vector of individual observations without touching the base
+    // class.  The conversion does not change the data the model holds, so
+    // it is allowed in const methods, and the two members are mutable for
+    // that reason alone.  Non-const methods move observations_ into the base
+    // class before changing the data.
+    mutable Ptr<ColumnarRegressionData> columns_;
+    mutable std::vector<Ptr<D>> observations_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_COLUMNAR_REGRESSION_DATA_HPP_
@@ -62,7 +62,6 @@ namespace BOOM {
     // dell  = (y - E*lambda) * x
     // ddell = -lambda * x * x'
     double ans = 0;
-    const std::vector<Ptr<PoissonRegressionData> > &data(dat());
     const Selector &included(inc());
     int nvars = included.nvars();
     if (beta.size() != nvars) {
@@ -74,15 +73,14 @@ namespace BOOM {
     }
     initialize_derivatives(g, h, nvars, reset_derivatives);
 
-    for (int i = 0; i < data.size(); ++i) {
-      const Vector x = included.select(data[i]->x());
-      int64_t y = data[i]->y();
+    auto add_observation = [&](int64_t y, double exposure,
+                               const ConstVectorView &full_x) {
+      const Vector x = included.select(full_x);
       double lambda = 1.0;
       if (nvars > 0) {
         double eta = beta.dot(x);
         lambda = exp(eta);
       }
-      double exposure = data[i]->exposure();
       ans += dpois(y, exposure * lambda, true);
       if (g) {
         g->axpy(x, (y - exposure * lambda));
@@ -90,10 +88,28 @@ namespace BOOM {
           h->add_outer(x, x, -lambda);
         }
       }
+    };
+
+    if (has_columnar_data()) {
+      const ColumnarRegressionData &data(columnar_data());
+      for (int i = 0; i < data.nobs(); ++i) {
+        add_observation(lround(data.y(i)), data.weight(i), data.x(i));
+      }
+    } else {
+      const std::vector<Ptr<PoissonRegressionData> > &data(dat());
+      for (int i = 0; i < data.size(); ++i) {
+        add_observation(data[i]->y(), data[i]->exposure(), data[i]->x());
+      }
     }
     return ans;
   }
 
+  Ptr<PoissonRegressionData> PoissonRegressionModel::make_observation(
+      const ColumnarRegressionData &data, int i) const {
+    return new PoissonRegressionData(lround(data.y(i)), Vector(data.x(i)),
+                                     data.weight(i));
+  }
+
   double PoissonRegressionModel::Loglike(const Vector &beta, Vector &g,
                                          Matrix &h, uint nd) const {
     Vector *gp = NULL;
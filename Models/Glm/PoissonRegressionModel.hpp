@@ -21,10 +21,10 @@
 #ifndef POISSON_REGRESSION_MODEL_HPP
 #define POISSON_REGRESSION_MODEL_HPP
 
+#include "Models/Glm/ColumnarRegressionData.hpp"
 #include "Models/Glm/Glm.hpp"
 #include "Models/Glm/PoissonRegressionData.hpp"
 #include "Models/ModelTypes.hpp"
-#include "Models/Policies/IID_DataPolicy.hpp"
 #include "Models/Policies/ParamPolicy_1.hpp"
 #include "Models/Policies/PriorPolicy.hpp"
 
@@ -32,12 +32,16 @@ namespace BOOM {
 
   // A PoissonRegressionModel describes a non-negative integer
   // response y ~ Poisson(E exp(beta*x)), where E is an exposure.
-  class PoissonRegressionModel : public GlmModel,
-                                 public NumOptModel,
-                                 virtual public MixtureComponent,
-                                 public ParamPolicy_1<GlmCoefs>,
-                                 public IID_DataPolicy<PoissonRegressionData>,
-                                 public PriorPolicy {
+  //
+  // Data can be held either as individual PoissonRegressionData objects, or in
+  // a ColumnarRegressionData where the weights are the exposures.
+  class PoissonRegressionModel
+      : public GlmModel,
+        public NumOptModel,
+        virtual public MixtureComponent,
+        public ParamPolicy_1<GlmCoefs>,
+        public ColumnarRegressionDataPolicy<PoissonRegressionData>,
+        public PriorPolicy {
    public:
     explicit PoissonRegressionModel(int xdim);
     explicit PoissonRegressionModel(const Vector &beta);
@@ -90,7 +94,11 @@ namespace BOOM {
 
     double pdf(const Data *, bool logscale) const override;
     double logp(const PoissonRegressionData &data) const;
-    int number_of_observations() const override { return dat().size(); }
+    int number_of_observations() const override { return sample_size(); }
+
+   protected:
+    Ptr<PoissonRegressionData> make_observation(
+        const ColumnarRegressionData &data, int i) const override;
   };
 
 }  // namespace BOOM
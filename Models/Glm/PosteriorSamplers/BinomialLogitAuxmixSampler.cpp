@@ -58,8 +58,8 @@ namespace BOOM {
 
     const Vector &SufficientStatistics::xty() const { return xty_; }
 
-    void SufficientStatistics::update(const Vector &x, double weighted_value,
-                                      double weight) {
+    void SufficientStatistics::update(const ConstVectorView &x,
+                                      double weighted_value, double weight) {
       sym_ = false;
       xtx_.add_outer(x, weight, false);
       xty_.axpy(x, weighted_value);
@@ -72,16 +72,50 @@ namespace BOOM {
         : SufstatImputeWorker<BinomialRegressionData, SufficientStatistics>(
               global_suf, global_suf_mutex, rng, seeding_rng),
           binomial_data_imputer_(clt_threshold),
-          coefficients_(coef) {}
+          coefficients_(coef),
+          columns_begin_(0),
+          columns_end_(0) {}
 
     void ImputeWorker::impute_latent_data_point(
         const BinomialRegressionData &observation, SufficientStatistics *suf,
         RNG &rng) {
-      const Vector &x(observation.x());
+      impute(observation.n(), observation.y(), observation.x(), suf, rng);
+    }
+
+    void ImputeWorker::set_columnar_data(
+        const Ptr<ColumnarRegressionData> &data, int begin, int end) {
+      columns_ = data;
+      columns_begin_ = begin;
+      columns_end_ = end;
+    }
+
+    int ImputeWorker::number_of_observations_managed() const {
+      if (columns_) return columns_end_ - columns_begin_;
+      return SufstatImputeWorker<BinomialRegressionData, SufficientStatistics>::
+          number_of_observations_managed();
+    }
+
+    void ImputeWorker::impute_latent_data() {
+      if (!columns_) {
+        SufstatImputeWorker<BinomialRegressionData, SufficientStatistics>::
+            impute_latent_data();
+        return;
+      }
+      SufficientStatistics *suf = local_suf();
+      suf->clear();
+      for (int i = columns_begin_; i < columns_end_; ++i) {
+        impute(columns_->weight(i), columns_->y(i), columns_->x(i), suf,
+               rng());
+      }
+    }
+
+    void ImputeWorker::impute(double trials, double successes,
+                              const ConstVectorView &x,
+                              SufficientStatistics *suf, RNG &rng) {
       double eta = coefficients_->predict(x);
       try {
         std::pair<double, double> imputed = binomial_data_imputer_.impute(
-            rng, observation.n(), observation.y(), eta);
+            rng, trials, successes, eta);
         double sum = imputed.first;
         double weight = imputed.second;
         suf->update(x, sum, weight);
@@ -89,8 +123,8 @@ namespace BOOM {
         ostringstream err;
         err << "caught an exception "
             << "with the following message:" << e.what() << endl
-            << "n   = " << observation.n() << endl
-            << "y   = " << observation.y() << endl
+            << "n   = " << trials << endl
+            << "y   = " << successes << endl
             << "eta = " << eta << endl;
         report_error(err.str());
       }
@@ -106,7 +140,8 @@ namespace BOOM {
         model_(model),
         prior_(prior),
         suf_(model->xdim()),
-        clt_threshold_(clt_threshold) {
+        clt_threshold_(clt_threshold),
+        assigned_columns_(nullptr) {
     set_number_of_workers(1);
   }
 
@@ -117,6 +152,15 @@ namespace BOOM {
     draw_params();
   }
 
+  void BLAMS::impute_latent_data() {
+    const ColumnarRegressionData *columns =
+        model_->has_columnar_data() ? &model_->columnar_data() : nullptr;
+    if (columns != assigned_columns_) {
+      assign_data_to_workers();
+    }
+    LatentDataSampler<ImputeWorker>::impute_latent_data();
+  }
+
   Ptr<ImputeWorker> BLAMS::create_worker(std::mutex &suf_mutex) {
     return new ImputeWorker(suf_, suf_mutex, clt_threshold_,
                             model_->coef_prm().get(), nullptr, rng());
@@ -138,7 +182,25 @@ namespace BOOM {
   }
 
   void BLAMS::assign_data_to_workers() {
-    BOOM::assign_data_to_workers(model_->dat(), workers());
+    std::vector<Ptr<ImputeWorker>> &imputers(workers());
+    if (model_->has_columnar_data()) {
+      // Split the observations into contiguous blocks, one per worker.
+      Ptr<ColumnarRegressionData> columns = model_->columnar_data_ptr();
+      int nobs = columns->nobs();
+      int nworkers = imputers.size();
+      for (int i = 0; i < nworkers; ++i) {
+        int begin = (static_cast<long>(nobs) * i) / nworkers;
+        int end = (static_cast<long>(nobs) * (i + 1)) / nworkers;
+        imputers[i]->set_columnar_data(columns, begin, end);
+      }
+      assigned_columns_ = columns.get();
+    } else {
+      for (auto &imputer : imputers) {
+        imputer->set_columnar_data(nullptr, 0, 0);
+      }
+      BOOM::assign_data_to_workers(model_->dat(), imputers);
+      assigned_columns_ = nullptr;
+    }
   }
 
 }  // namespace BOOM
@@ -47,7 +47,8 @@ namespace BOOM {
       void clear();
       void combine(const SufficientStatistics &rhs);
 
-      void update(const Vector &x, double weighted_value, double weight);
+      void update(const ConstVectorView &x, double weighted_value,
+                  double weight);
       const SpdMatrix &xtx() const;
       const Vector &xty() const;
       int sample_size() const { return sample_size_; }
@@ -99,9 +100,24 @@ namespace BOOM {
                                     SufficientStatistics *suf,
                                     RNG &rng) override;
 
+      // Assign the worker observations [begin, end) from columnar data.  A
+      // NULL 'data' returns the worker to the individual observations
+      // assigned by set_data().
+      void set_columnar_data(const Ptr<ColumnarRegressionData> &data,
+                             int begin, int end);
+
+      int number_of_observations_managed() const override;
+      void impute_latent_data() override;
+
      private:
+      void impute(double trials, double successes, const ConstVectorView &x,
+                  SufficientStatistics *suf, RNG &rng);
+
       BinomialLogitCltDataImputer binomial_data_imputer_;
       const GlmCoefs *coefficients_;
+      Ptr<ColumnarRegressionData> columns_;
+      int columns_begin_;
+      int columns_end_;
     };
   }  // namespace BinomialLogit
 
@@ -123,6 +139,10 @@ namespace BOOM {
 
     void assign_data_to_workers() override;
 
+    // Reassigns data to the workers if the model's data storage has switched
+    // between columnar data and individual observations, then imputes.
+    void impute_latent_data() override;
+
     // TODO: remove calls to this function and replace
     // them with calls to clear_latent_data().
     //
@@ -149,6 +169,11 @@ namespace BOOM {
     Ptr<MvnBase> prior_;
     BinomialLogit::SufficientStatistics suf_;
     int clt_threshold_;
+
+    // The columnar data most recently assigned to the workers, or NULL if
+    // the workers were assigned individual observations.  Used to detect
+    // changes in the model's data storage.
+    const ColumnarRegressionData *assigned_columns_;
   };
 
 }  // namespace BOOM
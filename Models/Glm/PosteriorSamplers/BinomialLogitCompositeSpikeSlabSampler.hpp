@@ -67,6 +67,9 @@ namespace BOOM {
         double rwm_variance_scale_factor = 1.0,
         RNG &seeding_rng = GlobalRng::rng);
     void draw() override;
+    const MoveAccounting *mh_accounting() const override {
+      return &move_accounting_;
+    }
     void rwm_draw();
     void tim_draw();
 
@@ -86,34 +86,20 @@ namespace BOOM {
   }
 
   double BLSSS::log_model_prob(const Selector &g) const {
-    // borrowed from MLVS.cpp
     double num = spike_->logp(g);
-    if (num == BOOM::negative_infinity() || g.nvars() == 0) {
-      // If num == -infinity then it is in a zero support point in the
-      // prior.  If g.nvars()==0 then all coefficients are zero
-      // because of the point mass.  The only entries remaining in the
-      // likelihood are sums of squares of y[i] that are independent
-      // of g.  They need to be omitted here because they are omitted
-      // in the non-empty case below.
+    // The cache must be reset even if num is -infinity, because subsequent
+    // calls to mcmc_one_flip are scored relative to it.  If g.nvars()==0 then
+    // all coefficients are zero because of the point mass, and the cache
+    // returns zero.  The only entries remaining in the likelihood are sums of
+    // squares of y[i] that are independent of g, and they are omitted in all
+    // cases.
+    double log_marginal_likelihood = model_cache_.reset(
+        g, slab_->siginv(), slab_->mu(), suf().xtx(), suf().xty());
+    if (num == BOOM::negative_infinity()) {
+      // The model is at a zero support point in the prior.
       return num;
     }
-    SpdMatrix ivar = g.select(slab_->siginv());
-    num += .5 * ivar.logdet();
-    if (num == BOOM::negative_infinity()) return num;
-
-    Vector mu = g.select(slab_->mu());
-    Vector ivar_mu = ivar * mu;
-    num -= .5 * mu.dot(ivar_mu);
-
-    bool ok = true;
-    ivar += g.select(suf().xtx());
-    Matrix L = ivar.chol(ok);
-    if (!ok) return BOOM::negative_infinity();
-    double denom = sum(log(L.diag()));  // = .5 log |ivar|
-    Vector S = g.select(suf().xty()) + ivar_mu;
-    Lsolve_inplace(L, S);
-    denom -= .5 * S.normsq();  // S.normsq =  beta_tilde ^T V_tilde beta_tilde
-    return num - denom;
+    return num + log_marginal_likelihood;
   }
 
   void BLSSS::allow_model_selection(bool tf) { allow_model_selection_ = tf; }
@@ -212,12 +198,16 @@ namespace BOOM {
 
   double BLSSS::mcmc_one_flip(Selector &mod, uint which_var, double logp_old) {
     mod.flip(which_var);
-    double logp_new = log_model_prob(mod);
+    double logp_new = spike_->logp(mod);
+    if (logp_new > BOOM::negative_infinity()) {
+      logp_new += model_cache_.propose_flip(which_var);
+    }
     double u = runif_mt(rng(), 0, 1);
-    if (log(u) > logp_new - logp_old) {
+    if (!std::isfinite(logp_new) || log(u) > logp_new - logp_old) {
       mod.flip(which_var);  // reject draw
       return logp_old;
     }
+    model_cache_.accept_proposal();
     return logp_new;
   }
 
@@ -21,6 +21,7 @@
 
 #include "LinAlg/Selector.hpp"
 #include "Models/Glm/PosteriorSamplers/BinomialLogitAuxmixSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/SpikeSlabCholeskyCache.hpp"
 #include "Models/Glm/VariableSelectionPrior.hpp"
 
 namespace BOOM {
@@ -40,6 +41,10 @@ namespace BOOM {
 
     void draw_model_indicators();
     virtual void draw_beta();
+
+    // The log of the marginal posterior probability of model 'gamma', up to a
+    // constant.  As a side effect, subsequent calls to mcmc_one_flip are
+    // scored relative to 'gamma'.
     double log_model_prob(const Selector &gamma) const;
 
     // toggles whether or not draw_model_indicators is called as part
@@ -75,6 +80,9 @@ namespace BOOM {
     }
 
    private:
+    // Considers flipping mod[which_var].  The current value of 'mod' must be
+    // the one most recently passed to log_model_prob, or reached from it by
+    // previous calls to mcmc_one_flip.
     double mcmc_one_flip(Selector &mod, uint which_var, double logp_old);
     BinomialLogitModel *model_;
     Ptr<MvnBase> slab_;
@@ -84,6 +92,10 @@ namespace BOOM {
     bool posterior_mode_found_;
     double log_posterior_at_mode_;
 
+    // Cholesky factors of the included blocks of the prior and posterior
+    // precision, updated in O(k^2) as inclusion indicators are flipped.
+    mutable SpikeSlabCholeskyCache model_cache_;
+
     // If the argument's dimension matches m_->xdim() the argument is returned.
     // Otherwise an error is reported.
     const Ptr<VariableSelectionPrior> &check_spike_dimension(
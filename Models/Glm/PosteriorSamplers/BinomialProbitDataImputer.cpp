@@ -18,15 +18,44 @@
 */
 
 #include "Models/Glm/PosteriorSamplers/BinomialProbitDataImputer.hpp"
+#include <algorithm>
 #include <cstdint>
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
+#include "distributions/batch_draws.hpp"
 
 namespace BOOM {
 
   BinomialProbitDataImputer::BinomialProbitDataImputer(int clt_threshold)
       : clt_threshold_(clt_threshold) {}
 
+  double BinomialProbitDataImputer::impute_sum(RNG &rng, int64_t count,
+                                               double eta,
+                                               bool positive) const {
+    if (count > clt_threshold_) {
+      // If we draw 'count' deviates from the same truncated normal and add
+      // them up we'll have a normal with mean (count * mean) and variance
+      // (count * variance).
+      double mean, variance;
+      trun_norm_moments(eta, 1, 0, positive, &mean, &variance);
+      return count * mean + sqrt(count * variance) * rnorm_ziggurat_mt(rng);
+    }
+    // Draw the deviates in chunks, so that the truncated normal sampler is
+    // built once per chunk rather than once per deviate.
+    const int64_t chunk_size = 32;
+    double buffer[chunk_size];
+    double ans = 0;
+    while (count > 0) {
+      int64_t n = std::min(count, chunk_size);
+      rtrun_norm_batch_mt(rng, buffer, n, eta, 1, 0, positive);
+      for (int64_t i = 0; i < n; ++i) {
+        ans += buffer[i];
+      }
+      count -= n;
+    }
+    return ans;
+  }
+
   double BinomialProbitDataImputer::impute(RNG &rng, double number_of_trials,
                                            double number_of_successes,
                                            double eta) const {
@@ -42,32 +71,47 @@ namespace BOOM {
           "Success count exceeds trial count in "
           "BinomialProbitDataImputer::impute.");
     }
-    double mean, variance;
-
     double ans = 0;
-    if (y > clt_threshold_) {
-      trun_norm_moments(eta, 1, 0, true, &mean, &variance);
-      // If we draw y deviates from the same truncated normal and add
-      // them up we'll have a normal with mean (y * mean) and variance
-      // (y * variance).
-      ans += rnorm_mt(rng, y * mean, sqrt(y * variance));
-    } else {
-      for (int i = 0; i < y; ++i) {
-        // TODO: If y is large-ish but not quite
-        // clt_threshold_ then we might waste some time here
-        // constantly rebuilding the same TnSampler object.
-        ans += rtrun_norm_mt(rng, eta, 1, 0, true);
+    ans += impute_sum(rng, y, eta, true);
+    ans += impute_sum(rng, n - y, eta, false);
+    return ans;
+  }
+
+  namespace BinomialProbit {
+    SufficientStatistics::SufficientStatistics(int dim)
+        : xtz_(dim, 0.0), sample_size_(0) {}
+
+    SufficientStatistics *SufficientStatistics::clone() const {
+      return new SufficientStatistics(*this);
+    }
+
+    void SufficientStatistics::clear() {
+      xtz_ = 0.0;
+      sample_size_ = 0;
+    }
+
+    void SufficientStatistics::combine(const SufficientStatistics &rhs) {
+      if (rhs.sample_size_ == 0) return;
+      if (sample_size_ == 0 && xtz_.size() != rhs.xtz_.size()) {
+        xtz_ = rhs.xtz_;
+      } else {
+        xtz_ += rhs.xtz_;
       }
+      sample_size_ += rhs.sample_size_;
     }
 
-    if (n - y > clt_threshold_) {
-      trun_norm_moments(eta, 1, 0, false, &mean, &variance);
-      ans += rnorm_mt(rng, (n - y) * mean, sqrt((n - y) * variance));
-    } else {
-      for (int i = 0; i < n - y; ++i) {
-        ans += rtrun_norm_mt(rng, eta, 1, 0, false);
+    void SufficientStatistics::update(const ConstVectorView &x,
+                                      double sum_of_z) {
+      if (x.size() != xtz_.size()) {
+        if (sample_size_ > 0) {
+          report_error("Predictor dimension changed in "
+                       "BinomialProbit::SufficientStatistics::update.");
+        }
+        xtz_.resize(x.size());
+        xtz_ = 0.0;
       }
+      xtz_.axpy(x, sum_of_z);
+      ++sample_size_;
     }
-    return ans;
-  }
+  }  // namespace BinomialProbit
 }  // namespace BOOM
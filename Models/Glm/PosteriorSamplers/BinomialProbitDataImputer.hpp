@@ -20,7 +20,10 @@
 #ifndef BOOM_BINOMIAL_PROBIT_DATA_IMPUTER_HPP_
 #define BOOM_BINOMIAL_PROBIT_DATA_IMPUTER_HPP_
 
+#include <cstdint>
 #include <ostream>
+#include "LinAlg/Vector.hpp"
+#include "cpputil/RefCounted.hpp"
 #include "distributions/rng.hpp"
 
 namespace BOOM {
@@ -60,9 +63,53 @@ namespace BOOM {
     int clt_threshold() const { return clt_threshold_; }
 
    private:
+    // Returns the sum of 'count' draws from the N(eta, 1) distribution,
+    // truncated to be positive if 'positive' is true and negative otherwise.
+    double impute_sum(RNG &rng, int64_t count, double eta,
+                      bool positive) const;
+
     int clt_threshold_;
   };
 
+  namespace BinomialProbit {
+    // Complete data sufficient statistics for probit regression samplers
+    // that hold X'X fixed across iterations, so that only X'z (the latent
+    // Gaussian responses summed against the predictors) must be imputed.
+    //
+    // This class was designed to work with the SufstatImputeWorker class
+    // defined in Imputer.hpp.
+    class SufficientStatistics : private RefCounted {
+     public:
+      // Args:
+      //   dim:  The dimension of the predictor vectors.
+      explicit SufficientStatistics(int dim = 0);
+
+      SufficientStatistics *clone() const;
+      void clear();
+      void combine(const SufficientStatistics &rhs);
+
+      // Add sum_of_z * x to X'z.  If the dimension of x differs from that
+      // of X'z then the statistics must be empty, and they are resized.
+      void update(const ConstVectorView &x, double sum_of_z);
+
+      const Vector &xtz() const { return xtz_; }
+
+     private:
+      Vector xtz_;
+      // The number of observations that have been added since the last
+      // call to clear().
+      int64_t sample_size_;
+
+      friend void intrusive_ptr_add_ref(SufficientStatistics *s) {
+        s->up_count();
+      }
+      friend void intrusive_ptr_release(SufficientStatistics *s) {
+        s->down_count();
+        if (s->ref_count() == 0) delete s;
+      }
+    };
+  }  // namespace BinomialProbit
+
 }  // namespace BOOM
 
 #endif  // BOOM_BINOMIAL_PROBIT_DATA_IMPUTER_HPP_
@@ -23,8 +23,18 @@ namespace BOOM {
 
   namespace {
     typedef BinomialProbitSpikeSlabSampler BPSSS;
+    typedef BinomialProbitImputeWorker BPIW;
   }  // namespace
 
+  void BPIW::impute_latent_data_point(
+      const BinomialRegressionData &data_point,
+      BinomialProbit::SufficientStatistics *suf, RNG &rng) {
+    const Vector &x(data_point.x());
+    double sum_of_z = imputer_.impute(rng, data_point.n(), data_point.y(),
+                                      model_->predict(x));
+    suf->update(x, sum_of_z);
+  }
+
   BPSSS::BinomialProbitSpikeSlabSampler(
       BinomialProbitModel *model, const Ptr<MvnBase> &slab_prior,
       const Ptr<VariableSelectionPrior> &spike_prior, int clt_threshold,
@@ -34,7 +44,13 @@ namespace BOOM {
         slab_prior_(slab_prior),
         spike_prior_(spike_prior),
         spike_slab_(model_, slab_prior_, spike_prior_),
-        imputer_(clt_threshold) {}
+        clt_threshold_(clt_threshold),
+        suf_(model_->xdim()) {
+    // Assigning the data is cheap, and reassigning each iteration keeps the
+    // workers valid if data are added to the model.
+    reassign_data_each_time();
+    set_number_of_workers(1);
+  }
 
   void BPSSS::draw() {
     impute_latent_data();
@@ -57,16 +73,17 @@ namespace BOOM {
     if (nrow(xtx_) != model_->xdim()) {
       refresh_xtx();
     }
+    LatentDataSampler<BinomialProbitImputeWorker>::impute_latent_data();
+  }
 
-    xtz_.resize(model_->xdim());
-    xtz_ = 0.0;
-    const std::vector<Ptr<BinomialRegressionData>> &data(model_->dat());
-    for (int i = 0; i < data.size(); ++i) {
-      const Vector &x(data[i]->x());
-      double sum_of_z = imputer_.impute(rng(), data[i]->n(), data[i]->y(),
-                                        model_->predict(x));
-      xtz_.axpy(x, sum_of_z);
-    }
+  Ptr<BPIW> BPSSS::create_worker(std::mutex &suf_mutex) {
+    return new BPIW(model_, clt_threshold_, suf_, suf_mutex, nullptr, rng());
+  }
+
+  void BPSSS::clear_latent_data() { suf_.clear(); }
+
+  void BPSSS::assign_data_to_workers() {
+    BOOM::assign_data_to_workers(model_->dat(), workers());
   }
 
   void BPSSS::refresh_xtx() {
@@ -80,7 +97,7 @@ namespace BOOM {
   WeightedRegSuf BPSSS::complete_data_sufficient_statistics() const {
     WeightedRegSuf suf(model_->xdim());
     suf.set_xtwx(xtx_);
-    suf.set_xtwy(xtz_);
+    suf.set_xtwy(suf_.xtz());
     return suf;
   }
 
@@ -26,12 +26,54 @@
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "Models/Glm/WeightedRegressionModel.hpp"
 #include "Models/MvnBase.hpp"
+#include "Models/PosteriorSamplers/Imputer.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "distributions/rng.hpp"
 
 namespace BOOM {
 
-  class BinomialProbitSpikeSlabSampler : public PosteriorSampler {
+  // A worker that imputes the sums of the latent Gaussian responses for a
+  // chunk of the data in a binomial probit model, and accumulates them in
+  // X'z.
+  class BinomialProbitImputeWorker
+      : public SufstatImputeWorker<BinomialRegressionData,
+                                   BinomialProbit::SufficientStatistics> {
+   public:
+    // Args:
+    //   model:  The model whose latent data is to be imputed.
+    //   clt_threshold: Observations with more than this many trials have
+    //     their latent data imputed using a central limit theorem
+    //     approximation.  See BinomialProbitDataImputer.
+    //   global_suf: The complete data sufficient statistics held by the
+    //     sampler.
+    //   global_suf_mutex:  A mutex protecting global_suf.
+    //   rng:  A random number generator, or nullptr.
+    //   seeding_rng: Used to seed a new RNG in the case that rng is
+    //     nullptr.
+    BinomialProbitImputeWorker(
+        const BinomialProbitModel *model, int clt_threshold,
+        BinomialProbit::SufficientStatistics &global_suf,
+        std::mutex &global_suf_mutex, RNG *rng = nullptr,
+        RNG &seeding_rng = GlobalRng::rng)
+        : SufstatImputeWorker<BinomialRegressionData,
+                              BinomialProbit::SufficientStatistics>(
+              global_suf, global_suf_mutex, rng, seeding_rng),
+          model_(model),
+          imputer_(clt_threshold) {}
+
+    void impute_latent_data_point(const BinomialRegressionData &data_point,
+                                  BinomialProbit::SufficientStatistics *suf,
+                                  RNG &rng) override;
+
+   private:
+    const BinomialProbitModel *model_;
+    BinomialProbitDataImputer imputer_;
+  };
+
+  //======================================================================
+  class BinomialProbitSpikeSlabSampler
+      : public PosteriorSampler,
+        public LatentDataSampler<BinomialProbitImputeWorker> {
    public:
     BinomialProbitSpikeSlabSampler(
         BinomialProbitModel *model, const Ptr<MvnBase> &slab_prior,
@@ -51,20 +93,26 @@ namespace BOOM {
     // inclusion indicators will be sampled.
     void limit_model_selection(int max_flips);
 
-    void impute_latent_data();
+    // Refreshes X'X if the dimension of the model has changed, then imputes
+    // the latent data.
+    void impute_latent_data() override;
 
     void refresh_xtx();
     WeightedRegSuf complete_data_sufficient_statistics() const;
 
+    Ptr<BinomialProbitImputeWorker> create_worker(std::mutex &m) override;
+    void clear_latent_data() override;
+    void assign_data_to_workers() override;
+
    private:
     BinomialProbitModel *model_;
     Ptr<MvnBase> slab_prior_;
     Ptr<VariableSelectionPrior> spike_prior_;
     SpikeSlabSampler spike_slab_;
-    BinomialProbitDataImputer imputer_;
+    int clt_threshold_;
 
     SpdMatrix xtx_;
-    Vector xtz_;
+    BinomialProbit::SufficientStatistics suf_;
   };
 
 }  // namespace BOOM
@@ -212,38 +212,53 @@ namespace BOOM {
   double BVS::prior_ss() const { return 2 * residual_precision_prior_->beta(); }
 
   double BVS::log_model_prob(const Selector &g) const {
-    if (g.nvars() == 0) {
-      // Integrate out sigma.  The empty model is handled as a special
-      // case because information matrices cancel, and do not appear
-      // in the sum of squares.  It is easier to handle them here than
-      // to impose a global requirement about what logdet() should
-      // mean for an empty matrix.
-      double ss = model_->suf()->yty() + prior_ss();
-      double df = model_->suf()->n() + prior_df();
-      double ans = spike_->logp(g) - (.5 * df - 1) * log(ss);
-      return ans;
-    }
     double ans = spike_->logp(g);
-    if (ans == negative_infinity()) {
-      return ans;
+    // The cache must be reset even if ans is -infinity, because subsequent
+    // calls to mcmc_one_flip are scored relative to it.
+    Ptr<RegSuf> suf = model_->suf();
+    double log_marginal_likelihood = model_cache_.reset(
+        g, slab_->unscaled_precision(), slab_->mu(), suf->xtx(), suf->xty());
+    if (ans == negative_infinity()
+        || log_marginal_likelihood == negative_infinity()) {
+      return negative_infinity();
     }
-    double ldoi = set_reg_post_params(g, true);
-    if (ldoi <= negative_infinity()) {
+    return ans + log_model_prob(model_cache_.current());
+  }
+  //----------------------------------------------------------------------
+  // Integrate out sigma.  The empty model needs no special handling, because
+  // the cached log determinants and quadratic forms are all zero, so the
+  // information matrices cancel and do not appear in the sum of squares.
+  double BVS::log_model_prob(const SpikeSlabCholeskyCache::State &state) const {
+    Ptr<RegSuf> suf = model_->suf();
+    double df = suf->n() + prior_df();
+    // The residual sum of squares around the posterior mean, plus the
+    // discrepancy between the prior and posterior means, plus the prior sum of
+    // squares.  See set_reg_post_params.
+    double ss = prior_ss() + suf->yty() - state.posterior_quadratic_form()
+        + state.prior_quadratic_form();
+    if (!(ss > 0) || !std::isfinite(ss)) {
       return negative_infinity();
     }
-    ans += .5 * (ldoi - unscaled_posterior_precision_.logdet());
-    ans -= (.5 * DF_ - 1) * log(SS_);
-    return ans;
+    return .5 * (state.prior_logdet() - state.posterior_logdet())
+        - (.5 * df - 1) * log(ss);
   }
   //----------------------------------------------------------------------
   double BVS::mcmc_one_flip(Selector &model, uint which_var, double logp_old) {
     model.flip(which_var);
-    double logp_new = log_model_prob(model);
+    double logp_new = spike_->logp(model);
+    if (logp_new > negative_infinity()) {
+      if (model_cache_.propose_flip(which_var) > negative_infinity()) {
+        logp_new += log_model_prob(model_cache_.proposal());
+      } else {
+        logp_new = negative_infinity();
+      }
+    }
     double u = runif_mt(rng(), 0, 1);
-    if (log(u) > logp_new - logp_old) {
+    if (!std::isfinite(logp_new) || log(u) > logp_new - logp_old) {
       model.flip(which_var);  // reject draw
       return logp_old;
     }
+    model_cache_.accept_proposal();
     return logp_new;
   }
   //----------------------------------------------------------------------
@@ -24,6 +24,7 @@
 #include "Models/Glm/RegressionModel.hpp"
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "Models/Glm/PosteriorSamplers/CorrelationMap.hpp"
+#include "Models/Glm/PosteriorSamplers/SpikeSlabCholeskyCache.hpp"
 #include "Models/MvnGivenScalarSigma.hpp"
 #include "Models/MvnGivenSigma.hpp"
 #include "Models/PosteriorSamplers/GenericGaussianVarianceSampler.hpp"
@@ -126,6 +127,11 @@ namespace BOOM {
 
     void draw() override;
     double logpri() const override;
+
+    // The log of the marginal posterior probability of the model defined by
+    // 'inclusion_indicators', integrating over the coefficients and the
+    // residual variance.  As a side effect, subsequent calls to mcmc_one_flip
+    // are scored relative to inclusion_indicators.
     double log_model_prob(const Selector &inclusion_indicators) const;
 
     // Model selection can be turned on and off altogether, or if very large
@@ -192,7 +198,9 @@ namespace BOOM {
     //   which_var: The position (element) in inclusion_indicators that might be
     //     changed.
     //   current_logp: The current log posterior evaluated at
-    //     inclusion_indicators.
+    //     inclusion_indicators.  The most recent call to log_model_prob must
+    //     have been made with inclusion_indicators, or with a value from which
+    //     inclusion_indicators was reached by calls to mcmc_one_flip.
     //
     // Returns:
     //   inclusion_indicators[which_var] will be sampled from its full
@@ -250,6 +258,15 @@ namespace BOOM {
     double set_reg_post_params(const Selector &inclusion_indicators,
                                bool do_ldoi) const;
 
+    // The log marginal posterior probability of a model, excluding the
+    // contribution from the spike.
+    double log_model_prob(const SpikeSlabCholeskyCache::State &state) const;
+
+    // Cholesky factors of the included blocks of the unscaled prior and
+    // posterior precision, updated in O(k^2) as inclusion indicators are
+    // flipped.
+    mutable SpikeSlabCholeskyCache model_cache_;
+
     void draw_beta();
     void draw_model_indicators();
     void draw_sigma();
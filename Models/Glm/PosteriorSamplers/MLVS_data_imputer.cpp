@@ -26,6 +26,7 @@
 
 #include <cmath>
 #include "distributions.hpp"
+#include "distributions/batch_draws.hpp"
 
 namespace BOOM {
 
@@ -46,7 +47,8 @@ namespace BOOM {
         post_prob_(log_mixing_weights_),
         u(model_->Nchoices()),
         eta(u),
-        wgts(u) {}
+        wgts(u),
+        log_exponentials_(u) {}
 
   void MlvsDataImputer::impute_latent_data_point(const ChoiceData &dp,
                                                  SufficientStatistics *suf,
@@ -57,11 +59,15 @@ namespace BOOM {
     uint y = dp.value();
     assert(y < M);
     double loglam = lse(eta);
-    double logzmin = rlexp_mt(rng, loglam);
+    // Draw all the log exponentials needed for this observation at once, with
+    // unit rate.  A log exponential with log rate 'loglam' is a unit rate log
+    // exponential minus loglam.
+    rlexp_batch_mt(rng, log_exponentials_.data(), M);
+    double logzmin = log_exponentials_[y] - loglam;
     u[y] = -logzmin;
     for (uint m = 0; m < M; ++m) {
       if (m != y) {
-        double tmp = rlexp_mt(rng, eta[m]);
+        double tmp = log_exponentials_[m] - eta[m];
         double logz = lse2(logzmin, tmp);
         u[m] = -logz;
       }
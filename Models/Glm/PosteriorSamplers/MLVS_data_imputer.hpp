@@ -72,6 +72,7 @@ namespace BOOM {
     mutable Vector u;
     mutable Vector eta;
     mutable Vector wgts;
+    mutable Vector log_exponentials_;
   };
 
 }  // namespace BOOM
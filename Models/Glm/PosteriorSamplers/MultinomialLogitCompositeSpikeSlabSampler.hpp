@@ -69,6 +69,9 @@ namespace BOOM {
         RNG &seeding_rng = GlobalRng::rng);
 
     void draw() override;
+    const MoveAccounting *mh_accounting() const override {
+      return &accounting_;
+    }
     void rwm_draw();
     void tim_draw();
     void rwm_draw_chunk(int chunk);
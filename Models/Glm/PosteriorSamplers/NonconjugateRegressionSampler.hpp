@@ -65,6 +65,9 @@ namespace BOOM {
     void set_slice_sampler_limits(const Vector &lower, const Vector &upper);
 
     void draw() override;
+    const MoveAccounting *mh_accounting() const override {
+      return &move_accounting_;
+    }
     double logpri() const override;
 
     void draw_coefficients();
@@ -23,6 +23,19 @@
 
 namespace BOOM {
 
+  void OrdinalLogitImputeWorker::impute_latent_data_point(
+      const OrdinalRegressionData &data_point, WeightedRegSuf *suf,
+      RNG &rng) {
+    double eta = model_->predict(data_point.x());
+    int y = data_point.y();
+    double upper_cutpoint = model_->upper_cutpoint(y);
+    double lower_cutpoint = model_->lower_cutpoint(y);
+    double z = imputer_.impute(rng, eta, lower_cutpoint, upper_cutpoint);
+    double mu, sigsq;
+    logit_mixture_.unmix(rng, z, &mu, &sigsq);
+    suf->add_data(data_point.x(), z, 1.0 / sigsq);
+  }
+
   OrdinalLogitPosteriorSampler::OrdinalLogitPosteriorSampler(
       OrdinalLogitModel *model,
       const Ptr<MvnBase> &coefficient_prior,
@@ -51,6 +64,10 @@ namespace BOOM {
       cutpoint_samplers_.push_back(ScalarSliceSampler(
           cutpoint_i_logpost, false, 1.0, &rng()));
     }
+    // Assigning the data is cheap, and reassigning each iteration keeps the
+    // workers valid if data are added to the model.
+    reassign_data_each_time();
+    set_number_of_workers(1);
   }
 
   double OrdinalLogitPosteriorSampler::logpri() const {
@@ -64,19 +81,18 @@ namespace BOOM {
     draw_cutpoints();
   }
 
-  void OrdinalLogitPosteriorSampler::impute_latent_data() {
+  Ptr<OrdinalLogitImputeWorker> OrdinalLogitPosteriorSampler::create_worker(
+      std::mutex &suf_mutex) {
+    return new OrdinalLogitImputeWorker(model_, complete_data_suf_, suf_mutex,
+                                        nullptr, rng());
+  }
+
+  void OrdinalLogitPosteriorSampler::clear_latent_data() {
     complete_data_suf_.clear();
-    for (int i = 0; i < model_->dat().size(); ++i) {
-      const OrdinalRegressionData &data_point(*model_->dat()[i]);
-      double eta = model_->predict(data_point.x());
-      int y = data_point.y();
-      double upper_cutpoint = model_->upper_cutpoint(y);
-      double lower_cutpoint = model_->lower_cutpoint(y);
-      double z = imputer_.impute(rng(), eta, lower_cutpoint, upper_cutpoint);
-      double mu, sigsq;
-      logit_mixture_.unmix(rng(), z, &mu, &sigsq);
-      complete_data_suf_.add_data(data_point.x(), z, 1.0 / sigsq);
-    }
+  }
+
+  void OrdinalLogitPosteriorSampler::assign_data_to_workers() {
+    BOOM::assign_data_to_workers(model_->dat(), workers());
   }
 
   void OrdinalLogitPosteriorSampler::draw_beta() {
@@ -18,6 +18,7 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include "Models/PosteriorSamplers/Imputer.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
 #include "Models/Glm/OrdinalCutpointModel.hpp"
@@ -36,8 +37,45 @@
 
 namespace BOOM {
 
+  // A worker that imputes the latent logistic responses for a chunk of the
+  // data in an ordinal logit model, along with the mixture indicators from a
+  // normal mixture approximation to the logistic distribution.  The imputed
+  // values are stored as weighted regression data.
+  class OrdinalLogitImputeWorker
+      : public SufstatImputeWorker<OrdinalRegressionData, WeightedRegSuf> {
+   public:
+    // Args:
+    //   model:  The model whose latent data is to be imputed.
+    //   global_suf: The complete data sufficient statistics held by the
+    //     sampler.
+    //   global_suf_mutex:  A mutex protecting global_suf.
+    //   rng:  A random number generator, or nullptr.
+    //   seeding_rng: Used to seed a new RNG in the case that rng is
+    //     nullptr.
+    OrdinalLogitImputeWorker(const OrdinalLogitModel *model,
+                             WeightedRegSuf &global_suf,
+                             std::mutex &global_suf_mutex,
+                             RNG *rng = nullptr,
+                             RNG &seeding_rng = GlobalRng::rng)
+        : SufstatImputeWorker<OrdinalRegressionData, WeightedRegSuf>(
+              global_suf, global_suf_mutex, rng, seeding_rng),
+          model_(model) {}
+
+    void impute_latent_data_point(const OrdinalRegressionData &data_point,
+                                  WeightedRegSuf *suf, RNG &rng) override;
+
+   private:
+    const OrdinalLogitModel *model_;
+    OrdinalLogitImputer imputer_;
+    LogitMixtureApproximation logit_mixture_;
+  };
+
+  //======================================================================
+  // The latent data can be imputed in parallel by calling
+  // set_number_of_workers().
   class OrdinalLogitPosteriorSampler
-      : public PosteriorSampler {
+      : public PosteriorSampler,
+        public LatentDataSampler<OrdinalLogitImputeWorker> {
    public:
     // Args:
     //   model: The model to be managed.
@@ -54,8 +92,11 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    Ptr<OrdinalLogitImputeWorker> create_worker(std::mutex &m) override;
+    void clear_latent_data() override;
+    void assign_data_to_workers() override;
+
    private:
-    void impute_latent_data();
     void draw_beta();
     void draw_cutpoints();
 
@@ -64,8 +105,6 @@ namespace BOOM {
     Ptr<VectorModel> cutpoint_prior_;
 
     WeightedRegSuf complete_data_suf_;
-    OrdinalLogitImputer imputer_;
-    LogitMixtureApproximation logit_mixture_;
 
     SpikeSlabSampler coefficient_sampler_;
 
@@ -34,7 +34,36 @@ namespace BOOM {
       : SufstatImputeWorker<PoissonRegressionData, WeightedRegSuf>(
             global_suf, global_suf_mutex, rng, seeding_rng),
         coefficients_(coefficients),
-        imputer_(new PoissonDataImputer) {}
+        imputer_(new PoissonDataImputer),
+        columns_begin_(0),
+        columns_end_(0) {}
+
+  void PoissonRegressionDataImputer::set_columnar_data(
+      const Ptr<ColumnarRegressionData> &data, int begin, int end) {
+    columns_ = data;
+    columns_begin_ = begin;
+    columns_end_ = end;
+  }
+
+  int PoissonRegressionDataImputer::number_of_observations_managed() const {
+    if (columns_) return columns_end_ - columns_begin_;
+    return SufstatImputeWorker<PoissonRegressionData, WeightedRegSuf>::
+        number_of_observations_managed();
+  }
+
+  void PoissonRegressionDataImputer::impute_latent_data() {
+    if (!columns_) {
+      SufstatImputeWorker<PoissonRegressionData, WeightedRegSuf>::
+          impute_latent_data();
+      return;
+    }
+    WeightedRegSuf *suf = local_suf();
+    suf->clear();
+    for (int i = columns_begin_; i < columns_end_; ++i) {
+      impute(lround(columns_->y(i)), columns_->weight(i), columns_->x(i), suf,
+             rng());
+    }
+  }
 
   // The latent variable scheme imagines the event times of y[i]
   // events from a Poisson process that occur in the interval [0, 1].
@@ -58,10 +87,14 @@ namespace BOOM {
   void PoissonRegressionDataImputer::impute_latent_data_point(
       const PoissonRegressionData &dp, WeightedRegSuf *complete_data_suf,
       RNG &rng) {
-    const Vector &x(dp.x());
+    impute(dp.y(), dp.exposure(), dp.x(), complete_data_suf, rng);
+  }
+
+  void PoissonRegressionDataImputer::impute(int64_t y, double exposure,
+                                            const ConstVectorView &x,
+                                            WeightedRegSuf *complete_data_suf,
+                                            RNG &rng) {
     double eta = coefficients_->predict(x);
-    int y = dp.y();
-    double exposure = dp.exposure();
     double internal_neglog_final_event_time;
     double internal_mu;
     double internal_weight;
@@ -90,7 +123,8 @@ namespace BOOM {
         model_(model),
         prior_(prior),
         complete_data_suf_(model_->xdim()),
-        first_pass_through_data_(true) {
+        first_pass_through_data_(true),
+        assigned_columns_(nullptr) {
     set_number_of_workers(number_of_imputation_workers);
   }
 
@@ -111,6 +145,11 @@ namespace BOOM {
   }
 
   void PRAMS::impute_latent_data() {
+    const ColumnarRegressionData *columns =
+        model_->has_columnar_data() ? &model_->columnar_data() : nullptr;
+    if (columns != assigned_columns_) {
+      assign_data_to_workers();
+    }
     Parent::impute_latent_data();
     if (first_pass_through_data_) {
       first_pass_through_data_ = false;
@@ -158,7 +197,25 @@ namespace BOOM {
   }
 
   void PRAMS::assign_data_to_workers() {
-    BOOM::assign_data_to_workers(model_->dat(), workers());
+    std::vector<Ptr<PoissonRegressionDataImputer>> &imputers(workers());
+    if (model_->has_columnar_data()) {
+      // Split the observations into contiguous blocks, one per worker.
+      Ptr<ColumnarRegressionData> columns = model_->columnar_data_ptr();
+      int nobs = columns->nobs();
+      int nworkers = imputers.size();
+      for (int i = 0; i < nworkers; ++i) {
+        int begin = (static_cast<long>(nobs) * i) / nworkers;
+        int end = (static_cast<long>(nobs) * (i + 1)) / nworkers;
+        imputers[i]->set_columnar_data(columns, begin, end);
+      }
+      assigned_columns_ = columns.get();
+    } else {
+      for (auto &imputer : imputers) {
+        imputer->set_columnar_data(nullptr, 0, 0);
+      }
+      BOOM::assign_data_to_workers(model_->dat(), imputers);
+      assigned_columns_ = nullptr;
+    }
   }
 
 }  // namespace BOOM
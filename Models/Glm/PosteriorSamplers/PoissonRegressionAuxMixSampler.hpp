@@ -52,9 +52,24 @@ namespace BOOM {
                                   WeightedRegSuf *complete_data_suf,
                                   RNG &rng) override;
 
+    // Assign the worker observations [begin, end) from columnar data.  A
+    // NULL 'data' returns the worker to the individual observations
+    // assigned by set_data().
+    void set_columnar_data(const Ptr<ColumnarRegressionData> &data,
+                           int begin, int end);
+
+    int number_of_observations_managed() const override;
+    void impute_latent_data() override;
+
    private:
+    void impute(int64_t y, double exposure, const ConstVectorView &x,
+                WeightedRegSuf *complete_data_suf, RNG &rng);
+
     const GlmCoefs *coefficients_;
     std::unique_ptr<PoissonDataImputer> imputer_;
+    Ptr<ColumnarRegressionData> columns_;
+    int columns_begin_;
+    int columns_end_;
   };
 
   //----------------------------------------------------------------------
@@ -122,6 +137,10 @@ namespace BOOM {
     // multi-threaded environment can be set up.  This field keeps
     // track of the desired number of workers.
     int desired_number_of_workers_;
+
+    // The columnar data most recently assigned to the workers, or NULL if
+    // the workers were assigned individual observations.
+    const ColumnarRegressionData *assigned_columns_;
   };
 
 }  // namespace BOOM
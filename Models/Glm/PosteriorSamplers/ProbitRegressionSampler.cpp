@@ -23,6 +23,16 @@ namespace BOOM {
 
   namespace {
     typedef ProbitRegressionSampler PRS;
+    typedef ProbitRegressionImputeWorker PRIW;
+  }
+
+  void PRIW::impute_latent_data_point(
+      const BinaryRegressionData &data_point,
+      BinomialProbit::SufficientStatistics *suf, RNG &rng) {
+    const Vector &x(data_point.x());
+    double z = imputer_.impute(rng, 1, data_point.y(),
+                               coefficients_->predict(x));
+    suf->update(x, z);
   }
 
   PRS::ProbitRegressionSampler(ProbitRegressionModel *model,
@@ -31,8 +41,12 @@ namespace BOOM {
         model_(model),
         prior_(prior),
         xtx_(model_->xdim()),
-        xtz_(model_->xdim()) {
+        suf_(model_->xdim()) {
     refresh_xtx();
+    // Assigning the data is cheap, and reassigning each iteration keeps the
+    // workers valid if data are added to the model.
+    reassign_data_each_time();
+    set_number_of_workers(1);
   }
 
   double PRS::logpri() const { return prior_->logp(model_->Beta()); }
@@ -44,22 +58,21 @@ namespace BOOM {
 
   void PRS::draw_beta() {
     model_->set_Beta(rmvn_suf_mt(rng(), xtx_ + prior_->siginv(),
-                                 xtz_ + prior_->siginv() * prior_->mu()));
+                                 xtz() + prior_->siginv() * prior_->mu()));
   }
 
-  void PRS::impute_latent_data() {
-    const ProbitRegressionModel::DatasetType &data(model_->dat());
-    int n = data.size();
-    const Vector &beta(model_->Beta());
-    xtz_ = 0;
-    for (int i = 0; i < n; ++i) {
-      const Vector &x(data[i]->x());
-      double z = imputer_.impute(rng(), 1, data[i]->y(), x.dot(beta));
-      xtz_.axpy(x, z);
-    }
+  Ptr<PRIW> PRS::create_worker(std::mutex &suf_mutex) {
+    return new PRIW(model_->coef_prm().get(), suf_, suf_mutex, nullptr,
+                    rng());
+  }
+
+  void PRS::clear_latent_data() { suf_.clear(); }
+
+  void PRS::assign_data_to_workers() {
+    BOOM::assign_data_to_workers(model_->dat(), workers());
   }
 
-  const Vector &PRS::xtz() const { return xtz_; }
+  const Vector &PRS::xtz() const { return suf_.xtz(); }
   const SpdMatrix &PRS::xtx() const { return xtx_; }
 
   void PRS::refresh_xtx() {
@@ -23,10 +23,52 @@
 #include "Models/Glm/PosteriorSamplers/BinomialProbitDataImputer.hpp"
 #include "Models/Glm/ProbitRegression.hpp"
 #include "Models/MvnBase.hpp"
+#include "Models/PosteriorSamplers/Imputer.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
 namespace BOOM {
-  class ProbitRegressionSampler : public PosteriorSampler {
+
+  // A worker that imputes the latent Gaussian responses for a chunk of the
+  // data in a probit regression model, and accumulates them in X'z.
+  class ProbitRegressionImputeWorker
+      : public SufstatImputeWorker<BinaryRegressionData,
+                                   BinomialProbit::SufficientStatistics> {
+   public:
+    // Args:
+    //   coefficients: The coefficients of the model whose latent data is to
+    //     be imputed.
+    //   global_suf: The complete data sufficient statistics held by the
+    //     sampler.
+    //   global_suf_mutex:  A mutex protecting global_suf.
+    //   rng:  A random number generator, or nullptr.
+    //   seeding_rng: Used to seed a new RNG in the case that rng is
+    //     nullptr.
+    ProbitRegressionImputeWorker(
+        const GlmCoefs *coefficients,
+        BinomialProbit::SufficientStatistics &global_suf,
+        std::mutex &global_suf_mutex, RNG *rng = nullptr,
+        RNG &seeding_rng = GlobalRng::rng)
+        : SufstatImputeWorker<BinaryRegressionData,
+                              BinomialProbit::SufficientStatistics>(
+              global_suf, global_suf_mutex, rng, seeding_rng),
+          coefficients_(coefficients) {}
+
+    void impute_latent_data_point(const BinaryRegressionData &data_point,
+                                  BinomialProbit::SufficientStatistics *suf,
+                                  RNG &rng) override;
+
+   private:
+    const GlmCoefs *coefficients_;
+    BinomialProbitDataImputer imputer_;
+  };
+
+  //======================================================================
+  // Samples the coefficients of a probit regression model by data
+  // augmentation (Albert and Chib 1993).  The latent data can be imputed in
+  // parallel by calling set_number_of_workers().
+  class ProbitRegressionSampler
+      : public PosteriorSampler,
+        public LatentDataSampler<ProbitRegressionImputeWorker> {
    public:
     ProbitRegressionSampler(ProbitRegressionModel *model,
                             const Ptr<MvnBase> &prior,
@@ -38,10 +80,13 @@ namespace BOOM {
     // Otherwise, it is assumed that xtx_ is fixed between iterations
     void refresh_xtx();
 
-    void impute_latent_data();
     const Vector &xtz() const;
     const SpdMatrix &xtx() const;
 
+    Ptr<ProbitRegressionImputeWorker> create_worker(std::mutex &m) override;
+    void clear_latent_data() override;
+    void assign_data_to_workers() override;
+
    protected:
     virtual void draw_beta();
 
@@ -49,11 +94,10 @@ namespace BOOM {
     ProbitRegressionModel *model_;
     Ptr<MvnBase> prior_;
 
-    BinomialProbitDataImputer imputer_;
-
-    // Complete data sufficient statistics.
+    // Complete data sufficient statistics.  X'X does not depend on the
+    // latent data, so it is computed once.
     SpdMatrix xtx_;
-    Vector xtz_;
+    BinomialProbit::SufficientStatistics suf_;
   };
 }  // namespace BOOM
 
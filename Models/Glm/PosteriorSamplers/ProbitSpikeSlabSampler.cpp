@@ -111,38 +111,28 @@ namespace BOOM {
     for (uint i = 0; i < hi; ++i) {
       uint I = flips[i];
       inc.flip(I);
-      double logp_new = log_model_prob(inc);
-      if (keep_flip(logp, logp_new))
+      double logp_new = gamma_prior_->logp(inc);
+      if (logp_new > BOOM::negative_infinity()) {
+        logp_new += model_cache_.propose_flip(I);
+      }
+      if (keep_flip(logp, logp_new)) {
         logp = logp_new;
-      else
+        model_cache_.accept_proposal();
+      } else {
         inc.flip(I);  // reject the flip, so flip back
+      }
     }
     m_->coef().set_inc(inc);
   }
 
   double PSSS::log_model_prob(const Selector &g) {
     double num = gamma_prior_->logp(g);
+    // The cache must be reset even if num is -infinity, because subsequent
+    // flips in draw_gamma are scored relative to it.
+    double log_marginal_likelihood = model_cache_.reset(
+        g, beta_prior_->siginv(), beta_prior_->mu(), xtx(), xtz());
     if (num == BOOM::negative_infinity()) return num;
-
-    Ominv_ = g.select(beta_prior_->siginv());
-    num += .5 * Ominv_.logdet();
-    if (num == BOOM::negative_infinity()) return num;
-
-    Vector mu = g.select(beta_prior_->mu());
-    Vector Ominv_mu = Ominv_ * mu;
-    num -= .5 * mu.dot(Ominv_mu);
-
-    bool ok = true;
-    iV_tilde_ = Ominv_ + g.select(xtx());
-    Matrix L = iV_tilde_.chol(ok);
-    if (!ok) return BOOM::negative_infinity();
-    double denom = sum(log(L.diag()));  // = .5 log |Ominv_|
-
-    Vector S = g.select(xtz()) + Ominv_mu;
-    Lsolve_inplace(L, S);
-    denom -= .5 * S.normsq();  // S.normsq =  beta_tilde ^T V_tilde beta_tilde
-
-    return num - denom;
+    return num + log_marginal_likelihood;
   }
 
 }  // namespace BOOM
@@ -19,6 +19,7 @@
 #ifndef BOOM_PROBIT_SPIKE_SLAB_SAMPLER_HPP_
 #define BOOM_PROBIT_SPIKE_SLAB_SAMPLER_HPP_
 #include "Models/Glm/PosteriorSamplers/ProbitRegressionSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/SpikeSlabCholeskyCache.hpp"
 #include "Models/Glm/VariableSelectionPrior.hpp"
 namespace BOOM {
 
@@ -43,6 +44,9 @@ namespace BOOM {
 
    private:
     bool keep_flip(double logp_new, double logp_old) const;
+
+    // The log of the marginal posterior probability of model 'inc', up to a
+    // constant.  As a side effect, model_cache_ is initialized at 'inc'.
     double log_model_prob(const Selector &inc);
 
     ProbitRegressionModel *m_;
@@ -50,10 +54,13 @@ namespace BOOM {
     Ptr<VariableSelectionPrior> gamma_prior_;
 
     SpdMatrix Ominv_;
-    SpdMatrix iV_tilde_;
     uint max_nflips_;
     bool allow_selection_;
     Vector beta_, wsp_;
+
+    // Cholesky factors of the included blocks of the prior and posterior
+    // precision, updated in O(k^2) as inclusion indicators are flipped.
+    SpikeSlabCholeskyCache model_cache_;
   };
 
 }  // namespace BOOM
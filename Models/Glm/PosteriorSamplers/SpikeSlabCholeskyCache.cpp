@@ -0,0 +1,142 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/Glm/PosteriorSamplers/SpikeSlabCholeskyCache.hpp"
+#include <algorithm>
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    using SSCC = SpikeSlabCholeskyCache;
+  }  // namespace
+
+  SSCC::SpikeSlabCholeskyCache() : proposal_is_valid_(false) {}
+
+  double SSCC::reset(const Selector &inclusion_indicators,
+                     const SpdMatrix &prior_precision,
+                     const Vector &prior_mean,
+                     const SpdMatrix &xtx,
+                     const Vector &xty,
+                     double sigsq) {
+    prior_precision_ = prior_precision;
+    prior_mean_ = prior_mean;
+    posterior_precision_ = xtx;
+    posterior_precision_ /= sigsq;
+    posterior_precision_ += prior_precision;
+    scaled_xty_ = xty / sigsq;
+    proposal_is_valid_ = false;
+
+    current_.positions_.clear();
+    current_.prior_cholesky_.clear();
+    current_.posterior_cholesky_.clear();
+    for (int i = 0; i < inclusion_indicators.nvars(); ++i) {
+      if (!flip(current_, inclusion_indicators.indx(i))) {
+        current_.positions_.clear();
+        current_.prior_cholesky_.clear();
+        current_.posterior_cholesky_.clear();
+        compute_summaries(current_);
+        return negative_infinity();
+      }
+    }
+    compute_summaries(current_);
+    return current_.log_marginal_likelihood();
+  }
+
+  double SSCC::propose_flip(int which_variable) {
+    proposal_ = current_;
+    proposal_is_valid_ = flip(proposal_, which_variable);
+    if (!proposal_is_valid_) {
+      return negative_infinity();
+    }
+    compute_summaries(proposal_);
+    return proposal_.log_marginal_likelihood();
+  }
+
+  void SSCC::accept_proposal() {
+    if (!proposal_is_valid_) {
+      report_error("There is no valid proposal to accept.");
+    }
+    std::swap(current_, proposal_);
+    proposal_is_valid_ = false;
+  }
+
+  bool SSCC::flip(State &state, int which_variable) const {
+    std::vector<int> &positions(state.positions_);
+    auto it = std::find(positions.begin(), positions.end(), which_variable);
+    if (it != positions.end()) {
+      int position = it - positions.begin();
+      positions.erase(it);
+      state.prior_cholesky_.remove(position);
+      state.posterior_cholesky_.remove(position);
+      return true;
+    }
+
+    int k = positions.size();
+    column_.resize(k + 1);
+    for (int i = 0; i < k; ++i) {
+      column_[i] = prior_precision_(positions[i], which_variable);
+    }
+    column_[k] = prior_precision_(which_variable, which_variable);
+    if (!state.prior_cholesky_.append(column_)) {
+      return false;
+    }
+    for (int i = 0; i < k; ++i) {
+      column_[i] = posterior_precision_(positions[i], which_variable);
+    }
+    column_[k] = posterior_precision_(which_variable, which_variable);
+    if (!state.posterior_cholesky_.append(column_)) {
+      return false;
+    }
+    positions.push_back(which_variable);
+    return true;
+  }
+
+  void SSCC::compute_summaries(State &state) const {
+    const std::vector<int> &positions(state.positions_);
+    int k = positions.size();
+    state.prior_logdet_ = state.prior_cholesky_.logdet();
+    state.posterior_logdet_ = state.posterior_cholesky_.logdet();
+
+    // posterior_location_ = Ominv_gamma * mu_gamma + X'y_gamma / sigsq.
+    // Vector::operator=(double) would turn an empty vector into a vector of
+    // length 1, so assign() is used instead.
+    posterior_location_.assign(k, 0.0);
+    for (int j = 0; j < k; ++j) {
+      double mu = prior_mean_[positions[j]];
+      if (mu == 0.0) continue;
+      ConstVectorView prior_precision_column(
+          prior_precision_.col(positions[j]));
+      for (int i = 0; i < k; ++i) {
+        posterior_location_[i] += prior_precision_column[positions[i]] * mu;
+      }
+    }
+    double prior_quadratic_form = 0;
+    for (int i = 0; i < k; ++i) {
+      prior_quadratic_form +=
+          prior_mean_[positions[i]] * posterior_location_[i];
+      posterior_location_[i] += scaled_xty_[positions[i]];
+    }
+    state.prior_quadratic_form_ = prior_quadratic_form;
+
+    state.posterior_cholesky_.Lsolve_inplace(VectorView(posterior_location_));
+    state.posterior_quadratic_form_ = posterior_location_.normsq();
+  }
+
+}  // namespace BOOM
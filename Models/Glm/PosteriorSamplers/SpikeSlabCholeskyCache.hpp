@@ -0,0 +1,164 @@
+#ifndef BOOM_GLM_SPIKE_SLAB_CHOLESKY_CACHE_HPP_
+#define BOOM_GLM_SPIKE_SLAB_CHOLESKY_CACHE_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <vector>
+#include "LinAlg/Selector.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/UpdatableCholesky.hpp"
+#include "LinAlg/Vector.hpp"
+
+namespace BOOM {
+
+  // Spike and slab samplers for Gaussian (or conditionally Gaussian) models
+  // score a vector of inclusion indicators gamma using the prior
+  //
+  //     beta_gamma ~ N(mu_gamma, Ominv_gamma^{-1})
+  //
+  // and the complete data sufficient statistics X'X and X'y.  The score depends
+  // on gamma through the log determinants of Ominv_gamma and
+  //
+  //     V_gamma = Ominv_gamma + X'X_gamma / sigsq,
+  //
+  // and through two quadratic forms.  Computing these from scratch costs O(k^3)
+  // for a model with k included variables.  A single MCMC sweep through p
+  // inclusion indicators thus costs O(p * k^3).
+  //
+  // This class keeps updatable Cholesky factors of Ominv_gamma and V_gamma so
+  // that adding or removing a single variable costs O(k^2).  The cache is
+  // initialized with reset() at the start of each sweep, because sufficient
+  // statistics and sigsq change between sweeps.  Candidate flips are then
+  // evaluated with propose_flip(), and either accepted with accept_proposal()
+  // or abandoned by simply proposing another flip.
+  class SpikeSlabCholeskyCache {
+   public:
+    // The summaries of the posterior distribution of beta_gamma needed to
+    // compute the marginal probability of a model gamma.
+    class State {
+     public:
+      State() : prior_logdet_(0), posterior_logdet_(0),
+                prior_quadratic_form_(0), posterior_quadratic_form_(0) {}
+
+      // The number of included variables.
+      int nvars() const { return positions_.size(); }
+
+      // log |Ominv_gamma|
+      double prior_logdet() const { return prior_logdet_; }
+
+      // log |V_gamma|
+      double posterior_logdet() const { return posterior_logdet_; }
+
+      // mu_gamma' Ominv_gamma mu_gamma
+      double prior_quadratic_form() const { return prior_quadratic_form_; }
+
+      // S' V_gamma^{-1} S, where S = X'y_gamma / sigsq + Ominv_gamma mu_gamma.
+      // This is the posterior mean times posterior precision times posterior
+      // mean.
+      double posterior_quadratic_form() const {
+        return posterior_quadratic_form_;
+      }
+
+      // The log of the marginal likelihood of model gamma, up to an additive
+      // constant that does not depend on gamma.  This is the quantity that
+      // SpikeSlabSampler::log_model_prob adds to the log of the spike prior.
+      double log_marginal_likelihood() const {
+        return .5 * (prior_logdet_ - posterior_logdet_
+                     - prior_quadratic_form_ + posterior_quadratic_form_);
+      }
+
+     private:
+      friend class SpikeSlabCholeskyCache;
+
+      // positions_[i] is the index (in the full set of variables) of the
+      // variable in row/column i of the Cholesky factors.
+      std::vector<int> positions_;
+      UpdatableCholesky prior_cholesky_;
+      UpdatableCholesky posterior_cholesky_;
+      double prior_logdet_;
+      double posterior_logdet_;
+      double prior_quadratic_form_;
+      double posterior_quadratic_form_;
+    };
+
+    SpikeSlabCholeskyCache();
+
+    // Initialize the cache for a new sweep through the inclusion indicators.
+    //
+    // Args:
+    //   inclusion_indicators:  The initial model.
+    //   prior_precision:  The full (all variables included) prior precision
+    //     Ominv.
+    //   prior_mean:  The full prior mean mu.
+    //   xtx:  The full cross product matrix X'X (or X'WX).
+    //   xty:  The full cross product vector X'y (or X'Wy).
+    //   sigsq: The residual variance, for models where it is not already
+    //     included in the sufficient statistics.  Others should use 1.0.
+    //
+    // Returns:
+    //   The log marginal likelihood of the initial model, or negative infinity
+    //   if either Ominv_gamma or V_gamma is not positive definite.
+    double reset(const Selector &inclusion_indicators,
+                 const SpdMatrix &prior_precision,
+                 const Vector &prior_mean,
+                 const SpdMatrix &xtx,
+                 const Vector &xty,
+                 double sigsq = 1.0);
+
+    // Evaluate the model obtained by flipping one inclusion indicator in the
+    // current model.  The current model is not changed.
+    //
+    // Returns:
+    //   proposal().log_marginal_likelihood(), or negative infinity if the
+    //   proposed model is not positive definite.
+    double propose_flip(int which_variable);
+
+    // Make the most recent proposal the current model.  It is an error to call
+    // this function unless propose_flip() succeeded since the last call to
+    // reset() or accept_proposal().
+    void accept_proposal();
+
+    const State &current() const { return current_; }
+    const State &proposal() const { return proposal_; }
+
+   private:
+    // Add or remove a variable from 'state'.  Returns false if the resulting
+    // model is not positive definite, in which case 'state' is unspecified.
+    bool flip(State &state, int which_variable) const;
+
+    // Recompute the log determinants and quadratic forms in 'state' after its
+    // Cholesky factors have changed.
+    void compute_summaries(State &state) const;
+
+    SpdMatrix prior_precision_;
+    Vector prior_mean_;
+    SpdMatrix posterior_precision_;
+    Vector scaled_xty_;
+
+    State current_;
+    State proposal_;
+    bool proposal_is_valid_;
+
+    // Workspace.
+    mutable Vector column_;
+    mutable Vector posterior_location_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_SPIKE_SLAB_CHOLESKY_CACHE_HPP_
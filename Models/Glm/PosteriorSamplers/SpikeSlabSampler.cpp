@@ -76,8 +76,7 @@ namespace BOOM {
     uint n = inclusion_indicators.nvars_possible();
     if (max_flips_ > 0) n = std::min<int>(n, max_flips_);
     for (int i = 0; i < n; ++i) {
-      logp = mcmc_one_flip(
-          rng, inclusion_indicators, indx[i], logp, suf, sigsq);
+      logp = mcmc_one_flip(rng, inclusion_indicators, indx[i], logp);
     }
   }
 
@@ -171,47 +170,35 @@ namespace BOOM {
   double SSS::log_model_prob(const Selector &inclusion_indicators,
                              const WeightedRegSuf &suf, double sigsq) const {
     double numerator = spike_prior_->logp(inclusion_indicators);
-    if (numerator == BOOM::negative_infinity() ||
-        inclusion_indicators.nvars() == 0) {
-      // If numerator == -infinity then it is in a zero support point
-      // in the prior.  If inclusion_indicators.nvars()==0 then all
-      // coefficients are zero because of the point mass.  The only
-      // entries remaining in the likelihood are sums of squares of
-      // y[i] that are independent of inclusion_indicators.  They need
-      // to be omitted here because they are omitted in the non-empty
-      // case below.
+    // The cache must be reset even if numerator is -infinity, because
+    // subsequent flips are scored relative to it.  If
+    // inclusion_indicators.nvars()==0 then all coefficients are zero because of
+    // the point mass, and the cache returns zero.  The only entries remaining
+    // in the likelihood are sums of squares of y[i] that are independent of
+    // inclusion_indicators, and they are omitted in all cases.
+    double log_marginal_likelihood = model_cache_.reset(
+        inclusion_indicators, slab_prior_->siginv(), slab_prior_->mu(),
+        suf.xtx(), suf.xty(), sigsq);
+    if (numerator == BOOM::negative_infinity()) {
+      // The model is at a zero support point in the prior.
       return numerator;
     }
-    SpdMatrix precision = inclusion_indicators.select(slab_prior_->siginv());
-    numerator += .5 * precision.logdet();
-    if (numerator == BOOM::negative_infinity()) return numerator;
-
-    Vector mu = inclusion_indicators.select(slab_prior_->mu());
-    Vector precision_mu = precision * mu;
-    numerator -= .5 * mu.dot(precision_mu);
-
-    bool ok = true;
-    precision += inclusion_indicators.select(suf.xtx()) / sigsq;
-    Matrix L = precision.chol(ok);
-    if (!ok) return BOOM::negative_infinity();
-    double denominator = sum(log(L.diag()));  // = .5 log |precision|
-    Vector S = inclusion_indicators.select(suf.xty()) / sigsq + precision_mu;
-    Lsolve_inplace(L, S);
-    denominator -= .5 * S.normsq();
-    // S.normsq =  beta_tilde ^T V_tilde beta_tilde
-    return numerator - denominator;
+    return numerator + log_marginal_likelihood;
   }
 
   double SSS::mcmc_one_flip(RNG &rng, Selector &mod, int which_var,
-                            double logp_old, const WeightedRegSuf &suf,
-                            double sigsq) const {
+                            double logp_old) const {
     mod.flip(which_var);
-    double logp_new = log_model_prob(mod, suf, sigsq);
+    double logp_new = spike_prior_->logp(mod);
+    if (logp_new > BOOM::negative_infinity()) {
+      logp_new += model_cache_.propose_flip(which_var);
+    }
     double u = runif_mt(rng, 0, 1);
-    if (log(u) > logp_new - logp_old) {
+    if (!std::isfinite(logp_new) || log(u) > logp_new - logp_old) {
       mod.flip(which_var);  // reject draw
       return logp_old;
     }
+    model_cache_.accept_proposal();
     return logp_new;
   }
 
@@ -21,6 +21,7 @@
 #define BOOM_GLM_SPIKE_SLAB_SAMPLER_HPP_
 
 #include "Models/Glm/Glm.hpp"
+#include "Models/Glm/PosteriorSamplers/SpikeSlabCholeskyCache.hpp"
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "Models/Glm/WeightedRegressionModel.hpp"
 #include "Models/MvnBase.hpp"
@@ -132,7 +133,8 @@ namespace BOOM {
     void limit_model_selection(int max_flips);
 
    private:
-    // Compute the log of the marginal posterior probability of model 'g'.
+    // Compute the log of the marginal posterior probability of model 'g', and
+    // prepare model_cache_ for a sequence of flips starting from 'g'.
     // Args:
     //   g: The set of included coefficients defining the model.
     //   suf:  The set of complete data sufficient statistics.
@@ -144,7 +146,8 @@ namespace BOOM {
                           double sigsq = 1.0) const;
 
     // A single MCMC step for a single position in the set of
-    // coefficient indicators 'g'.
+    // coefficient indicators 'g'.  The model is scored using model_cache_,
+    // which must have been initialized by log_model_prob(g).
     // Args:
     //   rng:  A Uniform(0,1) random number generator.
     //   g: The set of included coefficients defining the model.  One
@@ -152,20 +155,18 @@ namespace BOOM {
     //   which_variable:  The position in 'g' to consider changing.
     //   logp_old: The value of log_model_prob(g) prior to calling
     //     this function.
-    //   suf:  The set of complete data sufficient statistics.
-    //   sigsq: If the model has a residual variance parameter that is
-    //     not reflected in 'suf' provide it here.  Models that do not
-    //     have a separate residual variance parameter should use
-    //     sigsq = 1.0.
     double mcmc_one_flip(RNG &rng, Selector &g, int which_variable,
-                         double logp_old, const WeightedRegSuf &suf,
-                         double sigsq = 1.0) const;
+                         double logp_old) const;
 
     GlmModel *model_;
     Ptr<MvnBase> slab_prior_;
     Ptr<VariableSelectionPrior> spike_prior_;
     int max_flips_;
     bool allow_model_selection_;
+
+    // Cholesky factors of the included blocks of the prior and posterior
+    // precision, updated in O(k^2) as inclusion indicators are flipped.
+    mutable SpikeSlabCholeskyCache model_cache_;
   };
 
 }  // namespace BOOM
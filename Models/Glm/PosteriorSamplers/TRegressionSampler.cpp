@@ -70,6 +70,36 @@ namespace BOOM {
 
   }  // namespace
 
+  TRegressionImputeWorker::TRegressionImputeWorker(
+      const TRegressionModel *model, WeightedRegSuf &global_suf,
+      GammaSuf &global_weight_suf, std::mutex &global_suf_mutex, RNG *rng,
+      RNG &seeding_rng)
+      : SufstatImputeWorker<RegressionData, WeightedRegSuf>(
+            global_suf, global_suf_mutex, rng, seeding_rng),
+        model_(model),
+        weight_suf_(global_weight_suf.clone()),
+        global_weight_suf_(global_weight_suf) {}
+
+  void TRegressionImputeWorker::impute_latent_data() {
+    weight_suf_->clear();
+    SufstatImputeWorker<RegressionData, WeightedRegSuf>::impute_latent_data();
+  }
+
+  void TRegressionImputeWorker::impute_latent_data_point(
+      const RegressionData &data_point, WeightedRegSuf *suf, RNG &rng) {
+    double residual = data_point.y() - model_->predict(data_point.x());
+    double weight = data_imputer_.impute(rng, residual, model_->sigma(),
+                                         model_->nu());
+    weight_suf_->update_raw(weight);
+    suf->add_data(data_point.x(), data_point.y(), weight);
+  }
+
+  void TRegressionImputeWorker::combine_complete_data() {
+    SufstatImputeWorker<RegressionData, WeightedRegSuf>::combine_complete_data();
+    global_weight_suf_.combine(*weight_suf_);
+  }
+
+  //======================================================================
   TRegressionSampler::TRegressionSampler(
       TRegressionModel *model, const Ptr<MvnBase> &coefficient_prior,
       const Ptr<GammaModelBase> &siginv_prior, const Ptr<DoubleModel> &nu_prior,
@@ -86,10 +116,13 @@ namespace BOOM {
                                   false, 1.0, &rng()),
         nu_complete_data_sampler_(
             TRegressionCompleteDataLogPosterior(weight_model_, nu_prior_),
-            false, 1.0, &rng()),
-        latent_data_is_fixed_(false) {
+            false, 1.0, &rng()) {
     nu_observed_data_sampler_.set_lower_limit(0.0);
     nu_complete_data_sampler_.set_lower_limit(0.0);
+    // Assigning the data is cheap, and reassigning each iteration keeps the
+    // workers valid if data are added to the model.
+    reassign_data_each_time();
+    set_number_of_workers(1);
   }
 
   void TRegressionSampler::draw() {
@@ -106,21 +139,20 @@ namespace BOOM {
     return ans;
   }
 
-  void TRegressionSampler::impute_latent_data() {
-    if (!latent_data_is_fixed_) {
-      complete_data_sufficient_statistics_.clear();
-      weight_model_->suf()->clear();
-      const std::vector<Ptr<RegressionData> > &data(model_->dat());
-      for (int i = 0; i < data.size(); ++i) {
-        double mu = model_->predict(data[i]->x());
-        double residual = data[i]->y() - mu;
-        double weight = data_imputer_.impute(rng(), residual, model_->sigma(),
-                                             model_->nu());
-        weight_model_->suf()->update_raw(weight);
-        complete_data_sufficient_statistics_.add_data(data[i]->x(),
-                                                      data[i]->y(), weight);
-      }
-    }
+  Ptr<TRegressionImputeWorker> TRegressionSampler::create_worker(
+      std::mutex &suf_mutex) {
+    return new TRegressionImputeWorker(
+        model_, complete_data_sufficient_statistics_, *weight_model_->suf(),
+        suf_mutex, nullptr, rng());
+  }
+
+  void TRegressionSampler::clear_latent_data() {
+    complete_data_sufficient_statistics_.clear();
+    weight_model_->suf()->clear();
+  }
+
+  void TRegressionSampler::assign_data_to_workers() {
+    BOOM::assign_data_to_workers(model_->dat(), workers());
   }
 
   // Y ~ N(X * beta, sigma^2 * W^{-1}), where W is diagonal.
@@ -177,8 +209,4 @@ namespace BOOM {
     weight_model_->suf()->update_raw(weight);
   }
 
-  void TRegressionSampler::fix_latent_data(bool fixed) {
-    latent_data_is_fixed_ = fixed;
-  }
-
 }  // namespace BOOM
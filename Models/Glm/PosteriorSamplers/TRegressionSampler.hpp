@@ -25,16 +25,66 @@
 #include "Models/Glm/WeightedRegressionModel.hpp"
 #include "Models/MvnBase.hpp"
 #include "Models/PosteriorSamplers/GenericGaussianVarianceSampler.hpp"
+#include "Models/PosteriorSamplers/Imputer.hpp"
 #include "Models/ScaledChisqModel.hpp"
 #include "Samplers/ScalarSliceSampler.hpp"
 
 namespace BOOM {
+
+  // A worker that imputes the latent precision weights for a chunk of the
+  // data in a T regression model.  The weighted observations are stored in a
+  // WeightedRegSuf, and the weights themselves are stored in a GammaSuf,
+  // which carries the complete data information about the tail thickness
+  // parameter.
+  class TRegressionImputeWorker
+      : public SufstatImputeWorker<RegressionData, WeightedRegSuf> {
+   public:
+    // Args:
+    //   model:  The model whose latent data is to be imputed.
+    //   global_suf: The complete data sufficient statistics for the
+    //     regression coefficients and residual variance.
+    //   global_weight_suf: The complete data sufficient statistics for the
+    //     weights.
+    //   global_suf_mutex:  A mutex protecting global_suf and
+    //     global_weight_suf.
+    //   rng:  A random number generator, or nullptr.
+    //   seeding_rng: Used to seed a new RNG in the case that rng is
+    //     nullptr.
+    TRegressionImputeWorker(const TRegressionModel *model,
+                            WeightedRegSuf &global_suf,
+                            GammaSuf &global_weight_suf,
+                            std::mutex &global_suf_mutex,
+                            RNG *rng = nullptr,
+                            RNG &seeding_rng = GlobalRng::rng);
+
+    void impute_latent_data() override;
+    void impute_latent_data_point(const RegressionData &data_point,
+                                  WeightedRegSuf *suf, RNG &rng) override;
+    void combine_complete_data() override;
+
+   private:
+    const TRegressionModel *model_;
+    TDataImputer data_imputer_;
+    Ptr<GammaSuf> weight_suf_;
+    GammaSuf &global_weight_suf_;
+  };
+
+  //======================================================================
   // A posterior sampler for T regression models.  Uses data
   // augmentation to turn the T regression into a Gaussian regression.
   // The DF parameters can be sampled either conditional on the latent
   // data (computationally fast, but slow mixing) or after
   // marginalizing out the latent data.
-  class TRegressionSampler : public PosteriorSampler {
+  //
+  // The latent data can be imputed in parallel by calling
+  // set_number_of_workers().  Normally the sampler imputes the latent data in
+  // its draw() method.  Calling fix_latent_data(true) turns
+  // impute_latent_data() into a no-op, so either the complete data
+  // sufficient statistics stay constant from call-to-call (e.g. for
+  // debugging), or else control of them passes to an outside object.
+  class TRegressionSampler
+      : public PosteriorSampler,
+        public LatentDataSampler<TRegressionImputeWorker> {
    public:
     // Args:
     //   model:  The model whose parameters are to be sampled.
@@ -54,7 +104,6 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
-    void impute_latent_data();
     void draw_beta_full_conditional();
     void draw_sigsq_full_conditional();
     void draw_nu_given_complete_data();
@@ -66,15 +115,6 @@ namespace BOOM {
       return complete_data_sufficient_statistics_;
     }
 
-    // Normally the sampler manages the draw of the complete data
-    // sufficient statistics in the draw() method by a call to
-    // impute_latent_data().  Calling fix_latent_data(true) turns
-    // impute_latent_data() into a no-op, so either the
-    // complete_data_sufficient_statistics_ stay constant from
-    // call-to-call (e.g. for debugging), or else control of them
-    // passes to an outside object.
-    void fix_latent_data(bool fixed = true);
-
     // Clears the complete data_sufficient statistics for beta and
     // sigma, and the weight_model for nu.  It is not normally
     // necessary to call this function unless an outside object wants
@@ -89,6 +129,10 @@ namespace BOOM {
     void update_complete_data_sufficient_statistics(double y, const Vector &x,
                                                     double weight);
 
+    Ptr<TRegressionImputeWorker> create_worker(std::mutex &m) override;
+    void clear_latent_data() override;
+    void assign_data_to_workers() override;
+
    private:
     TRegressionModel *model_;
     Ptr<MvnBase> coefficient_prior_;
@@ -110,8 +154,6 @@ namespace BOOM {
     ScalarSliceSampler nu_observed_data_sampler_;
 
     ScalarSliceSampler nu_complete_data_sampler_;
-
-    bool latent_data_is_fixed_;
   };
 
 }  // namespace BOOM
@@ -21,7 +21,9 @@
 
 #include <cmath>
 #include <sstream>
+#include "LinAlg/EigenMap.hpp"
 #include "Models/SufstatAbstractCombineImpl.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -385,6 +387,63 @@ namespace BOOM {
     x_column_sums_.axpy(tmpx, 1.0);
   }
 
+  void NeRegSuf::add_data(const Matrix &predictors, const Vector &response,
+                          ThreadWorkerPool *pool) {
+    int nobs = predictors.nrow();
+    if (response.size() != nobs) {
+      incompatible_X_and_y(predictors, response);
+    }
+    if (predictors.ncol() != xty_.size()) {
+      report_error("Wrong size predictors passed to NeRegSuf::add_data().");
+    }
+    int nshards = pool ? std::min<int>(pool->number_of_threads(), nobs) : 0;
+    if (nshards <= 1) {
+      add_data_block(predictors, response, 0, nobs);
+    } else {
+      std::vector<NeRegSuf> shards(nshards, NeRegSuf(xty_.size()));
+      std::vector<std::future<void>> futures;
+      int shard_size = nobs / nshards;
+      for (int i = 0; i < nshards; ++i) {
+        int begin = i * shard_size;
+        int end = (i + 1 == nshards) ? nobs : begin + shard_size;
+        NeRegSuf *shard = &shards[i];
+        shard->allow_non_finite_responses(allow_non_finite_responses_);
+        shard->fix_xtx(xtx_is_fixed_);
+        futures.emplace_back(pool->submit(
+            [shard, &predictors, &response, begin, end]() {
+              shard->add_data_block(predictors, response, begin, end);
+            }));
+      }
+      for (auto &future : futures) {
+        future.get();
+      }
+      for (const auto &shard : shards) {
+        combine(shard);
+      }
+    }
+    if (!allow_non_finite_responses_ && !std::isfinite(sumsqy_)) {
+      report_error("Non-finite response variable.");
+    }
+  }
+
+  void NeRegSuf::add_data_block(const Matrix &predictors,
+                                const Vector &response, int begin, int end) {
+    int nobs = end - begin;
+    if (nobs <= 0) return;
+    const auto X = EigenMap(predictors).middleRows(begin, nobs);
+    const auto y = EigenMap(response).segment(begin, nobs);
+    if (!xtx_is_fixed_) {
+      EigenMap(xtx_).selfadjointView<Eigen::Upper>().rankUpdate(
+          X.transpose());
+      needs_to_reflect_ = true;
+    }
+    EigenMap(xty_).noalias() += X.transpose() * y;
+    EigenMap(x_column_sums_) += X.colwise().sum().transpose();
+    sumsqy_ += y.squaredNorm();
+    sumy_ += y.sum();
+    n_ += nobs;
+  }
+
   uint NeRegSuf::size() const { return xtx_.ncol(); }  // dim(beta)
   SpdMatrix NeRegSuf::xtx() const {
     reflect();
@@ -426,6 +485,20 @@ namespace BOOM {
     n_ += other.n();
   }
 
+  // Combining with another NeRegSuf avoids the copies made by the virtual
+  // accessors, and also merges the column sums needed by xbar().
+  void NeRegSuf::combine(const NeRegSuf &other) {
+    if (!xtx_is_fixed_) {
+      xtx_ += other.xtx_;
+      needs_to_reflect_ = true;
+    }
+    xty_ += other.xty_;
+    sumsqy_ += other.sumsqy_;
+    sumy_ += other.sumy_;
+    n_ += other.n_;
+    x_column_sums_ += other.x_column_sums_;
+  }
+
   NeRegSuf *NeRegSuf::abstract_combine(Sufstat *s) {
     return abstract_combine_impl(this, s);
   }
@@ -36,6 +36,8 @@
 
 namespace BOOM {
 
+  class ThreadWorkerPool;
+
   class AnovaTable {
    public:
     double SSE, SSM, SST;
@@ -174,6 +176,23 @@ namespace BOOM {
     void add_mixture_data(double y, const ConstVectorView &x,
                           double prob) override;
     void Update(const RegressionData &rdp) override;
+
+    // Add a block of observations in a single call.  X'X is accumulated with a
+    // blocked rank-k (SYRK) update through Eigen, which is much faster than
+    // calling Update() once per observation.
+    //
+    // Args:
+    //   predictors: The matrix of predictors, with observations in rows.  An
+    //     intercept column, if desired, must already be present.
+    //   response: The vector of responses.  Its length must match
+    //     predictors.nrow().
+    //   pool: If non-NULL and the pool has threads, the rows are split into
+    //     one shard per thread.  Each shard accumulates its own partial
+    //     sufficient statistics, which are merged using combine() in shard
+    //     order, so the result does not depend on the timing of the threads.
+    void add_data(const Matrix &predictors, const Vector &response,
+                  ThreadWorkerPool *pool = nullptr);
+
     uint size() const override;  // dimension of beta
     double yty() const override;
     Vector xty() const override;
@@ -188,6 +207,7 @@ namespace BOOM {
     double n() const override;
     void combine(const Ptr<RegSuf> &) override;
     void combine(const RegSuf &);
+    void combine(const NeRegSuf &);
     NeRegSuf *abstract_combine(Sufstat *s) override;
 
     Vector vectorize(bool minimal = true) const override;
@@ -206,6 +226,11 @@ namespace BOOM {
     }
 
    private:
+    // Add rows [begin, end) of the predictors and response to the sufficient
+    // statistics, using a rank-k update for xtx_.
+    void add_data_block(const Matrix &predictors, const Vector &response,
+                        int begin, int end);
+
     mutable SpdMatrix xtx_;
     mutable bool needs_to_reflect_;
     Vector xty_;
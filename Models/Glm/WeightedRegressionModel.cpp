@@ -22,7 +22,9 @@
 
 #include <cmath>
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "LinAlg/EigenMap.hpp"
 #include "Models/SufstatAbstractCombineImpl.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "cpputil/math_utils.hpp"
 
 namespace BOOM {
@@ -38,7 +40,7 @@ namespace BOOM {
 
   WRS::WeightedRegSuf(const Matrix &X, const Vector &y, const Vector &w) {
     Matrix tmpx = add_intercept(X);
-    uint p = tmpx.nrow();
+    uint p = tmpx.ncol();
     setup_mat(p);
     if (w.empty()) {
       recompute(tmpx, y, Vector(y.size(), 1.0));
@@ -132,7 +134,7 @@ namespace BOOM {
     uint n = w.size();
     assert(y.size() == n && X.nrow() == n);
     clear();
-    for (uint i = 0; i < n; ++i) add_data(X.row(i), y[i], w[i]);
+    add_data(X, y, w);
   }
 
   void WRS::recompute(const std::vector<Ptr<WeightedRegressionData>> &data) {
@@ -158,7 +160,7 @@ namespace BOOM {
   
   //------------------------------------------------------------
 
-  void WRS::add_data(const Vector &x, double y, double w) {
+  void WRS::add_data(const ConstVectorView &x, double y, double w) {
     ++n_;
     yt_w_y_ += w * y * y;
     sumw_ += w;
@@ -168,6 +170,59 @@ namespace BOOM {
     sym_ = false;
   }
 
+  void WRS::add_data(const Matrix &X, const Vector &y, const Vector &w,
+                      ThreadWorkerPool *pool) {
+    int nobs = X.nrow();
+    if (y.size() != nobs || w.size() != nobs) {
+      report_error("The number of rows in X must match the lengths of y and w "
+                   "in WeightedRegSuf::add_data.");
+    }
+    if (X.ncol() != xtwy_.size()) {
+      report_error("Wrong size predictors passed to WeightedRegSuf::add_data.");
+    }
+    int nshards = pool ? std::min<int>(pool->number_of_threads(), nobs) : 0;
+    if (nshards <= 1) {
+      add_data_block(X, y, w, 0, nobs);
+      return;
+    }
+    std::vector<WeightedRegSuf> shards(nshards, WeightedRegSuf(X.ncol()));
+    std::vector<std::future<void>> futures;
+    int shard_size = nobs / nshards;
+    for (int i = 0; i < nshards; ++i) {
+      int begin = i * shard_size;
+      int end = (i + 1 == nshards) ? nobs : begin + shard_size;
+      WeightedRegSuf *shard = &shards[i];
+      futures.emplace_back(pool->submit([shard, &X, &y, &w, begin, end]() {
+            shard->add_data_block(X, y, w, begin, end);
+          }));
+    }
+    for (auto &future : futures) {
+      future.get();
+    }
+    for (const auto &shard : shards) {
+      combine(shard);
+    }
+  }
+
+  void WRS::add_data_block(const Matrix &X, const Vector &y, const Vector &w,
+                           int begin, int end) {
+    int nobs = end - begin;
+    if (nobs <= 0) return;
+    const auto x_block = EigenMap(X).middleRows(begin, nobs);
+    const auto y_block = EigenMap(y).segment(begin, nobs);
+    const auto w_block = EigenMap(w).segment(begin, nobs);
+    // Only the upper triangle is accumulated, as in add_data.
+    EigenMap(xtwx_).triangularView<Eigen::Upper>() +=
+        x_block.transpose() * w_block.asDiagonal() * x_block;
+    Eigen::VectorXd wy = w_block.cwiseProduct(y_block);
+    EigenMap(xtwy_).noalias() += x_block.transpose() * wy;
+    n_ += nobs;
+    yt_w_y_ += wy.dot(y_block);
+    sumw_ += w_block.sum();
+    sumlogw_ += w_block.array().log().sum();
+    sym_ = false;
+  }
+
   void WRS::clear() {
     xtwx_ = 0.0;
     xtwy_ = 0.0;
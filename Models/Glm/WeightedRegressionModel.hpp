@@ -71,7 +71,22 @@ namespace BOOM {
     void set_xtwy(const Vector &xtwy);
 
     void Update(const WeightedRegressionData &) override;
-    void add_data(const Vector &x, double y, double w);
+    void add_data(const ConstVectorView &x, double y, double w);
+
+    // Add a block of observations in a single call.  X'WX is accumulated with
+    // a blocked rank-k update through Eigen, which is much faster than adding
+    // observations one at a time.
+    //
+    // Args:
+    //   X:  The matrix of predictors, with observations in rows.
+    //   y:  The vector of responses.
+    //   w:  The vector of weights.
+    //   pool: If non-NULL and the pool has threads, the rows are split into
+    //     one shard per thread.  Each shard accumulates its own partial
+    //     sufficient statistics, which are merged using combine() in shard
+    //     order, so the result does not depend on the timing of the threads.
+    void add_data(const Matrix &X, const Vector &y, const Vector &w,
+                  ThreadWorkerPool *pool = nullptr);
 
     void clear() override;
     virtual uint size() const;                      // dimension of beta
@@ -110,6 +125,10 @@ namespace BOOM {
 
     void setup_mat(uint p);
     void make_symmetric() const;
+
+    // Add rows [begin, end) of X, y, and w to the sufficient statistics.
+    void add_data_block(const Matrix &X, const Vector &y, const Vector &w,
+                        int begin, int end);
   };
 
   inline std::ostream &operator<<(std::ostream &out, const WeightedRegSuf &s) {
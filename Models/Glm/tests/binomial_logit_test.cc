@@ -6,6 +6,8 @@
 #include "distributions.hpp"
 #include "Models/Glm/BinomialLogitModel.hpp"
 #include "Models/Glm/PosteriorSamplers/BinomialLogitDataImputer.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialLogitAuxmixSampler.hpp"
+#include "Models/MvnModel.hpp"
 
 #include "test_utils/test_utils.hpp"
 #include <fstream>
@@ -29,5 +31,85 @@ namespace {
     BinomialLogitCltDataImputer clt_imputer;
     BinomialLogitPartialAugmentationDataImputer pa_imputer;
   }
-  
+
+  // A model holding columnar data should give the same answers as one holding
+  // individual observations, and calling dat() should convert the former to
+  // the latter.
+  TEST_F(BinomialLogitTest, ColumnarData) {
+    int nobs = 200;
+    int xdim = 3;
+    Matrix X(nobs, xdim);
+    X.randomize();
+    X.col(0) = 1.0;
+    Vector beta = {-.5, 1.0, 2.0};
+    Vector trials(nobs);
+    Vector successes(nobs);
+    for (int i = 0; i < nobs; ++i) {
+      trials[i] = 1 + random_int(0, 5);
+      successes[i] = rbinom(trials[i], plogis(X.row(i).dot(beta)));
+    }
+
+    NEW(BinomialLogitModel, columnar_model)(X, successes, trials);
+    columnar_model->set_Beta(beta);
+    EXPECT_TRUE(columnar_model->has_columnar_data());
+    EXPECT_EQ(nobs, columnar_model->number_of_observations());
+
+    Ptr<BinomialLogitModel> row_model = columnar_model->clone();
+    EXPECT_EQ(nobs, row_model->dat().size());
+    EXPECT_FALSE(row_model->has_columnar_data());
+    EXPECT_TRUE(columnar_model->has_columnar_data());
+    EXPECT_DOUBLE_EQ(successes[7], row_model->dat()[7]->y());
+    EXPECT_DOUBLE_EQ(trials[7], row_model->dat()[7]->n());
+    EXPECT_TRUE(VectorEquals(X.row(7), row_model->dat()[7]->x()));
+
+    Vector g1, g2;
+    Matrix h1, h2;
+    EXPECT_NEAR(columnar_model->log_likelihood(beta, &g1, &h1),
+                row_model->log_likelihood(beta, &g2, &h2), 1e-8);
+    EXPECT_TRUE(VectorEquals(g1, g2));
+    EXPECT_TRUE(MatrixEquals(h1, h2));
+    EXPECT_TRUE(MatrixEquals(columnar_model->xtx(), row_model->xtx()));
+
+    // Data augmentation gives the same draw for both storage formats.
+    NEW(MvnModel, prior)(Vector(xdim, 0.0), SpdMatrix(xdim, 1.0));
+    RNG columnar_seeding_rng(17);
+    RNG row_seeding_rng(17);
+    NEW(BinomialLogitAuxmixSampler, columnar_sampler)(
+        columnar_model.get(), prior, 10, columnar_seeding_rng);
+    NEW(BinomialLogitAuxmixSampler, row_sampler)(
+        row_model.get(), prior, 10, row_seeding_rng);
+    columnar_sampler->draw();
+    row_sampler->draw();
+    EXPECT_TRUE(columnar_model->has_columnar_data());
+    EXPECT_TRUE(VectorEquals(columnar_model->Beta(), row_model->Beta()));
+
+    // The const dat() also gives individual observations, which are kept
+    // when data are added.
+    const BinomialLogitModel &const_model(*columnar_model);
+    const std::vector<Ptr<BinomialRegressionData>> &observations(
+        const_model.dat());
+    EXPECT_EQ(nobs, observations.size());
+    EXPECT_FALSE(columnar_model->has_columnar_data());
+    Ptr<BinomialRegressionData> first = observations[0];
+    columnar_model->add_data(row_model->dat()[1]);
+    EXPECT_EQ(nobs + 1, columnar_model->dat().size());
+    EXPECT_EQ(first.get(), columnar_model->dat()[0].get());
+    EXPECT_EQ(row_model->dat()[1].get(), columnar_model->dat()[nobs].get());
+  }
+
+  // The constructor taking a design matrix rejects impossible counts.
+  TEST_F(BinomialLogitTest, RejectsBadCounts) {
+    Matrix X(3, 2);
+    X.randomize();
+    Vector trials = {3, 2, 5};
+    EXPECT_NO_THROW(BinomialLogitModel(X, Vector{0, 2, 4}, trials));
+    EXPECT_THROW(BinomialLogitModel(X, Vector{0, 3, 4}, trials),
+                 std::exception);
+    EXPECT_THROW(BinomialLogitModel(X, Vector{-1, 1, 4}, trials),
+                 std::exception);
+    EXPECT_THROW(BinomialLogitModel(X, Vector{0, 1}, Vector{3, 2}),
+                 std::exception);
+  }
+
+
 }  // namespace
@@ -6,6 +6,7 @@
 #include "Models/Glm/BinomialProbitModel.hpp"
 #include "Models/Glm/PosteriorSamplers/BinomialProbitDataImputer.hpp"
 #include "Models/Glm/PosteriorSamplers/BinomialProbitCompositeSpikeSlabSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialProbitSpikeSlabSampler.hpp"
 
 #include "test_utils/test_utils.hpp"
 #include <fstream>
@@ -118,5 +119,40 @@ namespace {
       model->sample_posterior();
     }
   }
+
+  TEST_F(BinomialProbitTest, ThreadedImputation) {
+    int nobs = 2000;
+    int xdim = 3;
+    Matrix predictors(nobs, xdim);
+    predictors.randomize();
+    predictors.col(0) = 1.0;
+    Vector beta = {-0.5, 1.0, -0.7};
+
+    Vector eta = predictors * beta;
+    NEW(BinomialProbitModel, model)(xdim);
+    for (int i = 0; i < nobs; ++i) {
+      // Some observations use the central limit theorem approximation.
+      int n = 1 + rpois(i % 2 == 0 ? 2.0 : 20.0);
+      int y = rbinom(n, pnorm(eta[i]));
+      NEW(BinomialRegressionData, data_point)(y, n, predictors.row(i));
+      model->add_data(data_point);
+    }
+
+    NEW(MvnModel, slab)(Vector(xdim, 0.0), SpdMatrix(xdim, 1.0));
+    NEW(VariableSelectionPrior, spike)(xdim, 1.0);
+    NEW(BinomialProbitSpikeSlabSampler, sampler)(model.get(), slab, spike);
+    sampler->allow_model_selection(false);
+    sampler->set_number_of_workers(4);
+    model->set_method(sampler);
+
+    int niter = 500;
+    Matrix draws(niter, xdim);
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      draws.row(i) = model->Beta();
+    }
+    auto status = CheckMcmcMatrix(draws, beta);
+    EXPECT_TRUE(status.ok) << status;
+  }
   
 }  // namespace
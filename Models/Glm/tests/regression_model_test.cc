@@ -5,11 +5,13 @@
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "distributions.hpp"
 #include "Models/Glm/RegressionModel.hpp"
+#include "Models/Glm/WeightedRegressionModel.hpp"
 #include "Models/Glm/PosteriorSamplers/RegressionConjSampler.hpp"
 
 #include "stats/moments.hpp"
 #include "cpputil/lse.hpp"
 #include "LinAlg/Cholesky.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 #include "test_utils/test_utils.hpp"
 #include <fstream>
@@ -152,4 +154,51 @@ namespace {
   }
 
 
+  // Check that adding a block of data gives the same sufficient statistics as
+  // adding the observations one at a time, with and without a thread pool.
+  TEST_F(RegressionModelTest, BulkAddData) {
+    int nobs = 503;
+    int xdim = 4;
+    Matrix X(nobs, xdim);
+    X.randomize();
+    X.col(0) = 1.0;
+    Vector y = rnorm_vector(nobs, 0, 1);
+    Vector w(nobs);
+    for (int i = 0; i < nobs; ++i) {
+      w[i] = runif(.5, 2);
+    }
+
+    NeRegSuf one_at_a_time(xdim);
+    WeightedRegSuf weighted_one_at_a_time(xdim);
+    for (int i = 0; i < nobs; ++i) {
+      one_at_a_time.add_mixture_data(y[i], Vector(X.row(i)), 1.0);
+      weighted_one_at_a_time.add_data(X.row(i), y[i], w[i]);
+    }
+
+    ThreadWorkerPool pool(3);
+    for (ThreadWorkerPool *p : {static_cast<ThreadWorkerPool *>(nullptr),
+                                &pool}) {
+      NeRegSuf bulk(xdim);
+      bulk.add_data(X, y, p);
+      EXPECT_TRUE(MatrixEquals(bulk.xtx(), one_at_a_time.xtx()));
+      EXPECT_TRUE(VectorEquals(bulk.xty(), one_at_a_time.xty()));
+      EXPECT_NEAR(bulk.yty(), one_at_a_time.yty(), 1e-8);
+      EXPECT_DOUBLE_EQ(bulk.n(), one_at_a_time.n());
+      EXPECT_NEAR(bulk.ybar(), one_at_a_time.ybar(), 1e-8);
+      EXPECT_TRUE(VectorEquals(bulk.xbar(), one_at_a_time.xbar()));
+
+      WeightedRegSuf weighted_bulk(xdim);
+      weighted_bulk.add_data(X, y, w, p);
+      EXPECT_TRUE(MatrixEquals(weighted_bulk.xtx(),
+                               weighted_one_at_a_time.xtx()));
+      EXPECT_TRUE(VectorEquals(weighted_bulk.xty(),
+                               weighted_one_at_a_time.xty()));
+      EXPECT_NEAR(weighted_bulk.yty(), weighted_one_at_a_time.yty(), 1e-8);
+      EXPECT_NEAR(weighted_bulk.sumw(), weighted_one_at_a_time.sumw(), 1e-8);
+      EXPECT_NEAR(weighted_bulk.sumlogw(), weighted_one_at_a_time.sumlogw(),
+                  1e-8);
+      EXPECT_DOUBLE_EQ(weighted_bulk.n(), weighted_one_at_a_time.n());
+    }
+  }
+
 }  // namespace
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include "Models/Glm/PosteriorSamplers/SpikeSlabCholeskyCache.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class SpikeSlabCholeskyCacheTest : public ::testing::Test {
+   protected:
+    SpikeSlabCholeskyCacheTest()
+        : xdim_(8),
+          sigsq_(1.7),
+          prior_precision_(xdim_),
+          prior_mean_(xdim_),
+          xtx_(xdim_),
+          xty_(xdim_)
+    {
+      GlobalRng::rng.seed(8675309);
+      prior_precision_.randomize();
+      prior_mean_.randomize();
+      Matrix X(100, xdim_);
+      X.randomize();
+      xtx_ = X.inner();
+      Vector y(100);
+      y.randomize();
+      xty_ = y * X;
+    }
+
+    // Compute the log marginal likelihood directly, the way SpikeSlabSampler
+    // did before the cache was introduced.
+    double DirectLogMarginalLikelihood(const Selector &inc) {
+      if (inc.nvars() == 0) return 0.0;
+      SpdMatrix precision = inc.select(prior_precision_);
+      double ans = .5 * precision.logdet();
+      Vector mu = inc.select(prior_mean_);
+      Vector precision_mu = precision * mu;
+      ans -= .5 * mu.dot(precision_mu);
+      precision += inc.select(xtx_) / sigsq_;
+      Vector S = inc.select(xty_) / sigsq_ + precision_mu;
+      ans -= .5 * precision.logdet();
+      ans += .5 * precision.solve(S).dot(S);
+      return ans;
+    }
+
+    int xdim_;
+    double sigsq_;
+    SpdMatrix prior_precision_;
+    Vector prior_mean_;
+    SpdMatrix xtx_;
+    Vector xty_;
+  };
+
+  TEST_F(SpikeSlabCholeskyCacheTest, MatchesDirectComputation) {
+    Selector inc("10110010");
+    SpikeSlabCholeskyCache cache;
+    double logp = cache.reset(
+        inc, prior_precision_, prior_mean_, xtx_, xty_, sigsq_);
+    EXPECT_NEAR(logp, DirectLogMarginalLikelihood(inc), 1e-8);
+    EXPECT_EQ(4, cache.current().nvars());
+
+    // A sequence of proposals, some accepted and some not.
+    std::vector<int> flips = {1, 0, 5, 7, 2, 3, 3, 0, 6, 4};
+    for (int i = 0; i < flips.size(); ++i) {
+      Selector candidate = inc;
+      candidate.flip(flips[i]);
+      double proposal_logp = cache.propose_flip(flips[i]);
+      EXPECT_NEAR(proposal_logp, DirectLogMarginalLikelihood(candidate), 1e-8)
+          << "flip " << i << " to " << candidate;
+      EXPECT_EQ(candidate.nvars(), cache.proposal().nvars());
+      if (i % 3 != 2) {
+        cache.accept_proposal();
+        inc = candidate;
+      }
+      EXPECT_NEAR(cache.current().log_marginal_likelihood(),
+                  DirectLogMarginalLikelihood(inc), 1e-8);
+    }
+  }
+
+  TEST_F(SpikeSlabCholeskyCacheTest, EmptyModel) {
+    Selector inc(xdim_, false);
+    SpikeSlabCholeskyCache cache;
+    EXPECT_DOUBLE_EQ(0.0, cache.reset(
+        inc, prior_precision_, prior_mean_, xtx_, xty_, sigsq_));
+    inc.flip(2);
+    EXPECT_NEAR(cache.propose_flip(2), DirectLogMarginalLikelihood(inc), 1e-8);
+    cache.accept_proposal();
+    inc.flip(2);
+    EXPECT_NEAR(cache.propose_flip(2), 0.0, 1e-8);
+  }
+
+}  // namespace
@@ -105,4 +105,42 @@ namespace {
         << "Residual SD parameter failed to cover.";
   }
 
+  TEST_F(StudentSpikeSlabTest, ThreadedImputation) {
+    SimulatePredictors();
+    SimulateCoefficients();
+    SimulateResponse();
+
+    NEW(TRegressionModel, model)(predictors_, response_);
+    NEW(RegressionModel, reg)(predictors_, response_);
+    SpdMatrix xtx = reg->suf()->xtx();
+
+    NEW(MvnGivenScalarSigma, slab)(
+        Vector(xdim_, 0), xtx / nobs_, model->Sigsq_prm());
+    NEW(ChisqModel, residual_precision_prior)(1.0, 1.0);
+    NEW(VariableSelectionPrior, spike)(xdim_, .5);
+    NEW(ChisqModel, tail_thickness_prior)(5.0, 1.0);
+    NEW(TRegressionSpikeSlabSampler, sampler)(
+        model.get(), slab, spike,
+        residual_precision_prior,
+        tail_thickness_prior);
+    sampler->set_number_of_workers(4);
+    model->set_method(sampler);
+
+    Vector sigma_draws(niter_);
+    Vector nu_draws(niter_);
+    for (int i = 0; i < niter_; ++i) {
+      model->sample_posterior();
+      // The complete data must include every observation, however the work
+      // was split.
+      EXPECT_DOUBLE_EQ(nobs_, sampler->complete_data_sufficient_statistics().n());
+      sigma_draws[i] = model->sigma();
+      nu_draws[i] = model->nu();
+    }
+
+    EXPECT_TRUE(CheckMcmcVector(nu_draws, tail_thickness_))
+        << "Tail thickness parameter failed to cover.";
+    EXPECT_TRUE(CheckMcmcVector(sigma_draws, residual_sd_))
+        << "Residual SD parameter failed to cover.";
+  }
+
 }  // namespace
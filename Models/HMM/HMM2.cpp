@@ -47,6 +47,7 @@ namespace BOOM {
       : mark_(Mark),
         mix_(Mix),
         filter_(new HmmFilter(mix_, mark_)),
+        filter_storage_mode_(HmmFilter::FULL),
         loglike_(new UnivParams(0.0)),
         logpost_(new UnivParams(0.0)) {
     ParamPolicy::set_models(mix_.begin(), mix_.end());
@@ -60,6 +61,7 @@ namespace BOOM {
         PriorPolicy(rhs),
         mark_(rhs.mark_->clone()),
         mix_(rhs.state_space_size()),
+        filter_storage_mode_(rhs.filter_storage_mode_),
         loglike_(new UnivParams(0.0)),
         logpost_(new UnivParams(0.0)) {
     for (uint i = 0; i < state_space_size(); ++i) {
@@ -100,7 +102,18 @@ namespace BOOM {
 
   void HMM::set_pi0(const Vector &pi0) { mark_->set_pi0(pi0); }
   void HMM::set_Q(const Matrix &Q) { mark_->set_Q(Q); }
-  void HMM::set_filter(const Ptr<HmmFilter> &f) { filter_ = f; }
+  void HMM::set_filter(const Ptr<HmmFilter> &f) {
+    filter_ = f;
+    filter_->set_storage_mode(filter_storage_mode_);
+  }
+
+  void HMM::set_filter_storage_mode(HmmFilter::StorageMode mode) {
+    filter_storage_mode_ = mode;
+    filter_->set_storage_mode(mode);
+    for (auto &worker : workers_) {
+      worker->set_filter_storage_mode(mode);
+    }
+  }
 
   void HMM::fix_pi0(const Vector &Pi0) { mark_->fix_pi0(Pi0); }
   void HMM::fix_pi0_stationary() { mark_->fix_pi0_stationary(); }
@@ -175,8 +188,9 @@ namespace BOOM {
       : HiddenMarkovModel(
             std::vector<Ptr<MixtureComponent>>(Mix.begin(), Mix.end()), Mark),
         mix_(Mix),
+        filter_(new HmmEmFilter(mix_, mark())),
         eps(1e-5) {
-    set_filter(new HmmEmFilter(mix_, mark()));
+    set_filter(filter_);
   }
 
   std::vector<Ptr<MixtureComponent>> HMM_EM::tomod(
@@ -192,7 +206,8 @@ namespace BOOM {
         eps(rhs.eps) {
     for (uint i = 0; i < mix_.size(); ++i) mix_[i] = rhs.mix_[i]->clone();
     set_mixture_components(mix_.begin(), mix_.end());
-    set_filter(new HmmEmFilter(mix_, mark()));
+    filter_ = new HmmEmFilter(mix_, mark());
+    set_filter(filter_);
   }
 
   HMM_EM *HMM_EM::clone() const { return new HMM_EM(*this); }
@@ -281,6 +296,7 @@ namespace BOOM {
     workers_.clear();
     for (uint i = 0; i < n; ++i) {
       NEW(HmmDataImputer, imp)(this, i, n);
+      imp->set_filter_storage_mode(filter_storage_mode_);
       workers_.push_back(imp);
     }
   }
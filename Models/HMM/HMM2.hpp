@@ -28,12 +28,11 @@
 #include "Models/Policies/CompositeParamPolicy.hpp"
 #include "Models/Policies/PriorPolicy.hpp"
 #include "Models/TimeSeries/TimeSeriesDataPolicy.hpp"
+#include "Models/HMM/HmmFilter.hpp"
 #include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
-  class HmmFilter;
-  class HmmEmFilter;
   class HmmDataImputer;
 
   // A HiddenMarkovModel models one or more time series using a hidden Markov
@@ -70,6 +69,16 @@ namespace BOOM {
     virtual void initialize_params();
     void set_nthreads(uint);
 
+    // Set the amount of the forward recursion stored for the backward pass
+    // of the forward-backward algorithm.  The default is FULL.  MARGINALS
+    // or CHECKPOINT reduce the memory needed for long time series.  See
+    // the comments in HmmFilter.hpp.  The mode applies to the filters used
+    // by any worker threads as well.
+    void set_filter_storage_mode(HmmFilter::StorageMode mode);
+    HmmFilter::StorageMode filter_storage_mode() const {
+      return filter_storage_mode_;
+    }
+
     double pdf(const Ptr<Data> &dp, bool logscale) const;
     void clear_client_data();
 
@@ -111,6 +120,7 @@ namespace BOOM {
     Ptr<MarkovModel> mark_;
     std::vector<Ptr<MixtureComponent>> mix_;
     Ptr<HmmFilter> filter_;
+    HmmFilter::StorageMode filter_storage_mode_;
     std::map<Ptr<Data>, Vector> prob_hist_;
     Ptr<UnivParams> loglike_;
     Ptr<UnivParams> logpost_;
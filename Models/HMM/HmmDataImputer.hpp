@@ -39,6 +39,9 @@ namespace BOOM {
     void setup(HiddenMarkovModel *);
     void clear_client_data();
     void impute_data();
+    void set_filter_storage_mode(HmmFilter::StorageMode mode) {
+      filter_->set_storage_mode(mode);
+    }
 
     friend void intrusive_ptr_add_ref(HmmDataImputer *d) { d->up_count(); }
     friend void intrusive_ptr_release(HmmDataImputer *d) {
@@ -18,6 +18,8 @@
 */
 
 #include "Models/HMM/HmmFilter.hpp"
+#include <algorithm>
+#include <cmath>
 #include "Models/HMM/hmm_tools.hpp"
 #include "cpputil/math_utils.hpp"
 
@@ -56,10 +58,87 @@ namespace BOOM {
         logpi(mix.size()),
         one(mix.size(), 1.0),
         logQ(mix.size(), mix.size()),
-        markov_(mark) {}
+        markov_(mark),
+        storage_mode_(FULL),
+        checkpoint_interval_(1),
+        segment_start_(-1),
+        emission_block_start_(-1) {}
 
   uint HmmFilter::state_space_size() const { return models_.size(); }
 
+  void HmmFilter::set_storage_mode(StorageMode mode) {
+    storage_mode_ = mode;
+    // Release the memory held by the previous mode.
+    std::vector<Matrix>().swap(P);
+    std::vector<Vector>().swap(filtered_);
+    std::vector<Vector>().swap(segment_);
+    segment_start_ = -1;
+  }
+
+  void HmmFilter::compute_log_emission_densities(const Data *dp,
+                                                 Vector &logd) const {
+    uint S = state_space_size();
+    if (logd.size() != S) logd.resize(S);
+    if (dp->missing()) {
+      logd = 0;
+    } else {
+      for (uint s = 0; s < S; ++s) logd[s] = models_[s]->pdf(dp, true);
+    }
+  }
+
+  namespace {
+    // The number of observations whose emission densities are computed
+    // together.  Large enough to amortize the per-component setup cost, and
+    // small enough that the n x S block stays in cache.
+    const int emission_block_size = 256;
+  }  // namespace
+
+  void HmmFilter::load_log_emission_densities(
+      const std::vector<Ptr<Data>> &data, int t, Vector &logd) {
+    if (emission_block_start_ < 0 || t < emission_block_start_ ||
+        t >= emission_block_start_ + static_cast<int>(emission_block_.nrow())) {
+      // Position the block so that t is its first row when moving forward,
+      // or its last row when moving backward.
+      int start = t;
+      if (emission_block_start_ >= 0 && t < emission_block_start_) {
+        start = std::max<int>(0, t - emission_block_size + 1);
+      }
+      int end = std::min<int>(data.size(), start + emission_block_size);
+      fill_log_density_matrix(models_, data, start, end, emission_block_);
+      emission_block_start_ = start;
+    }
+    logd = emission_block_.row(t - emission_block_start_);
+  }
+
+  const Vector &HmmFilter::filtered_distribution(
+      const std::vector<Ptr<Data>> &data, int t) {
+    if (storage_mode_ == MARGINALS) {
+      return filtered_[t];
+    } else if (storage_mode_ == FULL) {
+      report_error(
+          "Filtered distributions are not stored when the HmmFilter storage "
+          "mode is FULL.");
+    }
+    if (segment_start_ < 0 || t < segment_start_ ||
+        t >= segment_start_ + static_cast<int>(segment_.size())) {
+      int checkpoint = t / checkpoint_interval_;
+      segment_start_ = checkpoint * checkpoint_interval_;
+      int segment_end = std::min<int>(data.size(),
+                                      segment_start_ + checkpoint_interval_);
+      segment_.resize(segment_end - segment_start_);
+      segment_[0] = filtered_[checkpoint];
+      Vector logd(state_space_size());
+      Matrix joint(state_space_size(), state_space_size());
+      clear_emission_block();
+      for (int m = 1; m < segment_.size(); ++m) {
+        segment_[m] = segment_[m - 1];
+        load_log_emission_densities(data, segment_start_ + m, logd);
+        fwd_1(segment_[m], joint, logQ, logd, one);
+      }
+    }
+    return segment_[t - segment_start_];
+  }
+
   double HmmFilter::initialize(const Data *dp) {
     uint S = state_space_size();
     pi = markov_->pi0();
@@ -81,15 +160,43 @@ namespace BOOM {
     uint n = dv.size();
     uint S = state_space_size();
     if (logp.size() != S) logp.resize(S);
-    if (P.size() < n) P.resize(n);
+    clear_emission_block();
     double loglike = initialize(dv[0].get());
-    for (uint i = 1; i < n; ++i) {
-      if (dv[i]->missing())
-        logp = 0;
-      else
-        for (uint s = 0; s < S; ++s)
-          logp[s] = models_[s]->pdf(dv[i].get(), true);
-      loglike += fwd_1(pi, P[i], logQ, logp, one);
+    switch (storage_mode_) {
+      case FULL:
+        if (P.size() < n) P.resize(n);
+        for (uint i = 1; i < n; ++i) {
+          load_log_emission_densities(dv, i, logp);
+          loglike += fwd_1(pi, P[i], logQ, logp, one);
+        }
+        break;
+
+      case MARGINALS:
+        filtered_.resize(n);
+        filtered_[0] = pi;
+        for (uint i = 1; i < n; ++i) {
+          load_log_emission_densities(dv, i, logp);
+          loglike += fwd_1(pi, joint_workspace_, logQ, logp, one);
+          filtered_[i] = pi;
+        }
+        break;
+
+      case CHECKPOINT:
+        checkpoint_interval_ = std::max<int>(1, lround(ceil(sqrt(n))));
+        filtered_.resize(1 + (n - 1) / checkpoint_interval_);
+        filtered_[0] = pi;
+        for (uint i = 1; i < n; ++i) {
+          load_log_emission_densities(dv, i, logp);
+          loglike += fwd_1(pi, joint_workspace_, logQ, logp, one);
+          if (i % checkpoint_interval_ == 0) {
+            filtered_[i / checkpoint_interval_] = pi;
+          }
+        }
+        segment_start_ = -1;
+        break;
+
+      default:
+        report_error("Unknown HmmFilter storage mode.");
     }
     return loglike;
   }
@@ -98,24 +205,21 @@ namespace BOOM {
   double HmmFilter::loglike(const std::vector<Ptr<Data>> &dv) {
     logQ = log(markov_->Q());
     pi = markov_->pi0();
-    uint S = pi.size();
     uint n = dv.size();
     Matrix P(logQ);
+    clear_emission_block();
     double ans = initialize(dv[0].get());
     for (uint i = 1; i < n; ++i) {
-      if (dv[i]->missing())
-        logp = 0;
-      else
-        for (uint s = 0; s < S; ++s)
-          logp[s] = models_[s]->pdf(dv[i].get(), true);
+      load_log_emission_densities(dv, i, logp);
       ans += fwd_1(pi, P, logQ, logp, one);
     }
     return ans;
   }
   //------------------------------------------------------------
 
-  void HmmFilter::bkwd_sampling_mt(const std::vector<Ptr<Data>> &data, RNG &rng) {
-    uint sample_size = data.size();
+  void HmmFilter::bkwd_sampling_mt(const std::vector<Ptr<Data>> &data,
+                                   RNG &rng) {
+    int64_t sample_size = data.size();
     std::vector<int> imputed_state(sample_size);
     // pi was already set by fwd.
     // So the following line would  break things when sample_size=1.
@@ -123,13 +227,19 @@ namespace BOOM {
     uint s = rmulti_mt(rng, pi);
     models_[s]->add_data(data.back());
     imputed_state.back() = s;
-    for (int64_t i = sample_size - 1; i >= 0; --i) {
-      pi = P[i].col(s);
+    const Matrix &Q(markov_->Q());
+    uint S = state_space_size();
+    for (int64_t i = sample_size - 1; i > 0; --i) {
+      // Draw h[i - 1] given h[i] = s.
+      if (storage_mode_ == FULL) {
+        pi = P[i].col(s);
+      } else {
+        pi = filtered_distribution(data, i - 1);
+        for (uint r = 0; r < S; ++r) pi[r] *= Q(r, s);
+      }
       pi.normalize_prob();
       uint r = rmulti_mt(rng, pi);
-      if (i > 0) {
-        imputed_state[i - 1] = r;
-      }
+      imputed_state[i - 1] = r;
       models_[r]->add_data(data[i - 1]);
       markov_->suf()->add_transition(r, s);
       s = r;
@@ -147,8 +257,17 @@ namespace BOOM {
     uint s = rmulti(pi);     // last obs in state s
     allocate(dv.back(), s);  // last data point allocated
 
+    const Matrix &Q(markov_->Q());
+    uint S = state_space_size();
     for (uint i = n - 1; i != 0; --i) {  // start with s=h[i]
-      pi = P[i].col(s);                  // compute r = h[i-1]
+      if (storage_mode_ == FULL) {
+        pi = P[i].col(s);  // compute r = h[i-1]
+      } else {
+        // p(h[i-1] = r | h[i] = s, Y) is proportional to
+        // p(h[i-1] = r | Y[i-1]) * Q(r, s).
+        pi = filtered_distribution(dv, i - 1);
+        for (uint r = 0; r < S; ++r) pi[r] *= Q(r, s);
+      }
       uint r = rmulti(pi);
       allocate(dv[i - 1], r);
       markov_->suf()->add_transition(r, s);
@@ -215,6 +334,10 @@ namespace BOOM {
         em_models_(mix) {}
   //------------------------------------------------------------
   void HmmEmFilter::bkwd_smoothing(const std::vector<Ptr<Data>> &dv) {
+    if (storage_mode_ != FULL) {
+      bkwd_smoothing_from_marginals(dv);
+      return;
+    }
     // pi was set by fwd;
     uint n = dv.size();
     uint S = state_space_size();
@@ -232,4 +355,31 @@ namespace BOOM {
     markov_->suf()->add_initial_distribution(pi);
   }
 
+  //------------------------------------------------------------
+  void HmmEmFilter::bkwd_smoothing_from_marginals(
+      const std::vector<Ptr<Data>> &dv) {
+    // pi was set by fwd;
+    uint n = dv.size();
+    uint S = state_space_size();
+    Vector previous_filtered(S);
+    for (uint i = n - 1; i != 0; --i) {
+      for (uint s = 0; s < S; ++s) {
+        em_models_[s]->add_mixture_data(dv[i], pi[s]);
+      }
+      // Rebuild the joint distribution of (h[i-1], h[i]) given Y[i] from
+      // the filtered distribution of h[i-1].
+      previous_filtered = filtered_distribution(dv, i - 1);
+      compute_log_emission_densities(dv[i].get(), logp);
+      fwd_1(previous_filtered, joint_workspace_, logQ, logp, one);
+      markov_->suf()->add_transition_distribution(joint_workspace_);
+      bkwd_1(pi, joint_workspace_, logp, one);
+    }
+    // After the final call to bkwd_1, pi is the smoothed distribution of
+    // h[0].
+    for (uint s = 0; s < S; ++s) {
+      em_models_[s]->add_mixture_data(dv[0], pi[s]);
+    }
+    markov_->suf()->add_initial_distribution(pi);
+  }
+
 }  // namespace BOOM
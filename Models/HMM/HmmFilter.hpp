@@ -40,11 +40,35 @@ namespace BOOM {
       if (d->ref_count() == 0) delete d;
     }
 
+    // Controls how much of the forward recursion is kept for use by the
+    // backward pass, for a series of length n with S states.
+    //
+    //   FULL: The S x S joint distribution of (h[t-1], h[t]) given Y[t] is
+    //     stored for every t.  Memory is O(n * S^2).
+    //   MARGINALS: Only the length S filtered distribution of h[t] given
+    //     Y[t] is stored for every t.  Memory is O(n * S).  Backward
+    //     sampling needs nothing more.  Backward smoothing recomputes the
+    //     emission densities.
+    //   CHECKPOINT: The filtered distribution is stored only every sqrt(n)
+    //     steps.  The backward pass re-runs the forward recursion one
+    //     segment at a time, starting from the checkpoint that begins the
+    //     segment.  Memory is O(sqrt(n) * S), at the cost of a second
+    //     forward pass.
+    //
+    // All three modes produce the same log likelihood, and the same
+    // backward draws and smoothed distributions up to rounding error.
+    enum StorageMode { FULL, MARGINALS, CHECKPOINT };
+
     HmmFilter(const std::vector<Ptr<MixtureComponent>> &mix,
               const Ptr<MarkovModel> &mark);
     ~HmmFilter() override {}
     uint state_space_size() const;
 
+    // Changing the storage mode discards the results of any previous call
+    // to fwd().
+    void set_storage_mode(StorageMode mode);
+    StorageMode storage_mode() const { return storage_mode_; }
+
     double initialize(const Data *);
     double loglike(const std::vector<Ptr<Data>> &);
     double fwd(const std::vector<Ptr<Data>> &);
@@ -58,12 +82,57 @@ namespace BOOM {
     std::vector<int> imputed_state(const std::vector<Ptr<Data>> &data) const;
     
    protected:
+    // Fill 'logd' with the log density of *dp under each mixture component.
+    // Missing data have log density zero.
+    void compute_log_emission_densities(const Data *dp, Vector &logd) const;
+
+    // Fill 'logd' with the log density of data[t] under each mixture
+    // component.  The densities are computed a block of observations at a
+    // time using MixtureComponent::fill_log_density, and cached, so calls
+    // should visit t in (increasing or decreasing) order.  The cache must be
+    // cleared with clear_emission_block() when the data or the model
+    // parameters change.
+    void load_log_emission_densities(const std::vector<Ptr<Data>> &data,
+                                     int t, Vector &logd);
+    void clear_emission_block() { emission_block_start_ = -1; }
+
+    // Returns the filtered distribution of h[t] given Y[t], as computed by
+    // the most recent call to fwd(data).  This is only available if the
+    // storage mode is MARGINALS or CHECKPOINT.  In CHECKPOINT mode the
+    // segment containing t is recomputed if it is not the current segment,
+    // so the backward pass should visit t in decreasing order.
+    const Vector &filtered_distribution(const std::vector<Ptr<Data>> &data,
+                                        int t);
+
     std::vector<Ptr<MixtureComponent>> models_;
     std::vector<Matrix> P;
     Vector pi, logp, logpi, one;
     Matrix logQ;
     Ptr<MarkovModel> markov_;
     std::map<std::vector<Ptr<Data>>, std::vector<int>> imputed_state_map_;
+
+    StorageMode storage_mode_;
+
+    // In MARGINALS mode filtered_[t] is the filtered distribution of h[t].
+    // In CHECKPOINT mode filtered_[j] is the filtered distribution of h[t]
+    // for t = j * checkpoint_interval_.
+    std::vector<Vector> filtered_;
+    int checkpoint_interval_;
+
+    // In CHECKPOINT mode, segment_[m] is the filtered distribution of h[t]
+    // for t = segment_start_ + m.  segment_start_ is -1 if no segment has
+    // been computed since the last call to fwd().
+    std::vector<Vector> segment_;
+    int segment_start_;
+
+    // Workspace for the S x S joint distribution in modes other than FULL.
+    Matrix joint_workspace_;
+
+    // Row i of emission_block_ holds the log emission densities of
+    // data[emission_block_start_ + i].  emission_block_start_ is -1 if the
+    // block is empty.
+    Matrix emission_block_;
+    int emission_block_start_;
   };
   //----------------------------------------------------------------------
   class HmmSavePiFilter : public HmmFilter {
@@ -86,6 +155,10 @@ namespace BOOM {
     virtual void bkwd_smoothing(const std::vector<Ptr<Data>> &);
 
    private:
+    // The implementation of bkwd_smoothing for storage modes other than
+    // FULL.
+    void bkwd_smoothing_from_marginals(const std::vector<Ptr<Data>> &);
+
     std::vector<Ptr<EmMixtureComponent>> em_models_;
   };
 
@@ -7,6 +7,9 @@
 #include "Models/PosteriorSamplers/PoissonGammaSampler.hpp"
 #include "Models/PosteriorSamplers/MarkovConjSampler.hpp"
 #include "Models/HMM/PosteriorSamplers/HmmPosteriorSampler.hpp"
+#include "Models/HMM/HmmFilter.hpp"
+#include "Models/GaussianModel.hpp"
+#include "distributions.hpp"
 
 #include "test_utils/test_utils.hpp"
 #include <fstream>
@@ -52,6 +55,94 @@ namespace {
   TEST_F(HmmTest, Basics) {
   }
 
+  // The low memory storage modes should reproduce the log likelihood and
+  // the backward draws of the full forward-backward algorithm.
+  TEST_F(HmmTest, FilterStorageModesAgree) {
+    std::vector<Ptr<MixtureComponent>> mixture_components;
+    mixture_components.push_back(new PoissonModel(.05));
+    mixture_components.push_back(new PoissonModel(.5));
+    mixture_components.push_back(new PoissonModel(3.0));
+    Matrix Q("0.90 0.08 0.02 | 0.10 0.85 0.05 | 0.20 0.20 0.60");
+    NEW(MarkovModel, mark)(Q);
+
+    std::vector<Ptr<Data>> data;
+    for (int y : lamb_data) {
+      data.push_back(new IntData(y));
+    }
+
+    std::vector<HmmFilter::StorageMode> modes = {
+      HmmFilter::FULL, HmmFilter::MARGINALS, HmmFilter::CHECKPOINT};
+    std::vector<double> loglike;
+    std::vector<std::vector<int>> states;
+    std::vector<Matrix> transition_counts;
+    for (auto mode : modes) {
+      for (auto &component : mixture_components) component->clear_data();
+      mark->clear_data();
+      NEW(HmmFilter, filter)(mixture_components, mark);
+      filter->set_storage_mode(mode);
+      loglike.push_back(filter->fwd(data));
+      RNG rng(12345);
+      filter->bkwd_sampling_mt(data, rng);
+      states.push_back(filter->imputed_state(data));
+      transition_counts.push_back(mark->suf()->trans());
+    }
+
+    for (int m = 1; m < modes.size(); ++m) {
+      EXPECT_DOUBLE_EQ(loglike[0], loglike[m]);
+      EXPECT_EQ(states[0], states[m]);
+      EXPECT_TRUE(MatrixEquals(transition_counts[0], transition_counts[m]));
+    }
+    EXPECT_EQ(lamb_data.size(), states[0].size());
+  }
+
+  TEST_F(HmmTest, EmStorageModesAgree) {
+    // Simulate a two state Gaussian HMM.
+    int sample_size = 500;
+    Vector mu = {-1.0, 2.0};
+    Matrix Q("0.95 0.05 | 0.10 0.90");
+    int state = 0;
+    std::vector<double> y;
+    for (int i = 0; i < sample_size; ++i) {
+      if (i > 0) state = rmulti(Q.row(state));
+      y.push_back(rnorm(mu[state], 1.0));
+    }
+
+    std::vector<Ptr<EmMixtureComponent>> mixture_components;
+    mixture_components.push_back(new GaussianModel(-.5, 1.0));
+    mixture_components.push_back(new GaussianModel(1.0, 1.0));
+    NEW(MarkovModel, mark)(Matrix("0.9 0.1 | 0.1 0.9"));
+    NEW(HMM_EM, model)(mixture_components, mark);
+    for (double yi : y) {
+      model->add_data(new DoubleData(yi));
+    }
+
+    std::vector<HmmFilter::StorageMode> modes = {
+      HmmFilter::FULL, HmmFilter::MARGINALS, HmmFilter::CHECKPOINT};
+    std::vector<double> loglike;
+    std::vector<Vector> component_sums;
+    std::vector<Matrix> transition_counts;
+    for (auto mode : modes) {
+      model->set_filter_storage_mode(mode);
+      EXPECT_EQ(mode, model->filter_storage_mode());
+      loglike.push_back(model->Estep());
+      Ptr<GaussianModel> m0 = mixture_components[0].dcast<GaussianModel>();
+      Ptr<GaussianModel> m1 = mixture_components[1].dcast<GaussianModel>();
+      component_sums.push_back(Vector{m0->suf()->n(), m0->suf()->sum(),
+                                      m1->suf()->n(), m1->suf()->sum()});
+      transition_counts.push_back(mark->suf()->trans());
+    }
+
+    for (int m = 1; m < modes.size(); ++m) {
+      EXPECT_DOUBLE_EQ(loglike[0], loglike[m]);
+      EXPECT_TRUE(VectorEquals(component_sums[0], component_sums[m], 1e-8))
+          << component_sums[0] << "\n" << component_sums[m];
+      EXPECT_TRUE(MatrixEquals(transition_counts[0], transition_counts[m],
+                               1e-8));
+    }
+    EXPECT_NEAR(sample_size, component_sums[0][0] + component_sums[0][2],
+                1e-6);
+  }
+
   TEST_F(HmmTest, Poisson) {
     std::vector<Ptr<PoissonModel>> mixture_components;
     mixture_components.push_back(new PoissonModel(1.0));
@@ -51,16 +51,28 @@ namespace BOOM {
   void HierarchicalGammaSampler::draw() {
     model_->prior_for_mean_parameters()->clear_data();
     model_->prior_for_shape_parameters()->clear_data();
-
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
-      GammaModel *data_model = model_->data_model(i);
-      ensure_posterior_sampling_method(data_model);
-      data_model->sample_posterior();
-      model_->prior_for_mean_parameters()->suf()->update_raw(
-          data_model->mean());
-      model_->prior_for_shape_parameters()->suf()->update_raw(
-          data_model->alpha());
+    int number_of_groups = model_->number_of_groups();
+    for (int i = 0; i < number_of_groups; ++i) {
+      ensure_posterior_sampling_method(model_->data_model(i));
     }
+    int number_of_blocks = group_sweep_.number_of_blocks(number_of_groups);
+    std::vector<Ptr<GammaSuf>> mean_suf = block_sufficient_statistics(
+        model_->prior_for_mean_parameters()->suf(), number_of_blocks);
+    std::vector<Ptr<GammaSuf>> shape_suf = block_sufficient_statistics(
+        model_->prior_for_shape_parameters()->suf(), number_of_blocks);
+    group_sweep_.run(number_of_groups, [this, &mean_suf, &shape_suf](
+        int block, int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        GammaModel *data_model = model_->data_model(i);
+        data_model->sample_posterior();
+        mean_suf[block]->update_raw(data_model->mean());
+        shape_suf[block]->update_raw(data_model->alpha());
+      }
+    });
+    merge_block_sufficient_statistics(
+        mean_suf, model_->prior_for_mean_parameters()->suf());
+    merge_block_sufficient_statistics(
+        shape_suf, model_->prior_for_shape_parameters()->suf());
 
     model_->prior_for_mean_parameters()->sample_posterior();
     model_->prior_for_shape_parameters()->sample_posterior();
@@ -22,6 +22,7 @@
 
 #include "Models/DoubleModel.hpp"
 #include "Models/Hierarchical/HierarchicalGammaModel.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalGroupSweep.hpp"
 #include "Models/PosteriorSamplers/GammaPosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
@@ -62,6 +63,12 @@ namespace BOOM {
     double logpri() const override;
     void draw() override;
 
+    // Draw the group level models using nthreads threads.  If nthreads <= 1
+    // the groups are drawn sequentially.
+    void set_number_of_threads(int nthreads) {
+      group_sweep_.set_number_of_threads(nthreads);
+    }
+
    private:
     // Check that a posterior sampler has been assigned to
     // *data_model.  If not, assign one.
@@ -78,6 +85,8 @@ namespace BOOM {
 
     // Responsible for drawing a_mean and a_shape.
     Ptr<GammaPosteriorSampler> gamma_shape_sampler_;
+
+    HierarchicalGroupSweep group_sweep_;
   };
 
 }  // namespace BOOM
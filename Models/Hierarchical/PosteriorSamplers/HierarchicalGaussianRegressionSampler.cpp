@@ -34,20 +34,34 @@ namespace BOOM {
         residual_variance_prior_(residual_precision_prior),
         residual_variance_sampler_(residual_variance_prior_) {}
 
-  // TODO:  Consider threads here.
   void HGRS::draw() {
-    double sample_size = 0;
-    double residual_sum_of_squares = 0;
     MvnModel *prior = model_->prior();
     prior->clear_data();
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
-      RegressionModel *reg = model_->data_model(i);
-      RegressionCoefficientSampler::sample_regression_coefficients(rng(), reg,
-                                                                   *prior);
-      prior->suf()->update_raw(reg->Beta());
-      sample_size += reg->suf()->n();
-      residual_sum_of_squares += reg->suf()->relative_sse(reg->coef());
-    }
+    int number_of_groups = model_->number_of_groups();
+    int number_of_blocks = group_sweep_.number_of_blocks(number_of_groups);
+    std::vector<Ptr<MvnSuf>> block_suf =
+        block_sufficient_statistics(prior->suf(), number_of_blocks);
+    Vector block_sample_size(number_of_blocks, 0.0);
+    Vector block_residual_sum_of_squares(number_of_blocks, 0.0);
+    // The prior precision is computed on demand and cached.  Compute it here
+    // so the threads in the sweep only read it.
+    prior->siginv();
+    group_sweep_.run(number_of_groups, rng(), [&](
+        int block, int begin, int end, RNG &rng) {
+      for (int i = begin; i < end; ++i) {
+        RegressionModel *reg = model_->data_model(i);
+        RegressionCoefficientSampler::sample_regression_coefficients(
+            rng, reg, *prior);
+        block_suf[block]->update_raw(reg->Beta());
+        block_sample_size[block] += reg->suf()->n();
+        block_residual_sum_of_squares[block] +=
+            reg->suf()->relative_sse(reg->coef());
+      }
+    });
+    merge_block_sufficient_statistics(block_suf, prior->suf());
+    double sample_size = block_sample_size.sum();
+    double residual_sum_of_squares = block_residual_sum_of_squares.sum();
+
     model_->set_residual_variance(residual_variance_sampler_.draw(
         rng(), sample_size, residual_sum_of_squares));
     prior->sample_posterior();
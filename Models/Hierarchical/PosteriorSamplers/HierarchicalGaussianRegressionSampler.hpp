@@ -22,6 +22,7 @@
 
 #include "Models/GammaModel.hpp"
 #include "Models/Hierarchical/HierarchicalGaussianRegressionModel.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalGroupSweep.hpp"
 #include "Models/PosteriorSamplers/GenericGaussianVarianceSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
@@ -36,10 +37,17 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Draw the group level coefficients using nthreads threads.  If nthreads
+    // <= 1 the groups are drawn sequentially.
+    void set_number_of_threads(int nthreads) {
+      group_sweep_.set_number_of_threads(nthreads);
+    }
+
    private:
     HierarchicalGaussianRegressionModel *model_;
     Ptr<GammaModelBase> residual_variance_prior_;
     GenericGaussianVarianceSampler residual_variance_sampler_;
+    HierarchicalGroupSweep group_sweep_;
   };
 
 }  // namespace BOOM
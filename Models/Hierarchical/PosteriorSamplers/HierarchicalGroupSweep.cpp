@@ -0,0 +1,46 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalGroupSweep.hpp"
+#include "distributions/parallel_rng.hpp"
+
+namespace BOOM {
+
+  void HierarchicalGroupSweep::set_number_of_threads(int nthreads) {
+    pool_.set_number_of_threads(nthreads <= 1 ? 0 : nthreads);
+  }
+
+  int HierarchicalGroupSweep::number_of_blocks(int number_of_groups) const {
+    return BOOM::number_of_blocks(pool_, number_of_groups);
+  }
+
+  void HierarchicalGroupSweep::run(
+      int number_of_groups,
+      const std::function<void(int, int, int)> &draw_block) {
+    run_in_blocks(pool_, number_of_groups, draw_block,
+                  "blocks of groups in a hierarchical model");
+  }
+
+  void HierarchicalGroupSweep::run(
+      int number_of_groups, RNG &seeding_rng,
+      const std::function<void(int, int, int, RNG &)> &draw_block) {
+    run_in_blocks(pool_, number_of_groups, seeding_rng, draw_block,
+                  "blocks of groups in a hierarchical model");
+  }
+
+}  // namespace BOOM
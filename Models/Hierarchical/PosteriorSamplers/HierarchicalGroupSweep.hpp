@@ -0,0 +1,135 @@
+#ifndef BOOM_HIERARCHICAL_GROUP_SWEEP_HPP_
+#define BOOM_HIERARCHICAL_GROUP_SWEEP_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <functional>
+#include <vector>
+#include "cpputil/Ptr.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // Draws the data level models in a hierarchical model, which are
+  // conditionally independent given the prior, on a pool of threads.
+  //
+  // The groups are divided into contiguous blocks, one per thread.  Each
+  // block accumulates the data level parameters in its own copy of the
+  // prior's sufficient statistics.  The copies are merged in block order once
+  // every block has finished, before the hyperparameters are drawn.  With no
+  // threads there is a single block, which uses the prior's own sufficient
+  // statistics, so the single-threaded draw is unchanged.
+  //
+  // Data level models that draw with their own samplers' RNGs use the
+  // RNG-free run().  Draws that need the caller's RNG use the other run(),
+  // which hands each block an RNG split from the caller's (or the caller's
+  // RNG itself when there is a single block).
+  //
+  // Typical use from a sampler's draw() method:
+  //   prior->clear_data();
+  //   int nblocks = sweep_.number_of_blocks(model_->number_of_groups());
+  //   std::vector<Ptr<GammaSuf>> sufs = block_sufficient_statistics(
+  //       prior->suf(), nblocks);
+  //   sweep_.run(model_->number_of_groups(),
+  //              [&](int block, int begin, int end) {
+  //                for (int i = begin; i < end; ++i) {
+  //                  model_->data_model(i)->sample_posterior();
+  //                  sufs[block]->update_raw(model_->data_model(i)->lam());
+  //                }
+  //              });
+  //   merge_block_sufficient_statistics(sufs, prior->suf());
+  //   prior->sample_posterior();
+  //
+  // Anything the data level samplers need that is shared across groups (e.g.
+  // posterior samplers assigned on first use) must be set up before run() is
+  // called.
+  class HierarchicalGroupSweep {
+   public:
+    HierarchicalGroupSweep() {}
+
+    // Args:
+    //   nthreads: The number of threads to use.  If nthreads <= 1 the groups
+    //     are drawn sequentially in the calling thread.
+    void set_number_of_threads(int nthreads);
+    int number_of_threads() const { return pool_.number_of_threads(); }
+
+    // The number of blocks that run() will divide number_of_groups groups
+    // into.
+    int number_of_blocks(int number_of_groups) const;
+
+    // Args:
+    //   number_of_groups:  The number of groups in the hierarchical model.
+    //   draw_block: Called once per block as draw_block(block, begin, end),
+    //     where [begin, end) is the range of groups in the block.
+    //
+    // Exceptions thrown by draw_block are collected and reported once all
+    // blocks have finished.
+    void run(int number_of_groups,
+             const std::function<void(int, int, int)> &draw_block);
+
+    // As above, but draw_block also gets an RNG.
+    //
+    // Args:
+    //   seeding_rng: With a single block, this is the RNG passed to
+    //     draw_block.  Otherwise each block gets an RNG split from it.
+    //   draw_block: Called once per block as draw_block(block, begin, end,
+    //     rng).
+    void run(int number_of_groups, RNG &seeding_rng,
+             const std::function<void(int, int, int, RNG &)> &draw_block);
+
+   private:
+    ThreadWorkerPool pool_;
+  };
+
+  // Sufficient statistics for each block of a group sweep.  With a single
+  // block the data are accumulated directly in global_suf.  Otherwise each
+  // block gets an empty copy of global_suf, to be merged back by
+  // merge_block_sufficient_statistics.
+  template <class SUF>
+  std::vector<Ptr<SUF>> block_sufficient_statistics(
+      const Ptr<SUF> &global_suf, int number_of_blocks) {
+    std::vector<Ptr<SUF>> ans;
+    if (number_of_blocks <= 1) {
+      ans.push_back(global_suf);
+      return ans;
+    }
+    ans.reserve(number_of_blocks);
+    for (int i = 0; i < number_of_blocks; ++i) {
+      Ptr<SUF> suf(global_suf->clone());
+      suf->clear();
+      ans.push_back(suf);
+    }
+    return ans;
+  }
+
+  // Add the block sufficient statistics to global_suf, in block order so the
+  // result does not depend on which block finished first.
+  template <class SUF>
+  void merge_block_sufficient_statistics(
+      const std::vector<Ptr<SUF>> &block_sufs, const Ptr<SUF> &global_suf) {
+    for (const Ptr<SUF> &suf : block_sufs) {
+      if (suf != global_suf && suf->n() > 0) {
+        global_suf->combine(*suf);
+      }
+    }
+  }
+
+}  // namespace BOOM
+
+#endif  // BOOM_HIERARCHICAL_GROUP_SWEEP_HPP_
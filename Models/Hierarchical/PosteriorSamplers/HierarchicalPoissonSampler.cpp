@@ -46,26 +46,40 @@ namespace BOOM {
   void HierarchicalPoissonSampler::draw() {
     GammaModel *prior = model_->prior_model();
     prior->clear_data();
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
-      PoissonModel *data_model = model_->data_model(i);
-      if (data_model->number_of_sampling_methods() != 1) {
-        data_model->clear_methods();
-        NEW(PoissonGammaSampler, data_model_sampler)
-        (data_model, Ptr<GammaModel>(prior), rng());
-        data_model->set_method(data_model_sampler);
-      }
-      int number_attempts = 0;
-      do {
-        data_model->sample_posterior();
-        if (++number_attempts > 1000) {
-          report_error(
-              "Too many attempts to draw a positive mean in "
-              "HierarchicalPoissonSampler::draw");
-        }
-      } while (data_model->lam() == 0);
-      prior->suf()->update_raw(data_model->lam());
+    int number_of_groups = model_->number_of_groups();
+    for (int i = 0; i < number_of_groups; ++i) {
+      ensure_posterior_sampling_method(model_->data_model(i));
     }
+    std::vector<Ptr<GammaSuf>> block_suf = block_sufficient_statistics(
+        prior->suf(), group_sweep_.number_of_blocks(number_of_groups));
+    group_sweep_.run(number_of_groups, [this, &block_suf](
+        int block, int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        PoissonModel *data_model = model_->data_model(i);
+        int number_attempts = 0;
+        do {
+          data_model->sample_posterior();
+          if (++number_attempts > 1000) {
+            report_error(
+                "Too many attempts to draw a positive mean in "
+                "HierarchicalPoissonSampler::draw");
+          }
+        } while (data_model->lam() == 0);
+        block_suf[block]->update_raw(data_model->lam());
+      }
+    });
+    merge_block_sufficient_statistics(block_suf, prior->suf());
     prior->sample_posterior();
   }
 
+  void HierarchicalPoissonSampler::ensure_posterior_sampling_method(
+      PoissonModel *data_model) {
+    if (data_model->number_of_sampling_methods() != 1) {
+      data_model->clear_methods();
+      NEW(PoissonGammaSampler, data_model_sampler)
+      (data_model, Ptr<GammaModel>(model_->prior_model()), rng());
+      data_model->set_method(data_model_sampler);
+    }
+  }
+
 }  // namespace BOOM
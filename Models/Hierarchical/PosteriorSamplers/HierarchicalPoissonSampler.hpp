@@ -22,6 +22,7 @@
 
 #include "Models/DoubleModel.hpp"
 #include "Models/Hierarchical/HierarchicalPoissonModel.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalGroupSweep.hpp"
 
 namespace BOOM {
 
@@ -53,10 +54,21 @@ namespace BOOM {
     double logpri() const override;
     void draw() override;
 
+    // Draw the group level models using nthreads threads.  If nthreads <= 1
+    // the groups are drawn sequentially.
+    void set_number_of_threads(int nthreads) {
+      group_sweep_.set_number_of_threads(nthreads);
+    }
+
    private:
+    // Check that a posterior sampler has been assigned to
+    // *data_model.  If not, assign one.
+    void ensure_posterior_sampling_method(PoissonModel *data_model);
+
     HierarchicalPoissonModel *model_;
     Ptr<DoubleModel> gamma_mean_prior_;
     Ptr<DoubleModel> gamma_sample_size_prior_;
+    HierarchicalGroupSweep group_sweep_;
   };
 
 }  // namespace BOOM
@@ -65,18 +65,36 @@ namespace BOOM {
     model_->prior_for_positive_probability()->clear_data();
     model_->prior_for_mean_parameters()->clear_data();
     model_->prior_for_shape_parameters()->clear_data();
-
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
-      ZeroInflatedGammaModel *data_model = model_->data_model(i);
-      ensure_posterior_sampling_method(data_model);
-      data_model->sample_posterior();
-      model_->prior_for_positive_probability()->suf()->update_raw(
-          data_model->positive_probability());
-      model_->prior_for_mean_parameters()->suf()->update_raw(
-          data_model->mean_parameter());
-      model_->prior_for_shape_parameters()->suf()->update_raw(
-          data_model->shape_parameter());
+    int number_of_groups = model_->number_of_groups();
+    for (int i = 0; i < number_of_groups; ++i) {
+      ensure_posterior_sampling_method(model_->data_model(i));
     }
+    int number_of_blocks = group_sweep_.number_of_blocks(number_of_groups);
+    std::vector<Ptr<BetaSuf>> positive_probability_suf =
+        block_sufficient_statistics(
+            model_->prior_for_positive_probability()->suf(), number_of_blocks);
+    std::vector<Ptr<GammaSuf>> mean_suf = block_sufficient_statistics(
+        model_->prior_for_mean_parameters()->suf(), number_of_blocks);
+    std::vector<Ptr<GammaSuf>> shape_suf = block_sufficient_statistics(
+        model_->prior_for_shape_parameters()->suf(), number_of_blocks);
+    group_sweep_.run(number_of_groups, [&](
+        int block, int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        ZeroInflatedGammaModel *data_model = model_->data_model(i);
+        data_model->sample_posterior();
+        positive_probability_suf[block]->update_raw(
+            data_model->positive_probability());
+        mean_suf[block]->update_raw(data_model->mean_parameter());
+        shape_suf[block]->update_raw(data_model->shape_parameter());
+      }
+    });
+    merge_block_sufficient_statistics(
+        positive_probability_suf,
+        model_->prior_for_positive_probability()->suf());
+    merge_block_sufficient_statistics(
+        mean_suf, model_->prior_for_mean_parameters()->suf());
+    merge_block_sufficient_statistics(
+        shape_suf, model_->prior_for_shape_parameters()->suf());
 
     model_->prior_for_positive_probability()->sample_posterior();
     model_->prior_for_mean_parameters()->sample_posterior();
@@ -52,31 +52,43 @@ namespace BOOM {
 
     BetaModel *zero_probability_prior = model_->prior_for_zero_probability();
     zero_probability_prior->clear_data();
-
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
+    int number_of_groups = model_->number_of_groups();
+    for (int i = 0; i < number_of_groups; ++i) {
       ZeroInflatedPoissonModel *data_level_model = model_->data_model(i);
       if (data_level_model->number_of_sampling_methods() == 0) {
         NEW(ZeroInflatedPoissonSampler, sampler)
         (data_level_model, lambda_prior, zero_probability_prior, rng());
         data_level_model->set_method(sampler);
       }
-      data_level_model->sample_posterior();
-      double lambda = data_level_model->lambda();
-      if (lambda <= 0.0) {
-        report_error("Data level model had zero value for lambda.");
-      }
-      lambda_prior->suf()->update_raw(lambda);
-
-      double zero_probability = data_level_model->zero_probability();
-      if (zero_probability <= 0.0) {
-        report_error("data level model had a zero_probability of zero.");
-      } else if (zero_probability >= 1.0) {
-        report_error("data_level_model had a zero_probability of 1.0");
-      }
-      zero_probability_prior->suf()->update_raw(
-          data_level_model->zero_probability());
     }
-
+    int number_of_blocks = group_sweep_.number_of_blocks(number_of_groups);
+    std::vector<Ptr<GammaSuf>> lambda_suf =
+        block_sufficient_statistics(lambda_prior->suf(), number_of_blocks);
+    std::vector<Ptr<BetaSuf>> zero_probability_suf =
+        block_sufficient_statistics(zero_probability_prior->suf(),
+                                    number_of_blocks);
+    group_sweep_.run(number_of_groups, [&](
+        int block, int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        ZeroInflatedPoissonModel *data_level_model = model_->data_model(i);
+        data_level_model->sample_posterior();
+        double lambda = data_level_model->lambda();
+        if (lambda <= 0.0) {
+          report_error("Data level model had zero value for lambda.");
+        }
+        lambda_suf[block]->update_raw(lambda);
+        double zero_probability = data_level_model->zero_probability();
+        if (zero_probability <= 0.0) {
+          report_error("data level model had a zero_probability of zero.");
+        } else if (zero_probability >= 1.0) {
+          report_error("data_level_model had a zero_probability of 1.0");
+        }
+        zero_probability_suf[block]->update_raw(zero_probability);
+      }
+    });
+    merge_block_sufficient_statistics(lambda_suf, lambda_prior->suf());
+    merge_block_sufficient_statistics(zero_probability_suf,
+                                      zero_probability_prior->suf());
     lambda_prior_sampler_.draw();
     zero_probability_prior_sampler_.draw();
   }
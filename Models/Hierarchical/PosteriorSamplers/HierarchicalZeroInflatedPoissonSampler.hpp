@@ -22,6 +22,7 @@
 
 #include "Models/DoubleModel.hpp"
 #include "Models/Hierarchical/HierarchicalZeroInflatedPoissonModel.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalGroupSweep.hpp"
 #include "Models/PosteriorSamplers/BetaPosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/GammaPosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
@@ -43,6 +44,12 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Draw the group level models using nthreads threads.  If nthreads <= 1
+    // the groups are drawn sequentially.
+    void set_number_of_threads(int nthreads) {
+      group_sweep_.set_number_of_threads(nthreads);
+    }
+
    private:
     HierarchicalZeroInflatedPoissonModel *model_;
     Ptr<DoubleModel> lambda_mean_prior_;
@@ -52,6 +59,7 @@ namespace BOOM {
 
     GammaPosteriorSamplerBeta lambda_prior_sampler_;
     BetaPosteriorSampler zero_probability_prior_sampler_;
+    HierarchicalGroupSweep group_sweep_;
   };
 
 }  // namespace BOOM
@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+#include "Models/Hierarchical/HierarchicalPoissonModel.hpp"
+#include "Models/Hierarchical/HierarchicalGaussianRegressionModel.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalPoissonSampler.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalGaussianRegressionSampler.hpp"
+#include "Models/ChisqModel.hpp"
+#include "Models/GammaModel.hpp"
+#include "Models/MvnModel.hpp"
+#include "Models/PosteriorSamplers/MvnConjSampler.hpp"
+
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class HierarchicalSamplerTest : public ::testing::Test {
+   protected:
+    HierarchicalSamplerTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  Ptr<HierarchicalPoissonModel> SimulatePoissonModel(int number_of_groups) {
+    RNG rng(12345);
+    NEW(HierarchicalPoissonModel, model)(3.0, 2.0);
+    for (int i = 0; i < number_of_groups; ++i) {
+      double exposure = 1 + rpois_mt(rng, 10);
+      double lambda = rgamma_mt(rng, 2.0, 2.0 / 3.0);
+      NEW(HierarchicalPoissonData, data_point)(
+          rpois_mt(rng, lambda * exposure), exposure);
+      model->add_data(data_point);
+    }
+    return model;
+  }
+
+  Ptr<HierarchicalPoissonSampler> AssignPoissonSampler(
+      HierarchicalPoissonModel *model, int nthreads, RNG &seeding_rng) {
+    NEW(GammaModel, mean_prior)(1.0, 1.0);
+    NEW(GammaModel, sample_size_prior)(1.0, 1.0);
+    NEW(HierarchicalPoissonSampler, sampler)(
+        model, mean_prior, sample_size_prior, seeding_rng);
+    sampler->set_number_of_threads(nthreads);
+    model->set_method(sampler);
+    return sampler;
+  }
+
+  // Each group level model has its own sampler, seeded before the threads
+  // start, so the threaded sweep should match the sequential one up to the
+  // order in which the prior's sufficient statistics are added.
+  TEST_F(HierarchicalSamplerTest, ThreadedPoissonMatchesSequential) {
+    int number_of_groups = 101;
+    Ptr<HierarchicalPoissonModel> sequential_model =
+        SimulatePoissonModel(number_of_groups);
+    Ptr<HierarchicalPoissonModel> threaded_model =
+        SimulatePoissonModel(number_of_groups);
+
+    RNG sequential_seed(31415);
+    AssignPoissonSampler(sequential_model.get(), 1, sequential_seed);
+    RNG threaded_seed(31415);
+    AssignPoissonSampler(threaded_model.get(), 4, threaded_seed);
+
+    sequential_model->sample_posterior();
+    threaded_model->sample_posterior();
+    const GammaSuf &sequential_suf = *sequential_model->prior_model()->suf();
+    const GammaSuf &threaded_suf = *threaded_model->prior_model()->suf();
+    EXPECT_EQ(number_of_groups, threaded_suf.n());
+    EXPECT_NEAR(sequential_suf.sum(), threaded_suf.sum(), 1e-8);
+    EXPECT_NEAR(sequential_suf.sumlog(), threaded_suf.sumlog(), 1e-8);
+    for (int i = 0; i < number_of_groups; ++i) {
+      EXPECT_DOUBLE_EQ(sequential_model->data_model(i)->lam(),
+                       threaded_model->data_model(i)->lam());
+    }
+
+    for (int iteration = 0; iteration < 5; ++iteration) {
+      threaded_model->sample_posterior();
+      EXPECT_EQ(number_of_groups, threaded_model->prior_model()->suf()->n());
+    }
+  }
+
+  Ptr<HierarchicalGaussianRegressionModel> SimulateRegressionModel(
+      int number_of_groups, int sample_size, const Vector &prior_mean,
+      double residual_sd, int nthreads, RNG &seeding_rng) {
+    RNG rng(12345);
+    int xdim = prior_mean.size();
+    SpdMatrix prior_variance(xdim, 0.25);
+    NEW(MvnModel, prior)(prior_mean, prior_variance);
+    NEW(MvnConjSampler, prior_sampler)(
+        prior.get(), Vector(xdim, 0.0), 1.0, SpdMatrix(xdim, 1.0), xdim + 1,
+        seeding_rng);
+    prior->set_method(prior_sampler);
+
+    NEW(HierarchicalGaussianRegressionModel, model)(prior);
+    for (int g = 0; g < number_of_groups; ++g) {
+      Vector beta = rmvn_mt(rng, prior_mean, prior_variance);
+      NEW(RegressionModel, group)(xdim);
+      for (int i = 0; i < sample_size; ++i) {
+        Vector x(xdim);
+        x.randomize_gaussian(0, 1, rng);
+        x[0] = 1.0;
+        double y = beta.dot(x) + rnorm_mt(rng, 0, residual_sd);
+        group->add_data(new RegressionData(y, x));
+      }
+      model->add_model(group);
+    }
+
+    NEW(ChisqModel, residual_precision_prior)(1.0, residual_sd);
+    NEW(HierarchicalGaussianRegressionSampler, sampler)(
+        model.get(), residual_precision_prior, seeding_rng);
+    sampler->set_number_of_threads(nthreads);
+    model->set_method(sampler);
+    return model;
+  }
+
+  TEST_F(HierarchicalSamplerTest, ThreadedRegressionIsReproducible) {
+    Vector prior_mean{1.0, -2.0, 0.5};
+    double residual_sd = 0.7;
+    RNG first_seed(2718);
+    Ptr<HierarchicalGaussianRegressionModel> first = SimulateRegressionModel(
+        40, 25, prior_mean, residual_sd, 3, first_seed);
+    RNG second_seed(2718);
+    Ptr<HierarchicalGaussianRegressionModel> second = SimulateRegressionModel(
+        40, 25, prior_mean, residual_sd, 3, second_seed);
+
+    int niter = 200;
+    Matrix prior_mean_draws(niter, prior_mean.size());
+    Vector residual_sd_draws(niter);
+    for (int i = 0; i < niter; ++i) {
+      first->sample_posterior();
+      second->sample_posterior();
+      EXPECT_EQ(40, first->prior()->suf()->n());
+      EXPECT_TRUE(VectorEquals(first->prior()->mu(), second->prior()->mu()));
+      EXPECT_DOUBLE_EQ(first->residual_variance(),
+                       second->residual_variance());
+      prior_mean_draws.row(i) = first->prior()->mu();
+      residual_sd_draws[i] = sqrt(first->residual_variance());
+    }
+
+    for (int j = 0; j < prior_mean.size(); ++j) {
+      EXPECT_TRUE(CheckMcmcVector(prior_mean_draws.col(j), prior_mean[j], .99))
+          << "Prior mean " << j;
+    }
+    EXPECT_TRUE(CheckMcmcVector(residual_sd_draws, residual_sd, .99));
+  }
+
+}  // namespace
@@ -0,0 +1,212 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/IRT/IrtBlockedGibbsSampler.hpp"
+#include <sstream>
+#include "Models/IRT/SubjectPrior.hpp"
+#include "Samplers/SliceSampler.hpp"
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions/parallel_rng.hpp"
+
+namespace BOOM {
+  namespace IRT {
+
+    typedef IrtBlockedGibbsSampler IBGS;
+
+    IBGS::IrtBlockedGibbsSampler(IrtModel *model,
+                                 const Ptr<MvnModel> &item_prior,
+                                 RNG &seeding_rng)
+        : PosteriorSampler(seeding_rng),
+          model_(model),
+          default_item_prior_(item_prior) {}
+
+    void IBGS::set_number_of_threads(int nthreads) {
+      pool_.set_number_of_threads(nthreads <= 1 ? 0 : nthreads);
+    }
+
+    void IBGS::set_item_prior(const Ptr<Item> &item,
+                              const Ptr<MvnModel> &prior) {
+      item_priors_[item.get()] = prior;
+      responses_.reset();
+    }
+
+    MvnModel *IBGS::item_prior(const Item *item) const {
+      auto it = item_priors_.find(item);
+      if (it != item_priors_.end()) {
+        return it->second.get();
+      }
+      return default_item_prior_.get();
+    }
+
+    void IBGS::refresh_responses() {
+      responses_.reset(new ResponseMatrix(*model_));
+      int nitems = responses_->number_of_items();
+      items_.resize(nitems);
+      priors_.resize(nitems);
+      subscales_.resize(nitems);
+      for (int i = 0; i < nitems; ++i) {
+        const Ptr<Item> &item = responses_->item(i);
+        items_[i] = dynamic_cast<PartialCreditModel *>(item.get());
+        if (!items_[i]) {
+          std::ostringstream err;
+          err << "Item " << item->id() << " is not a PartialCreditModel.  "
+              << "IrtBlockedGibbsSampler only handles partial credit items.";
+          report_error(err.str());
+        }
+        priors_[i] = item_prior(item.get());
+        if (!priors_[i] || priors_[i]->dim() != items_[i]->beta().size()) {
+          std::ostringstream err;
+          err << "Item " << item->id() << " has " << items_[i]->beta().size()
+              << " coefficients, but ";
+          if (priors_[i]) {
+            err << "its prior has dimension " << priors_[i]->dim() << ".";
+          } else {
+            err << "it has no prior.";
+          }
+          report_error(err.str());
+        }
+        subscales_[i] = items_[i]->which_subscale();
+      }
+    }
+
+    void IBGS::ensure_responses() {
+      if (!responses_ ||
+          responses_->number_of_subjects() != model_->nsubjects() ||
+          responses_->number_of_items() != model_->nitems()) {
+        refresh_responses();
+      }
+    }
+
+    void IBGS::draw() {
+      draw_subjects();
+      draw_items();
+    }
+
+    void IBGS::draw_subjects() {
+      ensure_responses();
+      Ptr<SubjectPrior> prior = model_->subject_prior();
+      if (!prior) {
+        report_error("IrtBlockedGibbsSampler needs a subject prior.");
+      }
+      int nsubjects = responses_->number_of_subjects();
+      if (nsubjects == 0) return;
+
+      // Item coefficients and the prior's precision are computed on demand
+      // and cached.  Compute them here so the threads only read them.
+      std::vector<Vector> betas;
+      betas.reserve(items_.size());
+      for (const PartialCreditModel *item : items_) {
+        betas.push_back(item->beta());
+      }
+      prior->pdf(responses_->subject(0), true);
+
+      run_in_blocks(nsubjects, [this, &prior, &betas](
+          int begin, int end, RNG &rng) {
+        int s = begin;
+        SliceSampler sampler([this, &prior, &betas, &s](const Vector &theta) {
+          const Ptr<Subject> &subject(responses_->subject(s));
+          subject->set_Theta(theta);
+          double ans = prior->pdf(subject, true);
+          if (ans == negative_infinity()) return ans;
+          for (int k = responses_->row_begin(s); k < responses_->row_end(s);
+               ++k) {
+            int i = responses_->item_in_row(k);
+            ans += items_[i]->log_response_prob(
+                responses_->response_in_row(k), theta[subscales_[i]],
+                betas[i]);
+          }
+          return ans;
+        });
+        sampler.set_rng(&rng, false);
+        for (; s < end; ++s) {
+          const Ptr<Subject> &subject(responses_->subject(s));
+          subject->set_Theta(sampler.draw(subject->Theta()));
+        }
+      });
+    }
+
+    void IBGS::draw_items() {
+      ensure_responses();
+      int nitems = responses_->number_of_items();
+      int nsubjects = responses_->number_of_subjects();
+      if (nitems == 0 || nsubjects == 0) return;
+
+      // Copy the abilities out of the subjects, so the threads read
+      // contiguous memory.
+      Matrix theta(nsubjects, model_->nscales());
+      for (int s = 0; s < nsubjects; ++s) {
+        theta.row(s) = responses_->subject(s)->Theta();
+      }
+      // Compute the cached precision of each prior before the threads start.
+      for (int i = 0; i < nitems; ++i) {
+        priors_[i]->logp(items_[i]->beta());
+      }
+
+      run_in_blocks(nitems, [this, &theta](int begin, int end, RNG &rng) {
+        int i = begin;
+        SliceSampler sampler([this, &theta, &i](const Vector &beta) {
+          // The last element of beta is the discrimination parameter 'a',
+          // which must be positive.
+          if (beta.back() <= 0) return negative_infinity();
+          double ans = priors_[i]->logp(beta);
+          if (ans == negative_infinity()) return ans;
+          for (int k = responses_->column_begin(i);
+               k < responses_->column_end(i); ++k) {
+            ans += items_[i]->log_response_prob(
+                responses_->response_in_column(k),
+                theta(responses_->subject_in_column(k), subscales_[i]), beta);
+          }
+          return ans;
+        });
+        sampler.set_rng(&rng, false);
+        for (; i < end; ++i) {
+          items_[i]->set_beta(sampler.draw(items_[i]->beta()));
+          items_[i]->sync_params();
+        }
+      });
+    }
+
+    double IBGS::logpri() const {
+      double ans = 0;
+      for (ItemItC it = model_->item_begin(); it != model_->item_end(); ++it) {
+        const MvnModel *prior = item_prior(it->get());
+        if (prior) ans += prior->logp((*it)->beta());
+      }
+      Ptr<SubjectPrior> subject_prior = model_->subject_prior();
+      if (!!subject_prior) {
+        for (CSI it = model_->subject_begin(); it != model_->subject_end();
+             ++it) {
+          ans += subject_prior->pdf(*it, true);
+        }
+      }
+      return ans;
+    }
+
+    void IBGS::run_in_blocks(
+        int n, const std::function<void(int, int, RNG &)> &draw_block) {
+      BOOM::run_in_blocks(
+          pool_, n, rng(),
+          [&draw_block](int block, int begin, int end, RNG &block_rng) {
+            draw_block(begin, end, block_rng);
+          },
+          "blocks of the IRT blocked Gibbs sampler");
+    }
+
+  }  // namespace IRT
+}  // namespace BOOM
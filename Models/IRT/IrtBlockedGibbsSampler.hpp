@@ -0,0 +1,113 @@
+#ifndef BOOM_IRT_BLOCKED_GIBBS_SAMPLER_HPP
+#define BOOM_IRT_BLOCKED_GIBBS_SAMPLER_HPP
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+#include "Models/IRT/IrtModel.hpp"
+#include "Models/IRT/PartialCreditModel.hpp"
+#include "Models/IRT/ResponseMatrix.hpp"
+#include "Models/MvnModel.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+
+namespace BOOM {
+  namespace IRT {
+
+    // A blocked Gibbs sampler for an IrtModel whose items are
+    // PartialCreditModels.  Subjects are conditionally independent given the
+    // items, and items are conditionally independent given the subjects, so
+    // each draw updates all the subjects in parallel, then all the items in
+    // parallel.  Subjects and items are divided into contiguous blocks, one
+    // per thread, and each block has its own RNG and slice sampler.
+    //
+    // The responses are read from a ResponseMatrix built on the first call to
+    // draw(), rather than from the maps in each Subject.  The matrix is
+    // rebuilt if the number of subjects or items in the model changes.  Call
+    // refresh_responses() after adding responses to existing subjects.
+    //
+    // The parameters of the subject prior are not drawn here.  If they are to
+    // be learned they need a sampler of their own.
+    class IrtBlockedGibbsSampler : public PosteriorSampler {
+     public:
+      // Args:
+      //   model: The model to be sampled.  All its items must be
+      //     PartialCreditModels, and it must have a subject prior.
+      //   item_prior: The prior distribution on the coefficients (beta) of
+      //     each item.  It is used for every item whose beta has the same
+      //     dimension, unless the item is given its own prior by
+      //     set_item_prior.
+      //   seeding_rng: The random number generator used to set the seed for
+      //     this object.
+      IrtBlockedGibbsSampler(IrtModel *model,
+                             const Ptr<MvnModel> &item_prior,
+                             RNG &seeding_rng = GlobalRng::rng);
+
+      void draw() override;
+      double logpri() const override;
+
+      // The two halves of draw().
+      void draw_subjects();
+      void draw_items();
+
+      // Args:
+      //   nthreads: The number of threads to use.  If nthreads <= 1 the
+      //     subjects and items are drawn sequentially in the calling thread.
+      void set_number_of_threads(int nthreads);
+
+      // Use 'prior' as the prior on the coefficients of 'item' in place of
+      // the default item prior.
+      void set_item_prior(const Ptr<Item> &item, const Ptr<MvnModel> &prior);
+
+      // Rebuild the response matrix from the model's current data.
+      void refresh_responses();
+
+     private:
+      // Build the response matrix if it does not exist or the model has
+      // changed size.
+      void ensure_responses();
+
+      // The prior for an item's coefficients.
+      MvnModel *item_prior(const Item *item) const;
+
+      // Divide [0, n) into one contiguous block per thread and call
+      // draw_block(begin, end, rng) for each block.
+      void run_in_blocks(int n,
+                         const std::function<void(int, int, RNG &)> &draw_block);
+
+      IrtModel *model_;
+      Ptr<MvnModel> default_item_prior_;
+      std::map<const Item *, Ptr<MvnModel>> item_priors_;
+
+      std::unique_ptr<ResponseMatrix> responses_;
+
+      // The following are indexed the same way as the items in responses_.
+      std::vector<PartialCreditModel *> items_;
+      std::vector<MvnModel *> priors_;
+      std::vector<int> subscales_;
+
+      ThreadWorkerPool pool_;
+    };
+
+  }  // namespace IRT
+}  // namespace BOOM
+
+#endif  // BOOM_IRT_BLOCKED_GIBBS_SAMPLER_HPP
@@ -19,10 +19,11 @@
 #include "Models/CategoricalData.hpp"
 #include "Models/IRT/Subject.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
-#include "cpputil/lse.hpp"
+#include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 #include "cpputil/seq.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <stdexcept>
 
@@ -333,12 +334,26 @@ namespace BOOM {
     }
 
     double PCR::response_prob(uint r, const Vector &Theta, bool logsc) const {
-      fill_eta(Theta);
-      double lognc = lse(eta_);
-      double ans = eta_[r] - lognc;
+      double ans = log_response_prob(r, Theta[which_subscale()], beta());
       return logsc ? ans : exp(ans);
     }
 
+    double PCR::log_response_prob(uint r, double theta,
+                                  const Vector &beta) const {
+      // eta[m] = beta[m] + (m + 1) * theta * a, which is X(theta) * beta.
+      uint M = maxscore();
+      double slope = theta * beta.back();
+      double max_eta = negative_infinity();
+      for (uint m = 0; m <= M; ++m) {
+        max_eta = std::max(max_eta, beta[m] + (m + 1) * slope);
+      }
+      double total = 0;
+      for (uint m = 0; m <= M; ++m) {
+        total += exp(beta[m] + (m + 1) * slope - max_eta);
+      }
+      return beta[r] + (r + 1) * slope - max_eta - log(total);
+    }
+
     std::pair<double, double> PCR::theta_moments() const {
       double mean(0), var(0), n(0);
       for (auto &subject : subjects()) {
@@ -122,6 +122,12 @@ namespace BOOM {
       double response_prob(uint r, const Vector &Theta,
                            bool logsc) const override;
 
+      // The log probability of response r from a subject with ability theta
+      // on this item's subscale, if the item's coefficients were 'beta'.
+      // Unlike fill_eta this uses no workspace, so it can be called from
+      // several threads at once.
+      double log_response_prob(uint r, double theta, const Vector &beta) const;
+
       std::pair<double, double> theta_moments() const;
       // mean and variance of theta's for subjects that were assigned
       // this item
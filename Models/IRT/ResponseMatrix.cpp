@@ -0,0 +1,86 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/IRT/ResponseMatrix.hpp"
+#include <limits>
+#include <map>
+#include <sstream>
+#include "Models/IRT/IrtModel.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+  namespace IRT {
+
+    ResponseMatrix::ResponseMatrix(const IrtModel &model)
+        : subjects_(model.subject_begin(), model.subject_end()),
+          items_(model.item_begin(), model.item_end()) {
+      std::map<const Item *, int> item_index;
+      for (int i = 0; i < items_.size(); ++i) {
+        item_index[items_[i].get()] = i;
+      }
+
+      // Fill the rows, counting the number of responses to each item along
+      // the way.
+      std::vector<int> column_sizes(items_.size(), 0);
+      row_offsets_.reserve(subjects_.size() + 1);
+      row_offsets_.push_back(0);
+      for (const Ptr<Subject> &subject : subjects_) {
+        for (const auto &item_response : subject->item_responses()) {
+          auto it = item_index.find(item_response.first.get());
+          if (it == item_index.end()) {
+            std::ostringstream err;
+            err << "Subject " << subject->id() << " responded to item "
+                << item_response.first->id()
+                << ", which is not part of the model.";
+            report_error(err.str());
+          }
+          uint response = item_response.second->value();
+          if (response > std::numeric_limits<std::uint16_t>::max()) {
+            std::ostringstream err;
+            err << "Response " << response << " to item "
+                << item_response.first->id() << " is too large.";
+            report_error(err.str());
+          }
+          row_items_.push_back(it->second);
+          row_responses_.push_back(response);
+          ++column_sizes[it->second];
+        }
+        row_offsets_.push_back(row_items_.size());
+      }
+
+      // Transpose the rows into columns.  Subjects are visited in order, so
+      // each column lists its subjects in order.
+      column_offsets_.resize(items_.size() + 1);
+      column_offsets_[0] = 0;
+      for (int i = 0; i < items_.size(); ++i) {
+        column_offsets_[i + 1] = column_offsets_[i] + column_sizes[i];
+      }
+      column_subjects_.resize(row_items_.size());
+      column_responses_.resize(row_items_.size());
+      std::vector<int> next(column_offsets_.begin(), column_offsets_.end() - 1);
+      for (int s = 0; s < subjects_.size(); ++s) {
+        for (int k = row_begin(s); k < row_end(s); ++k) {
+          int position = next[row_items_[k]]++;
+          column_subjects_[position] = s;
+          column_responses_[position] = row_responses_[k];
+        }
+      }
+    }
+
+  }  // namespace IRT
+}  // namespace BOOM
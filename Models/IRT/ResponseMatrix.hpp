@@ -0,0 +1,87 @@
+#ifndef BOOM_IRT_RESPONSE_MATRIX_HPP
+#define BOOM_IRT_RESPONSE_MATRIX_HPP
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdint>
+#include <vector>
+#include "Models/IRT/IRT.hpp"
+#include "Models/IRT/Item.hpp"
+#include "Models/IRT/Subject.hpp"
+
+namespace BOOM {
+  namespace IRT {
+
+    // A compact, read-only copy of the responses in an IrtModel, stored as a
+    // sparse subject x item matrix.  The responses are held twice: in
+    // compressed rows (one row per subject, listing the items the subject
+    // answered) and in compressed columns (one column per item, listing the
+    // subjects who answered it).  This avoids the per-subject maps in Subject
+    // when sweeping over all subjects or all items, and it lets a range of
+    // subjects or items be handed to a thread.
+    //
+    // Subjects are indexed in the order of IrtModel::subject_begin(), and
+    // items in the order of IrtModel::item_begin().  Within a row, items
+    // appear in increasing index order, and within a column so do subjects.
+    //
+    // The matrix does not track changes to the model.  It must be rebuilt if
+    // subjects, items, or responses are added.
+    class ResponseMatrix {
+     public:
+      explicit ResponseMatrix(const IrtModel &model);
+
+      int number_of_subjects() const { return subjects_.size(); }
+      int number_of_items() const { return items_.size(); }
+      int number_of_responses() const { return row_items_.size(); }
+
+      const Ptr<Subject> &subject(int s) const { return subjects_[s]; }
+      const Ptr<Item> &item(int i) const { return items_[i]; }
+
+      // The responses of subject s are stored in positions [row_begin(s),
+      // row_end(s)).  Position k holds a response of response_in_row(k) to
+      // item item_in_row(k).
+      int row_begin(int s) const { return row_offsets_[s]; }
+      int row_end(int s) const { return row_offsets_[s + 1]; }
+      int item_in_row(int k) const { return row_items_[k]; }
+      int response_in_row(int k) const { return row_responses_[k]; }
+
+      // The responses to item i are stored in positions [column_begin(i),
+      // column_end(i)).  Position k holds a response of response_in_column(k)
+      // from subject subject_in_column(k).
+      int column_begin(int i) const { return column_offsets_[i]; }
+      int column_end(int i) const { return column_offsets_[i + 1]; }
+      int subject_in_column(int k) const { return column_subjects_[k]; }
+      int response_in_column(int k) const { return column_responses_[k]; }
+
+     private:
+      std::vector<Ptr<Subject>> subjects_;
+      std::vector<Ptr<Item>> items_;
+
+      std::vector<int> row_offsets_;
+      std::vector<int> row_items_;
+      std::vector<std::uint16_t> row_responses_;
+
+      std::vector<int> column_offsets_;
+      std::vector<int> column_subjects_;
+      std::vector<std::uint16_t> column_responses_;
+    };
+
+  }  // namespace IRT
+}  // namespace BOOM
+
+#endif  // BOOM_IRT_RESPONSE_MATRIX_HPP
@@ -0,0 +1,198 @@
+#include "gtest/gtest.h"
+#include "Models/IRT/IrtBlockedGibbsSampler.hpp"
+#include "Models/IRT/IrtModel.hpp"
+#include "Models/IRT/PartialCreditModel.hpp"
+#include "Models/IRT/ResponseMatrix.hpp"
+#include "Models/IRT/Subject.hpp"
+#include "Models/MvnModel.hpp"
+
+#include "cpputil/lse.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+
+#include "test_utils/test_utils.hpp"
+#include <iomanip>
+#include <sstream>
+
+namespace {
+  using namespace BOOM;
+  using namespace BOOM::IRT;
+  using std::endl;
+  using std::cout;
+
+  std::string make_id(const std::string &prefix, int i) {
+    std::ostringstream id;
+    id << prefix << std::setw(4) << std::setfill('0') << i;
+    return id.str();
+  }
+
+  class IrtBlockedGibbsTest : public ::testing::Test {
+   protected:
+    IrtBlockedGibbsTest()
+        : nitems_(20),
+          nsubjects_(400),
+          max_score_(2),
+          true_theta_(nsubjects_) {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // Simulate a model where each subject answers each item with probability
+    // 'response_probability'.  The items are returned to default parameter
+    // values and the subjects to theta = 0 after the responses are
+    // simulated.
+    Ptr<IrtModel> SimulateModel(double response_probability = 1.0) {
+      NEW(IrtModel, model)(1);
+      std::vector<Ptr<PartialCreditModel>> items;
+      for (int i = 0; i < nitems_; ++i) {
+        double a = runif(0.7, 2.0);
+        double b = rnorm(0, 1);
+        double d1 = rnorm(0, .5);
+        Vector d = {0.0, d1, -d1};
+        NEW(PartialCreditModel, item)(make_id("item", i), max_score_, 0, 1,
+                                      a, b, d);
+        items.push_back(item);
+        model->add_item(item);
+      }
+      for (int s = 0; s < nsubjects_; ++s) {
+        true_theta_[s] = rnorm(0, 1);
+        NEW(Subject, subject)(make_id("subject", s),
+                              Vector(1, true_theta_[s]));
+        model->add_subject(subject);
+        for (const auto &item : items) {
+          if (runif(0, 1) < response_probability) {
+            Response r = subject->simulate_response(item);
+            item->add_subject(subject);
+            subject->add_item(item, r);
+          }
+        }
+        subject->set_Theta(Vector(1, 0.0));
+      }
+      for (const auto &item : items) {
+        item->set_a(1.0);
+        item->set_b(0.0);
+        item->set_d(Vector(max_score_ + 1, 0.0));
+      }
+      NEW(MvnModel, subject_prior)(Vector(1, 0.0), SpdMatrix(1, 1.0));
+      model->set_subject_prior(subject_prior);
+      return model;
+    }
+
+    Ptr<MvnModel> ItemPrior() const {
+      return new MvnModel(Vector(max_score_ + 2, 0.0),
+                          SpdMatrix(max_score_ + 2, 4.0));
+    }
+
+    int nitems_;
+    int nsubjects_;
+    int max_score_;
+    Vector true_theta_;
+  };
+
+  TEST_F(IrtBlockedGibbsTest, ResponseMatrixMatchesSubjects) {
+    Ptr<IrtModel> model = SimulateModel(0.6);
+    ResponseMatrix responses(*model);
+    EXPECT_EQ(nsubjects_, responses.number_of_subjects());
+    EXPECT_EQ(nitems_, responses.number_of_items());
+
+    int total = 0;
+    for (int s = 0; s < responses.number_of_subjects(); ++s) {
+      const Ptr<Subject> &subject(responses.subject(s));
+      const ItemResponseMap &item_responses(subject->item_responses());
+      ASSERT_EQ(item_responses.size(),
+                responses.row_end(s) - responses.row_begin(s));
+      for (int k = responses.row_begin(s); k < responses.row_end(s); ++k) {
+        const Ptr<Item> &item(responses.item(responses.item_in_row(k)));
+        EXPECT_EQ(subject->response(item)->value(),
+                  responses.response_in_row(k));
+        if (k > responses.row_begin(s)) {
+          EXPECT_LT(responses.item_in_row(k - 1), responses.item_in_row(k));
+        }
+      }
+      total += item_responses.size();
+    }
+    EXPECT_EQ(total, responses.number_of_responses());
+
+    for (int i = 0; i < responses.number_of_items(); ++i) {
+      const Ptr<Item> &item(responses.item(i));
+      EXPECT_EQ(item->Nsubjects(),
+                responses.column_end(i) - responses.column_begin(i));
+      for (int k = responses.column_begin(i); k < responses.column_end(i);
+           ++k) {
+        const Ptr<Subject> &subject(
+            responses.subject(responses.subject_in_column(k)));
+        EXPECT_EQ(subject->response(item)->value(),
+                  responses.response_in_column(k));
+      }
+    }
+  }
+
+  // log_response_prob should agree with the linear predictor X(theta) * beta.
+  TEST_F(IrtBlockedGibbsTest, ResponseProbabilities) {
+    Vector d = {0.0, 0.3, -0.3};
+    PartialCreditModel item("item", max_score_, 0, 1, 1.3, -0.4, d);
+    Vector theta(1, 0.7);
+    Vector eta = item.fill_eta(theta);
+    double total = 0;
+    for (int r = 0; r <= max_score_; ++r) {
+      EXPECT_NEAR(eta[r] - lse(eta),
+                  item.log_response_prob(r, theta[0], item.beta()), 1e-12);
+      total += item.response_prob(r, theta, false);
+    }
+    EXPECT_NEAR(1.0, total, 1e-12);
+  }
+
+  TEST_F(IrtBlockedGibbsTest, ThreadedDrawsAreReproducible) {
+    Ptr<IrtModel> model1 = SimulateModel(0.8);
+    GlobalRng::rng.seed(8675309);
+    Ptr<IrtModel> model2 = SimulateModel(0.8);
+
+    RNG seed1(31415);
+    IrtBlockedGibbsSampler sampler1(model1.get(), ItemPrior(), seed1);
+    sampler1.set_number_of_threads(3);
+    RNG seed2(31415);
+    IrtBlockedGibbsSampler sampler2(model2.get(), ItemPrior(), seed2);
+    sampler2.set_number_of_threads(3);
+
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      sampler1.draw();
+      sampler2.draw();
+    }
+    CSI s2 = model2->subject_begin();
+    for (CSI s1 = model1->subject_begin(); s1 != model1->subject_end();
+         ++s1, ++s2) {
+      EXPECT_TRUE(VectorEquals((*s1)->Theta(), (*s2)->Theta()));
+    }
+    ItemItC i2 = model2->item_begin();
+    for (ItemItC i1 = model1->item_begin(); i1 != model1->item_end();
+         ++i1, ++i2) {
+      EXPECT_TRUE(VectorEquals((*i1)->beta(), (*i2)->beta()));
+    }
+  }
+
+  TEST_F(IrtBlockedGibbsTest, RecoversAbilities) {
+    Ptr<IrtModel> model = SimulateModel();
+    IrtBlockedGibbsSampler sampler(model.get(), ItemPrior());
+    sampler.set_number_of_threads(4);
+    EXPECT_TRUE(std::isfinite(sampler.logpri()));
+
+    int burn = 100;
+    int niter = 200;
+    for (int i = 0; i < burn; ++i) {
+      sampler.draw();
+    }
+    Vector theta_sum(nsubjects_, 0.0);
+    for (int i = 0; i < niter; ++i) {
+      sampler.draw();
+      int s = 0;
+      for (CSI it = model->subject_begin(); it != model->subject_end(); ++it) {
+        theta_sum[s++] += (*it)->Theta()[0];
+      }
+    }
+    Vector posterior_mean = theta_sum / niter;
+    EXPECT_GT(cor(posterior_mean, true_theta_), .85);
+    for (ItemItC it = model->item_begin(); it != model->item_end(); ++it) {
+      EXPECT_GT((*it)->beta().back(), 0.0);
+    }
+  }
+
+}  // namespace
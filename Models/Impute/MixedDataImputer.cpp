@@ -20,6 +20,7 @@
 #include "distributions.hpp"
 #include "cpputil/lse.hpp"
 #include "Models/PosteriorSamplers/MultinomialDirichletSampler.hpp"
+#include <future>
 
 namespace BOOM {
 
@@ -217,6 +218,19 @@ namespace BOOM {
       return atoms_.size();
     }
 
+    void NumericScalarModel::combine_sufficient_statistics(
+        const ScalarModelBase &rhs) {
+      const NumericScalarModel &other(
+          dynamic_cast<const NumericScalarModel &>(rhs));
+      atom_model_->suf()->combine(other.atom_model_->suf());
+    }
+
+    void NumericScalarModel::copy_parameters(const ScalarModelBase &rhs) {
+      const NumericScalarModel &other(
+          dynamic_cast<const NumericScalarModel &>(rhs));
+      atom_model_->set_pi(other.atom_model_->pi());
+    }
+
     double NumericScalarModel::true_value(
         int true_atom, double observed_value) const {
       if (atoms_.empty()) {
@@ -295,17 +309,42 @@ namespace BOOM {
       }
     }
 
+    double CategoricalScalarModel::logp(int level) const {
+      if (level >= 0 && level < model_->dim()) {
+        return model_->logpi()[level];
+      } else {
+        return 0;
+      }
+    }
+
     double CategoricalScalarModel::logp(
         const MixedMultivariateData &data) const {
       const LabeledCategoricalData &scalar(data.categorical(index()));
       if (scalar.missing() != Data::missing_status::observed) {
         // return model_->entropy();
         return 0.0;
+      } else if (scalar.catkey().get() == levels_.get()) {
+        // The integer code is the position of the label in levels_, so the
+        // label lookup can be skipped.
+        return logp(static_cast<int>(scalar.value()));
       } else {
         return logp(scalar.label());
       }
     }
 
+    void CategoricalScalarModel::combine_sufficient_statistics(
+        const ScalarModelBase &rhs) {
+      const CategoricalScalarModel &other(
+          dynamic_cast<const CategoricalScalarModel &>(rhs));
+      model_->suf()->combine(other.model_->suf());
+    }
+
+    void CategoricalScalarModel::copy_parameters(const ScalarModelBase &rhs) {
+      const CategoricalScalarModel &other(
+          dynamic_cast<const CategoricalScalarModel &>(rhs));
+      model_->set_pi(other.model_->pi());
+    }
+
     void CategoricalScalarModel::update_complete_data_suf(int observed_level) {
       model_->suf()->update_raw(observed_level);
     }
@@ -382,6 +421,19 @@ namespace BOOM {
         model->sample_posterior();
       }
     }
+
+    void RowModelBase::combine_sufficient_statistics(const RowModelBase &rhs) {
+      for (size_t i = 0; i < scalar_models_.size(); ++i) {
+        scalar_models_[i]->combine_sufficient_statistics(
+            *rhs.scalar_models_[i]);
+      }
+    }
+
+    void RowModelBase::copy_parameters(const RowModelBase &rhs) {
+      for (size_t i = 0; i < scalar_models_.size(); ++i) {
+        scalar_models_[i]->copy_parameters(*rhs.scalar_models_[i]);
+      }
+    }
     //==========================================================================
     RowModel::RowModel() {}
 
@@ -557,6 +609,10 @@ namespace BOOM {
     set_numeric_data_model_observers();
   }
 
+  MixedDataImputerBase::~MixedDataImputerBase() {
+    shut_down_worker_pool();
+  }
+
   MixedDataImputerBase &MixedDataImputerBase::operator=(
       const MixedDataImputerBase &rhs) {
     if (&rhs != this) {
@@ -613,7 +669,11 @@ namespace BOOM {
     for (int i = 0; i < empirical_distributions_.size(); ++i) {
       empirical_distribution(i).update_cdf();
     }
-    impute_all_rows();
+    if (!workers_.empty()) {
+      impute_all_rows_multithreaded();
+    } else {
+      impute_all_rows();
+    }
     mixing_distribution_->sample_posterior();
     for (int s = 0; s < number_of_mixture_components(); ++s) {
       row_model(s)->sample_posterior();
@@ -621,6 +681,99 @@ namespace BOOM {
     numeric_data_model()->sample_posterior();
   }
 
+  //---------------------------------------------------------------------------
+  void MixedDataImputerBase::setup_worker_pool(int nworkers) {
+    shut_down_worker_pool();
+    if (nworkers <= 0) {
+      return;
+    } else {
+      for (int i = 0; i < nworkers; ++i) {
+        // Workers don't sample their own parameters, so no need to set priors
+        // on workers.
+        workers_.push_back(clone());
+      }
+      thread_pool_.set_number_of_threads(nworkers);
+    }
+  }
+
+  void MixedDataImputerBase::shut_down_worker_pool() {
+    thread_pool_.set_number_of_threads(0);
+    workers_.clear();
+  }
+
+  void MixedDataImputerBase::impute_all_rows_multithreaded() {
+    ensure_data_distribution();
+    broadcast_parameters();
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      MixedDataImputerBase *worker = workers_[i].get();
+      futures.emplace_back(thread_pool_.submit(
+          [worker]() {
+            worker->impute_all_rows();
+          }));
+    }
+    for (size_t i = 0; i < futures.size(); ++i) {
+      futures[i].get();
+    }
+    reduce_sufficient_statistics();
+  }
+
+  void MixedDataImputerBase::ensure_data_distribution() {
+    size_t nobs = 0;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      nobs += workers_[i]->complete_data_.size();
+    }
+    if (nobs != complete_data_.size()) {
+      distribute_data_to_workers();
+    }
+  }
+
+  // Each row is handed to exactly one worker, so workers never write to the
+  // same CompleteData object.
+  void MixedDataImputerBase::distribute_data_to_workers() {
+    size_t data_per_worker = complete_data_.size() / workers_.size();
+    auto b = complete_data_.begin();
+    auto e = complete_data_.end();
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      workers_[i]->complete_data_.clear();
+      if (i + 1 == workers_.size()) {
+        std::copy(b, e, std::back_inserter(workers_[i]->complete_data_));
+      } else {
+        std::copy(b, b + data_per_worker,
+                  std::back_inserter(workers_[i]->complete_data_));
+        b += data_per_worker;
+      }
+      workers_[i]->empirical_distributions_ = empirical_distributions_;
+    }
+  }
+
+  void MixedDataImputerBase::broadcast_parameters() {
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      workers_[i]->numeric_data_model_->set_Beta(numeric_data_model_->Beta());
+      workers_[i]->numeric_data_model_->set_Sigma(
+          numeric_data_model_->Sigma());
+      workers_[i]->mixing_distribution_->set_pi(mixing_distribution_->pi());
+      for (int s = 0; s < number_of_mixture_components(); ++s) {
+        workers_[i]->row_model(s)->copy_parameters(*row_model(s));
+      }
+    }
+  }
+
+  void MixedDataImputerBase::reduce_sufficient_statistics() {
+    clear_client_data();
+    for (size_t worker = 0; worker < workers_.size(); ++worker) {
+      numeric_data_model_->suf()->combine(
+          workers_[worker]->numeric_data_model_->suf());
+      mixing_distribution_->suf()->combine(
+          workers_[worker]->mixing_distribution_->suf());
+      for (int s = 0; s < number_of_mixture_components(); ++s) {
+        row_model(s)->combine_sufficient_statistics(
+            *workers_[worker]->row_model(s));
+      }
+    }
+  }
+
+  //---------------------------------------------------------------------------
   Vector MixedDataImputerBase::ybar() const {
     Vector ans(data_types_.number_of_numeric_fields());
     int index = 0;
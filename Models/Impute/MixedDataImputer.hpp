@@ -22,7 +22,7 @@
 #include "stats/Encoders.hpp"
 #include "stats/summary.hpp"
 #include "Models/Impute/MvRegCopulaDataImputer.hpp"
-
+#include "cpputil/ThreadTools.hpp"
 namespace BOOM {
 
   namespace MixedImputation {
@@ -149,6 +149,15 @@ namespace BOOM {
       // The type of variable the scalar model describes.
       virtual VariableType variable_type() const = 0;
 
+      // Add the complete data sufficient statistics of 'rhs' to those of this
+      // model.  'rhs' must be a model of the same type.  This is how the work
+      // of several imputation threads is combined.
+      virtual void combine_sufficient_statistics(
+          const ScalarModelBase &rhs) = 0;
+
+      // Set the parameters of this model to those of 'rhs', which must be a
+      // model of the same type.
+      virtual void copy_parameters(const ScalarModelBase &rhs) = 0;
      private:
       int index_;
     };
@@ -188,10 +197,13 @@ namespace BOOM {
 
       void sample_posterior() override {atom_model_->sample_posterior();}
       double logpri() const override {return atom_model_->logpri();}
+      void clear_data() override {atom_model_->clear_data();}
       VariableType variable_type() const override {
         return VariableType::numeric;
       }
 
+      void combine_sufficient_statistics(const ScalarModelBase &rhs) override;
+      void copy_parameters(const ScalarModelBase &rhs) override;
       // Return the atom responsible for the observed value.  If the observed
       // value is missing then impute using the atom_model_.
       int impute_atom(double observed_value, RNG &rhg, bool update);
@@ -241,8 +253,12 @@ namespace BOOM {
 
       double logp(const std::string &label) const;
       double logp(const MixedMultivariateData &data) const override;
-      const Vector &log_probs() const {return model_->logpi();}
 
+      // The log probability of the level with integer code 'level' in the
+      // level key.  Codes outside the key have log probability 0, matching
+      // the treatment of unrecognized labels.
+      double logp(int level) const;
+      const Vector &log_probs() const {return model_->logpi();}
       void sample_posterior() override {model_->sample_posterior();}
       double logpri() const override {return model_->logpri();}
       void clear_data() override {model_->clear_data();}
@@ -250,8 +266,10 @@ namespace BOOM {
         return VariableType::categorical;
       }
 
-      void update_complete_data_suf(int observed_level);
+      void combine_sufficient_statistics(const ScalarModelBase &rhs) override;
+      void copy_parameters(const ScalarModelBase &rhs) override;
 
+      void update_complete_data_suf(int observed_level);
       void set_conjugate_prior(const Vector &counts);
       const Vector &level_probs() const { return model_->pi(); }
       void set_level_probs(const Vector &probs) {
@@ -262,12 +280,13 @@ namespace BOOM {
       // The set of levels observed in the data.
       Ptr<CatKey> levels_;
 
-      // A mapping between level labels and numeric index values.
+      // A mapping between level labels and numeric index values.  Data
+      // sharing the levels_ key are looked up by their integer codes, so this
+      // map is only consulted for data encoded with a different key.
       //
       // The atom index may also contain a missing data symbol.  If so it will
       // be associated to the value -1.
       std::map<std::string, int> atom_index_;
-
       // The marginal distribution of the data.
       Ptr<MultinomialModel> model_;
 
@@ -302,6 +321,14 @@ namespace BOOM {
       void clear_data() override;
       void sample_posterior() override;
 
+      // Add the complete data sufficient statistics of each scalar model in
+      // 'rhs' to the corresponding model here.  'rhs' must have the same
+      // structure as this object, e.g. because it is a clone.
+      void combine_sufficient_statistics(const RowModelBase &rhs);
+
+      // Set the parameters of each scalar model to those of the corresponding
+      // model in 'rhs', which must have the same structure as this object.
+      void copy_parameters(const RowModelBase &rhs);
       // For numeric variables, impute the latent variables indicating which
       // atom is responsible for each variable.
       virtual void impute_atoms(
@@ -440,7 +467,7 @@ namespace BOOM {
     MixedDataImputerBase & operator=(const MixedDataImputerBase &rhs);
     MixedDataImputerBase(MixedDataImputerBase &&rhs) = default;
     MixedDataImputerBase & operator=(MixedDataImputerBase &&rhs) = default;
-
+    ~MixedDataImputerBase();
     MixedDataImputerBase * clone() const override = 0;
     // Setup functions that require virtual functions.  Clients should call this
     // function immediately after construction.
@@ -473,6 +500,17 @@ namespace BOOM {
 
     void sample_posterior() override;
 
+    //--------------------------------------------------------------------------
+    // Multi-threading.
+    //--------------------------------------------------------------------------
+    // Impute the training data in sample_posterior() using 'nworkers'
+    // threads.  Each worker is a clone of this object that imputes a
+    // contiguous share of the rows using its own RNG and its own complete data
+    // sufficient statistics.  The workers' statistics are added to this
+    // object's models before the parameters are drawn.  If nworkers <= 0 the
+    // rows are imputed in the calling thread.
+    void setup_worker_pool(int nworkers);
+    void shut_down_worker_pool();
     //--------------------------------------------------------------------------
     // Accessing the component models.
     //--------------------------------------------------------------------------
@@ -587,8 +625,22 @@ namespace BOOM {
     // numeric_data_model_ object is constructed.
     void set_numeric_data_model_observers();
     mutable Vector wsp_;
-  };
 
+    // ======================================================================
+    // Threading section
+    // ======================================================================
+
+    // If the object is a worker then the workers_ vector is empty and the
+    // thread pool has no threads.
+    std::vector<Ptr<MixedDataImputerBase>> workers_;
+    ThreadWorkerPool thread_pool_;
+
+    void impute_all_rows_multithreaded();
+    void distribute_data_to_workers();
+    void ensure_data_distribution();
+    void broadcast_parameters();
+    void reduce_sufficient_statistics();
+  };
   //===========================================================================
   // A multivariate model for imputing missing values for independent
   // observations (or "rows").  The model breaks a multivariate observation d =
@@ -60,6 +60,14 @@ namespace BOOM {
 
     NECM *NECM::clone() const {return new NECM(*this);}
 
+    void NECM::combine_sufficient_statistics(const ScalarModelBase &rhs) {
+      impl_->combine_sufficient_statistics(
+          *dynamic_cast<const NECM &>(rhs).impl_);
+    }
+
+    void NECM::copy_parameters(const ScalarModelBase &rhs) {
+      impl_->copy_parameters(*dynamic_cast<const NECM &>(rhs).impl_);
+    }
     double NECM::logp(const MixedMultivariateData &data) const {
       const DoubleData &scalar(data.numeric(index()));
       double value = std::numeric_limits<double>::quiet_NaN();
@@ -135,6 +143,22 @@ namespace BOOM {
       }
     }
 
+    void CECM::combine_sufficient_statistics(const ScalarModelBase &rhs) {
+      const CECM &other(dynamic_cast<const CECM &>(rhs));
+      truth_model_->suf()->combine(other.truth_model_->suf());
+      for (size_t i = 0; i < obs_models_.size(); ++i) {
+        obs_models_[i]->suf()->combine(other.obs_models_[i]->suf());
+      }
+    }
+
+    void CECM::copy_parameters(const ScalarModelBase &rhs) {
+      const CECM &other(dynamic_cast<const CECM &>(rhs));
+      truth_model_->set_pi(other.truth_model_->pi());
+      for (size_t i = 0; i < obs_models_.size(); ++i) {
+        obs_models_[i]->set_pi(other.obs_models_[i]->pi());
+      }
+    }
+
     void CECM::update_complete_data_suf(int true_level, int observed_level) {
       truth_model_->suf()->update_raw(true_level);
       obs_models_[true_level]->suf()->update_raw(observed_level);
@@ -161,18 +185,23 @@ namespace BOOM {
     Vector CECM::true_level_log_probability(
         const LabeledCategoricalData &observed) {
       ensure_workspace_is_current();
-      return log_joint_distribution_.col(atom_index(levels_->label(
-          observed.value())));
+      return log_joint_distribution_.col(level_index(observed.value()));
     }
 
     int CECM::atom_index(const LabeledCategoricalData &data) const {
       if (data.missing() != Data::missing_status::observed) {
         return levels_->max_levels() + 1;
       } else {
-        return atom_index(levels_->label(data.value()));
+        return level_index(data.value());
       }
     }
 
+    // Observed values are coded with respect to levels_, and atom_index_ maps
+    // the label of level i to i, so the integer code is the atom index.
+    int CECM::level_index(uint value) const {
+      int nlevels = levels_->max_levels();
+      return value < nlevels ? value : nlevels;
+    }
     int CECM::atom_index(const std::string &label) const {
       auto it = atom_index_.find(label);
       if (it == atom_index_.end()) {
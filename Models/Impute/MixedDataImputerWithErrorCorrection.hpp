@@ -83,6 +83,8 @@ namespace BOOM {
       void sample_posterior() override { impl_->sample_posterior(); }
       double logpri() const override {return impl_->logpri();}
       void clear_data() override {impl_->clear_data();}
+      void combine_sufficient_statistics(const ScalarModelBase &rhs) override;
+      void copy_parameters(const ScalarModelBase &rhs) override;
       int impute_atom(double observed_value, RNG &rng, bool update) {
         return impl_->impute_atom(observed_value, rng, update);
       }
@@ -151,8 +153,10 @@ namespace BOOM {
         return VariableType::categorical;
       }
 
-      void update_complete_data_suf(int true_level, int observed_level);
+      void combine_sufficient_statistics(const ScalarModelBase &rhs) override;
+      void copy_parameters(const ScalarModelBase &rhs) override;
 
+      void update_complete_data_suf(int true_level, int observed_level);
       // The log conditional probability distribution of the true value, given
       // the obseved value that each atom is the true value.
       Vector true_level_log_probability(
@@ -163,6 +167,8 @@ namespace BOOM {
       int atom_index(const LabeledCategoricalData &data) const;
       int atom_index(const std::string &label) const;
 
+      // The atom index of an observed value with integer code 'value'.
+      int level_index(uint value) const;
       void set_conjugate_prior_for_levels(const Vector &counts);
       void set_conjugate_prior_for_observations(const Matrix &counts);
 
@@ -44,6 +44,54 @@ namespace {
     NEW(RowModel, model)();
   }
 
+  TEST_F(MixedDataImputerTest, CategoricalLogpUsesLevelCodes) {
+    CategoricalScalarModel model(1, colors_);
+    model.set_level_probs(Vector{.2, .5, .3});
+    EXPECT_NEAR(model.logp(*data_), log(.5), 1e-8);
+    EXPECT_NEAR(model.logp(*data_), model.logp("blue"), 1e-8);
+    EXPECT_NEAR(model.logp(2), log(.3), 1e-8);
+
+    // Data coded with a different key fall back to the labels.
+    NEW(CatKey, other_colors)(std::vector<std::string>{"blue", "red"});
+    MixedMultivariateData other;
+    other.add_numeric(new DoubleData(1.0));
+    other.add_categorical(new LabeledCategoricalData("blue", other_colors));
+    EXPECT_NEAR(model.logp(other), log(.5), 1e-8);
+  }
+
+  TEST_F(MixedDataImputerTest, WorkersCombineSufficientStatistics) {
+    int nrows = 200;
+    Vector x1(nrows), x2(nrows);
+    std::vector<std::string> colors, shapes;
+    for (int i = 0; i < nrows; ++i) {
+      x1[i] = rnorm();
+      x2[i] = runif() < .2 ? 0.0 : rexp(1.0);
+      colors.push_back(colors_->label(random_int(0, 2)));
+      shapes.push_back(shapes_->label(random_int(0, 2)));
+    }
+    DataTable table;
+    table.append_variable(x1, "x1");
+    table.append_variable(CategoricalVariable(colors), "color");
+    table.append_variable(x2, "x2");
+    table.append_variable(CategoricalVariable(shapes), "shape");
+    std::vector<Vector> atoms = {Vector(0), Vector(1, 0.0)};
+
+    MixedDataImputer imputer(3, table, atoms);
+    imputer.setup_worker_pool(3);
+    for (int i = 0; i < 3; ++i) {
+      imputer.sample_posterior();
+      EXPECT_DOUBLE_EQ(imputer.mixing_distribution()->suf()->n().sum(),
+                       nrows);
+      EXPECT_DOUBLE_EQ(imputer.numeric_data_model()->suf()->n(), nrows);
+    }
+
+    // Going back to a single thread gives the same totals.
+    imputer.shut_down_worker_pool();
+    imputer.sample_posterior();
+    EXPECT_DOUBLE_EQ(imputer.mixing_distribution()->suf()->n().sum(), nrows);
+    EXPECT_DOUBLE_EQ(imputer.numeric_data_model()->suf()->n(), nrows);
+  }
+
   TEST_F(MixedDataImputerTest, Empty) {
     // This test checks if the code can be built and linked.
   }
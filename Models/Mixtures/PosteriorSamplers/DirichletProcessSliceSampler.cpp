@@ -18,6 +18,7 @@
 */
 
 #include "Models/Mixtures/PosteriorSamplers/DirichletProcessSliceSampler.hpp"
+#include <algorithm>
 #include "cpputil/lse.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
@@ -140,17 +141,33 @@ namespace BOOM {
     Vector mixing_weights = model_->mixing_weights();
     Vector log_mixing_weights = log(mixing_weights);
     Vector workspace;
-    for (int i = 0; i < sample_size; ++i) {
-      Ptr<Data> data_point = data[i];
-      workspace.resize(max_clusters_[i]);
-      for (int c = 0; c < max_clusters_[i]; ++c) {
-        workspace[c] = log_mixing_weights[c] +
-                       model_->component(c)->pdf(data_point.get(), true) -
-                       log_mixing_weight_importance(c);
+    // The component densities are evaluated for a block of observations at a
+    // time, for all the clusters that any observation in the block might
+    // join.  Assigning data to clusters does not change cluster parameters,
+    // so the block remains valid while it is being used.
+    const int block_size = 256;
+    Matrix log_densities;
+    for (int begin = 0; begin < sample_size; begin += block_size) {
+      int end = std::min<int>(sample_size, begin + block_size);
+      int block_clusters = *std::max_element(max_clusters_.begin() + begin,
+                                             max_clusters_.begin() + end);
+      log_densities.resize(end - begin, block_clusters);
+      for (int c = 0; c < block_clusters; ++c) {
+        model_->component(c)->fill_log_density(data, begin, end,
+                                               log_densities.col(c));
+      }
+      for (int i = begin; i < end; ++i) {
+        Ptr<Data> data_point = data[i];
+        workspace.resize(max_clusters_[i]);
+        for (int c = 0; c < max_clusters_[i]; ++c) {
+          workspace[c] = log_mixing_weights[c] + log_densities(i - begin, c) -
+                         log_mixing_weight_importance(c);
+        }
+        workspace.normalize_logprob();
+        int new_mixture_indicator = rmulti_mt(rng(), workspace);
+        model_->assign_data_to_cluster(data_point, new_mixture_indicator,
+                                       rng());
       }
-      workspace.normalize_logprob();
-      int new_mixture_indicator = rmulti_mt(rng(), workspace);
-      model_->assign_data_to_cluster(data_point, new_mixture_indicator, rng());
     }
     model_->remove_all_empty_clusters();
   }
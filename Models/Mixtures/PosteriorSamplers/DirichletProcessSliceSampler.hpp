@@ -42,6 +42,9 @@ namespace BOOM {
         RNG &seeding_rng = GlobalRng::rng);
 
     void draw() override;
+    const MoveAccounting *mh_accounting() const override {
+      return &move_accounting_;
+    }
 
     // The true Bayesian prior for this model is the prior on the base measure.
     double logpri() const override;
@@ -231,4 +231,31 @@ namespace BOOM {
     return Logp(x, g, h, 2);
   }
 
+  //======================================================================
+  void MixtureComponent::fill_log_density(const std::vector<Ptr<Data>> &data,
+                                          int begin, int end,
+                                          VectorView ans) const {
+    if (ans.size() != end - begin) {
+      report_error("Wrong size output argument in fill_log_density.");
+    }
+    for (int i = begin; i < end; ++i) {
+      const Data *data_point = data[i].get();
+      ans[i - begin] = data_point->missing() ? 0.0 : pdf(data_point, true);
+    }
+  }
+
+  void fill_log_density_matrix(
+      const std::vector<Ptr<MixtureComponent>> &components,
+      const std::vector<Ptr<Data>> &data, int begin, int end, Matrix &ans) {
+    int nrow = end - begin;
+    int ncol = components.size();
+    if (ans.nrow() != nrow || ans.ncol() != ncol) {
+      ans.resize(nrow, ncol);
+    }
+    for (int s = 0; s < ncol; ++s) {
+      // Matrices are stored by column, so each column is a contiguous block.
+      components[s]->fill_log_density(data, begin, end, ans.col(s));
+    }
+  }
+
 }  // namespace BOOM
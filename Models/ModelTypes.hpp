@@ -108,6 +108,9 @@ namespace BOOM {
   template <class MODEL>
   Ptr<MODEL> deepclone(const MODEL &model) {
     Ptr<MODEL> ans = model.clone();
+    // Some models copy their samplers along with everything else.  Those
+    // samplers would still be managing the original model.
+    ans->clear_methods();
     for (int s = 0; s < model.number_of_sampling_methods(); ++s) {
       ans->set_method(model.sampler(s)->clone_to_new_host(ans.get()));
     }
@@ -285,6 +288,22 @@ namespace BOOM {
 
     virtual double pdf(const Data *, bool logscale) const = 0;
 
+    // Evaluate the log density of a contiguous block of observations.
+    //
+    // Args:
+    //   data:  A vector of data points of the type modeled by this component.
+    //   begin, end: Log densities are computed for data[begin], ...,
+    //     data[end - 1].
+    //   ans: A view of size end - begin.  On output ans[i] is the log density
+    //     of data[begin + i].  Missing observations have log density zero.
+    //
+    // The default implementation calls pdf() once per observation.
+    // Components with simple densities override it to compute
+    // parameter-dependent constants once per block, and to do the arithmetic
+    // in a tight loop over contiguous memory that the compiler can vectorize.
+    virtual void fill_log_density(const std::vector<Ptr<Data>> &data,
+                                  int begin, int end, VectorView ans) const;
+
     // The number of data points that have been allocated to this model.  This
     // might have been called "sample_size", but that sometimes refers to
     // certain model parameters, such as the beta distribution.
@@ -308,6 +327,15 @@ namespace BOOM {
     int component_;
   };
 
+  // Fill the matrix 'ans' with the log densities of data[begin], ...,
+  // data[end - 1] under each mixture component.  On output 'ans' has
+  // end - begin rows and components.size() columns, with ans(i, s) the log
+  // density of data[begin + i] under components[s].  Missing observations
+  // have log density zero.
+  void fill_log_density_matrix(
+      const std::vector<Ptr<MixtureComponent>> &components,
+      const std::vector<Ptr<Data>> &data, int begin, int end, Matrix &ans);
+
   //======================================================================
   class ConjugateModel : virtual public Model {
    public:
@@ -245,6 +245,29 @@ namespace BOOM {
     suf()->add_mixture_data(i, prob);
   }
 
+  void MM::fill_log_density(const std::vector<Ptr<Data>> &data, int begin,
+                            int end, VectorView ans) const {
+    if (ans.size() != end - begin) {
+      report_error("Wrong size output argument in fill_log_density.");
+    }
+    check_logp();
+    const double *logp = logp_.data();
+    const uint levels = dim();
+    for (int i = begin; i < end; ++i) {
+      const Data *data_point = data[i].get();
+      if (data_point->missing()) {
+        ans[i - begin] = 0.0;
+      } else {
+        uint level = DAT(data_point)->value();
+        if (level >= levels) {
+          report_error(
+              "too large a value passed to MultinomialModel::fill_log_density");
+        }
+        ans[i - begin] = logp[level];
+      }
+    }
+  }
+
   void MM::check_logp() const {
     if (logp_current_) return;
     logp_ = log(pi());
@@ -101,6 +101,8 @@ namespace BOOM {
     void mle() override;
     double pdf(const Data *dp, bool logscale) const override;
     double pdf(const Ptr<Data> &dp, bool logscale) const;
+    void fill_log_density(const std::vector<Ptr<Data>> &data, int begin,
+                          int end, VectorView ans) const override;
     void add_mixture_data(const Ptr<Data> &, double prob);
     int number_of_observations() const override { return suf()->n().sum(); }
 
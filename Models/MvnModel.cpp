@@ -25,6 +25,7 @@
 #include "Models/PosteriorSamplers/HierarchicalPosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/MvnConjSampler.hpp"
 #include "Models/WishartModel.hpp"
+#include "cpputil/Constants.hpp"
 #include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
 
@@ -58,6 +59,55 @@ namespace BOOM {
     return logscale ? ans : exp(ans);
   }
 
+  // With siginv = L * L^T, the quadratic form (y - mu)^T siginv (y - mu) is
+  // the squared norm of (y - mu)^T L.  Stacking the centered observations as
+  // the rows of a matrix turns the whole block into one matrix multiply.
+  void MvnModel::fill_log_density(const std::vector<Ptr<Data>> &data,
+                                  int begin, int end, VectorView ans) const {
+    int n = end - begin;
+    if (ans.size() != n) {
+      report_error("Wrong size output argument in fill_log_density.");
+    }
+    bool ok = true;
+    Matrix L = siginv().chol(ok);
+    if (!ok || n == 0) {
+      MixtureComponent::fill_log_density(data, begin, end, ans);
+      return;
+    }
+    const Vector &mean(mu());
+    int dim = mean.size();
+    Matrix centered(n, dim);
+    std::vector<int> missing;
+    for (int i = 0; i < n; ++i) {
+      const Data *data_point = data[begin + i].get();
+      if (data_point->missing()) {
+        missing.push_back(i);
+        continue;
+      }
+      const Vector &y(DAT(data_point)->value());
+      for (int j = 0; j < dim; ++j) {
+        centered(i, j) = y[j] - mean[j];
+      }
+    }
+    Matrix scaled = centered * L;
+
+    // Accumulate the squared row norms one column at a time, so the inner
+    // loop runs over contiguous memory.
+    Vector quadratic_form(n, 0.0);
+    double *qform = quadratic_form.data();
+    for (int j = 0; j < dim; ++j) {
+      const double *column = scaled.col(j).data();
+      for (int i = 0; i < n; ++i) {
+        qform[i] += column[i] * column[i];
+      }
+    }
+    const double constant = 0.5 * (ldsi() - dim * Constants::log_2pi);
+    for (int i = 0; i < n; ++i) {
+      ans[i] = constant - 0.5 * qform[i];
+    }
+    for (int i : missing) ans[i] = 0.0;
+  }
+
   Vector MvnModel::sim(RNG &rng) const {
     return rmvn_L_mt(rng, mu(), Sigma_chol());
   }
@@ -77,6 +77,8 @@ namespace BOOM {
     double pdf(const Ptr<Data> &dp, bool logscale) const;
     double pdf(const Data *, bool logscale) const override;
     double pdf(const Vector &x, bool logscale) const;
+    void fill_log_density(const std::vector<Ptr<Data>> &data, int begin,
+                          int end, VectorView ans) const override;
     int number_of_observations() const override { return dat().size(); }
 
     Vector sim(RNG &rng = GlobalRng::rng) const override;
@@ -48,6 +48,12 @@ namespace BOOM {
     return *this;
   }
   
+  Vector GFFNN::predict(const Matrix &predictors) const {
+    std::vector<Matrix> activation_probs;
+    fill_activation_probabilities(predictors, activation_probs);
+    return terminal_layer_->coef().predict(activation_probs.back());
+  }
+
   void GFFNN::restructure_terminal_layer(int dim) {
     if (dim != terminal_layer_->xdim()) {
       ParamPolicy::drop_model(terminal_layer_);
@@ -53,6 +53,17 @@ namespace BOOM {
       return predict(ConstVectorView(predictors));
     }
 
+
+    // Predictions for a batch of observations, with each layer evaluated for
+    // the whole batch as a matrix-matrix product.
+    //
+    // Args:
+    //   predictors:  Each row holds the predictors for one observation.
+    //
+    // Returns:
+    //   The vector of predictions, with one element per row of predictors.
+    Vector predict(const Matrix &predictors) const;
+
     Ptr<RegressionModel> terminal_layer() {return terminal_layer_;}
 
     double residual_sd() const {return terminal_layer_->sigma();}
@@ -69,6 +69,29 @@ namespace BOOM {
       outputs[i] = plogis(models_[i]->predict(inputs));
     }
   }
+
+  void HiddenLayer::predict(const Matrix &inputs, Matrix &outputs) const {
+    if (inputs.ncol() != input_dimension()) {
+      report_error("The inputs passed to HiddenLayer::predict have the "
+                   "wrong number of columns.");
+    }
+    if (outputs.nrow() != inputs.nrow() ||
+        outputs.ncol() != output_dimension()) {
+      outputs.resize(inputs.nrow(), output_dimension());
+    }
+    inputs.multT(coefficient_matrix(), outputs);
+    for (double &logit : outputs) {
+      logit = plogis(logit);
+    }
+  }
+
+  Matrix HiddenLayer::coefficient_matrix() const {
+    Matrix ans(output_dimension(), input_dimension());
+    for (int i = 0; i < models_.size(); ++i) {
+      ans.row(i) = models_[i]->Beta();
+    }
+    return ans;
+  }
   
   //===========================================================================
   namespace {
@@ -132,6 +155,19 @@ namespace BOOM {
     }
   }
 
+  void FFNN::fill_activation_probabilities(
+      const Matrix &inputs,
+      std::vector<Matrix> &activation_probs) const {
+    if (activation_probs.size() != hidden_layers_.size()) {
+      activation_probs.resize(hidden_layers_.size());
+    }
+    const Matrix *in = &inputs;
+    for (int i = 0; i < hidden_layers_.size(); ++i) {
+      hidden_layers_[i]->predict(*in, activation_probs[i]);
+      in = &activation_probs[i];
+    }
+  }
+
   std::vector<Vector> FFNN::activation_probability_workspace() const {
     std::vector<Vector> ans;
     for (int i = 0; i < hidden_layers_.size(); ++i) {
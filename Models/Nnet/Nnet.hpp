@@ -83,6 +83,19 @@ namespace BOOM {
     //   outputs: The marginal probabilties that each output node is active.  
     void predict(const Vector &inputs, Vector &outputs) const;
 
+    // Evaluate the layer on a batch of observations as a single
+    // matrix-matrix product.
+    //
+    // Args:
+    //   inputs: Each row holds the inputs to the layer for one observation.
+    //   outputs: On output, element (i, j) is the marginal probability that
+    //     node j is active for observation i.  Resized if needed.
+    void predict(const Matrix &inputs, Matrix &outputs) const;
+
+    // The logistic regression coefficients for the layer.  Row j holds the
+    // coefficients for node j, with zeros for excluded inputs.
+    Matrix coefficient_matrix() const;
+
     Ptr<BinomialLogitModel> logistic_regression(int node) {
       return models_[node];
     }
@@ -145,6 +158,19 @@ namespace BOOM {
         const Vector &inputs,
         std::vector<Vector> &activation_probs) const;
     
+    // Batched version of fill_activation_probabilities, which evaluates each
+    // hidden layer for all observations at once.
+    //
+    // Args:
+    //   inputs:  Each row holds the observed predictors for one observation.
+    //   activation_probs: Element i corresponds to hidden layer i.  Row j of
+    //     that element is filled with the activation probabilities for
+    //     observation j.  The elements are resized if needed, so the vector
+    //     need only have one element per hidden layer.
+    void fill_activation_probabilities(
+        const Matrix &inputs,
+        std::vector<Matrix> &activation_probs) const;
+
     // Allocate a data structure that can be passed to
     // fill_activation_probabilities.
     std::vector<Vector> activation_probability_workspace() const;
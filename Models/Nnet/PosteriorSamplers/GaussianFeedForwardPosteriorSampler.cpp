@@ -17,6 +17,7 @@
 */
 
 #include "Models/Nnet/PosteriorSamplers/GaussianFeedForwardPosteriorSampler.hpp"
+#include <algorithm>
 #include "distributions.hpp"
 #include "cpputil/lse.hpp"
 
@@ -24,14 +25,111 @@ namespace BOOM {
 
   namespace {
     using GFFPS = GaussianFeedForwardPosteriorSampler;
+    using Worker = GaussianFeedForwardImputeWorker;
   }  // namespace 
-  
+
+  Worker::GaussianFeedForwardImputeWorker(GFFPS *sampler,
+                                          std::mutex &mutex,
+                                          RNG &seeding_rng)
+      : LatentDataImputerWorker(mutex),
+        sampler_(sampler),
+        rng_(seeding_rng.split()),
+        begin_(0),
+        end_(0)
+  {}
+
+  void Worker::set_rows(int begin, int end) {
+    begin_ = begin;
+    end_ = end;
+  }
+
+  // The imputation method is a "collapsed Gibbs sampler" that integrates out
+  // latent data from preceding layers (i.e. preceding nodes are activated
+  // probabilistically), but conditions on the latent data from the current
+  // layer and the layer above.
+  void Worker::impute_latent_data() {
+    ensure_local_suf();
+    terminal_suf_->clear();
+    for (auto &suf : hidden_layer_suf_) {
+      suf.clear();
+    }
+    if (begin_ >= end_) return;
+
+    const GaussianFeedForwardNeuralNetwork &model(*sampler_->model_);
+    const std::vector<Ptr<RegressionData>> &data(model.dat());
+    int number_of_hidden_layers = model.number_of_hidden_layers();
+    std::vector<Vector> allocation_probs =
+        model.activation_probability_workspace();
+    std::vector<Vector> complementary_allocation_probs = allocation_probs;
+    std::vector<Vector> workspace = allocation_probs;
+    int xdim = data[begin_]->xdim();
+    int batch_size = sampler_->batch_size();
+
+    for (int start = begin_; start < end_; start += batch_size) {
+      int nrows = std::min(batch_size, end_ - start);
+      if (predictors_.nrow() != nrows || predictors_.ncol() != xdim) {
+        predictors_.resize(nrows, xdim);
+      }
+      for (int j = 0; j < nrows; ++j) {
+        predictors_.row(j) = data[start + j]->x();
+      }
+      model.fill_activation_probabilities(predictors_,
+                                          batch_activation_probs_);
+
+      for (int j = 0; j < nrows; ++j) {
+        const Ptr<RegressionData> &data_point(data[start + j]);
+        Nnet::HiddenNodeValues &outputs(
+            sampler_->imputed_hidden_layer_outputs_[start + j]);
+        for (int layer = 0; layer < number_of_hidden_layers; ++layer) {
+          allocation_probs[layer] = batch_activation_probs_[layer].row(j);
+        }
+        sampler_->impute_terminal_layer_inputs(
+            rng_, data_point->y(), outputs.back(), allocation_probs.back(),
+            complementary_allocation_probs.back(), *terminal_suf_);
+        for (int layer = number_of_hidden_layers - 1; layer > 0; --layer) {
+          // This for-loop intentionally skips layer 0, because the inputs to
+          // the first hidden layer are the observed predictors.
+          sampler_->imputers_[layer].draw_inputs(
+              rng_,
+              outputs,
+              allocation_probs[layer - 1],
+              complementary_allocation_probs[layer - 1],
+              workspace[layer - 1]);
+          hidden_layer_suf_[layer].update(outputs[layer - 1], outputs[layer]);
+        }
+        sampler_->imputers_[0].store_initial_layer_latent_data(
+            outputs[0], data_point);
+      }
+    }
+  }
+
+  void Worker::combine_complete_data() {
+    if (terminal_suf_->n() > 0) {
+      sampler_->model_->terminal_layer()->suf()->combine(terminal_suf_);
+    }
+    for (int layer = 1; layer < hidden_layer_suf_.size(); ++layer) {
+      sampler_->imputers_[layer].store_latent_data(hidden_layer_suf_[layer]);
+    }
+  }
+
+  void Worker::ensure_local_suf() {
+    const Ptr<RegSuf> &global_suf(sampler_->model_->terminal_layer()->suf());
+    if (!terminal_suf_ || terminal_suf_->size() != global_suf->size()) {
+      terminal_suf_.reset(global_suf->clone());
+    }
+    hidden_layer_suf_.resize(sampler_->model_->number_of_hidden_layers());
+  }
+
+  //===========================================================================
   GFFPS::GaussianFeedForwardPosteriorSampler(
       GaussianFeedForwardNeuralNetwork *model,
       RNG &seeding_rng)
       : PosteriorSampler(seeding_rng),
-        model_(model)
-  {}
+        model_(model),
+        batch_size_(64)
+  {
+    set_number_of_workers(1);
+  }
 
   double GFFPS::logpri() const {
     report_error("Not yet implemented");
@@ -40,41 +138,41 @@ namespace BOOM {
 
   void GFFPS::draw() {
     ensure_imputers();
-    impute_hidden_layer_outputs(rng());
+    if (model_->number_of_hidden_layers() > 0) {
+      if (ensure_space_for_latent_data()) {
+        for (const auto &data_point : model_->dat()) {
+          imputers_[0].register_initial_layer_data_point(data_point);
+        }
+        assign_data_to_workers();
+      }
+      impute_latent_data();
+    }
     draw_parameters_given_hidden_nodes();
   }
-  
-  // The imputation method is a "collapsed Gibbs sampler" that integrates out
-  // latent data from preceding layers (i.e. preceding nodes are activated
-  // probabilistically), but conditions on the latent data from the current
-  // layer and the layer above.
-  void GFFPS::impute_hidden_layer_outputs(RNG &rng) {
-    int number_of_hidden_layers = model_->number_of_hidden_layers();
-    if (number_of_hidden_layers == 0) return;
-    ensure_space_for_latent_data();
-    clear_latent_data();
-    std::vector<Vector> allocation_probs =
-        model_->activation_probability_workspace();
-    std::vector<Vector> complementary_allocation_probs = allocation_probs;
-    std::vector<Vector> workspace = allocation_probs;
-    for (int i = 0; i < model_->dat().size(); ++i) {
-      const Ptr<RegressionData> &data_point(model_->dat()[i]);
-      Nnet::HiddenNodeValues &outputs(imputed_hidden_layer_outputs_[i]);
-      model_->fill_activation_probabilities(data_point->x(), allocation_probs);
-      impute_terminal_layer_inputs(rng, data_point->y(), outputs.back(),
-                                   allocation_probs.back(),
-                                   complementary_allocation_probs.back());
-      for (int layer = number_of_hidden_layers - 1; layer > 0; --layer) {
-        // This for-loop intentionally skips layer 0, because the inputs to the
-        // first hidden layer are the observed predictors.
-        imputers_[layer].impute_inputs(
-            rng,
-            outputs,
-            allocation_probs[layer - 1],
-            complementary_allocation_probs[layer - 1],
-            workspace[layer - 1]);
-      }
-      imputers_[0].store_initial_layer_latent_data(outputs[0], data_point);
+
+  void GFFPS::set_batch_size(int batch_size) {
+    if (batch_size <= 0) {
+      report_error("batch_size must be positive.");
+    }
+    batch_size_ = batch_size;
+  }
+
+  Ptr<Worker> GFFPS::create_worker(std::mutex &mutex) {
+    return new Worker(this, mutex, rng());
+  }
+
+  void GFFPS::assign_data_to_workers() {
+    std::vector<Ptr<Worker>> &pool(workers());
+    int number_of_workers = pool.size();
+    if (number_of_workers == 0) return;
+    int nobs = model_->dat().size();
+    int chunk_size = nobs / number_of_workers;
+    int remainder = nobs % number_of_workers;
+    int begin = 0;
+    for (int i = 0; i < number_of_workers; ++i) {
+      int end = begin + chunk_size + (i < remainder);
+      pool[i]->set_rows(begin, end);
+      begin = end;
     }
   }
 
@@ -106,7 +204,7 @@ namespace BOOM {
   // clear any latent data structures stored by the imputers.
   void GFFPS::clear_latent_data() {
     model_->terminal_layer()->suf()->clear();
-    for (int i = 0; i < model_->number_of_hidden_layers(); ++i) {
+    for (int i = 0; i < imputers_.size(); ++i) {
       imputers_[i].clear_latent_data();
     }
   }
@@ -140,7 +238,7 @@ namespace BOOM {
   }
 
   // Set up space for storing the outputs of the hidden layers.
-  void GFFPS::ensure_space_for_latent_data() {
+  bool GFFPS::ensure_space_for_latent_data() {
     if (imputed_hidden_layer_outputs_.size() != model_->dat().size()) {
       imputed_hidden_layer_outputs_.clear();
       imputed_hidden_layer_outputs_.reserve(model_->dat().size());
@@ -154,7 +252,9 @@ namespace BOOM {
         }
         imputed_hidden_layer_outputs_.push_back(element);
       }
+      return true;
     }
+    return false;
   }
   
   void GFFPS::ensure_imputers() {
@@ -174,17 +274,19 @@ namespace BOOM {
   //     over-written by their logarithms.
   //   logprob_complement: On input this is any vector with size matching
   //     logprob.  On output its elements contain log(1 - exp(logprob)).
+  //   suf: Sufficient statistics for the regression model in the terminal
+  //     layer.
   //
   // Effects:
-  //   The latent data for the terminal layer is imputed, and the sufficient
-  //   statistics for the latent regression model in the terminal layer are
-  //   updated to included the imputed data.
+  //   The latent data for the terminal layer is imputed, and 'suf' is updated
+  //   to include the imputed data.
   void GFFPS::impute_terminal_layer_inputs(
       RNG &rng,
       double response,
       std::vector<bool> &binary_inputs,
       Vector &logprob,
-      Vector &logprob_complement) {
+      Vector &logprob_complement,
+      RegSuf &suf) const {
     for (int i = 0; i < logprob.size(); ++i) {
       logprob_complement[i] = log(1 - logprob[i]);
       logprob[i] = log(logprob[i]);
@@ -205,8 +307,7 @@ namespace BOOM {
         terminal_layer_inputs[i] = 1 - terminal_layer_inputs[i];
       }
     }
-    model_->terminal_layer()->suf()->add_mixture_data(
-        response, terminal_layer_inputs, 1.0);
+    suf.add_mixture_data(response, terminal_layer_inputs, 1.0);
     Nnet::to_binary(terminal_layer_inputs, binary_inputs);
   }
 
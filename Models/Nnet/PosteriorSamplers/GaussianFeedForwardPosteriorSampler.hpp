@@ -20,12 +20,65 @@
 
 #include "Models/Nnet/GaussianFeedForwardNeuralNetwork.hpp"
 #include "Models/Nnet/PosteriorSamplers/HiddenLayerImputer.hpp"
+#include "Models/PosteriorSamplers/Imputer.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
 namespace BOOM {
 
+  class GaussianFeedForwardPosteriorSampler;
+
+  // A worker that imputes the hidden node outputs for a contiguous block of
+  // observations.  Activation probabilities are computed for mini-batches of
+  // observations using the batched forward pass.  The latent data are stored
+  // in the worker's own sufficient statistics, which are merged into the
+  // layer models once the worker is done.
+  class GaussianFeedForwardImputeWorker : public LatentDataImputerWorker {
+   public:
+    // Args:
+    //   sampler:  The sampler that owns this worker.
+    //   mutex:  The mutex guarding the models in the network.
+    //   seeding_rng:  The RNG used to seed this worker's RNG.
+    GaussianFeedForwardImputeWorker(GaussianFeedForwardPosteriorSampler *sampler,
+                                    std::mutex &mutex,
+                                    RNG &seeding_rng);
+
+    // Assign the observations in [begin, end) to this worker.
+    void set_rows(int begin, int end);
+
+    void impute_latent_data() override;
+    void combine_complete_data() override;
+    int number_of_observations_managed() const override {
+      return end_ - begin_;
+    }
+
+   private:
+    // Ensure that the local sufficient statistics match the structure of the
+    // network.
+    void ensure_local_suf();
+
+    GaussianFeedForwardPosteriorSampler *sampler_;
+    RNG rng_;
+    int begin_;
+    int end_;
+
+    // Local complete data sufficient statistics for the terminal layer, and
+    // for each hidden layer.  Element 0 of hidden_layer_suf_ is unused,
+    // because the first hidden layer stores its latent data directly.
+    Ptr<RegSuf> terminal_suf_;
+    std::vector<HiddenLayerLatentDataSuf> hidden_layer_suf_;
+
+    // Workspace for the batched forward pass.
+    Matrix predictors_;
+    std::vector<Matrix> batch_activation_probs_;
+  };
+
+  //===========================================================================
+  // Samples the parameters of a Gaussian feed forward neural network by
+  // imputing the binary outputs of the hidden nodes.  The imputation can be
+  // spread across threads by calling set_number_of_workers().
   class GaussianFeedForwardPosteriorSampler
-      : public PosteriorSampler {
+      : public PosteriorSampler,
+        public LatentDataSampler<GaussianFeedForwardImputeWorker> {
    public:
     explicit GaussianFeedForwardPosteriorSampler(
         GaussianFeedForwardNeuralNetwork *model,
@@ -34,19 +87,29 @@ namespace BOOM {
     double logpri() const override;
     void draw() override;
 
+    // The number of observations passed through the batched forward pass at
+    // once when computing activation probabilities.
+    void set_batch_size(int batch_size);
+    int batch_size() const { return batch_size_; }
+
+    Ptr<GaussianFeedForwardImputeWorker> create_worker(
+        std::mutex &mutex) override;
+
+    // Remove imputed data from the models used to implement the hidden and
+    // terminal layers.
+    void clear_latent_data() override;
+    void assign_data_to_workers() override;
+
    private:
+    friend class GaussianFeedForwardImputeWorker;
+
     //---------------------------------------------------------------------------
     // This section contains implementation for the 'draw' method.
-    void impute_hidden_layer_outputs(RNG &rng);
 
     // Simulate from the posterior distribution of model parameters, conditional
     // on the imputed {0, 1} values at the hidden nodes.
     void draw_parameters_given_hidden_nodes();
 
-    // Remove imputed data from the models used to implement the hidden and
-    // terminal layers.
-    void clear_latent_data();
-
     // The un-normalized conditional distribution for the inputs to the
     // termainal layer (i.e. the outputs from the final hidden layer).  This
     // distribution conditions on the model parameters and observed data, and
@@ -68,19 +131,21 @@ namespace BOOM {
         const Vector &logprob_complement) const;
 
     // Ensure that the proper data structures have been built for storing latent
-    // data.
-    void ensure_space_for_latent_data();
+    // data.  Returns true if they had to be rebuilt.
+    bool ensure_space_for_latent_data();
 
     // Ensure that each hidden layer in the model has a HiddenLayerImputer
     // allocated to manage it.
     void ensure_imputers();
 
-    // Implementation for impute_hidden_layer_outputs.  Don't call these from
-    // elsewhere.
+    // Impute the inputs to the terminal layer for a single observation, and
+    // add the completed data to 'suf'.  This function does not modify the
+    // model, so it is safe to call from several threads at once.
     void impute_terminal_layer_inputs(RNG &rng,
                                       double response,
                                       std::vector<bool> &inputs,
-                                      Vector &wsp1, Vector &wsp2);
+                                      Vector &wsp1, Vector &wsp2,
+                                      RegSuf &suf) const;
 
     //----------------------------------------------------------------------
     // Data section.
@@ -92,6 +157,8 @@ namespace BOOM {
     // imputed_hidden_layer_outputs_[i][layer][node] indicates whether the
     // specified node in the specified hidden layer is 'on' for observation i.
     std::vector<Nnet::HiddenNodeValues> imputed_hidden_layer_outputs_;
+
+    int batch_size_;
   };
 
 }  // namespace BOOM
@@ -22,6 +22,28 @@
 
 namespace BOOM {
 
+  //---------------------------------------------------------------------------
+  void HiddenLayerLatentDataSuf::update(const std::vector<bool> &inputs,
+                                        const std::vector<bool> &outputs) {
+    Counts &counts(counts_[inputs]);
+    if (counts.successes.size() != outputs.size()) {
+      counts.successes.resize(outputs.size());
+      counts.successes = 0.0;
+    }
+    for (int i = 0; i < outputs.size(); ++i) {
+      counts.successes[i] += outputs[i];
+    }
+    counts.trials += 1.0;
+  }
+
+  void HiddenLayerLatentDataSuf::clear() {
+    for (auto &el : counts_) {
+      el.second.successes = 0.0;
+      el.second.trials = 0;
+    }
+  }
+
+  //===========================================================================
   HiddenLayerImputer::HiddenLayerImputer(const Ptr<HiddenLayer> &layer,
                                          int layer_index) 
       : layer_(layer),
@@ -36,6 +58,19 @@ namespace BOOM {
       Vector &complementary_allocation_probs,
       Vector &input_workspace) {
     if (layer_index_ <= 0) return;
+    draw_inputs(rng, outputs, allocation_probs, complementary_allocation_probs,
+                input_workspace);
+    store_latent_data(outputs);
+  }
+
+  //---------------------------------------------------------------------------
+  void HiddenLayerImputer::draw_inputs(
+      RNG &rng,
+      Nnet::HiddenNodeValues &outputs,
+      Vector &allocation_probs,
+      Vector &complementary_allocation_probs,
+      Vector &input_workspace) const {
+    if (layer_index_ <= 0) return;
     std::vector<bool> &inputs(outputs[layer_index_ - 1]);
     Nnet::to_numeric(inputs, input_workspace);
     for (int i = 0; i < allocation_probs.size(); ++i) {
@@ -67,7 +102,6 @@ namespace BOOM {
         input_workspace[i] = 1 - input_workspace[i];
       }
     }
-    store_latent_data(outputs);
   }
 
   //---------------------------------------------------------------------------
@@ -132,6 +166,23 @@ namespace BOOM {
     }
   }
 
+  //---------------------------------------------------------------------------
+  void HiddenLayerImputer::store_latent_data(
+      const HiddenLayerLatentDataSuf &suf) {
+    if (layer_index_ <= 0) {
+      report_error("Don't call store_latent_data for hidden layer 0.");
+    }
+    for (const auto &el : suf.counts()) {
+      const HiddenLayerLatentDataSuf::Counts &counts(el.second);
+      if (counts.trials <= 0) continue;
+      std::vector<Ptr<BinomialRegressionData>> data_row =
+          get_data_row(el.first);
+      for (int i = 0; i < data_row.size(); ++i) {
+        data_row[i]->increment(counts.successes[i], counts.trials);
+      }
+    }
+  }
+
   //---------------------------------------------------------------------------
   std::vector<Ptr<BinomialRegressionData>> HiddenLayerImputer::get_data_row(
       const std::vector<bool> &inputs) {
@@ -189,6 +240,16 @@ namespace BOOM {
     }
   }
 
+  //---------------------------------------------------------------------------
+  void HiddenLayerImputer::register_initial_layer_data_point(
+      const Ptr<GlmBaseData> &data_point) {
+    if (layer_index_ != 0) {
+      report_error("Only the first hidden layer can store initial layer "
+                   "latent data.");
+    }
+    get_initial_data(data_point);
+  }
+
   //---------------------------------------------------------------------------
   std::vector<Ptr<BinomialRegressionData>>
   HiddenLayerImputer::get_initial_data(const Ptr<GlmBaseData> &data_point) {
@@ -18,6 +18,7 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <map>
 #include "Models/Nnet/Nnet.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
@@ -27,6 +28,38 @@ namespace HiddenLayerImputerTestNamespace {
 }
 
 namespace BOOM {
+
+  // Latent data for a hidden layer other than the first, summarized by the
+  // distinct patterns of inputs to the layer.  For each pattern it records the
+  // number of observations having that pattern, and the number of those for
+  // which each node was active.  Workers imputing hidden nodes in parallel
+  // accumulate latent data in their own copy of this object, which is later
+  // passed to HiddenLayerImputer::store_latent_data.
+  class HiddenLayerLatentDataSuf {
+   public:
+    struct Counts {
+      // The number of observations for which each node was active.
+      Vector successes;
+      double trials = 0;
+    };
+
+    // Add the inputs and outputs from one observation.
+    void update(const std::vector<bool> &inputs,
+                const std::vector<bool> &outputs);
+
+    // Set all counts to zero.  Patterns that have been seen before are kept,
+    // so that accumulating the next set of latent data does not allocate.
+    void clear();
+
+    const std::map<std::vector<bool>, Counts> &counts() const {
+      return counts_;
+    }
+
+   private:
+    std::map<std::vector<bool>, Counts> counts_;
+  };
+
+  //===========================================================================
   // A HiddenLayerImputer manages the imputed data for a single hidden layer in
   // a feed forward neural network.
   class HiddenLayerImputer {
@@ -65,6 +98,16 @@ namespace BOOM {
                        Vector &complementary_allocation_probs,
                        Vector &input_workspace);
 
+    // The MCMC update performed by impute_inputs, without storing the imputed
+    // latent data.  This function does not modify the managed layer, so it
+    // can be called from several threads at once for different observations.
+    // Arguments and effects on 'outputs' are as in impute_inputs.
+    void draw_inputs(RNG &rng,
+                     Nnet::HiddenNodeValues &outputs,
+                     Vector &allocation_probs,
+                     Vector &complementary_allocation_probs,
+                     Vector &input_workspace) const;
+
     // The conditional distribution for the vector of inputs to this layer,
     // given the set of predictors and model parameters, and given the outputs
     // for the layer.
@@ -94,6 +137,11 @@ namespace BOOM {
     void clear_latent_data();
 
     // Store the imputed outputs of the first hidden layer.
+    //
+    // Once register_initial_layer_data_point has been called for each data
+    // point, this function may be called from several threads at once for
+    // distinct data points.
+    //
     // Args:
     //   outputs:  The imputed outputs for the first hidden layer.
     //   data_point:  The observed data point for this observation.
@@ -101,11 +149,20 @@ namespace BOOM {
         const std::vector<bool>  &outputs,
         const Ptr<GlmBaseData> &data_point);
 
+    // Create the latent data storage for the first hidden layer for the given
+    // data point, if it does not already exist.  This must be called from a
+    // single thread.
+    void register_initial_layer_data_point(const Ptr<GlmBaseData> &data_point);
+
     // Store the latent data simulated from impute_inputs in the logistic
     // regression models making up the hidden layer, and in the data store
     // managed by this object.
     void store_latent_data(Nnet::HiddenNodeValues &outputs);
 
+    // Store latent data accumulated for many observations, e.g. by a worker
+    // thread calling draw_inputs.
+    void store_latent_data(const HiddenLayerLatentDataSuf &suf);
+
    private:
     // For testing.  Let the test rig access private data.
     friend class HiddenLayerImputerTestNamespace::HiddenLayerImputerTest;
@@ -1,6 +1,11 @@
 #include "gtest/gtest.h"
 #include "Models/Nnet/Nnet.hpp"
 #include "Models/Nnet/GaussianFeedForwardNeuralNetwork.hpp"
+#include "Models/Nnet/PosteriorSamplers/GaussianFeedForwardPosteriorSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialLogitAuxmixSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/RegressionSemiconjugateSampler.hpp"
+#include "Models/ChisqModel.hpp"
+#include "Models/MvnModel.hpp"
 
 #include "distributions.hpp"
 
@@ -197,5 +202,151 @@ namespace {
     EXPECT_TRUE(VectorEquals(activation_probs[0], manual_activation_probs[0]));
     EXPECT_TRUE(VectorEquals(activation_probs[1], manual_activation_probs[1]));
   }
-  
+
+  //===========================================================================
+  // The batched forward pass agrees with the one-observation-at-a-time
+  // version.
+  TEST_F(NnetTest, BatchedForwardPass) {
+    Matrix X(7, layer1_->input_dimension());
+    X.randomize();
+
+    std::vector<Matrix> batch_probs;
+    network_.fill_activation_probabilities(X, batch_probs);
+    ASSERT_EQ(2, batch_probs.size());
+    EXPECT_EQ(7, batch_probs[0].nrow());
+    EXPECT_EQ(2, batch_probs[0].ncol());
+    EXPECT_EQ(7, batch_probs[1].nrow());
+    EXPECT_EQ(3, batch_probs[1].ncol());
+
+    std::vector<Vector> activation_probs =
+        network_.activation_probability_workspace();
+    Vector predictions = network_.predict(X);
+    EXPECT_EQ(7, predictions.size());
+    for (int i = 0; i < X.nrow(); ++i) {
+      Vector x = X.row(i);
+      network_.fill_activation_probabilities(x, activation_probs);
+      EXPECT_TRUE(VectorEquals(activation_probs[0], batch_probs[0].row(i)));
+      EXPECT_TRUE(VectorEquals(activation_probs[1], batch_probs[1].row(i)));
+      EXPECT_NEAR(network_.predict(x), predictions[i], 1e-8);
+    }
+  }
+
+  //===========================================================================
+  // Simulate data from network_ and set up posterior samplers for a network
+  // with the same structure.
+  class NnetSamplerTest : public NnetTest {
+   protected:
+    NnetSamplerTest()
+        : sample_size_(500),
+          X_(sample_size_, layer1_->input_dimension()),
+          y_(sample_size_)
+    {
+      X_.randomize_gaussian(0, 1, GlobalRng::rng);
+      y_ = network_.predict(X_);
+      for (int i = 0; i < sample_size_; ++i) {
+        y_[i] += rnorm(0, network_.residual_sd());
+      }
+    }
+
+    // Build a model with the same structure as network_, with data and
+    // samplers assigned.  The posterior sampler for the whole network is
+    // returned in 'sampler'.
+    Ptr<GaussianFeedForwardNeuralNetwork> build_model(
+        Ptr<GaussianFeedForwardPosteriorSampler> &sampler) {
+      NEW(GaussianFeedForwardNeuralNetwork, model)();
+      model->add_layer(new HiddenLayer(3, 2));
+      model->add_layer(new HiddenLayer(2, 3));
+      model->finalize_network_structure();
+      for (int i = 0; i < sample_size_; ++i) {
+        NEW(RegressionData, data_point)(y_[i], X_.row(i));
+        model->add_data(data_point);
+      }
+      for (int i = 0; i < model->number_of_hidden_layers(); ++i) {
+        Ptr<HiddenLayer> layer = model->hidden_layer(i);
+        for (int j = 0; j < layer->number_of_nodes(); ++j) {
+          Ptr<BinomialLogitModel> logit = layer->logistic_regression(j);
+          NEW(MvnModel, prior)(logit->xdim(), 0.0, 1.0);
+          NEW(BinomialLogitAuxmixSampler, logit_sampler)(logit.get(), prior);
+          logit->set_method(logit_sampler);
+        }
+      }
+      Ptr<RegressionModel> terminal = model->terminal_layer();
+      NEW(MvnModel, coefficient_prior)(terminal->xdim(), 0.0, 100.0);
+      NEW(ChisqModel, residual_precision_prior)(1.0, 1.0);
+      NEW(RegressionSemiconjugateSampler, terminal_sampler)(
+          terminal.get(), coefficient_prior, residual_precision_prior);
+      terminal->set_method(terminal_sampler);
+
+      sampler.reset(new GaussianFeedForwardPosteriorSampler(model.get()));
+      model->set_method(sampler);
+      return model;
+    }
+
+    int sample_size_;
+    Matrix X_;
+    Vector y_;
+  };
+
+  //===========================================================================
+  // Each observation contributes exactly once to the latent data in every
+  // layer, however the imputation is split among workers.
+  TEST_F(NnetSamplerTest, ParallelImputationStoresAllLatentData) {
+    for (int workers : {1, 3}) {
+      Ptr<GaussianFeedForwardPosteriorSampler> sampler;
+      Ptr<GaussianFeedForwardNeuralNetwork> model = build_model(sampler);
+      sampler->set_number_of_workers(workers);
+      sampler->set_batch_size(16);
+      for (int iteration = 0; iteration < 3; ++iteration) {
+        model->sample_posterior();
+      }
+
+      Ptr<RegSuf> terminal_suf = model->terminal_layer()->suf();
+      EXPECT_DOUBLE_EQ(sample_size_, terminal_suf->n());
+      EXPECT_NEAR(y_.normsq(), terminal_suf->yty(), 1e-6);
+      EXPECT_NEAR(sum(y_), terminal_suf->n() * terminal_suf->ybar(), 1e-6);
+
+      // Observations are stored individually in the first hidden layer, and
+      // by input pattern in the second.
+      for (int layer = 0; layer < 2; ++layer) {
+        Ptr<HiddenLayer> hidden = model->hidden_layer(layer);
+        for (int node = 0; node < hidden->number_of_nodes(); ++node) {
+          double trials = 0;
+          for (const auto &data_point :
+                   hidden->logistic_regression(node)->dat()) {
+            trials += data_point->n();
+            EXPECT_LE(data_point->y(), data_point->n());
+          }
+          EXPECT_DOUBLE_EQ(sample_size_, trials)
+              << "workers = " << workers << " layer = " << layer
+              << " node = " << node;
+        }
+      }
+    }
+  }
+
+  //===========================================================================
+  // The threaded sampler fits the training data about as well as the single
+  // threaded sampler.
+  TEST_F(NnetSamplerTest, ParallelImputationFitsData) {
+    int niter = 200;
+    int burn = 100;
+    Vector residual_sd(2, 0.0);
+    std::vector<int> workers = {1, 4};
+    for (int w = 0; w < workers.size(); ++w) {
+      Ptr<GaussianFeedForwardPosteriorSampler> sampler;
+      Ptr<GaussianFeedForwardNeuralNetwork> model = build_model(sampler);
+      sampler->set_number_of_workers(workers[w]);
+      for (int iteration = 0; iteration < niter; ++iteration) {
+        model->sample_posterior();
+        if (iteration >= burn) {
+          residual_sd[w] += model->residual_sd() / (niter - burn);
+        }
+      }
+    }
+    EXPECT_LT(residual_sd[0], 2 * network_.residual_sd());
+    EXPECT_LT(residual_sd[1], 2 * network_.residual_sd());
+    EXPECT_NEAR(residual_sd[0], residual_sd[1], 0.25 * residual_sd[0])
+        << residual_sd;
+  }
+
 }  // namespace
@@ -188,6 +188,62 @@ namespace BOOM {
   double PoissonModel::pdf(const Data *dp, bool logscale) const {
     return dpois(DAT(dp)->value(), lam(), logscale);
   }
+
+  namespace {
+    // log(y!) for small y is looked up in a table rather than computed with
+    // lgamma.
+    class LogFactorialTable {
+     public:
+      LogFactorialTable() : table_(size_) {
+        for (int y = 0; y < size_; ++y) {
+          table_[y] = lgamma(y + 1.0);
+        }
+      }
+      double operator()(int y) const {
+        return y < size_ ? table_[y] : lgamma(y + 1.0);
+      }
+
+     private:
+      static const int size_ = 1024;
+      std::vector<double> table_;
+    };
+  }  // namespace
+
+  void PoissonModel::fill_log_density(const std::vector<Ptr<Data>> &data,
+                                      int begin, int end,
+                                      VectorView ans) const {
+    const double lambda = lam();
+    if (ans.stride() != 1 || lambda <= 0) {
+      // dpois handles the edge cases for a degenerate rate.
+      MixtureComponent::fill_log_density(data, begin, end, ans);
+      return;
+    }
+    int n = end - begin;
+    if (ans.size() != n) {
+      report_error("Wrong size output argument in fill_log_density.");
+    }
+    static const LogFactorialTable log_factorial;
+    const double log_lambda = log(lambda);
+    double *logp = ans.data();
+    std::vector<double> counts(n);
+    std::vector<int> exceptions;
+    for (int i = 0; i < n; ++i) {
+      const Data *data_point = data[begin + i].get();
+      int y = data_point->missing() ? -1 : DAT(data_point)->value();
+      if (y < 0) {
+        exceptions.push_back(i);
+        y = 0;
+      }
+      counts[i] = y;
+      logp[i] = log_factorial(y);
+    }
+    for (int i = 0; i < n; ++i) {
+      logp[i] = counts[i] * log_lambda - lambda - logp[i];
+    }
+    for (int i : exceptions) {
+      logp[i] = data[begin + i]->missing() ? 0.0 : negative_infinity();
+    }
+  }
   double PoissonModel::mean() const { return lam(); }
   double PoissonModel::var() const { return lam(); }
   double PoissonModel::sd() const { return sqrt(lam()); }
@@ -18,12 +18,15 @@
 */
 #include "Models/Policies/PriorPolicy.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Models/PosteriorSamplers/SamplerProfiler.hpp"
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
   void PriorPolicy::sample_posterior() {
+    SamplerProfiler::Scope model_scope(this);
     for (uint i = 0; i < samplers_.size(); ++i) {
+      SamplerProfiler::Scope sampler_scope(samplers_[i].get());
       samplers_[i]->draw();
     }
   }
@@ -19,6 +19,7 @@
 
 #include "Models/PosteriorSamplers/CompositeSampler.hpp"
 #include <cmath>
+#include "Models/PosteriorSamplers/SamplerProfiler.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -45,7 +46,11 @@ namespace BOOM {
     return CSA(this);
   }
 
-  void CS::draw() { choose_sampler()->draw(); }
+  void CS::draw() {
+    Ptr<PosteriorSampler> sampler = choose_sampler();
+    SamplerProfiler::Scope scope(sampler.get());
+    sampler->draw();
+  }
 
   double CS::logpri() const { return choose_sampler()->logpri(); }
 
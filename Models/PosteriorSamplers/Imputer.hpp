@@ -181,6 +181,12 @@ namespace BOOM {
 
     void combine_complete_data() override { global_suf_.combine(*suf_); }
 
+   protected:
+    // Child classes that override impute_latent_data() need access to the
+    // local sufficient statistics and the random number generator.
+    SUFFICIENT_STATISTICS *local_suf() { return suf_.get(); }
+    RNG &rng() { return *rng_; }
+
    private:
     Ptr<SUFFICIENT_STATISTICS> suf_;
     SUFFICIENT_STATISTICS &global_suf_;
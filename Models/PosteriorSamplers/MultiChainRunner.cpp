@@ -0,0 +1,195 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/PosteriorSamplers/MultiChainRunner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <string>
+#include <vector>
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  MultiChainRunner::MultiChainRunner(const Ptr<Model> &prototype,
+                                     int number_of_chains,
+                                     RNG &seeding_rng)
+      : swap_interval_(1),
+        swap_round_(0),
+        rng_(seed_rng(seeding_rng)) {
+    if (!prototype) {
+      report_error("MultiChainRunner needs a model.");
+    }
+    if (number_of_chains < 1) {
+      report_error("MultiChainRunner needs at least one chain.");
+    }
+    if (prototype->number_of_sampling_methods() == 0) {
+      report_error("The model passed to MultiChainRunner has no posterior "
+                   "sampler.");
+    }
+    // clone_to_new_host() seeds the new sampler, and any samplers nested
+    // inside it, from the RNG of the sampler being cloned.  Seed the
+    // prototype's samplers from seeding_rng before each clone, so that every
+    // stream in every chain comes from seeding_rng, and restore them
+    // afterward so the prototype is left as it was.
+    int number_of_samplers = prototype->number_of_sampling_methods();
+    std::vector<RNG> prototype_rngs;
+    prototype_rngs.reserve(number_of_samplers);
+    for (int s = 0; s < number_of_samplers; ++s) {
+      prototype_rngs.push_back(prototype->sampler(s)->rng());
+    }
+    for (int i = 0; i < number_of_chains; ++i) {
+      for (int s = 0; s < number_of_samplers; ++s) {
+        prototype->sampler(s)->set_seed(seed_rng(seeding_rng));
+      }
+      Ptr<Model> chain = deepclone(*prototype);
+      for (int s = 0; s < chain->number_of_sampling_methods(); ++s) {
+        chain->sampler(s)->set_seed(seed_rng(seeding_rng));
+      }
+      chains_.push_back(chain);
+      chain_at_level_.push_back(i);
+    }
+    for (int s = 0; s < number_of_samplers; ++s) {
+      prototype->sampler(s)->rng() = prototype_rngs[s];
+    }
+    draws_.resize(number_of_chains);
+  }
+
+  void MultiChainRunner::set_number_of_threads(int n) {
+    pool_.set_number_of_threads(n <= 1 ? 0 : n);
+  }
+
+  void MultiChainRunner::set_temperatures(
+      const Vector &inverse_temperatures,
+      const LogLikelihood &log_likelihood,
+      const TemperatureSetter &set_temperature,
+      int swap_interval) {
+    if (inverse_temperatures.size() != chains_.size()) {
+      report_error("There must be one inverse temperature per chain.");
+    }
+    if (inverse_temperatures[0] != 1.0) {
+      report_error("The first inverse temperature must be 1.");
+    }
+    for (int k = 1; k < inverse_temperatures.size(); ++k) {
+      if (inverse_temperatures[k] <= 0 ||
+          inverse_temperatures[k] >= inverse_temperatures[k - 1]) {
+        report_error("Inverse temperatures must be positive and strictly "
+                     "decreasing.");
+      }
+    }
+    if (!log_likelihood || !set_temperature) {
+      report_error("Tempering requires both a log likelihood function and a "
+                   "function to set the temperature of a chain.");
+    }
+    if (swap_interval < 1) {
+      report_error("swap_interval must be positive.");
+    }
+    inverse_temperatures_ = inverse_temperatures;
+    log_likelihood_ = log_likelihood;
+    set_temperature_ = set_temperature;
+    swap_interval_ = swap_interval;
+    swap_round_ = 0;
+    log_likelihoods_.assign(chains_.size(), 0.0);
+    swaps_proposed_.assign(chains_.size(), 0);
+    swaps_accepted_.assign(chains_.size(), 0);
+    for (int k = 0; k < chain_at_level_.size(); ++k) {
+      set_temperature_(*chains_[chain_at_level_[k]], inverse_temperatures_[k]);
+    }
+  }
+
+  void MultiChainRunner::run(int niter) {
+    if (niter < 1) {
+      report_error("MultiChainRunner::run needs a positive number of "
+                   "iterations.");
+    }
+    int dim = chains_[0]->vectorize_params().size();
+    for (int k = 0; k < draws_.size(); ++k) {
+      draws_[k] = Matrix(niter, dim);
+    }
+
+    int block_size = tempering() ? swap_interval_ : niter;
+    for (int start = 0; start < niter; start += block_size) {
+      int n = std::min(block_size, niter - start);
+      if (pool_.no_threads()) {
+        for (int k = 0; k < chain_at_level_.size(); ++k) {
+          run_chain(chain_at_level_[k], k, start, n);
+        }
+      } else {
+        std::vector<std::future<void>> jobs;
+        jobs.reserve(chain_at_level_.size());
+        for (int k = 0; k < chain_at_level_.size(); ++k) {
+          int chain_index = chain_at_level_[k];
+          jobs.emplace_back(pool_.submit([this, chain_index, k, start, n]() {
+            run_chain(chain_index, k, start, n);
+          }));
+        }
+        wait_for_jobs(jobs, "chain(s)");
+      }
+      if (tempering()) {
+        swap_temperatures();
+      }
+    }
+  }
+
+  double MultiChainRunner::swap_acceptance_rate(int level) const {
+    if (level < 0 || level >= swaps_proposed_.size() ||
+        swaps_proposed_[level] == 0) {
+      return 0.0;
+    }
+    return static_cast<double>(swaps_accepted_[level]) /
+           swaps_proposed_[level];
+  }
+
+  void MultiChainRunner::run_chain(int chain_index, int level,
+                                   int first_iteration, int niter) {
+    Model &model(*chains_[chain_index]);
+    Matrix &draws(draws_[level]);
+    for (int i = first_iteration; i < first_iteration + niter; ++i) {
+      model.sample_posterior();
+      draws.row(i) = model.vectorize_params();
+    }
+    if (tempering()) {
+      log_likelihoods_[chain_index] = log_likelihood_(model);
+    }
+  }
+
+  // A swap exchanges the states of the chains at levels k and k + 1.  Its
+  // Metropolis-Hastings ratio is
+  //   exp((beta[k] - beta[k+1]) * (loglike(upper) - loglike(lower)))
+  // where 'lower' is the chain currently at level k.
+  void MultiChainRunner::swap_temperatures() {
+    for (int k = swap_round_ % 2; k + 1 < chain_at_level_.size(); k += 2) {
+      int lower = chain_at_level_[k];
+      int upper = chain_at_level_[k + 1];
+      double log_acceptance_ratio =
+          (inverse_temperatures_[k] - inverse_temperatures_[k + 1]) *
+          (log_likelihoods_[upper] - log_likelihoods_[lower]);
+      ++swaps_proposed_[k];
+      if (log(runif_mt(rng_)) < log_acceptance_ratio) {
+        ++swaps_accepted_[k];
+        std::swap(chain_at_level_[k], chain_at_level_[k + 1]);
+        set_temperature_(*chains_[upper], inverse_temperatures_[k]);
+        set_temperature_(*chains_[lower], inverse_temperatures_[k + 1]);
+      }
+    }
+    ++swap_round_;
+  }
+
+}  // namespace BOOM
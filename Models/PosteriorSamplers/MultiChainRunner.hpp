@@ -0,0 +1,169 @@
+#ifndef BOOM_MULTI_CHAIN_RUNNER_HPP_
+#define BOOM_MULTI_CHAIN_RUNNER_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <functional>
+#include <vector>
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Models/ModelTypes.hpp"
+#include "cpputil/Ptr.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // Runs several MCMC chains for the same model, possibly in parallel, and
+  // optionally links them with parallel tempering swap moves.
+  //
+  // Each chain is a deepclone() of a prototype model, so it has its own
+  // parameters and its own posterior samplers, but it shares the prototype's
+  // data.  The samplers must therefore not modify the observed data objects.
+  // The samplers in each chain, including samplers nested inside them, are
+  // seeded from the seeding RNG passed to the constructor, so the chains use
+  // independent random number streams, and a run is reproducible given the
+  // state of the seeding RNG.  This relies on clone_to_new_host() seeding the
+  // new sampler from the cloned sampler's rng(), as the samplers in BOOM do.
+  // Code that draws from GlobalRng::rng rather than from a sampler's own RNG
+  // is neither reproducible nor safe to run on more than one thread.
+  //
+  // Draws are recorded in matrices that are allocated once at the start of
+  // run(), with one row per iteration holding the vectorized model parameters.
+  //
+  // Parallel tempering: chain k targets a posterior in which the likelihood is
+  // raised to the power beta[k], where 1 = beta[0] > beta[1] > ... > 0.  The
+  // runner has no way of tempering an arbitrary sampler, so the caller
+  // supplies a function that sets the temperature of a chain's samplers.
+  // Swaps exchange the temperatures of adjacent chains, rather than their
+  // parameters, so any latent data held by a chain travels with it.  Draws are
+  // recorded by temperature level, so draws(0) always holds draws from the
+  // untempered posterior.
+  //
+  // Typical use:
+  //   MultiChainRunner runner(model, 4);
+  //   runner.set_number_of_threads(4);
+  //   runner.run(1000);
+  //   for (int k = 0; k < runner.number_of_chains(); ++k) {
+  //     const Matrix &draws(runner.draws(k));
+  //     ...
+  //   }
+  class MultiChainRunner {
+   public:
+    // Returns the log likelihood of the data given the current parameters of
+    // the model.
+    typedef std::function<double(const Model &)> LogLikelihood;
+
+    // Sets the posterior samplers for the model so that they target the
+    // posterior distribution with the likelihood raised to the power of the
+    // second argument.
+    typedef std::function<void(Model &, double)> TemperatureSetter;
+
+    // Args:
+    //   prototype: The model to be sampled.  It must have a posterior sampler
+    //     which implements clone_to_new_host().  The RNGs of the
+    //     prototype's samplers are used while the chains are cloned, but
+    //     they are restored before the constructor returns, so the prototype
+    //     is not modified.
+    //   number_of_chains: The number of chains to run.
+    //   seeding_rng: The random number generator used to seed the chains, and
+    //     to seed the RNG used for swap moves.
+    MultiChainRunner(const Ptr<Model> &prototype,
+                     int number_of_chains,
+                     RNG &seeding_rng = GlobalRng::rng);
+
+    // Set the number of threads in the worker pool.  If n <= 1 the chains are
+    // run sequentially in the calling thread.
+    void set_number_of_threads(int n);
+
+    // Turn on parallel tempering.
+    // Args:
+    //   inverse_temperatures: The likelihood exponent for each temperature
+    //     level.  The first element must be 1, the elements must be strictly
+    //     decreasing and positive, and there must be one element per chain.
+    //   log_likelihood: Evaluates the untempered log likelihood for a chain.
+    //   set_temperature: Sets the temperature of a chain.  It is called for
+    //     every chain by this function, and for each pair of chains whose
+    //     temperatures are swapped.
+    //   swap_interval: The number of MCMC iterations between rounds of swap
+    //     proposals.  Chains run without synchronization between swap rounds,
+    //     so larger values cost less thread coordination.
+    void set_temperatures(const Vector &inverse_temperatures,
+                          const LogLikelihood &log_likelihood,
+                          const TemperatureSetter &set_temperature,
+                          int swap_interval = 1);
+
+    // Run each chain for 'niter' iterations, replacing any draws from
+    // previous calls to run().
+    void run(int niter);
+
+    int number_of_chains() const { return chains_.size(); }
+
+    // The chain currently at temperature level 'level'.  Without tempering
+    // chain i is always at level i.
+    Ptr<Model> chain(int level) { return chains_[chain_at_level_[level]]; }
+
+    // The draws from temperature level 'level' (i.e. from chain 'level' if
+    // tempering is not used).  Row i contains the result of
+    // vectorize_params() after iteration i.
+    const Matrix &draws(int level) const { return draws_[level]; }
+
+    // The fraction of proposed swaps between levels 'level' and 'level + 1'
+    // that were accepted.
+    double swap_acceptance_rate(int level) const;
+
+   private:
+    // Run the chain at position 'chain_index' in chains_ for iterations
+    // [first_iteration, first_iteration + niter), recording the draws in
+    // draws_[level].
+    void run_chain(int chain_index, int level, int first_iteration,
+                   int niter);
+
+    // Propose swaps between adjacent temperature levels, alternating between
+    // even and odd pairs on successive rounds.
+    void swap_temperatures();
+
+    bool tempering() const { return !inverse_temperatures_.empty(); }
+
+    std::vector<Ptr<Model>> chains_;
+    std::vector<Matrix> draws_;
+
+    // chain_at_level_[k] is the index in chains_ of the chain currently at
+    // temperature level k.
+    std::vector<int> chain_at_level_;
+
+    Vector inverse_temperatures_;
+    LogLikelihood log_likelihood_;
+    TemperatureSetter set_temperature_;
+    int swap_interval_;
+    int swap_round_;
+
+    // Log likelihood of each chain (indexed as in chains_) at the end of the
+    // most recent block of iterations.
+    Vector log_likelihoods_;
+    std::vector<int> swaps_proposed_;
+    std::vector<int> swaps_accepted_;
+
+    ThreadWorkerPool pool_;
+    RNG rng_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_MULTI_CHAIN_RUNNER_HPP_
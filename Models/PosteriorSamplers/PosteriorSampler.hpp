@@ -30,6 +30,7 @@
 namespace BOOM {
 
   class Model;
+  class MoveAccounting;
 
   // The job of a PosteriorSampler is primarily to simulate a set of
   // model parameters from their posterior distribution.  Concrete
@@ -99,6 +100,11 @@ namespace BOOM {
     virtual double increment_log_prior_gradient(
         const ConstVectorView &parameters, VectorView gradient) const;
 
+    // Samplers that record the outcomes of Metropolis-Hastings moves can
+    // expose them here so they show up in SamplerProfiler reports.  The
+    // default returns nullptr.
+    virtual const MoveAccounting *mh_accounting() const { return nullptr; }
+
     friend void intrusive_ptr_add_ref(PosteriorSampler *m);
     friend void intrusive_ptr_release(PosteriorSampler *m);
 
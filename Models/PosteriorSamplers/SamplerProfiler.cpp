@@ -0,0 +1,244 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/PosteriorSamplers/SamplerProfiler.hpp"
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <typeindex>
+#include <vector>
+#include "Models/ModelTypes.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Samplers/MoveAccounting.hpp"
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace BOOM {
+
+  struct SamplerProfiler::Node {
+    explicit Node(const std::type_index &type) : type(type) {}
+
+    // Returns the child for calls of the given type, creating it if needed.
+    Node *child(const std::type_index &child_type) {
+      for (auto &node : children) {
+        if (node->type == child_type) return node.get();
+      }
+      children.emplace_back(new Node(child_type));
+      return children.back().get();
+    }
+
+    double self_seconds() const {
+      double ans = total_seconds;
+      for (const auto &node : children) ans -= node->total_seconds;
+      return ans;
+    }
+
+    std::type_index type;
+    long calls = 0;
+    double total_seconds = 0;
+    std::uint64_t allocations = 0;
+    long accepted = 0;
+    long rejected = 0;
+    std::vector<std::unique_ptr<Node>> children;
+  };
+
+  std::atomic<bool> SamplerProfiler::enabled_(false);
+  thread_local std::uint64_t SamplerProfiler::allocation_count_ = 0;
+  thread_local SamplerProfiler::Node *SamplerProfiler::current_node_ = nullptr;
+
+  namespace {
+    using Profiler = SamplerProfiler;
+
+    // Guards the structure of the tree and the statistics in its nodes.
+    std::mutex &profile_mutex() {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    std::string type_name(const std::type_index &type) {
+      std::string ans = type.name();
+#ifdef __GNUG__
+      int status = 0;
+      char *demangled =
+          abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+      if (status == 0 && demangled) {
+        ans = demangled;
+      }
+      std::free(demangled);
+#endif
+      const std::string prefix = "BOOM::";
+      size_t pos;
+      while ((pos = ans.find(prefix)) != std::string::npos) {
+        ans.erase(pos, prefix.size());
+      }
+      return ans;
+    }
+
+    std::string json_escape(const std::string &s) {
+      std::string ans;
+      for (char c : s) {
+        if (c == '"' || c == '\\') ans.push_back('\\');
+        ans.push_back(c);
+      }
+      return ans;
+    }
+  }  // namespace
+
+  void Profiler::enable() { enabled_.store(true); }
+
+  void Profiler::disable() { enabled_.store(false); }
+
+  //---------------------------------------------------------------------------
+  Profiler::Scope::Scope(const Model *model) : node_(nullptr) {
+    if (SamplerProfiler::enabled()) {
+      accounting_ = nullptr;
+      start(typeid(*model));
+    }
+  }
+
+  Profiler::Scope::Scope(const PosteriorSampler *sampler) : node_(nullptr) {
+    if (SamplerProfiler::enabled()) {
+      accounting_ = sampler->mh_accounting();
+      start(typeid(*sampler));
+    }
+  }
+
+  void Profiler::Scope::start(const std::type_info &type) {
+    parent_ = current_node_ ? current_node_ : &root();
+    {
+      std::lock_guard<std::mutex> lock(profile_mutex());
+      node_ = parent_->child(std::type_index(type));
+    }
+    current_node_ = node_;
+    if (accounting_) {
+      initial_acceptances_ = accounting_->number_of_acceptances();
+      initial_rejections_ = accounting_->number_of_rejections();
+    }
+    initial_allocations_ = allocation_count_;
+    start_time_ = std::chrono::steady_clock::now();
+  }
+
+  void Profiler::Scope::finish() {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start_time_;
+    std::uint64_t allocations = allocation_count_ - initial_allocations_;
+    {
+      std::lock_guard<std::mutex> lock(profile_mutex());
+      ++node_->calls;
+      node_->total_seconds += elapsed.count();
+      node_->allocations += allocations;
+      if (accounting_) {
+        node_->accepted +=
+            accounting_->number_of_acceptances() - initial_acceptances_;
+        node_->rejected +=
+            accounting_->number_of_rejections() - initial_rejections_;
+      }
+    }
+    current_node_ = parent_ == &root() ? nullptr : parent_;
+  }
+
+  //---------------------------------------------------------------------------
+  Profiler::Node &Profiler::root() {
+    static Node root_node{std::type_index(typeid(void))};
+    return root_node;
+  }
+
+  void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(profile_mutex());
+    root().children.clear();
+  }
+
+  std::ostream &Profiler::print(std::ostream &out) {
+    std::lock_guard<std::mutex> lock(profile_mutex());
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::left << std::setw(50) << "name" << std::right
+        << std::setw(10) << "calls"
+        << std::setw(12) << "total(s)"
+        << std::setw(12) << "self(s)"
+        << std::setw(12) << "ms/call"
+        << std::setw(12) << "allocs/call"
+        << std::setw(10) << "accept" << "\n";
+    for (const auto &node : root().children) {
+      print_node(out, *node, 0);
+    }
+    out.flags(flags);
+    out.precision(precision);
+    return out;
+  }
+
+  std::string Profiler::to_json() {
+    std::lock_guard<std::mutex> lock(profile_mutex());
+    std::ostringstream out;
+    out << std::setprecision(9) << "[";
+    const auto &nodes(root().children);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      if (i > 0) out << ",";
+      write_json(out, *nodes[i]);
+    }
+    out << "]";
+    return out.str();
+  }
+
+  void Profiler::print_node(std::ostream &out, const Node &node, int depth) {
+    std::string name = std::string(2 * depth, ' ') + type_name(node.type);
+    double calls = node.calls > 0 ? node.calls : 1;
+    std::ostringstream acceptance;
+    long trials = node.accepted + node.rejected;
+    if (trials > 0) {
+      acceptance << std::fixed << std::setprecision(3)
+                 << static_cast<double>(node.accepted) / trials;
+    } else {
+      acceptance << "-";
+    }
+    out << std::left << std::setw(50) << name << std::right
+        << std::setw(10) << node.calls << std::fixed
+        << std::setprecision(4)
+        << std::setw(12) << node.total_seconds
+        << std::setw(12) << node.self_seconds()
+        << std::setw(12) << 1000 * node.total_seconds / calls
+        << std::setprecision(1)
+        << std::setw(12) << node.allocations / calls
+        << std::setw(10) << acceptance.str() << "\n";
+    out.unsetf(std::ios::fixed);
+    for (const auto &child : node.children) {
+      print_node(out, *child, depth + 1);
+    }
+  }
+
+  void Profiler::write_json(std::ostream &out, const Node &node) {
+    out << "{\"name\":\"" << json_escape(type_name(node.type)) << "\""
+        << ",\"calls\":" << node.calls
+        << ",\"total_seconds\":" << node.total_seconds
+        << ",\"self_seconds\":" << node.self_seconds()
+        << ",\"allocations\":" << node.allocations
+        << ",\"accepted\":" << node.accepted
+        << ",\"rejected\":" << node.rejected
+        << ",\"children\":[";
+    for (size_t i = 0; i < node.children.size(); ++i) {
+      if (i > 0) out << ",";
+      write_json(out, *node.children[i]);
+    }
+    out << "]}";
+  }
+
+}  // namespace BOOM
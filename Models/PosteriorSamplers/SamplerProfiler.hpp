@@ -0,0 +1,165 @@
+#ifndef BOOM_SAMPLER_PROFILER_HPP_
+#define BOOM_SAMPLER_PROFILER_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+
+namespace BOOM {
+
+  class Model;
+  class PosteriorSampler;
+  class MoveAccounting;
+
+  // Records where the time goes in an MCMC run.  When the profiler is enabled,
+  // each call to Model::sample_posterior() (through PriorPolicy) and to each
+  // PosteriorSampler::draw() is timed and counted.  Calls are aggregated by
+  // concrete type into a tree that follows the call structure: a sampler
+  // whose draw() calls sample_posterior() on the models it owns (e.g. a
+  // hierarchical or mixture sampler), or a CompositeSampler choosing among
+  // its components, appears as the parent of the nested calls.
+  //
+  // Each node of the tree reports the number of calls, the inclusive and
+  // exclusive wall time, Metropolis-Hastings acceptances and rejections
+  // recorded by samplers that keep a MoveAccounting (see
+  // PosteriorSampler::mh_accounting()), and the number of memory allocations
+  // made during the calls.  Allocations are only counted if the program
+  // installs the counting allocator described below.
+  //
+  // The profiler is off by default.  When it is off, instrumented code pays
+  // for a single relaxed atomic load per call.
+  //
+  // Typical use:
+  //   SamplerProfiler::enable();
+  //   for (int i = 0; i < niter; ++i) model->sample_posterior();
+  //   SamplerProfiler::disable();
+  //   SamplerProfiler::print(std::cout);
+  //   std::string json = SamplerProfiler::to_json();
+  //
+  // Timings are collected per thread.  Calls made on worker threads (e.g. by
+  // a multithreaded imputer) are recorded at the top level of the tree
+  // rather than under the call that launched the thread.
+  //
+  // To count allocations, define BOOM_SAMPLER_PROFILER_COUNT_ALLOCATIONS
+  // before including this header in exactly one translation unit of the
+  // program (typically the one containing main()).  That replaces the global
+  // operator new with one that calls record_allocation().
+  class SamplerProfiler {
+    // A node in the tree of profiled calls.
+    struct Node;
+
+   public:
+    static void enable();
+    static void disable();
+    static bool enabled() {
+      return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // Discard everything recorded so far.  Must not be called while a profiled
+    // call is in progress.
+    static void reset();
+
+    // Count one memory allocation against the calls in progress on this
+    // thread.
+    static void record_allocation() {
+      if (enabled()) ++allocation_count_;
+    }
+
+    // Print the profile as a table with one row per node of the tree.
+    // Nested calls are indented beneath their parent.
+    static std::ostream &print(std::ostream &out);
+
+    // The profile as a JSON array of nodes.  Each node is an object with
+    // fields "name", "calls", "total_seconds", "self_seconds",
+    // "allocations", "accepted", "rejected", and "children".
+    static std::string to_json();
+
+    // A Scope records a single call, from its construction to its
+    // destruction.  Scopes on the same thread must nest.
+    class Scope {
+     public:
+      explicit Scope(const Model *model);
+      explicit Scope(const PosteriorSampler *sampler);
+      ~Scope() {
+        if (node_) finish();
+      }
+      Scope(const Scope &rhs) = delete;
+      Scope &operator=(const Scope &rhs) = delete;
+
+     private:
+      void start(const std::type_info &type);
+      void finish();
+
+      // The node for this call, or nullptr if the profiler was disabled when
+      // the call began.
+      Node *node_;
+      Node *parent_;
+      const MoveAccounting *accounting_;
+      int initial_acceptances_;
+      int initial_rejections_;
+      std::uint64_t initial_allocations_;
+      std::chrono::steady_clock::time_point start_time_;
+    };
+
+   private:
+    // The root of the tree.  It holds no statistics of its own.  Its
+    // children are the outermost profiled calls.
+    static Node &root();
+    static void print_node(std::ostream &out, const Node &node, int depth);
+    static void write_json(std::ostream &out, const Node &node);
+
+    static std::atomic<bool> enabled_;
+    static thread_local std::uint64_t allocation_count_;
+
+    // The node for the innermost call in progress on this thread, or nullptr
+    // if there is none.
+    static thread_local Node *current_node_;
+  };
+
+}  // namespace BOOM
+
+#ifdef BOOM_SAMPLER_PROFILER_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+void *operator new(std::size_t size) {
+  BOOM::SamplerProfiler::record_allocation();
+  void *ans = std::malloc(size == 0 ? 1 : size);
+  if (!ans) throw std::bad_alloc();
+  return ans;
+}
+
+void *operator new[](std::size_t size) {
+  BOOM::SamplerProfiler::record_allocation();
+  void *ans = std::malloc(size == 0 ? 1 : size);
+  if (!ans) throw std::bad_alloc();
+  return ans;
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+#endif  // BOOM_SAMPLER_PROFILER_COUNT_ALLOCATIONS
+
+#endif  // BOOM_SAMPLER_PROFILER_HPP_
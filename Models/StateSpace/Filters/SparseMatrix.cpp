@@ -18,6 +18,7 @@
 */
 
 #include "Models/StateSpace/Filters/SparseMatrix.hpp"
+#include <algorithm>
 #include <utility>
 #include "LinAlg/SpdMatrix.hpp"
 #include "LinAlg/DiagonalMatrix.hpp"
@@ -975,6 +976,22 @@ namespace BOOM {
     v[0] += v[1];
   }
 
+  void LocalLinearTrendMatrix::matrix_multiply_inplace(SubMatrix m) const {
+    conforms_to_cols(m.nrow());
+    m.row(0) += m.row(1);
+  }
+
+  // m * T' adds the second column of m to the first.
+  void LocalLinearTrendMatrix::matrix_transpose_premultiply_inplace(
+      SubMatrix m) const {
+    conforms_to_rows(m.ncol());
+    double *first = m.col_begin(0);
+    const double *second = m.col_begin(1);
+    for (int i = 0; i < m.nrow(); ++i) {
+      first[i] += second[i];
+    }
+  }
+
   SpdMatrix LocalLinearTrendMatrix::inner() const {
     // 1 0 * 1 1  = 1 1
     // 1 1   0 1    1 2
@@ -1183,6 +1200,41 @@ namespace BOOM {
     *now = total;
   }
 
+  void SSSM::matrix_multiply_inplace(SubMatrix m) const {
+    conforms_to_cols(m.nrow());
+    int n = m.nrow();
+    for (int j = 0; j < m.ncol(); ++j) {
+      double *column = m.col_begin(j);
+      double total = 0;
+      for (int i = 0; i < n; ++i) {
+        total -= column[i];
+      }
+      std::copy_backward(column, column + n - 1, column + n);
+      column[0] = total;
+    }
+  }
+
+  // Column j of m * T' is m * T.row(j).  The first row of T is all -1's, and
+  // row j > 0 picks out element j - 1, so the columns of m shift right by one
+  // and the first column becomes minus the sum of the original columns.
+  void SSSM::matrix_transpose_premultiply_inplace(SubMatrix m) const {
+    conforms_to_rows(m.ncol());
+    int nr = m.nrow();
+    Vector total(nr, 0.0);
+    for (int j = m.ncol() - 1; j > 0; --j) {
+      double *column = m.col_begin(j);
+      const double *previous = m.col_begin(j - 1);
+      for (int i = 0; i < nr; ++i) {
+        total[i] -= column[i];
+        column[i] = previous[i];
+      }
+    }
+    double *first = m.col_begin(0);
+    for (int i = 0; i < nr; ++i) {
+      first[i] = total[i] - first[i];
+    }
+  }
+
   SpdMatrix SSSM::inner() const {
     // -1  1  0  0 .... 0          -1 -1 -1 -1 ... -1
     // -1  0  1  0 .... 0           1  0  0  0 .... 0
@@ -538,6 +538,8 @@ namespace BOOM {
                           const ConstVectorView &rhs) const override;
     void Tmult(VectorView lhs, const ConstVectorView &rhs) const override;
     void multiply_inplace(VectorView v) const override;
+    void matrix_multiply_inplace(SubMatrix m) const override;
+    void matrix_transpose_premultiply_inplace(SubMatrix m) const override;
     SpdMatrix inner() const override;
     SpdMatrix inner(const ConstVectorView &weights) const override;
     void add_to_block(SubMatrix block) const override;
@@ -849,6 +851,17 @@ namespace BOOM {
     void Tmult(VectorView lhs, const ConstVectorView &rhs) const override;
     // x = (*this) * x;
     void multiply_inplace(VectorView x) const override;
+
+    // These are called by the Kalman filter once per time period on a
+    // potentially large state variance matrix.  The default implementations
+    // call multiply_inplace on each row or column of m, and the rows of m are
+    // not contiguous.  These versions work directly on the columns.
+    //
+    // m = (*this) * m;
+    void matrix_multiply_inplace(SubMatrix m) const override;
+    // m = m * this->transpose();
+    void matrix_transpose_premultiply_inplace(SubMatrix m) const override;
+
     SpdMatrix inner() const override;
     SpdMatrix inner(const ConstVectorView &weights) const override;
     void add_to_block(SubMatrix block) const override;
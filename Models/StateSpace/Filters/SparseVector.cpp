@@ -205,11 +205,13 @@ namespace BOOM {
   //======================================================================
 
   Vector operator*(const SpdMatrix &P, const SparseVector &z) {
-    int n = nrow(P);
-    Vector ans(n);
-    for (int i = 0; i < n; ++i) {
-      //      ans[i] = z.dot(P.col(i));
-      ans[i] = z.dot(P.row(i));
+    // Accumulate the columns of P corresponding to the nonzero elements of z.
+    // This touches P with stride 1, where taking the dot product of z with
+    // each row of P would not.  The terms are summed in the same order either
+    // way.
+    Vector ans(nrow(P), 0.0);
+    for (const auto &el : z) {
+      ans.axpy(P.col(el.first), el.second);
     }
     return ans;
   }
@@ -287,6 +287,31 @@ namespace {
     CheckSparseMatrixBlock(seasonal, seasonal_dense);
   }
 
+  // A transition matrix like the one for a weekly series with an annual
+  // seasonal pattern, where the sandwich products work column by column.
+  TEST_F(SparseMatrixTest, LongSeasonalTransition) {
+    NEW(SeasonalStateSpaceMatrix, annual)(52);
+    Matrix annual_dense(51, 51, 0.0);
+    annual_dense.row(0) = -1;
+    annual_dense.subdiag(1) = 1.0;
+    CheckSparseMatrixBlock(annual, annual_dense);
+
+    BlockDiagonalMatrix transition;
+    transition.add_block(new LocalLinearTrendMatrix);
+    transition.add_block(annual);
+    transition.add_block(new SeasonalStateSpaceMatrix(7));
+    transition.add_block(new IdentityMatrix(3));
+    CheckSparseKalmanMatrix(transition);
+
+    SpdMatrix P(transition.ncol());
+    P.randomize();
+    SparseVector z(transition.ncol());
+    z[0] = 1.0;
+    z[2] = -2.0;
+    z[60] = 0.5;
+    EXPECT_TRUE(VectorEquals(P * z, P * z.dense()));
+  }
+
   TEST_F(SparseMatrixTest, AutoRegression) {
     Vector elements(4);
     elements.randomize();
@@ -17,6 +17,7 @@
 */
 
 #include "Models/StateSpace/Multivariate/MultivariateStateSpaceRegressionModel.hpp"
+#include <future>
 #include "Models/StateSpace/Filters/KalmanFilterBase.hpp"
 #include "distributions.hpp"
 #include "numopt.hpp"
@@ -102,6 +103,7 @@ namespace BOOM {
         adjusted_data_workspace_(nseries),
         workspace_time_index_(-1),
         workspace_status_(UNSET),
+        series_specific_data_current_(false),
         observation_variance_(nseries),
         observation_variance_current_(false),
         dummy_selector_(nseries, true)
@@ -241,6 +243,10 @@ namespace BOOM {
   }
 
   double MSSRM::adjusted_observation(int series, int time) const {
+    if (series_specific_data_current_
+        && workspace_status_ == ISOLATE_SERIES_SPECIFIC_STATE) {
+      return series_specific_data_(series, time);
+    }
     return adjusted_observation(time)[series];
   }
 
@@ -619,16 +625,56 @@ namespace BOOM {
 
   void MSSRM::impute_series_state_given_shared_state(RNG &rng) {
     if (has_series_specific_state()) {
+      isolate_series_specific_state_at_all_times();
       workspace_status_ = ISOLATE_SERIES_SPECIFIC_STATE;
-      for (int s = 0; s < nseries(); ++s) {
-        if (proxy_models_[s]->state_dimension() > 0) {
-          proxy_models_[s]->impute_state(rng);
+      series_specific_data_current_ = true;
+      if (pool_.no_threads()) {
+        for (int s = 0; s < nseries(); ++s) {
+          if (proxy_models_[s]->state_dimension() > 0) {
+            proxy_models_[s]->impute_state(rng);
+          }
+        }
+      } else {
+        // Streams are assigned to series rather than threads, so the draws do
+        // not depend on the number of threads.
+        std::vector<RNG> series_rngs;
+        series_rngs.reserve(nseries());
+        for (int s = 0; s < nseries(); ++s) {
+          series_rngs.push_back(rng.split());
         }
+        for_each_series_with_specific_state([this, &series_rngs](int s) {
+          proxy_models_[s]->impute_state(series_rngs[s]);
+        });
       }
+      series_specific_data_current_ = false;
       workspace_status_ = UNSET;
     }
   }
 
+  void MSSRM::set_number_of_threads(int nthreads) {
+    pool_.set_number_of_threads(nthreads <= 1 ? 0 : nthreads);
+  }
+
+  void MSSRM::for_each_series_with_specific_state(
+      const std::function<void(int)> &task) {
+    if (pool_.no_threads()) {
+      for (int s = 0; s < nseries(); ++s) {
+        if (series_state_dimension(s) > 0) {
+          task(s);
+        }
+      }
+      return;
+    }
+    std::vector<std::future<void>> jobs;
+    jobs.reserve(nseries());
+    for (int s = 0; s < nseries(); ++s) {
+      if (series_state_dimension(s) > 0) {
+        jobs.emplace_back(pool_.submit([&task, s]() { task(s); }));
+      }
+    }
+    wait_for_jobs(jobs, "series");
+  }
+
   // Set the adjusted data workspace by subtracting regression and
   // series-specific effects from the observed data.
   // void MSSRM::isolate_shared_state() {
@@ -710,6 +756,23 @@ namespace BOOM {
     workspace_status_ = ISOLATE_SERIES_SPECIFIC_STATE;
   }
 
+  void MSSRM::isolate_series_specific_state_at_all_times() {
+    series_specific_data_.resize(nseries(), time_dimension());
+    for (int time = 0; time < time_dimension(); ++time) {
+      const Selector &observed(observed_status(time));
+      if (observed.nvars() == 0) continue;
+      Vector shared_state_contribution =
+          *observation_coefficients(time, observed) * shared_state(time);
+      for (int s = 0; s < observed.nvars(); ++s) {
+        int series = observed.sparse_index(s);
+        const Vector &predictors(dat()[data_index(series, time)]->x());
+        series_specific_data_(series, time) = observed_data(series, time)
+            - shared_state_contribution[s]
+            - observation_model_->model(series)->predict(predictors);
+      }
+    }
+  }
+
   double MSSRM::series_specific_state_contribution(int series, int time) const {
     if (proxy_models_.empty()) return 0;
     const ProxyScalarStateSpaceModel &proxy(*proxy_models_[series]);
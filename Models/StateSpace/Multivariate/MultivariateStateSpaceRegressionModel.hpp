@@ -18,6 +18,7 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <functional>
 #include "Models/IndependentMvnModel.hpp"
 #include "Models/Glm/Glm.hpp"
 #include "Models/Glm/IndependentRegressionModels.hpp"
@@ -25,6 +26,7 @@
 #include "Models/StateSpace/StateSpaceModel.hpp"
 #include "Models/StateSpace/StateModelVector.hpp"
 #include "Models/StateSpace/Multivariate/MultivariateStateSpaceModelBase.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BoomStateSpaceTesting{
   class MultivariateStateSpaceRegressionModelTest;
@@ -411,6 +413,32 @@ namespace BOOM {
       return proxy_models_[index];
     }
 
+    //--------------------------------------------------------------------------
+    // Threading.
+    //--------------------------------------------------------------------------
+    // Given the shared state, the series-specific portions of the model are
+    // conditionally independent across series.  Setting more than one thread
+    // imputes the series-specific state of different series concurrently, and
+    // lets MultivariateStateSpaceRegressionPosteriorSampler draw the
+    // parameters of the series-specific state models concurrently.  The
+    // shared state is still imputed jointly across all series.
+    //
+    // Concurrent parameter draws require that the series-specific state
+    // models for different series not share parameters or priors.
+    //
+    // When threads are in use each series draws its state from its own RNG
+    // stream, split from the RNG passed to impute_state, so results for a
+    // given seed do not depend on the number of threads.
+    void set_number_of_threads(int nthreads);
+    int number_of_threads() const { return pool_.number_of_threads(); }
+
+    // Call task(series) for each series with series-specific state.  The calls
+    // run on the model's worker threads if any have been allocated, and
+    // sequentially otherwise.  Errors thrown by the tasks are collected and
+    // reported once all tasks have finished.
+    void for_each_series_with_specific_state(
+        const std::function<void(int)> &task);
+
     IndependentRegressionModels *observation_model() override {
       return observation_model_.get();
     }
@@ -627,6 +655,10 @@ namespace BOOM {
     //    void isolate_series_specific_state();
     void isolate_series_specific_state(int time) const;
 
+    // Fill series_specific_data_ with the observed data minus the shared state
+    // and regression contributions, for all series and time points.
+    void isolate_series_specific_state_at_all_times();
+
     // The contribution of the series_specific state to the given series at the
     // given time.
     double series_specific_state_contribution(int series, int time) const;
@@ -695,6 +727,19 @@ namespace BOOM {
     };
     mutable WorkspaceStatus workspace_status_;
 
+    // The data adjusted for shared state and regression effects, with series
+    // as rows and time as columns.  Filled once per call to
+    // impute_series_state_given_shared_state, so the proxy models can read it
+    // concurrently without touching adjusted_data_workspace_.  Entries for
+    // missing observations are unused.
+    Matrix series_specific_data_;
+
+    // Indicates that series_specific_data_ holds current values.
+    bool series_specific_data_current_;
+
+    // Worker threads for series-specific imputation and parameter draws.
+    ThreadWorkerPool pool_;
+
     // A workspace to copy the residual variances stored in observation_model_
     // in the data structure expected by the model.
     mutable DiagonalMatrix observation_variance_;
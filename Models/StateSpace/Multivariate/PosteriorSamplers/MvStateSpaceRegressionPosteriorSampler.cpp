@@ -62,14 +62,15 @@ namespace BOOM {
     }
 
     // Sample parameters for proxy models if any series specific state is
-    // present.
+    // present.  Given the state, the proxies are independent, so their draws
+    // run concurrently if the model has been given worker threads.
     if (model_->has_series_specific_state()) {
-      for (int j = 0; j < model_->nseries(); ++j) {
+      model_->for_each_series_with_specific_state([this](int j) {
         ProxyScalarStateSpaceModel &proxy(*model_->series_specific_model(j));
         for (int s = 0; s < proxy.number_of_state_models(); ++s) {
           proxy.state_model(s)->sample_posterior();
         }
-      }
+      });
     }
 
     // The complete data sufficient statistics for the observation model and the
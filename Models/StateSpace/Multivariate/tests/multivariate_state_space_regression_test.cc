@@ -1,4 +1,6 @@
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
 
 #include "test_utils/test_utils.hpp"
 
@@ -818,6 +820,125 @@ namespace BoomStateSpaceTesting {
     lines(f1[1, ], col = "green")
   */
 
+  //===========================================================================
+  // A model with a shared local level, where some of the series also have a
+  // local level of their own.
+  struct SeriesSpecificStateSimulation {
+    SeriesSpecificStateSimulation()
+        : sim(2, 8, 1, 100, 0, .3),
+          series{5, 6, 7},
+          innovation_sd{.5, .8, 1.0},
+          series_state(series.size(), 100) {
+      for (int i = 0; i < series.size(); ++i) {
+        double level = 0;
+        for (int time = 0; time < sample_size(); ++time) {
+          level += rnorm(0, innovation_sd[i]);
+          series_state(i, time) = level;
+          sim.response(time, series[i]) += level;
+        }
+      }
+    }
+
+    int sample_size() const { return series_state.ncol(); }
+
+    // Runs an MCMC on the simulated data using 'nthreads' threads, starting
+    // from the same seed each time.  Returns the draws of the series-specific
+    // innovation SD's, with a column for each entry in 'series'.  The draws
+    // of the series-specific state for each entry in 'series' are returned in
+    // 'state_draws'.
+    Matrix run(int nthreads, int niter, std::vector<Matrix> &state_draws) {
+      GlobalRng::rng.seed(8675309);
+      sim.build_model(.3);
+      // Fix the shared state, the regression models, and the observation
+      // coefficients at their true values, so that only the series-specific
+      // state and its parameters are sampled.
+      for (int s = 0; s < sim.nseries(); ++s) {
+        sim.model->observation_model()->model(s)->set_Beta(
+            sim.regression_coefficients.row(s));
+        sim.model->observation_model()->model(s)->set_sigsq(square(.3));
+      }
+      sim.model->observation_model()->clear_methods();
+      set_observation_coefficients(sim.observation_coefficients,
+                                   *sim.state_model);
+      sim.state_model->clear_methods();
+      sim.model->permanently_set_state(ConstSubMatrix(
+          sim.state, 0, sim.nfactors() - 1, 0, sample_size() - 1).to_matrix());
+      for (int i = 0; i < series.size(); ++i) {
+        NEW(LocalLevelStateModel, level)(1.0);
+        level->set_initial_state_mean(0.0);
+        level->set_initial_state_variance(1.0);
+        NEW(ZeroMeanGaussianConjSampler, level_sampler)(level.get(), 1.0, 1.0);
+        level->set_method(level_sampler);
+        sim.model->add_series_specific_state(level, series[i]);
+      }
+      // The framework's sampler was built before the series-specific state
+      // was added, so it needs to be replaced.
+      sim.model->clear_methods();
+      NEW(MultivariateStateSpaceRegressionPosteriorSampler, sampler)(
+          sim.model.get());
+      sim.model->set_method(sampler);
+      sim.model->set_number_of_threads(nthreads);
+
+      Matrix sd_draws(niter, series.size());
+      state_draws.assign(series.size(), Matrix(niter, sample_size()));
+      for (int iteration = 0; iteration < niter; ++iteration) {
+        sim.model->sample_posterior();
+        for (int i = 0; i < series.size(); ++i) {
+          ProxyScalarStateSpaceModel &proxy(
+              *sim.model->series_specific_model(series[i]));
+          sd_draws(iteration, i) = dynamic_cast<LocalLevelStateModel *>(
+              proxy.state_model(0))->sigma();
+          state_draws[i].row(iteration) = proxy.state().row(0);
+        }
+      }
+      return sd_draws;
+    }
+
+    McmcTestFramework sim;
+    // The series with series-specific state.
+    std::vector<int> series;
+    Vector innovation_sd;
+    // Row i is the series-specific state of series[i].
+    Matrix series_state;
+  };
+
+  TEST_F(MultivariateStateSpaceRegressionModelTest, ThreadedSeriesSpecificState) {
+    SeriesSpecificStateSimulation simulation;
+    int niter = 500;
+    int burn = 100;
+    std::vector<Matrix> state_draws;
+    Matrix sd_draws = simulation.run(2, niter, state_draws);
+
+    // The threaded draws recover the series-specific state and innovation
+    // SD's.
+    for (int i = 0; i < simulation.series.size(); ++i) {
+      Vector sd = ConstSubMatrix(sd_draws, burn, niter - 1, i, i)
+          .to_matrix().col(0);
+      EXPECT_NEAR(mean(sd), simulation.innovation_sd[i],
+                  .5 * simulation.innovation_sd[i])
+          << "series " << simulation.series[i];
+      Matrix state = ConstSubMatrix(state_draws[i], burn, niter - 1,
+                                    0, simulation.sample_size() - 1).to_matrix();
+      EXPECT_EQ("", CheckStochasticProcess(
+          state, simulation.series_state.row(i), .95, .5))
+          << "series " << simulation.series[i];
+    }
+
+    // Each series draws from its own RNG stream, so the draws do not depend
+    // on the number of threads.
+    int short_run = 20;
+    std::vector<Matrix> two_thread_state;
+    std::vector<Matrix> four_thread_state;
+    Matrix two_threads = simulation.run(2, short_run, two_thread_state);
+    Matrix four_threads = simulation.run(4, short_run, four_thread_state);
+    EXPECT_TRUE(MatrixEquals(two_threads, four_threads));
+    for (int i = 0; i < simulation.series.size(); ++i) {
+      EXPECT_TRUE(MatrixEquals(two_thread_state[i], four_thread_state[i]));
+    }
+    EXPECT_TRUE(MatrixEquals(two_threads, ConstSubMatrix(
+        sd_draws, 0, short_run - 1, 0, sd_draws.ncol() - 1).to_matrix()));
+  }
+
   //=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
   // //===========================================================================
@@ -0,0 +1,313 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/StateSpace/StateSpaceForecastEngine.hpp"
+#include <algorithm>
+#include "Models/StateSpace/Filters/ScalarKalmanFilter.hpp"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "Models/StateSpace/StateSpaceRegressionModel.hpp"
+#include "cpputil/lse.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    using Engine = StateSpaceForecastEngine;
+  }  // namespace
+
+  Engine::StateSpaceForecastEngine(ScalarStateSpaceModelBase *model,
+                                   FinalStateMethod method)
+      : model_(model),
+        regression_model_(dynamic_cast<StateSpaceRegressionModel *>(model)),
+        method_(method),
+        time_dimension_(0),
+        number_of_appended_observations_(0),
+        resampling_threshold_(0) {
+    if (!model_) {
+      report_error("StateSpaceForecastEngine needs a model.");
+    }
+    if (!regression_model_ && !dynamic_cast<StateSpaceModel *>(model_)) {
+      report_error("StateSpaceForecastEngine only supports StateSpaceModel "
+                   "and StateSpaceRegressionModel.");
+    }
+  }
+
+  void Engine::record_draw() {
+    if (model_->time_dimension() == 0) {
+      report_error("The model has no data.");
+    }
+    if (number_of_appended_observations_ > 0) {
+      report_error("Draws cannot be recorded after observations have been "
+                   "appended.");
+    }
+    Draw draw;
+    draw.parameters = model_->vectorize_params(false);
+    if (!draws_.empty()
+        && (draw.parameters.size() != draws_[0].parameters.size()
+            || model_->time_dimension() != time_dimension_)) {
+      report_error("The model changed after draws were recorded.");
+    }
+    if (regression_model_) {
+      draw.regression_coefficients =
+          regression_model_->observation_model()->Beta();
+    }
+    if (method_ == SAMPLED_STATE) {
+      draw.final_state = model_->final_state();
+    } else {
+      model_->set_state_model_behavior(StateModel::MARGINAL);
+      model_->kalman_filter();
+      const ScalarKalmanFilter &filter(model_->get_filter());
+      draw.final_state = filter.back().state_mean();
+      draw.final_state_variance = filter.back().state_variance();
+    }
+    time_dimension_ = model_->time_dimension();
+    draws_.push_back(draw);
+    log_weights_.push_back(0.0);
+  }
+
+  void Engine::clear_draws() {
+    draws_.clear();
+    log_weights_.clear();
+    workers_.clear();
+    time_dimension_ = 0;
+    number_of_appended_observations_ = 0;
+  }
+
+  void Engine::set_number_of_threads(int nthreads) {
+    pool_.set_number_of_threads(nthreads <= 1 ? 0 : nthreads);
+  }
+
+  //---------------------------------------------------------------------------
+  double Engine::append_observation(RNG &rng, double y) {
+    if (regression_model_) {
+      report_error("The model has a regression component.  New observations "
+                   "need predictors.");
+    }
+    return append(rng, y, nullptr);
+  }
+
+  double Engine::append_observation(RNG &rng, double y,
+                                    const Vector &predictors) {
+    if (!regression_model_) {
+      report_error("The model has no regression component.");
+    }
+    if (predictors.size() != regression_model_->xdim()) {
+      report_error("The predictors have the wrong dimension.");
+    }
+    return append(rng, y, &predictors);
+  }
+
+  double Engine::append(RNG &rng, double y, const Vector *predictors) {
+    if (draws_.empty()) {
+      report_error("No draws have been recorded.");
+    }
+    int t = time_dimension_;
+    Vector log_predictive_density(draws_.size());
+    for_each_draw(rng, [this, &log_predictive_density, y, predictors, t](
+        ScalarStateSpaceModelBase &worker, int d, RNG &draw_rng) {
+      log_predictive_density[d] =
+          advance_draw(worker, draws_[d], draw_rng, y, predictors, t);
+    });
+    double ans = lse(log_weights_ + log_predictive_density) - lse(log_weights_);
+    log_weights_ += log_predictive_density;
+    log_weights_ -= max(log_weights_);
+    ++time_dimension_;
+    ++number_of_appended_observations_;
+    if (effective_sample_size() < resampling_threshold_ * draws_.size()) {
+      resample_draws(rng);
+    }
+    return ans;
+  }
+
+  double Engine::advance_draw(ScalarStateSpaceModelBase &worker, Draw &draw,
+                              RNG &rng, double y, const Vector *predictors,
+                              int t) const {
+    if (predictors) {
+      y -= predictors->dot(draw.regression_coefficients);
+    }
+    if (method_ == FILTERED_STATE) {
+      // One step of the Kalman filter takes the predictive distribution of
+      // the state at time t to that at time t + 1.
+      Kalman::ScalarMarginalDistribution marginal(&worker, nullptr, t);
+      marginal.set_state_mean(draw.final_state);
+      marginal.set_state_variance(draw.final_state_variance);
+      double log_density = marginal.update(y, false, t);
+      draw.final_state = marginal.state_mean();
+      draw.final_state_variance = marginal.state_variance();
+      return log_density;
+    }
+
+    // Given the state at t - 1, the state at t has mean T * state and
+    // variance RQR'.  Draw it from its distribution given y by simulating the
+    // state and the observation jointly, and adjusting the state by the
+    // regression of state on observation.
+    SparseVector observation_coefficients(worker.observation_matrix(t));
+    Vector PZ = *worker.state_variance_matrix(t - 1)
+        * observation_coefficients.dense();
+    double observation_variance = worker.observation_variance(t);
+    double prediction_variance =
+        observation_coefficients.dot(PZ) + observation_variance;
+    double prediction_mean = observation_coefficients.dot(
+        *worker.state_transition_matrix(t - 1) * draw.final_state);
+    double log_density =
+        dnorm(y, prediction_mean, sqrt(prediction_variance), true);
+
+    Vector state = worker.simulate_next_state(rng, draw.final_state, t);
+    double simulated_y = observation_coefficients.dot(state)
+        + rnorm_mt(rng, 0, sqrt(observation_variance));
+    state.axpy(PZ, (y - simulated_y) / prediction_variance);
+    draw.final_state = state;
+    return log_density;
+  }
+
+  Vector Engine::draw_weights() const {
+    Vector ans = exp(log_weights_ - max(log_weights_));
+    ans /= ans.sum();
+    return ans;
+  }
+
+  double Engine::effective_sample_size() const {
+    if (draws_.empty()) return 0;
+    Vector weights = draw_weights();
+    return 1.0 / weights.dot(weights);
+  }
+
+  void Engine::resample_draws(RNG &rng) {
+    int ndraws = draws_.size();
+    if (ndraws == 0) return;
+    Vector weights = draw_weights();
+    std::vector<Draw> resampled;
+    resampled.reserve(ndraws);
+    double u = runif_mt(rng) / ndraws;
+    double cumulative_weight = weights[0];
+    int d = 0;
+    for (int i = 0; i < ndraws; ++i) {
+      double target = u + static_cast<double>(i) / ndraws;
+      while (cumulative_weight < target && d < ndraws - 1) {
+        cumulative_weight += weights[++d];
+      }
+      resampled.push_back(draws_[d]);
+    }
+    std::swap(draws_, resampled);
+    log_weights_ = 0.0;
+  }
+
+  void Engine::set_resampling_threshold(double fraction) {
+    if (fraction < 0 || fraction > 1) {
+      report_error("The resampling threshold must be between 0 and 1.");
+    }
+    resampling_threshold_ = fraction;
+  }
+
+  //---------------------------------------------------------------------------
+  Matrix Engine::forecast(RNG &rng, int horizon) {
+    if (regression_model_) {
+      report_error("The model has a regression component.  Forecasts need a "
+                   "matrix of predictors.");
+    }
+    return simulate(rng, horizon, nullptr);
+  }
+
+  Matrix Engine::forecast(RNG &rng, const Matrix &predictors) {
+    if (!regression_model_) {
+      report_error("The model has no regression component.  Forecasts need "
+                   "a horizon instead of predictors.");
+    }
+    if (predictors.ncol() != regression_model_->xdim()) {
+      report_error("The predictors have the wrong number of columns.");
+    }
+    return simulate(rng, predictors.nrow(), &predictors);
+  }
+
+  Matrix Engine::simulate(RNG &rng, int horizon, const Matrix *predictors) {
+    if (horizon < 0) {
+      report_error("The forecast horizon must be non-negative.");
+    }
+    Matrix ans(draws_.size(), horizon, 0.0);
+    if (draws_.empty() || horizon == 0) {
+      return ans;
+    }
+    for_each_draw(rng, [this, predictors, &ans](
+        ScalarStateSpaceModelBase &worker, int d, RNG &draw_rng) {
+      simulate_draw(worker, draws_[d], draw_rng, predictors, ans.row(d));
+    });
+    return ans;
+  }
+
+  void Engine::simulate_draw(ScalarStateSpaceModelBase &worker,
+                             const Draw &draw, RNG &rng,
+                             const Matrix *predictors,
+                             VectorView forecast) const {
+    int t0 = time_dimension_;
+    Vector state;
+    if (method_ == SAMPLED_STATE) {
+      state = draw.final_state;
+    } else {
+      // The filtered distribution already describes the state at time t0.
+      state = rmvn_robust_mt(rng, draw.final_state, draw.final_state_variance);
+    }
+    for (int t = 0; t < forecast.size(); ++t) {
+      if (t > 0 || method_ == SAMPLED_STATE) {
+        state = worker.simulate_next_state(rng, state, t0 + t);
+      }
+      double mean = worker.observation_matrix(t0 + t).dot(state);
+      if (predictors) {
+        mean += predictors->row(t).dot(draw.regression_coefficients);
+      }
+      forecast[t] = rnorm_mt(rng, mean,
+                             sqrt(worker.observation_variance(t0 + t)));
+    }
+  }
+
+  //---------------------------------------------------------------------------
+  void Engine::for_each_draw(
+      RNG &rng,
+      const std::function<void(ScalarStateSpaceModelBase &, int, RNG &)>
+          &task) {
+    int ndraws = draws_.size();
+    // Streams are tied to draws rather than threads, so results do not depend
+    // on the number of threads.
+    std::vector<RNG> rngs;
+    rngs.reserve(ndraws);
+    for (int d = 0; d < ndraws; ++d) {
+      rngs.push_back(rng.split());
+    }
+
+    auto run_block = [this, &task, &rngs](int worker_index, int begin,
+                                          int end) {
+      ScalarStateSpaceModelBase &worker(*workers_[worker_index]);
+      for (int d = begin; d < end; ++d) {
+        worker.unvectorize_params(draws_[d].parameters, false);
+        task(worker, d, rngs[d]);
+      }
+    };
+
+    create_workers(number_of_blocks(pool_, ndraws));
+    run_in_blocks(pool_, ndraws, run_block, "blocks of forecast draws");
+  }
+
+  void Engine::create_workers(int number_of_workers) {
+    while (workers_.size() < number_of_workers) {
+      Ptr<ScalarStateSpaceModelBase> worker(model_->clone());
+      worker->set_state_model_behavior(StateModel::MARGINAL);
+      workers_.push_back(worker);
+    }
+  }
+
+}  // namespace BOOM
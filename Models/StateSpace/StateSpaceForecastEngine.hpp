@@ -0,0 +1,234 @@
+#ifndef BOOM_STATE_SPACE_FORECAST_ENGINE_HPP_
+#define BOOM_STATE_SPACE_FORECAST_ENGINE_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <functional>
+#include <vector>
+#include "Models/StateSpace/StateSpaceModelBase.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  class StateSpaceRegressionModel;
+
+  // Serves forecasts from a fitted Gaussian state space model
+  // (StateSpaceModel or StateSpaceRegressionModel) without re-running the
+  // Kalman filter over the training data.
+  //
+  // During (or after) MCMC, record_draw() caches the model parameters, the
+  // regression coefficients, and the state as of the end of the training data.
+  // A forecast then only has to project the cached state forward, which costs
+  // O(horizon * state_dimension) per draw.  Draws are simulated in parallel
+  // if threads have been set.
+  //
+  // Typical use:
+  //   StateSpaceForecastEngine engine(model.get());
+  //   for (int i = 0; i < niter; ++i) {
+  //     model->sample_posterior();
+  //     engine.record_draw();
+  //   }
+  //   engine.set_number_of_threads(4);
+  //   Matrix draws = engine.forecast(rng, new_predictors);
+  //
+  // New observations can be folded into the cached draws as they arrive with
+  // append_observation(), at a cost per observation that does not depend on
+  // the length of the training data.  Each draw's state is advanced by one
+  // Kalman filter step (or, for sampled states, by a draw from the state
+  // given the new observation), and the draw's weight is multiplied by the
+  // predictive likelihood of the observation, as in a particle filter.  The
+  // parameters are not updated, so once the weights degenerate (see
+  // effective_sample_size()) the model should be refit.
+  //
+  // The structure of the model (its state models and predictors) must not
+  // change once draws have been recorded.
+  class StateSpaceForecastEngine {
+   public:
+    // How the state at the end of the training data is summarized.
+    enum FinalStateMethod {
+      // Cache the state at time_dimension() - 1 from the model's most recent
+      // state draw.  This costs nothing at recording time.
+      SAMPLED_STATE,
+
+      // Run the Kalman filter at recording time and cache the mean and
+      // variance of the predictive distribution of the state at
+      // time_dimension().  Each forecast draws its starting state from this
+      // distribution.
+      FILTERED_STATE
+    };
+
+    // Args:
+    //   model: The model whose draws are to be recorded.  The model must
+    //     outlive the engine.  It must be a StateSpaceModel or a
+    //     StateSpaceRegressionModel.
+    //   method:  How the state at the end of the training data is cached.
+    explicit StateSpaceForecastEngine(ScalarStateSpaceModelBase *model,
+                                      FinalStateMethod method = SAMPLED_STATE);
+
+    // Cache the current parameters and final state of the model.  Draws
+    // cannot be recorded after observations have been appended.
+    void record_draw();
+
+    // Discard all recorded draws and appended observations.
+    void clear_draws();
+
+    int number_of_draws() const { return draws_.size(); }
+
+    // The number of time points described by the cached draws: the model's
+    // time dimension plus the number of appended observations.  Forecasts
+    // start at this time index.
+    int time_dimension() const { return time_dimension_; }
+
+    // Advance every draw by one time point.
+    //
+    // Args:
+    //   rng:  The random number generator used to seed the update.
+    //   y:  The newly observed value of the series.
+    //   predictors: The predictors for the new observation.  Required for
+    //     StateSpaceRegressionModel, and not allowed otherwise.
+    //
+    // Returns:
+    //   The log of the weighted average of the predictive densities of y.
+    double append_observation(RNG &rng, double y);
+    double append_observation(RNG &rng, double y, const Vector &predictors);
+
+    // The normalized importance weights of the draws.  All weights are equal
+    // until observations are appended.
+    Vector draw_weights() const;
+
+    // The effective sample size, 1 / sum(weights^2), of the weighted draws.
+    double effective_sample_size() const;
+
+    // Replace the draws by a systematic resample drawn in proportion to
+    // their weights, and reset the weights to be equal.
+    void resample_draws(RNG &rng);
+
+    // If the effective sample size falls below 'fraction' times the number of
+    // draws after an observation is appended, the draws are resampled.  The
+    // default of 0 never resamples automatically.
+    void set_resampling_threshold(double fraction);
+
+    // Forecasts are simulated on 'nthreads' threads.  Values less than 2
+    // simulate on the calling thread.  Each draw gets its own RNG stream,
+    // so results do not depend on the number of threads.
+    void set_number_of_threads(int nthreads);
+
+    // Simulate forecasts for a model without a regression component.
+    //
+    // Args:
+    //   rng:  The random number generator used to seed the simulation.
+    //   horizon:  The number of periods after the training data to forecast.
+    //
+    // Returns:
+    //   A matrix with a row for each recorded draw and a column for each
+    //   forecast period, containing draws from the posterior predictive
+    //   distribution.  If observations have been appended, rows should be
+    //   weighted by draw_weights().
+    Matrix forecast(RNG &rng, int horizon);
+
+    // Simulate forecasts for a StateSpaceRegressionModel.
+    //
+    // Args:
+    //   rng:  The random number generator used to seed the simulation.
+    //   predictors: The predictors for the forecast periods.  Row t contains
+    //     the predictors for period time_dimension() + t.
+    //
+    // Returns:
+    //   A matrix with a row for each recorded draw and a column for each row
+    //   of 'predictors'.
+    Matrix forecast(RNG &rng, const Matrix &predictors);
+
+   private:
+    struct Draw {
+      // The non-minimal vector of model parameters.
+      Vector parameters;
+
+      // The dense vector of regression coefficients, including zeros for
+      // excluded predictors.  Empty if the model has no regression.
+      Vector regression_coefficients;
+
+      // The sampled state at time_dimension() - 1, or the mean of the state at
+      // time_dimension(), depending on method_.
+      Vector final_state;
+
+      // The variance of the state at time_dimension().  Only used for
+      // FILTERED_STATE.
+      SpdMatrix final_state_variance;
+    };
+
+    Matrix simulate(RNG &rng, int horizon, const Matrix *predictors);
+
+    double append(RNG &rng, double y, const Vector *predictors);
+
+    // Advance 'draw' by one time point, given the observation y at time t.
+    // Returns the log predictive density of y.
+    double advance_draw(ScalarStateSpaceModelBase &worker, Draw &draw,
+                        RNG &rng, double y, const Vector *predictors,
+                        int t) const;
+
+    // Call task(worker, d, rng) for each draw d.  Each draw gets its own RNG
+    // stream split from 'rng', and its own worker's parameters set to those
+    // of the draw.  Blocks of draws run on separate threads if threads have
+    // been set.
+    void for_each_draw(
+        RNG &rng,
+        const std::function<void(ScalarStateSpaceModelBase &, int, RNG &)>
+            &task);
+
+    // Simulate the forecast for one draw.
+    //
+    // Args:
+    //   worker: A copy of the model used for the simulation.  Its parameters
+    //     are overwritten with those of the draw.
+    //   draw:  The cached draw.
+    //   rng:  The random number generator for this draw.
+    //   predictors: The predictors for the forecast period, or nullptr if the
+    //     model has no regression.
+    //   forecast:  The output, with one element per forecast period.
+    void simulate_draw(ScalarStateSpaceModelBase &worker, const Draw &draw,
+                       RNG &rng, const Matrix *predictors,
+                       VectorView forecast) const;
+
+    // Ensure workers_ holds at least 'number_of_workers' copies of the model.
+    void create_workers(int number_of_workers);
+
+    ScalarStateSpaceModelBase *model_;
+    StateSpaceRegressionModel *regression_model_;
+    FinalStateMethod method_;
+    std::vector<Draw> draws_;
+
+    // Unnormalized log importance weights for draws_.
+    Vector log_weights_;
+
+    int time_dimension_;
+    int number_of_appended_observations_;
+    double resampling_threshold_;
+
+    // Copies of model_ used for simulation, so forecasting leaves model_
+    // untouched, and so each thread owns the model it works with.
+    std::vector<Ptr<ScalarStateSpaceModelBase>> workers_;
+    ThreadWorkerPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_FORECAST_ENGINE_HPP_
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include "Models/StateSpace/StateSpaceRegressionModel.hpp"
+#include "Models/StateSpace/StateSpaceForecastEngine.hpp"
 #include "Models/StateSpace/PosteriorSamplers/StateSpacePosteriorSampler.hpp"
 
 #include "Models/StateSpace/StateModels/LocalLevelStateModel.hpp"
@@ -24,6 +25,52 @@ namespace {
     StateSpaceRegressionModelTest() {
       GlobalRng::rng.seed(8675309);
     }
+
+    // Simulates sample_size observations from a local level plus a
+    // regression on two predictors, and builds a model with a local level and
+    // posterior samplers, holding the first 'train' observations.  The
+    // sampler is run for 100 burn-in iterations.
+    void build_local_level_model(int sample_size, int train) {
+      int xdim = 2;
+      double innovation_sd = 1.1;
+      double residual_sd = .2;
+
+      model_.reset(new StateSpaceRegressionModel(xdim));
+      predictors_ = Matrix(sample_size, xdim);
+      predictors_.randomize();
+      Vector coefficients = {10.0, 20.0};
+      y_ = cumsum(rnorm_vector(sample_size, 0, innovation_sd))
+          + predictors_ * coefficients
+          + rnorm_vector(sample_size, 0, residual_sd);
+
+      NEW(LocalLevelStateModel, state_model)(square(innovation_sd));
+      NEW(ZeroMeanGaussianConjSampler, state_model_sampler)(
+          state_model.get(), 1, innovation_sd);
+      state_model->set_method(state_model_sampler);
+      state_model->set_initial_state_mean(0);
+      state_model->set_initial_state_variance(square(innovation_sd));
+      model_->add_state(state_model);
+
+      NEW(RegressionSemiconjugateSampler, observation_model_sampler)(
+          model_->observation_model(),
+          new MvnModel(Vector(xdim, 0), SpdMatrix(xdim, square(xdim * 100.0))),
+          new ChisqModel(1, residual_sd));
+      model_->observation_model()->set_method(observation_model_sampler);
+      NEW(StateSpacePosteriorSampler, sampler)(model_.get());
+      model_->set_method(sampler);
+
+      for (int i = 0; i < train; ++i) {
+        model_->add_regression_data(
+            new RegressionData(y_[i], predictors_.row(i)));
+      }
+      for (int i = 0; i < 100; ++i) {
+        model_->sample_posterior();
+      }
+    }
+
+    Ptr<StateSpaceRegressionModel> model_;
+    Matrix predictors_;
+    Vector y_;
   };
 
   TEST_F(StateSpaceRegressionModelTest, Forecasting) {
@@ -90,7 +137,7 @@ namespace {
       model->sample_posterior();
     }
 
-    int niter = 500;
+    int niter = 1000;
     Matrix coefficient_draws(niter, xdim);
     Vector residual_sd_draws(niter);
     Matrix state_draws(niter, train);
@@ -117,4 +164,128 @@ namespace {
                                          .95, .2));
   }
 
+  TEST_F(StateSpaceRegressionModelTest, ForecastEngine) {
+    int sample_size = 120;
+    int train = 100;
+    build_local_level_model(sample_size, train);
+    Matrix test_predictors = ConstSubMatrix(
+        predictors_, train, sample_size - 1,
+        0, ncol(predictors_) - 1).to_matrix();
+    int horizon = test_predictors.nrow();
+
+    StateSpaceForecastEngine engine(model_.get());
+    StateSpaceForecastEngine filtered_engine(
+        model_.get(), StateSpaceForecastEngine::FILTERED_STATE);
+    int niter = 400;
+    Matrix direct_draws(niter, horizon);
+    for (int i = 0; i < niter; ++i) {
+      model_->sample_posterior();
+      engine.record_draw();
+      filtered_engine.record_draw();
+      direct_draws.row(i) = model_->simulate_forecast(
+          GlobalRng::rng, test_predictors, Vector(model_->final_state()));
+    }
+    EXPECT_EQ(niter, engine.number_of_draws());
+
+    Vector parameters = model_->vectorize_params(false);
+    RNG rng(17);
+    Matrix engine_draws = engine.forecast(rng, test_predictors);
+    EXPECT_EQ(niter, engine_draws.nrow());
+    EXPECT_EQ(horizon, engine_draws.ncol());
+    // Forecasting does not disturb the model.
+    EXPECT_TRUE(VectorEquals(parameters, model_->vectorize_params(false)));
+
+    // Results do not depend on the number of threads.
+    engine.set_number_of_threads(3);
+    RNG threaded_rng(17);
+    EXPECT_TRUE(MatrixEquals(engine_draws,
+                             engine.forecast(threaded_rng, test_predictors)));
+
+    // Both caching methods draw from the same distribution as
+    // simulate_forecast.
+    Matrix filtered_draws = filtered_engine.forecast(rng, test_predictors);
+    for (int t = 0; t < horizon; ++t) {
+      Vector direct_column(direct_draws.col(t));
+      for (const Matrix *draws : {&engine_draws, &filtered_draws}) {
+        Vector column(draws->col(t));
+        double standard_error = sqrt(
+            (var(column) + var(direct_column)) / niter);
+        EXPECT_NEAR(mean(column), mean(direct_column), 4 * standard_error)
+            << "t = " << t;
+        EXPECT_NEAR(sd(column), sd(direct_column), .15 * sd(direct_column))
+            << "t = " << t;
+      }
+    }
+  }
+
+  TEST_F(StateSpaceRegressionModelTest, ForecastEngineAppendsObservations) {
+    int sample_size = 110;
+    int train = 100;
+    build_local_level_model(sample_size, train);
+    int xdim = ncol(predictors_);
+
+    StateSpaceForecastEngine engine(model_.get());
+    StateSpaceForecastEngine threaded_engine(model_.get());
+    threaded_engine.set_number_of_threads(3);
+    int niter = 200;
+    for (int i = 0; i < niter; ++i) {
+      model_->sample_posterior();
+      engine.record_draw();
+      threaded_engine.record_draw();
+    }
+
+    // A single filtered draw, whose parameters stay fixed while data are
+    // added to the model.
+    StateSpaceForecastEngine filtered_engine(
+        model_.get(), StateSpaceForecastEngine::FILTERED_STATE);
+    filtered_engine.record_draw();
+    double training_loglike = model_->log_likelihood();
+
+    RNG rng(17);
+    RNG threaded_rng(17);
+    RNG filtered_rng(23);
+    double appended_loglike = 0;
+    for (int i = train; i < sample_size; ++i) {
+      Vector x(predictors_.row(i));
+      EXPECT_EQ(engine.append_observation(rng, y_[i], x),
+                threaded_engine.append_observation(threaded_rng, y_[i], x));
+      appended_loglike +=
+          filtered_engine.append_observation(filtered_rng, y_[i], x);
+    }
+    EXPECT_EQ(sample_size, engine.time_dimension());
+    EXPECT_TRUE(VectorEquals(engine.draw_weights(),
+                             threaded_engine.draw_weights()));
+    EXPECT_NEAR(1.0, engine.draw_weights().sum(), 1e-8);
+    EXPECT_GT(engine.effective_sample_size(), 1.0);
+    EXPECT_LE(engine.effective_sample_size(), niter + 1e-8);
+
+    // Appending observations to the filtered draw reproduces the Kalman
+    // filter run over the full data.
+    for (int i = train; i < sample_size; ++i) {
+      model_->add_regression_data(
+          new RegressionData(y_[i], predictors_.row(i)));
+    }
+    model_->kalman_filter();
+    EXPECT_NEAR(model_->log_likelihood() - training_loglike,
+                appended_loglike, 1e-6);
+    StateSpaceForecastEngine refit_engine(
+        model_.get(), StateSpaceForecastEngine::FILTERED_STATE);
+    refit_engine.record_draw();
+    Matrix future_predictors(3, xdim);
+    future_predictors.randomize();
+    RNG forecast_rng(29);
+    RNG refit_rng(29);
+    Matrix filtered_forecast =
+        filtered_engine.forecast(forecast_rng, future_predictors);
+    Matrix refit_forecast = refit_engine.forecast(refit_rng, future_predictors);
+    for (int t = 0; t < future_predictors.nrow(); ++t) {
+      EXPECT_NEAR(refit_forecast(0, t), filtered_forecast(0, t), 1e-6);
+    }
+
+    // Resampling resets the weights.
+    engine.resample_draws(rng);
+    EXPECT_EQ(niter, engine.number_of_draws());
+    EXPECT_NEAR(niter, engine.effective_sample_size(), 1e-6);
+  }
+
 }  // namespace
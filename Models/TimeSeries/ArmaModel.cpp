@@ -17,8 +17,9 @@
 */
 
 #include "Models/TimeSeries/ArmaModel.hpp"
-#include "Models/StateSpace/Filters/SparseKalmanTools.hpp"
 #include "Models/TimeSeries/ArModel.hpp"
+#include "TargetFun/AutoDiff.hpp"
+#include "cpputil/Constants.hpp"
 #include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
 
@@ -27,6 +28,83 @@ namespace BOOM {
   namespace {
     using ASSTM = ArmaStateSpaceTransitionMatrix;
     using ASSVM = ArmaStateSpaceVarianceMatrix;
+
+    // The Kalman filter log likelihood behind every ArmaModel::log_likelihood
+    // overload, written for a generic scalar type so it can be evaluated on
+    // doubles or differentiated by AutoDiff.  The argument is [phi, theta, sigsq].  Matrices are dense
+    // and stored by rows, and the structure of the transition matrix (phi in
+    // the first column, ones on the superdiagonal) is used explicitly.
+    class ArmaLogLikelihood {
+     public:
+      ArmaLogLikelihood(const std::vector<Ptr<DoubleData>> &data, int p,
+                        int q)
+          : data_(data), p_(p), q_(q), dim_(std::max(p, q + 1)) {}
+
+      template <class Scalar>
+      Scalar operator()(const std::vector<Scalar> &x) const {
+        using std::log;
+        using AutoDiff::value_of;
+        std::vector<Scalar> phi(dim_, Scalar(0.0));
+        std::vector<Scalar> theta(dim_, Scalar(0.0));
+        for (int i = 0; i < p_; ++i) phi[i] = x[i];
+        theta[0] = 1.0;
+        for (int i = 0; i < q_; ++i) theta[i + 1] = x[p_ + i];
+        const Scalar &sigsq(x[p_ + q_]);
+
+        std::vector<Scalar> a(dim_, Scalar(0.0));
+        std::vector<Scalar> P(dim_ * dim_, Scalar(0.0));
+        for (int i = 0; i < dim_; ++i) P[i * dim_ + i] = 10 * sigsq;
+        std::vector<Scalar> TPZ(dim_), kalman_gain(dim_), TP(dim_ * dim_);
+
+        Scalar ans = 0.0;
+        int time_dimension = data_.size();
+        for (int t = 1; t < time_dimension; ++t) {
+          const Scalar &F(P[0]);
+          if (value_of(F) <= 0) {
+            report_error("Found a zero (or negative) forecast variance.");
+          }
+          Scalar v = data_[t]->value() - a[0];
+          ans -= Constants::log_root_2pi + 0.5 * (log(F) + v * v / F);
+
+          // T * P, and T * P * Z, which is its first column.
+          for (int i = 0; i < dim_; ++i) {
+            for (int j = 0; j < dim_; ++j) {
+              Scalar &TPij(TP[i * dim_ + j]);
+              TPij = phi[i] * P[j];
+              if (i + 1 < dim_) TPij += P[(i + 1) * dim_ + j];
+            }
+            TPZ[i] = TP[i * dim_];
+            kalman_gain[i] = TPZ[i] / F;
+          }
+
+          // a = T * a + K * v.
+          Scalar a0 = a[0];
+          for (int i = 0; i < dim_; ++i) {
+            a[i] = phi[i] * a0 + kalman_gain[i] * v;
+            if (i + 1 < dim_) a[i] += a[i + 1];
+          }
+
+          // P = T * P * T' - TPZ * K' + sigsq * theta * theta'.
+          for (int i = 0; i < dim_; ++i) {
+            for (int j = i; j < dim_; ++j) {
+              Scalar Pij = TP[i * dim_] * phi[j];
+              if (j + 1 < dim_) Pij += TP[i * dim_ + j + 1];
+              Pij -= TPZ[i] * kalman_gain[j];
+              Pij += sigsq * theta[i] * theta[j];
+              P[i * dim_ + j] = Pij;
+              P[j * dim_ + i] = Pij;
+            }
+          }
+        }
+        return ans;
+      }
+
+     private:
+      const std::vector<Ptr<DoubleData>> &data_;
+      int p_;
+      int q_;
+      int dim_;
+    };
   }  // namespace
 
   ASSTM::ArmaStateSpaceTransitionMatrix(const Vector &expanded_ar_coefficients)
@@ -247,42 +325,53 @@ namespace BOOM {
     if (sigsq <= 0) {
       return negative_infinity();
     }
-    double ans = 0;
-
-    int state_dimension = std::max(ar_dimension(), ma_dimension() + 1);
+    Vector params = concat(concat(ar_coefficients, ma_coefficients), sigsq);
+    ArmaLogLikelihood loglike(dat(), ar_dimension(), ma_dimension());
+    return loglike(std::vector<double>(params.begin(), params.end()));
+  }
 
-    SparseVector Z(state_dimension);
-    Z[0] = 1.0;
+  double ArmaModel::log_likelihood(const Vector &ar_coefficients,
+                                   const Vector &ma_coefficients,
+                                   double sigsq, Vector &gradient) const {
+    Matrix hessian;
+    return log_likelihood_and_derivatives(ar_coefficients, ma_coefficients,
+                                          sigsq, gradient, hessian, 1);
+  }
 
-    BlockDiagonalMatrix transition_matrix;
-    transition_matrix.add_block(new ArmaStateSpaceTransitionMatrix(
-        expand_ar_coefficients(ar_coefficients, state_dimension)));
+  double ArmaModel::log_likelihood(const Vector &ar_coefficients,
+                                   const Vector &ma_coefficients,
+                                   double sigsq, Vector &gradient,
+                                   Matrix &hessian) const {
+    return log_likelihood_and_derivatives(ar_coefficients, ma_coefficients,
+                                          sigsq, gradient, hessian, 2);
+  }
 
-    BlockDiagonalMatrix state_variance_matrix;
-    state_variance_matrix.add_block(new ArmaStateSpaceVarianceMatrix(
-        expand_ma_coefficients(ma_coefficients, state_dimension), sigsq));
-
-    // Initial distribution of the state at time 0.  It might be better to use
-    // the stationary or prior distribution here.
-    Vector a(state_dimension, 0.0);
-    SpdMatrix P(state_dimension, 0.0);
-    P.diag() = 10 * sigsq;
-
-    // Define some working variables needed by the Kalman filter.
-    Vector kalman_gain(state_dimension);
-    double forecast_error_variance = 0;
-    double forecast_error = 0;
-    bool missing = false;
-
-    const std::vector<Ptr<DoubleData>> &data(dat());
-    int time_dimension = data.size();
-    for (int t = 1; t < time_dimension; ++t) {
-      ans += sparse_scalar_kalman_update(
-          data[t]->value(), a, P, kalman_gain, forecast_error_variance,
-          forecast_error, missing, Z, 0, transition_matrix,
-          state_variance_matrix);
+  double ArmaModel::log_likelihood_and_derivatives(
+      const Vector &ar_coefficients, const Vector &ma_coefficients,
+      double sigsq, Vector &gradient, Matrix &hessian, int nderiv) const {
+    if (ar_coefficients.size() != ar_dimension()) {
+      report_error("ar_coefficients are the wrong size.");
+    }
+    if (ma_coefficients.size() != ma_dimension()) {
+      report_error("ma_coefficients are the wrong size.");
+    }
+    int nparams = ar_dimension() + ma_dimension() + 1;
+    if (sigsq <= 0) {
+      gradient.resize(nparams);
+      gradient = 0.0;
+      if (nderiv > 1) {
+        hessian.resize(nparams, nparams);
+        hessian = 0.0;
+      }
+      return negative_infinity();
+    }
+    Vector params = concat(concat(ar_coefficients, ma_coefficients), sigsq);
+    ArmaLogLikelihood loglike(dat(), ar_dimension(), ma_dimension());
+    if (nderiv > 1) {
+      return AutoDiff::hessian(loglike, params, gradient, hessian);
+    } else {
+      return AutoDiff::gradient(loglike, params, gradient);
     }
-    return ans;
   }
 
   Vector ArmaModel::expand_ar_coefficients(const Vector &ar_coefficients,
@@ -201,6 +201,28 @@ namespace BOOM {
     double log_likelihood(const Vector &ar_coefficients,
                           const Vector &ma_coefficients, double sigsq) const;
 
+    // The log likelihood, along with its derivatives with respect to the
+    // parameter vector [ar_coefficients, ma_coefficients, sigsq].  The
+    // derivatives are computed by automatic differentiation of the Kalman
+    // filter, so they are exact up to rounding error.  The gradient costs a
+    // small multiple of a log likelihood evaluation.  The Hessian is more
+    // expensive, scaling with the square of the number of parameters.
+    //
+    // Args:
+    //   ar_coefficients, ma_coefficients, sigsq:  As above.
+    //   gradient:  On output, the gradient of the log likelihood.
+    //   hessian:  On output, the Hessian of the log likelihood.
+    //
+    // Returns:
+    //   The log likelihood of the data.  If sigsq is not positive, negative
+    //   infinity is returned and the derivatives are set to zero.
+    double log_likelihood(const Vector &ar_coefficients,
+                          const Vector &ma_coefficients, double sigsq,
+                          Vector &gradient) const;
+    double log_likelihood(const Vector &ar_coefficients,
+                          const Vector &ma_coefficients, double sigsq,
+                          Vector &gradient, Matrix &hessian) const;
+
     // Simulate an ARMA process of the specified length.
     // Args:
     //   length:  The desired number of observations in the simulated series.
@@ -266,6 +288,13 @@ namespace BOOM {
     // set of filter coefficients, and phi is the set of AR coefficients.
     double filter_ar_dot_product(const Vector &filter_coefficients) const;
 
+    // Implements the log_likelihood overloads that compute derivatives.  If
+    // nderiv is 1 then only the gradient is computed.
+    double log_likelihood_and_derivatives(const Vector &ar_coefficients,
+                                          const Vector &ma_coefficients,
+                                          double sigsq, Vector &gradient,
+                                          Matrix &hessian, int nderiv) const;
+
     // Convenience functions for accessing the AR and MA coefficients in the
     // unit-offset framework in which they're written about mathematically.  If
     // n is larger than the index of the largest coefficient then 0 is returned.
@@ -3,6 +3,7 @@
 #include "Models/TimeSeries/ArmaPriors.hpp"
 #include "Models/TimeSeries/PosteriorSamplers/ArmaSliceSampler.hpp"
 #include "Models/ChisqModel.hpp"
+#include "numopt/NumericalDerivatives.hpp"
 #include "test_utils/test_utils.hpp"
 
 namespace {
@@ -113,6 +114,67 @@ namespace {
     EXPECT_LT(wrong_log_likelihood, true_log_likelihood);
   }
 
+  TEST_F(ArmaModelTest, LogLikelihoodDerivatives) {
+    ArmaModel model(new GlmCoefs(phi_),
+                    new VectorParams(theta_),
+                    new UnivParams(1.8));
+    Vector y = model.simulate(200, GlobalRng::rng);
+    for (int i = 0; i < y.size(); ++i) {
+      model.add_data(new DoubleData(y[i]));
+    }
+
+    Vector gradient;
+    Matrix hessian;
+    double loglike = model.log_likelihood(phi_, theta_, 1.8);
+    EXPECT_NEAR(loglike, model.log_likelihood(phi_, theta_, 1.8, gradient),
+                1e-8);
+    EXPECT_NEAR(loglike,
+                model.log_likelihood(phi_, theta_, 1.8, gradient, hessian),
+                1e-8);
+    EXPECT_EQ(5, gradient.size());
+    EXPECT_EQ(5, hessian.nrow());
+    EXPECT_TRUE(hessian.is_sym(1e-8));
+
+    auto vectorized_loglike = [&model](const Vector &params) {
+      return model.log_likelihood(Vector(ConstVectorView(params, 0, 2)),
+                                  Vector(ConstVectorView(params, 2, 2)),
+                                  params[4]);
+    };
+    Vector params = concat(concat(phi_, theta_), 1.8);
+    NumericalDerivatives numeric(vectorized_loglike);
+    EXPECT_TRUE(VectorEquals(gradient, numeric.gradient(params), 1e-4))
+        << "gradient = " << gradient << endl
+        << "numeric  = " << numeric.gradient(params);
+
+    // Second-order finite differences are too noisy to check the Hessian
+    // precisely, so compare its columns to central differences of the
+    // gradient.
+    double h = 1e-5;
+    for (int j = 0; j < 5; ++j) {
+      Vector up = params;
+      Vector down = params;
+      up[j] += h;
+      down[j] -= h;
+      Vector gradient_up, gradient_down;
+      model.log_likelihood(Vector(ConstVectorView(up, 0, 2)),
+                           Vector(ConstVectorView(up, 2, 2)), up[4],
+                           gradient_up);
+      model.log_likelihood(Vector(ConstVectorView(down, 0, 2)),
+                           Vector(ConstVectorView(down, 2, 2)), down[4],
+                           gradient_down);
+      Vector difference = (gradient_up - gradient_down) / (2 * h);
+      EXPECT_TRUE(VectorEquals(hessian.col(j), difference,
+                               1e-5 * (1 + difference.max_abs())))
+          << "column " << j << endl
+          << "hessian    = " << hessian.col(j) << endl
+          << "difference = " << difference;
+    }
+
+    Vector reference_gradient;
+    model.log_likelihood(phi_, theta_, 1.8, reference_gradient);
+    EXPECT_TRUE(VectorEquals(gradient, reference_gradient));
+  }
+
   TEST_F(ArmaModelTest, Acf) {
     ArmaModel model(new GlmCoefs(phi_),
                     new VectorParams(theta_),
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "Models/DataTypes.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class DataTypesTest : public ::testing::Test {
+   protected:
+    DataTypesTest() {}
+  };
+
+  // Observers are allocated on demand, and are not shared by copies.
+  TEST_F(DataTypesTest, Observers) {
+    NEW(DoubleData, data)(1.0);
+    EXPECT_FALSE(data->has_observers());
+    data->set(2.0);
+
+    int count = 0;
+    data->add_observer(&count, [&count]() { ++count; });
+    EXPECT_TRUE(data->has_observers());
+    data->set(3.0);
+    EXPECT_EQ(1, count);
+    data->set(4.0, false);
+    EXPECT_EQ(1, count);
+
+    Ptr<DoubleData> copy = data->clone();
+    EXPECT_FALSE(copy->has_observers());
+    copy->set(5.0);
+    EXPECT_EQ(1, count);
+
+    // Assigning a new value keeps the observers of the assigned object.
+    *data = *copy;
+    EXPECT_TRUE(data->has_observers());
+    EXPECT_DOUBLE_EQ(5.0, data->value());
+    data->set(6.0);
+    EXPECT_EQ(2, count);
+
+    data->remove_observer(&count);
+    EXPECT_FALSE(data->has_observers());
+    data->set(7.0);
+    EXPECT_EQ(2, count);
+  }
+
+  // An observer may remove itself while it is being signaled, without
+  // disturbing the other observers.
+  TEST_F(DataTypesTest, ObserverRemovesItself) {
+    NEW(DoubleData, data)(1.0);
+    int self_removing_count = 0;
+    int count = 0;
+    DoubleData *raw = data.get();
+    data->add_observer(&self_removing_count, [&self_removing_count, raw]() {
+      ++self_removing_count;
+      raw->remove_observer(&self_removing_count);
+    });
+    data->add_observer(&count, [&count]() { ++count; });
+
+    data->set(2.0);
+    EXPECT_EQ(1, self_removing_count);
+    EXPECT_EQ(1, count);
+    EXPECT_TRUE(data->has_observers());
+
+    data->set(3.0);
+    EXPECT_EQ(1, self_removing_count);
+    EXPECT_EQ(2, count);
+
+    // The last observer can remove itself too.
+    data->remove_observer(&count);
+    data->add_observer(&count, [&count, raw]() {
+      ++count;
+      raw->remove_observer(&count);
+    });
+    data->set(4.0);
+    EXPECT_EQ(3, count);
+    EXPECT_FALSE(data->has_observers());
+  }
+
+  // An observer removed during a signal is not called by that signal, even
+  // if it has not been reached yet.
+  TEST_F(DataTypesTest, ObserverRemovesAnotherObserver) {
+    NEW(DoubleData, data)(1.0);
+    // Observers are called in the order of their owner's address.
+    int counts[2] = {0, 0};
+    DoubleData *raw = data.get();
+    data->add_observer(&counts[1], [&counts]() { ++counts[1]; });
+    data->add_observer(&counts[0], [&counts, raw]() {
+      ++counts[0];
+      raw->remove_observer(&counts[1]);
+    });
+
+    data->set(2.0);
+    EXPECT_EQ(1, counts[0]);
+    EXPECT_EQ(0, counts[1]);
+    EXPECT_TRUE(data->has_observers());
+
+    // Clearing the observers from inside a signal stops the rest of them.
+    data->remove_observer(&counts[0]);
+    data->add_observer(&counts[0], [&counts, raw]() {
+      ++counts[0];
+      raw->clear_observers();
+    });
+    data->add_observer(&counts[1], [&counts]() { ++counts[1]; });
+    data->set(3.0);
+    EXPECT_EQ(2, counts[0]);
+    EXPECT_EQ(0, counts[1]);
+    EXPECT_FALSE(data->has_observers());
+    data->set(4.0);
+    EXPECT_EQ(2, counts[0]);
+    EXPECT_EQ(0, counts[1]);
+  }
+
+  // An unobserved Data object should be a small object.  The observer
+  // collection costs a single pointer until it is needed.
+  TEST_F(DataTypesTest, Size) {
+    EXPECT_LE(sizeof(DoubleData), 6 * sizeof(void *));
+  }
+
+}  // namespace
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "Models/DrawStorage.hpp"
+#include "Models/GaussianModel.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+#include <cstdio>
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class DrawStorageTest : public ::testing::Test {
+   protected:
+    DrawStorageTest() : filename_("draw_storage_test.bin") {
+      GlobalRng::rng.seed(8675309);
+    }
+    ~DrawStorageTest() override { std::remove(filename_.c_str()); }
+    std::string filename_;
+  };
+
+  TEST_F(DrawStorageTest, DoublePrecisionRoundTrip) {
+    // Draws of dimension 7 do not evenly divide a page, so some draws
+    // straddle the boundary between two chunks.
+    int dim = 7;
+    int ndraws = 1000;
+    Matrix draws(ndraws, dim);
+    draws.randomize();
+    {
+      DrawFileWriter writer(filename_, dim, DrawStorage::Precision::FLOAT64,
+                            1, .001);
+      for (int i = 0; i < ndraws; ++i) {
+        writer.write(draws.row(i));
+      }
+      EXPECT_EQ(ndraws, writer.number_of_draws());
+    }
+
+    DrawFileReader reader(filename_);
+    EXPECT_EQ(dim, reader.dimension());
+    EXPECT_EQ(ndraws, reader.number_of_draws());
+    EXPECT_EQ(1, reader.thin());
+    EXPECT_TRUE(MatrixEquals(draws, reader.draws(0, ndraws)));
+    EXPECT_TRUE(VectorEquals(draws.row(17), reader.draw(17)));
+    EXPECT_TRUE(VectorEquals(draws.col(3), reader.component(3)));
+    EXPECT_THROW(reader.draw(ndraws), std::exception);
+  }
+
+  TEST_F(DrawStorageTest, SinglePrecisionWithThinning) {
+    int dim = 3;
+    int niter = 100;
+    int thin = 7;
+    Matrix draws(niter, dim);
+    draws.randomize();
+    DrawFileWriter writer(filename_, dim, DrawStorage::Precision::FLOAT32,
+                          thin);
+    for (int i = 0; i < niter; ++i) {
+      // Strided views are acceptable input.
+      writer.write(draws.row(i));
+    }
+    writer.close();
+    EXPECT_THROW(writer.write(draws.row(0)), std::exception);
+
+    DrawFileReader reader(filename_);
+    EXPECT_EQ(15, reader.number_of_draws());
+    EXPECT_EQ(thin, reader.thin());
+    EXPECT_TRUE(reader.precision() == DrawStorage::Precision::FLOAT32);
+    for (int i = 0; i < reader.number_of_draws(); ++i) {
+      EXPECT_TRUE(VectorEquals(draws.row(i * thin), reader.draw(i), 1e-6));
+    }
+  }
+
+  TEST_F(DrawStorageTest, ReadWhileWriting) {
+    DrawFileWriter writer(filename_, 2);
+    writer.write(Vector{1.0, 2.0});
+    writer.write(Vector{3.0, 4.0});
+    writer.flush();
+    {
+      DrawFileReader reader(filename_);
+      EXPECT_EQ(2, reader.number_of_draws());
+      EXPECT_TRUE(VectorEquals(Vector{3.0, 4.0}, reader.draw(1)));
+    }
+    writer.write(Vector{5.0, 6.0});
+    writer.close();
+    DrawFileReader reader(filename_);
+    EXPECT_EQ(3, reader.number_of_draws());
+  }
+
+  TEST_F(DrawStorageTest, ModelParameters) {
+    GaussianModel model(1.0, 4.0);
+    DrawFileWriter writer(filename_, model.vectorize_params().size());
+    writer.write(model);
+    model.set_mu(-3.0);
+    writer.write(model);
+    EXPECT_THROW(writer.write(Vector(5)), std::exception);
+    writer.close();
+
+    DrawFileReader reader(filename_);
+    reader.set_model_parameters(0, model);
+    EXPECT_DOUBLE_EQ(1.0, model.mu());
+    EXPECT_DOUBLE_EQ(4.0, model.sigma());
+    reader.set_model_parameters(1, model);
+    EXPECT_DOUBLE_EQ(-3.0, model.mu());
+  }
+
+  TEST_F(DrawStorageTest, RejectsOtherFiles) {
+    {
+      std::FILE *f = std::fopen(filename_.c_str(), "w");
+      std::fputs("This is not a draw file, but it is long enough to hold a "
+                 "header.  It is still not a draw file.", f);
+      std::fclose(f);
+    }
+    EXPECT_THROW(DrawFileReader reader(filename_), std::exception);
+    EXPECT_THROW(DrawFileReader reader("no_such_file.bin"), std::exception);
+  }
+
+}  // namespace
@@ -196,4 +196,30 @@ namespace {
     EXPECT_NEAR(model->sd(), copy->sd(), 1e-8);
   }
 
+  // The batched log density should match pdf(), with missing data getting
+  // log density zero.
+  TEST_F(GaussianTest, FillLogDensity) {
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < 20; ++i) {
+      data.push_back(new DoubleData(rnorm(3, 7.0)));
+    }
+    data[4]->set_missing_status(Data::completely_missing);
+
+    std::vector<Ptr<MixtureComponent>> components;
+    components.push_back(new GaussianModel(2.0, 5.0));
+    components.push_back(new GaussianModel(-1.0, 0.5));
+
+    Matrix log_densities;
+    fill_log_density_matrix(components, data, 3, 15, log_densities);
+    EXPECT_EQ(12, log_densities.nrow());
+    EXPECT_EQ(2, log_densities.ncol());
+    for (int i = 3; i < 15; ++i) {
+      for (int s = 0; s < 2; ++s) {
+        double expected = data[i]->missing()
+            ? 0.0 : components[s]->pdf(data[i].get(), true);
+        EXPECT_NEAR(expected, log_densities(i - 3, s), 1e-10);
+      }
+    }
+  }
+
 }  // namespace
@@ -0,0 +1,199 @@
+#include "gtest/gtest.h"
+#include "Models/GaussianModel.hpp"
+#include "Models/PosteriorSamplers/GaussianMeanSampler.hpp"
+#include "Models/PosteriorSamplers/MultiChainRunner.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  // Draws the mean of a Gaussian model with known variance, given a N(0,
+  // prior_sd^2) prior, from the posterior with the likelihood raised to the
+  // power inverse_temperature.
+  class TemperedMeanSampler : public PosteriorSampler {
+   public:
+    TemperedMeanSampler(GaussianModel *model, double prior_sd,
+                        RNG &seeding_rng = GlobalRng::rng)
+        : PosteriorSampler(seeding_rng),
+          model_(model),
+          prior_sd_(prior_sd),
+          inverse_temperature_(1.0) {}
+
+    TemperedMeanSampler *clone_to_new_host(Model *host) const override {
+      TemperedMeanSampler *ans = new TemperedMeanSampler(
+          dynamic_cast<GaussianModel *>(host), prior_sd_, rng());
+      ans->set_inverse_temperature(inverse_temperature_);
+      return ans;
+    }
+
+    void draw() override {
+      double precision = 1.0 / square(prior_sd_) +
+          inverse_temperature_ * model_->suf()->n() / model_->sigsq();
+      double mean = inverse_temperature_ * model_->suf()->sum() /
+          model_->sigsq() / precision;
+      model_->set_mu(rnorm_mt(rng(), mean, 1.0 / sqrt(precision)));
+    }
+
+    double logpri() const override {
+      return dnorm(model_->mu(), 0, prior_sd_, true);
+    }
+
+    void set_inverse_temperature(double beta) { inverse_temperature_ = beta; }
+
+   private:
+    GaussianModel *model_;
+    double prior_sd_;
+    double inverse_temperature_;
+  };
+
+  // A sampler that delegates its draws to a nested sampler, which is seeded
+  // from the seeding RNG passed to the outer sampler.
+  class NestedSampler : public PosteriorSampler {
+   public:
+    NestedSampler(GaussianModel *model, double prior_sd,
+                  RNG &seeding_rng = GlobalRng::rng)
+        : PosteriorSampler(seeding_rng),
+          prior_sd_(prior_sd),
+          inner_(new TemperedMeanSampler(model, prior_sd, seeding_rng)) {}
+
+    NestedSampler *clone_to_new_host(Model *host) const override {
+      return new NestedSampler(dynamic_cast<GaussianModel *>(host), prior_sd_,
+                               rng());
+    }
+
+    void draw() override { inner_->draw(); }
+    double logpri() const override { return inner_->logpri(); }
+
+   private:
+    double prior_sd_;
+    Ptr<TemperedMeanSampler> inner_;
+  };
+
+  class MultiChainRunnerTest : public ::testing::Test {
+   protected:
+    MultiChainRunnerTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(MultiChainRunnerTest, IndependentChains) {
+    NEW(GaussianModel, model)(3.0, 2.0);
+    for (int i = 0; i < 100; ++i) {
+      model->add_data(new DoubleData(rnorm(3.0, 2.0)));
+    }
+    NEW(GaussianMeanSampler, sampler)(model.get(), 0.0, 10.0);
+    model->set_method(sampler);
+    double ybar = model->suf()->ybar();
+
+    MultiChainRunner runner(model, 3);
+    runner.set_number_of_threads(3);
+    runner.run(500);
+    EXPECT_EQ(3, runner.number_of_chains());
+    for (int k = 0; k < runner.number_of_chains(); ++k) {
+      const Matrix &draws(runner.draws(k));
+      EXPECT_EQ(500, draws.nrow());
+      EXPECT_EQ(2, draws.ncol());
+      EXPECT_NEAR(ybar, mean(draws.col(0)), .2);
+    }
+    EXPECT_FALSE(VectorEquals(runner.draws(0).col(0),
+                              runner.draws(1).col(0)));
+
+    // The prototype is not modified.
+    EXPECT_DOUBLE_EQ(3.0, model->mu());
+  }
+
+  TEST_F(MultiChainRunnerTest, Reproducible) {
+    NEW(GaussianModel, model)(3.0, 2.0);
+    for (int i = 0; i < 20; ++i) {
+      model->add_data(new DoubleData(rnorm(3.0, 2.0)));
+    }
+    NEW(GaussianMeanSampler, sampler)(model.get(), 0.0, 10.0);
+    model->set_method(sampler);
+
+    RNG seeding_rng(17);
+    MultiChainRunner serial(model, 2, seeding_rng);
+    serial.run(50);
+
+    seeding_rng.seed(17);
+    MultiChainRunner threaded(model, 2, seeding_rng);
+    threaded.set_number_of_threads(2);
+    threaded.run(50);
+
+    EXPECT_TRUE(MatrixEquals(serial.draws(0), threaded.draws(0)));
+    EXPECT_TRUE(MatrixEquals(serial.draws(1), threaded.draws(1)));
+  }
+
+  // Nested samplers are seeded from the seeding RNG, not from the state of the
+  // prototype's samplers, and building the chains leaves the prototype's RNGs
+  // where they were.
+  TEST_F(MultiChainRunnerTest, NestedSamplersAreSeededFromSeedingRng) {
+    NEW(GaussianModel, model)(3.0, 2.0);
+    for (int i = 0; i < 20; ++i) {
+      model->add_data(new DoubleData(rnorm(3.0, 2.0)));
+    }
+    NEW(NestedSampler, sampler)(model.get(), 10.0);
+    model->set_method(sampler);
+
+    RNG prototype_rng(sampler->rng());
+    RNG seeding_rng(17);
+    MultiChainRunner first(model, 2, seeding_rng);
+    EXPECT_DOUBLE_EQ(prototype_rng(), sampler->rng()());
+    first.run(50);
+    EXPECT_FALSE(VectorEquals(first.draws(0).col(0), first.draws(1).col(0)));
+
+    // Moving the prototype's RNG does not change the chains.
+    sampler->rng()();
+    seeding_rng.seed(17);
+    MultiChainRunner second(model, 2, seeding_rng);
+    second.run(50);
+    EXPECT_TRUE(MatrixEquals(first.draws(0), second.draws(0)));
+    EXPECT_TRUE(MatrixEquals(first.draws(1), second.draws(1)));
+  }
+
+  TEST_F(MultiChainRunnerTest, ParallelTempering) {
+    double sigma = 1.0;
+    double prior_sd = 10.0;
+    NEW(GaussianModel, model)(0.0, square(sigma));
+    int n = 50;
+    for (int i = 0; i < n; ++i) {
+      model->add_data(new DoubleData(rnorm(2.0, sigma)));
+    }
+    NEW(TemperedMeanSampler, sampler)(model.get(), prior_sd);
+    model->set_method(sampler);
+
+    MultiChainRunner runner(model, 4);
+    runner.set_number_of_threads(2);
+    runner.set_temperatures(
+        Vector{1.0, 0.5, 0.25, 0.125},
+        [](const Model &m) {
+          return dynamic_cast<const GaussianModel &>(m).log_likelihood();
+        },
+        [](Model &m, double beta) {
+          dynamic_cast<TemperedMeanSampler *>(m.sampler(0))
+              ->set_inverse_temperature(beta);
+        });
+    int niter = 4000;
+    runner.run(niter);
+
+    double precision = 1.0 / square(prior_sd) + n / square(sigma);
+    double posterior_mean = model->suf()->sum() / square(sigma) / precision;
+    ConstVectorView mu_draws(runner.draws(0).col(0));
+    EXPECT_NEAR(posterior_mean, mean(mu_draws), .02);
+    EXPECT_NEAR(1.0 / precision, var(mu_draws), .2 / precision);
+
+    // The hottest level has a wider posterior.
+    EXPECT_GT(var(runner.draws(3).col(0)), 4 * var(mu_draws));
+
+    for (int k = 0; k + 1 < runner.number_of_chains(); ++k) {
+      EXPECT_GT(runner.swap_acceptance_rate(k), 0.1);
+      EXPECT_LT(runner.swap_acceptance_rate(k), 1.0);
+    }
+  }
+
+}  // namespace
@@ -121,4 +121,20 @@ namespace {
     }
   }
 
+  TEST_F(MultinomialTest, FillLogDensity) {
+    MultinomialModel model(Vector{.2, .5, .3});
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < 10; ++i) {
+      data.push_back(new CategoricalData(i % 3, 3));
+    }
+    data[7]->set_missing_status(Data::completely_missing);
+    Vector log_densities(10);
+    model.fill_log_density(data, 0, 10, VectorView(log_densities));
+    for (int i = 0; i < 10; ++i) {
+      double expected = data[i]->missing()
+          ? 0.0 : model.pdf(data[i].get(), true);
+      EXPECT_DOUBLE_EQ(expected, log_densities[i]);
+    }
+  }
+
 }  // namespace
@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+#include "Models/MvnModel.hpp"
+#include "distributions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class MvnTest : public ::testing::Test {
+   protected:
+    MvnTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // The batched log density, which evaluates the quadratic forms for the
+  // whole block with one matrix multiplication, matches logp() for each
+  // observation.  Missing data get log density zero.
+  TEST_F(MvnTest, FillLogDensity) {
+    int dim = 3;
+    Vector mu = {1.0, -2.0, 0.5};
+    SpdMatrix Sigma(dim);
+    Sigma.randomize();
+    Sigma.diag() += 1.0;
+    MvnModel model(mu, Sigma);
+
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < 40; ++i) {
+      data.push_back(new VectorData(rmvn(mu, 4 * Sigma)));
+    }
+    data[12]->set_missing_status(Data::completely_missing);
+
+    for (const std::pair<int, int> &block : std::vector<std::pair<int, int>>{
+             {0, 40}, {10, 25}, {39, 40}}) {
+      int begin = block.first;
+      int end = block.second;
+      Vector log_densities(end - begin);
+      model.fill_log_density(data, begin, end, VectorView(log_densities));
+      for (int i = begin; i < end; ++i) {
+        double expected = data[i]->missing()
+            ? 0.0 : model.logp(data[i].dcast<VectorData>()->value());
+        EXPECT_NEAR(expected, log_densities[i - begin],
+                    1e-10 * std::max(1.0, fabs(expected)))
+            << "observation " << i;
+      }
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "Models/PoissonModel.hpp"
+#include "distributions.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class PoissonTest : public ::testing::Test {
+   protected:
+    PoissonTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // Check model.fill_log_density on data[begin], ..., data[end - 1]
+    // against model.logp for each observation.
+    void check_fill_log_density(const PoissonModel &model,
+                                const std::vector<Ptr<Data>> &data,
+                                int begin, int end) {
+      Vector log_densities(end - begin);
+      model.fill_log_density(data, begin, end, VectorView(log_densities));
+      for (int i = begin; i < end; ++i) {
+        int y = data[i].dcast<IntData>()->value();
+        double expected = data[i]->missing() ? 0.0 : model.logp(y);
+        if (std::isfinite(expected)) {
+          EXPECT_NEAR(expected, log_densities[i - begin],
+                      1e-10 * std::max(1.0, fabs(expected)))
+              << "lambda = " << model.lam() << " y = " << y;
+        } else {
+          EXPECT_EQ(expected, log_densities[i - begin]);
+        }
+      }
+    }
+  };
+
+  // The batched log density matches logp(), for counts on both sides of the
+  // size of the log factorial table, for zeros, and for missing data.
+  TEST_F(PoissonTest, FillLogDensity) {
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < 200; ++i) {
+      data.push_back(new IntData(rpois(3.0)));
+    }
+    for (int y : {0, 1, 1023, 1024, 1025, 5000}) {
+      data.push_back(new IntData(y));
+    }
+    data[17]->set_missing_status(Data::completely_missing);
+
+    for (double lambda : {.05, 3.0, 1000.0}) {
+      PoissonModel model(lambda);
+      check_fill_log_density(model, data, 0, data.size());
+      check_fill_log_density(model, data, 10, 30);
+      check_fill_log_density(model, data, 5, 5);
+    }
+  }
+
+  // A view with a non-unit stride falls back to the per-observation pdf.
+  TEST_F(PoissonTest, FillLogDensityStrided) {
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < 10; ++i) {
+      data.push_back(new IntData(rpois(2.0)));
+    }
+    PoissonModel model(2.0);
+    Matrix log_densities(2, 10);
+    model.fill_log_density(data, 0, 10, log_densities.row(1));
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_NEAR(model.logp(data[i].dcast<IntData>()->value()),
+                  log_densities(1, i), 1e-10);
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,120 @@
+// Install the allocation-counting operator new for this test program.
+#define BOOM_SAMPLER_PROFILER_COUNT_ALLOCATIONS
+#include "Models/PosteriorSamplers/SamplerProfiler.hpp"
+
+#include "gtest/gtest.h"
+#include <sstream>
+#include <vector>
+#include "Models/GaussianModel.hpp"
+#include "Models/PosteriorSamplers/CompositeSampler.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Samplers/MoveAccounting.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  // A sampler that makes one allocation per draw, and alternately accepts and
+  // rejects a Metropolis-Hastings move.
+  class AlternatingSampler : public PosteriorSampler {
+   public:
+    explicit AlternatingSampler(GaussianModel *model,
+                                RNG &seeding_rng = GlobalRng::rng)
+        : PosteriorSampler(seeding_rng), model_(model), number_of_draws_(0) {}
+
+    void draw() override {
+      std::unique_ptr<std::vector<double>> workspace(
+          new std::vector<double>());
+      workspace->reserve(10);
+      if (number_of_draws_++ % 2 == 0) {
+        accounting_.record_acceptance("mh");
+      } else {
+        accounting_.record_rejection("mh");
+      }
+    }
+    double logpri() const override { return 0; }
+    const MoveAccounting *mh_accounting() const override {
+      return &accounting_;
+    }
+
+   private:
+    GaussianModel *model_;
+    int number_of_draws_;
+    MoveAccounting accounting_;
+  };
+
+  class SamplerProfilerTest : public ::testing::Test {
+   protected:
+    SamplerProfilerTest() {
+      GlobalRng::rng.seed(8675309);
+      SamplerProfiler::reset();
+    }
+    ~SamplerProfilerTest() override {
+      SamplerProfiler::disable();
+      SamplerProfiler::reset();
+    }
+  };
+
+  TEST_F(SamplerProfilerTest, NothingRecordedWhenDisabled) {
+    NEW(GaussianModel, model)(0, 1);
+    NEW(AlternatingSampler, sampler)(model.get());
+    model->set_method(sampler);
+    for (int i = 0; i < 5; ++i) {
+      model->sample_posterior();
+    }
+    EXPECT_EQ("[]", SamplerProfiler::to_json());
+  }
+
+  TEST_F(SamplerProfilerTest, CallTree) {
+    NEW(GaussianModel, model)(0, 1);
+    NEW(AlternatingSampler, sampler)(model.get());
+    NEW(CompositeSampler, composite)(Ptr<PosteriorSampler>(sampler));
+    model->set_method(composite);
+
+    SamplerProfiler::enable();
+    for (int i = 0; i < 10; ++i) {
+      model->sample_posterior();
+    }
+    SamplerProfiler::disable();
+    // Calls made after the profiler is disabled are not recorded.
+    model->sample_posterior();
+
+    std::string json = SamplerProfiler::to_json();
+    EXPECT_EQ(0, json.find("[{\"name\":\"GaussianModel\",\"calls\":10,"))
+        << json;
+    size_t composite_pos = json.find(
+        "\"children\":[{\"name\":\"CompositeSampler\",\"calls\":10,");
+    EXPECT_NE(std::string::npos, composite_pos) << json;
+    size_t sampler_pos = json.find(
+        "\"children\":[{\"name\":\"(anonymous namespace)::"
+        "AlternatingSampler\",\"calls\":10,");
+    EXPECT_NE(std::string::npos, sampler_pos) << json;
+    EXPECT_LT(composite_pos, sampler_pos);
+
+    // Each draw made two allocations, plus a few the first time the
+    // MoveAccounting saw each outcome.
+    std::string sampler_json = json.substr(sampler_pos);
+    size_t allocations_pos = sampler_json.find("\"allocations\":");
+    ASSERT_NE(std::string::npos, allocations_pos);
+    int allocations = std::stoi(sampler_json.substr(allocations_pos + 14));
+    EXPECT_GE(allocations, 20);
+    EXPECT_LE(allocations, 30);
+    EXPECT_NE(std::string::npos,
+              sampler_json.find("\"accepted\":5,\"rejected\":5,"))
+        << json;
+
+    std::ostringstream table;
+    SamplerProfiler::print(table);
+    EXPECT_NE(std::string::npos, table.str().find("  CompositeSampler"))
+        << table.str();
+    EXPECT_NE(std::string::npos, table.str().find("0.500")) << table.str();
+
+    SamplerProfiler::reset();
+    EXPECT_EQ("[]", SamplerProfiler::to_json());
+  }
+
+}  // namespace
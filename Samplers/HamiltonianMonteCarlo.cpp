@@ -0,0 +1,436 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Samplers/HamiltonianMonteCarlo.hpp"
+#include <algorithm>
+#include <cmath>
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  //===========================================================================
+  DualAveragingStepSize::DualAveragingStepSize(double target_acceptance_rate,
+                                               double gamma, double t0,
+                                               double kappa)
+      : gamma_(gamma), t0_(t0), kappa_(kappa) {
+    set_target_acceptance_rate(target_acceptance_rate);
+    restart(1.0);
+  }
+
+  void DualAveragingStepSize::restart(double initial_step_size) {
+    shrinkage_target_ = log(10 * initial_step_size);
+    counter_ = 0;
+    average_error_ = 0;
+    average_log_step_size_ = 0;
+  }
+
+  double DualAveragingStepSize::update(double acceptance_statistic) {
+    ++counter_;
+    acceptance_statistic = std::min<double>(1.0, acceptance_statistic);
+    double eta = 1.0 / (counter_ + t0_);
+    average_error_ = (1 - eta) * average_error_ +
+                     eta * (target_acceptance_rate_ - acceptance_statistic);
+    double log_step_size =
+        shrinkage_target_ - average_error_ * sqrt(counter_) / gamma_;
+    double weight = pow(counter_, -kappa_);
+    average_log_step_size_ =
+        (1 - weight) * average_log_step_size_ + weight * log_step_size;
+    return exp(log_step_size);
+  }
+
+  double DualAveragingStepSize::final_step_size() const {
+    return exp(average_log_step_size_);
+  }
+
+  void DualAveragingStepSize::set_target_acceptance_rate(double rate) {
+    if (rate <= 0 || rate >= 1) {
+      report_error("The target acceptance rate must be in (0, 1).");
+    }
+    target_acceptance_rate_ = rate;
+  }
+
+  //===========================================================================
+  HamiltonianSamplerBase::HamiltonianSamplerBase(const dTarget &logf,
+                                                 double initial_step_size,
+                                                 RNG *rng)
+      : Sampler(rng),
+        logf_(logf),
+        gradient_count_(0),
+        mass_matrix_type_(IDENTITY),
+        number_of_warmup_draws_(0),
+        adapted_mass_matrix_type_(IDENTITY),
+        iteration_(0),
+        initial_buffer_(0),
+        terminal_buffer_(0),
+        window_start_(0),
+        window_end_(0),
+        window_size_(0),
+        window_count_(0),
+        accepted_(false),
+        acceptance_statistic_(0),
+        divergent_(false) {
+    set_step_size(initial_step_size);
+  }
+
+  HamiltonianSamplerBase::HamiltonianSamplerBase(const Ptr<dTargetFun> &logf,
+                                                 double initial_step_size,
+                                                 RNG *rng)
+      : HamiltonianSamplerBase(
+            [logf](const Vector &x, Vector &gradient) {
+              return (*logf)(x, gradient);
+            },
+            initial_step_size, rng) {}
+
+  Vector HamiltonianSamplerBase::draw(const Vector &old) {
+    ensure_dimension(old.size());
+    if (!warming_up()) {
+      return transition(old);
+    }
+    if (iteration_ == 0) {
+      initialize_step_size(old);
+      step_size_adaptation_.restart(step_size_);
+    }
+    Vector ans = transition(old);
+    adapt(ans);
+    return ans;
+  }
+
+  void HamiltonianSamplerBase::set_step_size(double step_size) {
+    if (step_size <= 0 || !std::isfinite(step_size)) {
+      report_error("The step size must be positive and finite.");
+    }
+    step_size_ = step_size;
+  }
+
+  void HamiltonianSamplerBase::set_warmup(int number_of_warmup_draws,
+                                          MassMatrixType mass_matrix_type,
+                                          double target_acceptance_rate) {
+    if (number_of_warmup_draws < 0) {
+      report_error("The number of warmup draws must be non-negative.");
+    }
+    number_of_warmup_draws_ = number_of_warmup_draws;
+    adapted_mass_matrix_type_ = mass_matrix_type;
+    step_size_adaptation_.set_target_acceptance_rate(target_acceptance_rate);
+    iteration_ = 0;
+    compute_adaptation_windows();
+  }
+
+  void HamiltonianSamplerBase::set_inverse_mass_matrix(const Vector &diagonal) {
+    for (double v : diagonal) {
+      if (v <= 0) {
+        report_error("The inverse mass matrix must be positive definite.");
+      }
+    }
+    diagonal_inverse_mass_ = diagonal;
+    mass_matrix_type_ = DIAGONAL;
+  }
+
+  void HamiltonianSamplerBase::set_inverse_mass_matrix(
+      const SpdMatrix &inverse_mass) {
+    bool ok = true;
+    SpdMatrix mass = inverse_mass.inv(ok);
+    if (ok) mass_cholesky_ = mass.chol(ok);
+    if (!ok) {
+      report_error("The inverse mass matrix must be positive definite.");
+    }
+    dense_inverse_mass_ = inverse_mass;
+    mass_matrix_type_ = DENSE;
+  }
+
+  SpdMatrix HamiltonianSamplerBase::inverse_mass_matrix() const {
+    if (mass_matrix_type_ == DENSE) {
+      return dense_inverse_mass_;
+    }
+    SpdMatrix ans(diagonal_inverse_mass_.size());
+    ans.set_diag(diagonal_inverse_mass_);
+    return ans;
+  }
+
+  //---------------------------------------------------------------------------
+  void HamiltonianSamplerBase::evaluate(PhasePoint &point) const {
+    int dim = point.position.size();
+    if (point.gradient.size() != dim) {
+      point.gradient.resize(dim);
+    }
+    point.gradient = 0.0;
+    point.log_density = logf_(point.position, point.gradient);
+    ++gradient_count_;
+  }
+
+  void HamiltonianSamplerBase::leapfrog(PhasePoint &point,
+                                        double epsilon) const {
+    point.momentum.axpy(point.gradient, 0.5 * epsilon);
+    point.position.axpy(velocity(point.momentum), epsilon);
+    evaluate(point);
+    point.momentum.axpy(point.gradient, 0.5 * epsilon);
+  }
+
+  void HamiltonianSamplerBase::draw_momentum(PhasePoint &point) const {
+    int dim = point.position.size();
+    Vector z(dim);
+    for (int i = 0; i < dim; ++i) {
+      z[i] = rnorm_mt(rng());
+    }
+    if (mass_matrix_type_ == DENSE) {
+      point.momentum = mass_cholesky_ * z;
+    } else {
+      for (int i = 0; i < dim; ++i) {
+        z[i] /= sqrt(diagonal_inverse_mass_[i]);
+      }
+      point.momentum = z;
+    }
+  }
+
+  Vector HamiltonianSamplerBase::velocity(const Vector &momentum) const {
+    if (mass_matrix_type_ == DENSE) {
+      return dense_inverse_mass_ * momentum;
+    }
+    Vector ans(momentum);
+    for (int i = 0; i < ans.size(); ++i) {
+      ans[i] *= diagonal_inverse_mass_[i];
+    }
+    return ans;
+  }
+
+  double HamiltonianSamplerBase::kinetic_energy(const Vector &momentum) const {
+    return 0.5 * momentum.dot(velocity(momentum));
+  }
+
+  double HamiltonianSamplerBase::hamiltonian(const PhasePoint &point) const {
+    double ans = kinetic_energy(point.momentum) - point.log_density;
+    return std::isfinite(ans) ? ans : infinity();
+  }
+
+  void HamiltonianSamplerBase::record_transition(bool accepted,
+                                                 double acceptance_statistic,
+                                                 bool divergent) {
+    accepted_ = accepted;
+    acceptance_statistic_ =
+        std::isfinite(acceptance_statistic) ? acceptance_statistic : 0.0;
+    divergent_ = divergent;
+  }
+
+  //---------------------------------------------------------------------------
+  void HamiltonianSamplerBase::ensure_dimension(int dim) {
+    if (mass_matrix_type_ == DENSE) {
+      if (dense_inverse_mass_.nrow() != dim) {
+        report_error("The inverse mass matrix has the wrong dimension.");
+      }
+    } else if (diagonal_inverse_mass_.size() != dim) {
+      if (mass_matrix_type_ == DIAGONAL) {
+        report_error("The inverse mass matrix has the wrong dimension.");
+      }
+      diagonal_inverse_mass_.resize(dim);
+      diagonal_inverse_mass_ = 1.0;
+    }
+  }
+
+  void HamiltonianSamplerBase::initialize_step_size(const Vector &position) {
+    PhasePoint start;
+    start.position = position;
+    evaluate(start);
+    if (!std::isfinite(start.log_density)) {
+      report_error("The Hamiltonian sampler was started at a point where the "
+                   "target density is zero.");
+    }
+    const double log_threshold = log(0.8);
+    int direction = 0;
+    while (true) {
+      PhasePoint point = start;
+      draw_momentum(point);
+      double initial_energy = hamiltonian(point);
+      leapfrog(point, step_size_);
+      double log_acceptance = initial_energy - hamiltonian(point);
+      int preferred_direction = log_acceptance > log_threshold ? 1 : -1;
+      if (direction == 0) {
+        direction = preferred_direction;
+      } else if (preferred_direction != direction) {
+        break;
+      }
+      step_size_ *= direction > 0 ? 2.0 : 0.5;
+      if (step_size_ > 1e+7) {
+        report_error("The target density appears to be improper.  The "
+                     "Hamiltonian sampler step size diverged.");
+      } else if (step_size_ < 1e-12) {
+        report_error("The Hamiltonian sampler could not find a step size "
+                     "with a reasonable acceptance probability.");
+      }
+    }
+  }
+
+  // The default schedule with a long warmup period is a 75 draw initial
+  // buffer, a 50 draw terminal buffer, and mass matrix windows of 25, 50,
+  // 100, ... draws in between, with the last window stretched to meet the
+  // terminal buffer.  Short warmup periods are split 15% / 75% / 10%.
+  void HamiltonianSamplerBase::compute_adaptation_windows() {
+    int warmup = number_of_warmup_draws_;
+    if (adapted_mass_matrix_type_ == IDENTITY || warmup < 20) {
+      initial_buffer_ = warmup;
+      terminal_buffer_ = 0;
+      window_start_ = window_end_ = warmup;
+      window_size_ = 0;
+      return;
+    }
+    initial_buffer_ = 75;
+    terminal_buffer_ = 50;
+    window_size_ = 25;
+    if (initial_buffer_ + terminal_buffer_ + window_size_ > warmup) {
+      initial_buffer_ = lround(0.15 * warmup);
+      terminal_buffer_ = lround(0.1 * warmup);
+      window_size_ = warmup - initial_buffer_ - terminal_buffer_;
+    }
+    window_start_ = initial_buffer_;
+    window_end_ = window_start_ + window_size_;
+    if (window_end_ + 2 * window_size_ > warmup - terminal_buffer_) {
+      window_end_ = warmup - terminal_buffer_;
+    }
+    window_count_ = 0;
+  }
+
+  void HamiltonianSamplerBase::adapt(const Vector &draw) {
+    int t = iteration_++;
+    step_size_ = step_size_adaptation_.update(acceptance_statistic_);
+
+    if (t >= window_start_ && t < window_end_) {
+      int dim = draw.size();
+      if (window_count_ == 0) {
+        window_mean_.resize(dim);
+        window_mean_ = 0.0;
+        if (adapted_mass_matrix_type_ == DENSE) {
+          window_sumsq_.resize(dim);
+          window_sumsq_ = 0.0;
+        } else {
+          window_sumsq_diagonal_.resize(dim);
+          window_sumsq_diagonal_ = 0.0;
+        }
+      }
+      ++window_count_;
+      Vector delta = draw - window_mean_;
+      window_mean_.axpy(delta, 1.0 / window_count_);
+      if (adapted_mass_matrix_type_ == DENSE) {
+        window_sumsq_.add_outer(delta, (window_count_ - 1.0) / window_count_);
+      } else {
+        for (int i = 0; i < dim; ++i) {
+          window_sumsq_diagonal_[i] +=
+              delta[i] * (draw[i] - window_mean_[i]);
+        }
+      }
+
+      if (t + 1 == window_end_) {
+        update_inverse_mass_matrix();
+        int last_window_end = number_of_warmup_draws_ - terminal_buffer_;
+        if (window_end_ < last_window_end) {
+          window_size_ *= 2;
+          window_start_ = window_end_;
+          window_end_ = window_start_ + window_size_;
+          if (window_end_ + 2 * window_size_ > last_window_end) {
+            window_end_ = last_window_end;
+          }
+        } else {
+          window_start_ = window_end_ = number_of_warmup_draws_;
+        }
+        initialize_step_size(draw);
+        step_size_adaptation_.restart(step_size_);
+      }
+    }
+
+    if (iteration_ == number_of_warmup_draws_) {
+      step_size_ = step_size_adaptation_.final_step_size();
+    }
+  }
+
+  // The sample variance is shrunk towards a small multiple of the identity,
+  // as in Stan, to guard against a poorly conditioned estimate from a short
+  // window.
+  void HamiltonianSamplerBase::update_inverse_mass_matrix() {
+    double n = window_count_;
+    window_count_ = 0;
+    if (n < 2) return;
+    double weight = n / ((n + 5.0) * (n - 1.0));
+    double shrinkage = 1e-3 * 5.0 / (n + 5.0);
+    if (adapted_mass_matrix_type_ == DENSE) {
+      SpdMatrix variance = window_sumsq_;
+      variance *= weight;
+      variance.diag() += shrinkage;
+      set_inverse_mass_matrix(variance);
+    } else {
+      Vector variance = window_sumsq_diagonal_ * weight;
+      variance += shrinkage;
+      set_inverse_mass_matrix(variance);
+    }
+  }
+
+  //===========================================================================
+  HamiltonianMonteCarlo::HamiltonianMonteCarlo(const dTarget &logf,
+                                               double initial_step_size,
+                                               int number_of_leapfrog_steps,
+                                               RNG *rng)
+      : HamiltonianSamplerBase(logf, initial_step_size, rng),
+        step_size_jitter_(0.1) {
+    set_number_of_leapfrog_steps(number_of_leapfrog_steps);
+  }
+
+  HamiltonianMonteCarlo::HamiltonianMonteCarlo(const Ptr<dTargetFun> &logf,
+                                               double initial_step_size,
+                                               int number_of_leapfrog_steps,
+                                               RNG *rng)
+      : HamiltonianSamplerBase(logf, initial_step_size, rng),
+        step_size_jitter_(0.1) {
+    set_number_of_leapfrog_steps(number_of_leapfrog_steps);
+  }
+
+  void HamiltonianMonteCarlo::set_number_of_leapfrog_steps(int steps) {
+    if (steps <= 0) {
+      report_error("The number of leapfrog steps must be positive.");
+    }
+    number_of_leapfrog_steps_ = steps;
+  }
+
+  void HamiltonianMonteCarlo::set_step_size_jitter(double jitter) {
+    if (jitter < 0 || jitter >= 1) {
+      report_error("The step size jitter must be in [0, 1).");
+    }
+    step_size_jitter_ = jitter;
+  }
+
+  Vector HamiltonianMonteCarlo::transition(const Vector &old) {
+    PhasePoint proposal;
+    proposal.position = old;
+    evaluate(proposal);
+    draw_momentum(proposal);
+    double initial_energy = hamiltonian(proposal);
+    double epsilon = step_size();
+    if (step_size_jitter_ > 0) {
+      epsilon *= 1 + step_size_jitter_ * (2 * runif_mt(rng()) - 1);
+    }
+    for (int i = 0; i < number_of_leapfrog_steps_; ++i) {
+      leapfrog(proposal, epsilon);
+      if (!std::isfinite(proposal.log_density)) break;
+    }
+    double energy_error = hamiltonian(proposal) - initial_energy;
+    double log_acceptance_probability =
+        std::isfinite(energy_error) ? -energy_error : negative_infinity();
+    bool accept = log(runif_mt(rng())) < log_acceptance_probability;
+    record_transition(accept, exp(std::min(0.0, log_acceptance_probability)),
+                      energy_error > divergence_threshold);
+    return accept ? proposal.position : old;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,299 @@
+#ifndef BOOM_SAMPLERS_HAMILTONIAN_MONTE_CARLO_HPP_
+#define BOOM_SAMPLERS_HAMILTONIAN_MONTE_CARLO_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Samplers/Sampler.hpp"
+#include "TargetFun/TargetFun.hpp"
+#include "cpputil/Ptr.hpp"
+#include "numopt.hpp"
+
+namespace BOOM {
+
+  //===========================================================================
+  // Step size adaptation by the dual averaging algorithm of Nesterov (2009),
+  // as adapted to Hamiltonian Monte Carlo by Hoffman and Gelman (2014) "The
+  // No-U-Turn Sampler", Algorithm 5.  The log step size is driven towards the
+  // value where the average acceptance statistic equals a target rate.
+  class DualAveragingStepSize {
+   public:
+    // Args:
+    //   target_acceptance_rate:  The desired average acceptance statistic.
+    //   gamma, t0, kappa: Tuning constants controlling the amount of
+    //     shrinkage towards log(10 * initial_step_size), the stability of
+    //     the early iterations, and the rate at which old iterates are
+    //     forgotten.  The defaults are those recommended by Hoffman and
+    //     Gelman.
+    explicit DualAveragingStepSize(double target_acceptance_rate = 0.8,
+                                   double gamma = 0.05, double t0 = 10,
+                                   double kappa = 0.75);
+
+    // Start a new adaptation phase near 'initial_step_size'.
+    void restart(double initial_step_size);
+
+    // Record the acceptance statistic from the most recent transition, and
+    // return the step size to use for the next one.
+    double update(double acceptance_statistic);
+
+    // The step size to use once adaptation is complete: the exponentiated
+    // weighted average of the log step sizes visited during adaptation.
+    double final_step_size() const;
+
+    double target_acceptance_rate() const { return target_acceptance_rate_; }
+    void set_target_acceptance_rate(double rate);
+
+   private:
+    double target_acceptance_rate_;
+    double gamma_;
+    double t0_;
+    double kappa_;
+
+    // log(10 * initial_step_size).
+    double shrinkage_target_;
+    int counter_;
+    double average_error_;
+    double average_log_step_size_;
+  };
+
+  //===========================================================================
+  // Common machinery for samplers that simulate Hamiltonian dynamics to
+  // propose moves from the current position.  Concrete samplers implement
+  // transition().
+  //
+  // The kinetic energy is 0.5 * p' M^{-1} p, where p is the momentum and M
+  // is the mass matrix.  The best choice of M^{-1} is the posterior variance
+  // of the parameters, which can be estimated during a warmup period.
+  //
+  // Warmup follows the schedule used by Stan.  The step size is adapted
+  // throughout warmup.  The inverse mass matrix is estimated from the draws
+  // in a sequence of windows that double in size, separated from the start
+  // and end of warmup by buffers where only the step size is adapted.  The
+  // step size adaptation is restarted each time the mass matrix changes.
+  // Once warmup ends the sampler is a valid MCMC transition with fixed
+  // tuning parameters.
+  class HamiltonianSamplerBase : public Sampler {
+   public:
+    // The form of the mass matrix estimated during warmup.
+    enum MassMatrixType { IDENTITY, DIAGONAL, DENSE };
+
+    // Args:
+    //   logf: The log of the un-normalized target density.  logf(x, g)
+    //     returns the log density at x, and fills g with its gradient.
+    //   initial_step_size:  The leapfrog step size.
+    //   rng:  The random number generator used by the sampler.
+    HamiltonianSamplerBase(const dTarget &logf, double initial_step_size,
+                           RNG *rng = nullptr);
+    HamiltonianSamplerBase(const Ptr<dTargetFun> &logf,
+                           double initial_step_size, RNG *rng = nullptr);
+
+    // Perform one transition starting from 'old', adapting the tuning
+    // parameters if the sampler is still in the warmup period.
+    Vector draw(const Vector &old) override;
+
+    double step_size() const { return step_size_; }
+    void set_step_size(double step_size);
+
+    // Request adaptive tuning for the next 'number_of_warmup_draws' calls to
+    // draw().  The draws made during warmup do not leave the target
+    // distribution invariant, and should be discarded.
+    //
+    // Args:
+    //   number_of_warmup_draws: The length of the warmup period.  Mass
+    //     matrix adaptation needs at least 20 warmup draws.  With fewer,
+    //     only the step size is adapted.
+    //   mass_matrix_type: The form of the inverse mass matrix to estimate.
+    //     IDENTITY turns off mass matrix adaptation.
+    //   target_acceptance_rate:  Passed to the step size adaptation.
+    void set_warmup(int number_of_warmup_draws,
+                    MassMatrixType mass_matrix_type = DIAGONAL,
+                    double target_acceptance_rate = 0.8);
+    bool warming_up() const { return iteration_ < number_of_warmup_draws_; }
+
+    // Set the inverse mass matrix, either to a diagonal matrix or to a
+    // dense one.  The inverse mass matrix should approximate the posterior
+    // variance of the parameters.
+    void set_inverse_mass_matrix(const Vector &diagonal);
+    void set_inverse_mass_matrix(const SpdMatrix &inverse_mass);
+
+    // Returns the inverse mass matrix in dense form.
+    SpdMatrix inverse_mass_matrix() const;
+
+    bool last_draw_was_accepted() const { return accepted_; }
+
+    // The average Metropolis acceptance probability associated with the most
+    // recent transition.  This is the statistic that drives step size
+    // adaptation.
+    double last_acceptance_statistic() const { return acceptance_statistic_; }
+
+    // True if the numerical integration error in the most recent transition
+    // grew past a large threshold.  Frequent divergences suggest the step
+    // size is too large for some region of the parameter space.
+    bool last_draw_diverged() const { return divergent_; }
+
+    // The total number of gradient evaluations since the sampler was
+    // created.
+    long number_of_gradient_evaluations() const { return gradient_count_; }
+
+   protected:
+    // A point in phase space, along with the log density and its gradient at
+    // 'position'.
+    struct PhasePoint {
+      Vector position;
+      Vector momentum;
+      Vector gradient;
+      double log_density;
+    };
+
+    // Perform one transition of the concrete sampler, starting from
+    // 'old'.  Implementations must call record_transition() before
+    // returning.
+    virtual Vector transition(const Vector &old) = 0;
+
+    // Evaluate the target at point.position, filling point.log_density and
+    // point.gradient.
+    void evaluate(PhasePoint &point) const;
+
+    // Advance 'point' by one leapfrog step of size 'epsilon' (which may be
+    // negative to integrate backwards in time).
+    void leapfrog(PhasePoint &point, double epsilon) const;
+
+    // Draw a momentum vector from N(0, M).
+    void draw_momentum(PhasePoint &point) const;
+
+    // Returns M^{-1} p, the rate of change of the position.
+    Vector velocity(const Vector &momentum) const;
+
+    double kinetic_energy(const Vector &momentum) const;
+
+    // The total energy of 'point'.  Non-finite energies are mapped to
+    // infinity.
+    double hamiltonian(const PhasePoint &point) const;
+
+    void record_transition(bool accepted, double acceptance_statistic,
+                           bool divergent);
+
+    // Energy errors larger than this mark a transition as divergent.
+    static constexpr double divergence_threshold = 1000.0;
+
+   private:
+    void ensure_dimension(int dim);
+
+    // Find a step size for which a single leapfrog step from 'position' has
+    // an acceptance probability near 0.8, by repeated doubling or halving.
+    void initialize_step_size(const Vector &position);
+
+    // Called after each warmup draw.
+    void adapt(const Vector &draw);
+    void update_inverse_mass_matrix();
+    void compute_adaptation_windows();
+
+    dTarget logf_;
+    double step_size_;
+    mutable long gradient_count_;
+
+    MassMatrixType mass_matrix_type_;
+    // If mass_matrix_type_ is DENSE then the inverse mass matrix is
+    // dense_inverse_mass_, and the mass matrix is L L'.  Otherwise the
+    // inverse mass matrix is diag(diagonal_inverse_mass_).
+    Vector diagonal_inverse_mass_;
+    SpdMatrix dense_inverse_mass_;
+    Matrix mass_cholesky_;
+
+    DualAveragingStepSize step_size_adaptation_;
+    int number_of_warmup_draws_;
+    MassMatrixType adapted_mass_matrix_type_;
+    int iteration_;
+
+    // Mass matrix estimation windows.  The current window covers warmup
+    // iterations [window_start_, window_end_).  The window is empty if
+    // window_end_ <= window_start_.
+    int initial_buffer_;
+    int terminal_buffer_;
+    int window_start_;
+    int window_end_;
+    int window_size_;
+
+    // Running mean and sum of squared deviations of the draws in the current
+    // window (Welford's algorithm).  Only the diagonal of the sum of squares
+    // is kept when estimating a DIAGONAL mass matrix.
+    int window_count_;
+    Vector window_mean_;
+    Vector window_sumsq_diagonal_;
+    SpdMatrix window_sumsq_;
+
+    bool accepted_;
+    double acceptance_statistic_;
+    bool divergent_;
+  };
+
+  //===========================================================================
+  // Hamiltonian Monte Carlo with a fixed number of leapfrog steps (Neal 2011,
+  // "MCMC using Hamiltonian dynamics").  The step size can be tuned during
+  // warmup by dual averaging.
+  //
+  // With a fixed trajectory length the sampler can be periodic: on a nearly
+  // Gaussian target a trajectory close to a multiple of half an oscillation
+  // returns to (or reflects) its starting point, and the chain stops mixing.
+  // Following Neal's advice, the step size used for each transition is drawn
+  // uniformly from step_size() * (1 +/- step_size_jitter()).
+  //
+  // Typical use:
+  //   HamiltonianMonteCarlo sampler(log_posterior, 0.1, 20);
+  //   sampler.set_warmup(1000);
+  //   for (int i = 0; i < niter; ++i) {
+  //     theta = sampler.draw(theta);
+  //   }
+  class HamiltonianMonteCarlo : public HamiltonianSamplerBase {
+   public:
+    // Args:
+    //   logf: The log of the un-normalized target density, and its
+    //     gradient.
+    //   initial_step_size:  The leapfrog step size.
+    //   number_of_leapfrog_steps: The number of leapfrog steps in each
+    //     proposal.
+    //   rng:  The random number generator used by the sampler.
+    HamiltonianMonteCarlo(const dTarget &logf, double initial_step_size = 0.1,
+                          int number_of_leapfrog_steps = 10,
+                          RNG *rng = nullptr);
+    HamiltonianMonteCarlo(const Ptr<dTargetFun> &logf,
+                          double initial_step_size = 0.1,
+                          int number_of_leapfrog_steps = 10,
+                          RNG *rng = nullptr);
+
+    int number_of_leapfrog_steps() const { return number_of_leapfrog_steps_; }
+    void set_number_of_leapfrog_steps(int steps);
+
+    // The relative amount by which the step size is randomly perturbed in
+    // each transition.  Must be in [0, 1).  The default is 0.1.
+    double step_size_jitter() const { return step_size_jitter_; }
+    void set_step_size_jitter(double jitter);
+
+   protected:
+    Vector transition(const Vector &old) override;
+
+   private:
+    int number_of_leapfrog_steps_;
+    double step_size_jitter_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SAMPLERS_HAMILTONIAN_MONTE_CARLO_HPP_
@@ -130,6 +130,17 @@ namespace BOOM {
     return ans;
   }
 
+  int MoveAccounting::total_count(const std::string &outcome_type) const {
+    int ans = 0;
+    for (const auto &move : counts_) {
+      auto it = move.second.find(outcome_type);
+      if (it != move.second.end()) {
+        ans += it->second;
+      }
+    }
+    return ans;
+  }
+
   MoveTimer MoveAccounting::start_time(const std::string &move_type) {
     return MoveTimer(move_type, this);
   }
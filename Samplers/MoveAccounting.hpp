@@ -75,6 +75,11 @@ namespace BOOM {
     double acceptance_ratio(const std::string &move_type,
                             int &number_of_trials);
 
+    // The total number of acceptances (or rejections) recorded across all
+    // move types.
+    int number_of_acceptances() const { return total_count("accept"); }
+    int number_of_rejections() const { return total_count("reject"); }
+
     // To time code, use eithr of the the following idioms:
     // When entering a code that is entirely devoted to an MCMC move:
     //    MoveTimer timer = this->start_time("MyMoveType");
@@ -88,6 +93,8 @@ namespace BOOM {
     double stop_time(const std::string &move_type, clock_t start);
 
    private:
+    int total_count(const std::string &outcome_type) const;
+
     // counts_ is essentially a matrix indexed by strings instead of
     // integers.  The "row" index is called a "move type".  It is
     // designed to keep track of different types of sampling
@@ -0,0 +1,238 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Samplers/NoUTurnSampler.hpp"
+#include <cmath>
+#include "cpputil/lse.hpp"
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // lse2, extended to the case where both arguments are -infinity.
+    inline double log_add(double x, double y) {
+      if (x == negative_infinity()) return y;
+      if (y == negative_infinity()) return x;
+      return lse2(x, y);
+    }
+  }  // namespace
+
+  NoUTurnSampler::NoUTurnSampler(const dTarget &logf, double initial_step_size,
+                                 RNG *rng)
+      : HamiltonianSamplerBase(logf, initial_step_size, rng),
+        max_tree_depth_(10),
+        last_tree_depth_(0),
+        last_number_of_leapfrog_steps_(0) {}
+
+  NoUTurnSampler::NoUTurnSampler(const Ptr<dTargetFun> &logf,
+                                 double initial_step_size, RNG *rng)
+      : HamiltonianSamplerBase(logf, initial_step_size, rng),
+        max_tree_depth_(10),
+        last_tree_depth_(0),
+        last_number_of_leapfrog_steps_(0) {}
+
+  void NoUTurnSampler::set_max_tree_depth(int depth) {
+    if (depth < 1) {
+      report_error("The maximum tree depth must be positive.");
+    }
+    max_tree_depth_ = depth;
+  }
+
+  bool NoUTurnSampler::no_u_turn(const Vector &velocity_begin,
+                                 const Vector &velocity_end,
+                                 const Vector &momentum_sum) {
+    return velocity_begin.dot(momentum_sum) > 0 &&
+           velocity_end.dot(momentum_sum) > 0;
+  }
+
+  // The trajectory is stored through its two ends ('backward' and
+  // 'forward'), the momenta and velocities at the two points nearest each
+  // end, and the sum of its momenta.  Names like momentum_forward_begin
+  // refer to the first point (i.e. the one nearest the starting point) of
+  // the subtree on the forward side.
+  Vector NoUTurnSampler::transition(const Vector &old) {
+    PhasePoint start;
+    start.position = old;
+    evaluate(start);
+    draw_momentum(start);
+    int dim = old.size();
+    double initial_energy = hamiltonian(start);
+
+    PhasePoint forward(start);
+    PhasePoint backward(start);
+    PhasePoint sample(start);
+    PhasePoint proposal(start);
+    bool moved = false;
+
+    Vector initial_velocity = velocity(start.momentum);
+    Vector velocity_forward_begin(initial_velocity);
+    Vector velocity_forward_end(initial_velocity);
+    Vector velocity_backward_begin(initial_velocity);
+    Vector velocity_backward_end(initial_velocity);
+    Vector momentum_forward_begin(start.momentum);
+    Vector momentum_forward_end(start.momentum);
+    Vector momentum_backward_begin(start.momentum);
+    Vector momentum_backward_end(start.momentum);
+    Vector momentum_sum(start.momentum);
+
+    // The starting point has weight exp(H0 - H0) = 1.
+    double log_sum_weight = 0;
+    TreeStatistics stats;
+    int depth = 0;
+    while (depth < max_tree_depth_) {
+      Vector momentum_sum_forward(dim, 0.0);
+      Vector momentum_sum_backward(dim, 0.0);
+      double log_sum_weight_subtree = negative_infinity();
+      bool valid_subtree;
+      if (runif_mt(rng()) > 0.5) {
+        // The existing trajectory becomes the backward side.
+        momentum_sum_backward = momentum_sum;
+        momentum_backward_begin = momentum_forward_end;
+        velocity_backward_begin = velocity_forward_end;
+        valid_subtree = build_tree(
+            depth, forward, proposal, velocity_forward_begin,
+            velocity_forward_end, momentum_sum_forward, momentum_forward_begin,
+            momentum_forward_end, initial_energy, 1, log_sum_weight_subtree,
+            stats);
+      } else {
+        // The existing trajectory becomes the forward side.
+        momentum_sum_forward = momentum_sum;
+        momentum_forward_begin = momentum_backward_end;
+        velocity_forward_begin = velocity_backward_end;
+        valid_subtree = build_tree(
+            depth, backward, proposal, velocity_backward_begin,
+            velocity_backward_end, momentum_sum_backward,
+            momentum_backward_begin, momentum_backward_end, initial_energy,
+            -1, log_sum_weight_subtree, stats);
+      }
+      if (!valid_subtree) break;
+      ++depth;
+
+      // Prefer the new subtree, as in Betancourt's "biased progressive
+      // sampling".
+      if (log_sum_weight_subtree > log_sum_weight ||
+          runif_mt(rng()) < exp(log_sum_weight_subtree - log_sum_weight)) {
+        sample = proposal;
+        moved = true;
+      }
+      log_sum_weight = log_add(log_sum_weight, log_sum_weight_subtree);
+
+      momentum_sum = momentum_sum_backward + momentum_sum_forward;
+      // The end points of the full trajectory are backward_end and
+      // forward_end.  The extra checks catch U-turns spanning the boundary
+      // between the old trajectory and the new subtree.
+      bool persist = no_u_turn(velocity_backward_end, velocity_forward_end,
+                               momentum_sum);
+      persist = persist &&
+                no_u_turn(velocity_backward_end, velocity_forward_begin,
+                          momentum_sum_backward + momentum_forward_begin);
+      persist = persist &&
+                no_u_turn(velocity_backward_begin, velocity_forward_end,
+                          momentum_sum_forward + momentum_backward_begin);
+      if (!persist) break;
+    }
+
+    last_tree_depth_ = depth;
+    last_number_of_leapfrog_steps_ = stats.number_of_leapfrog_steps;
+    double acceptance_statistic =
+        stats.number_of_leapfrog_steps > 0
+            ? stats.sum_acceptance_probability /
+                  stats.number_of_leapfrog_steps
+            : 0.0;
+    record_transition(moved, acceptance_statistic, stats.divergent);
+    return sample.position;
+  }
+
+  bool NoUTurnSampler::build_tree(int depth, PhasePoint &point,
+                                  PhasePoint &proposal,
+                                  Vector &velocity_begin, Vector &velocity_end,
+                                  Vector &momentum_sum, Vector &momentum_begin,
+                                  Vector &momentum_end, double initial_energy,
+                                  int sign, double &log_sum_weight,
+                                  TreeStatistics &stats) {
+    if (depth == 0) {
+      leapfrog(point, sign * step_size());
+      ++stats.number_of_leapfrog_steps;
+      double energy = hamiltonian(point);
+      double log_weight = initial_energy - energy;
+      if (-log_weight > divergence_threshold) {
+        stats.divergent = true;
+      }
+      log_sum_weight = log_add(log_sum_weight, log_weight);
+      stats.sum_acceptance_probability +=
+          log_weight > 0 ? 1.0 : exp(log_weight);
+      proposal = point;
+      velocity_begin = velocity(point.momentum);
+      velocity_end = velocity_begin;
+      momentum_sum += point.momentum;
+      momentum_begin = point.momentum;
+      momentum_end = point.momentum;
+      return !stats.divergent;
+    }
+
+    int dim = point.position.size();
+    // Build the half of the subtree nearest the existing trajectory.
+    double log_sum_weight_first = negative_infinity();
+    Vector velocity_first_end(dim);
+    Vector momentum_first_end(dim);
+    Vector momentum_sum_first(dim, 0.0);
+    if (!build_tree(depth - 1, point, proposal, velocity_begin,
+                    velocity_first_end, momentum_sum_first, momentum_begin,
+                    momentum_first_end, initial_energy, sign,
+                    log_sum_weight_first, stats)) {
+      return false;
+    }
+
+    // Build the other half.
+    PhasePoint proposal_second(point);
+    double log_sum_weight_second = negative_infinity();
+    Vector velocity_second_begin(dim);
+    Vector momentum_second_begin(dim);
+    Vector momentum_sum_second(dim, 0.0);
+    if (!build_tree(depth - 1, point, proposal_second, velocity_second_begin,
+                    velocity_end, momentum_sum_second, momentum_second_begin,
+                    momentum_end, initial_energy, sign,
+                    log_sum_weight_second, stats)) {
+      return false;
+    }
+
+    // Choose between the two halves in proportion to their weights.
+    double log_sum_weight_subtree =
+        log_add(log_sum_weight_first, log_sum_weight_second);
+    log_sum_weight = log_add(log_sum_weight, log_sum_weight_subtree);
+    if (log_sum_weight_second > log_sum_weight_subtree ||
+        runif_mt(rng()) <
+            exp(log_sum_weight_second - log_sum_weight_subtree)) {
+      proposal = proposal_second;
+    }
+
+    Vector momentum_sum_subtree = momentum_sum_first + momentum_sum_second;
+    momentum_sum += momentum_sum_subtree;
+
+    bool persist =
+        no_u_turn(velocity_begin, velocity_end, momentum_sum_subtree);
+    persist = persist && no_u_turn(velocity_begin, velocity_second_begin,
+                                   momentum_sum_first + momentum_second_begin);
+    persist = persist && no_u_turn(velocity_first_end, velocity_end,
+                                   momentum_sum_second + momentum_first_end);
+    return persist;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,127 @@
+#ifndef BOOM_SAMPLERS_NO_U_TURN_SAMPLER_HPP_
+#define BOOM_SAMPLERS_NO_U_TURN_SAMPLER_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Samplers/HamiltonianMonteCarlo.hpp"
+
+namespace BOOM {
+
+  // The No-U-Turn sampler of Hoffman and Gelman (2014), in the form used by
+  // Stan: the trajectory is doubled, forwards or backwards in time, until it
+  // starts to turn back on itself, and the draw is sampled from the points
+  // on the trajectory in proportion to their probability (Betancourt 2017,
+  // "A Conceptual Introduction to Hamiltonian Monte Carlo").  The
+  // generalized no-U-turn criterion is used, so the termination check
+  // accounts for the mass matrix.
+  //
+  // Unlike HamiltonianMonteCarlo there is no trajectory length to tune.
+  // The step size and the mass matrix can be adapted during warmup; see
+  // HamiltonianSamplerBase::set_warmup.
+  //
+  // Typical use:
+  //   NoUTurnSampler sampler(log_posterior);
+  //   sampler.set_warmup(1000, HamiltonianSamplerBase::DIAGONAL);
+  //   for (int i = 0; i < niter; ++i) {
+  //     theta = sampler.draw(theta);
+  //   }
+  class NoUTurnSampler : public HamiltonianSamplerBase {
+   public:
+    // Args:
+    //   logf: The log of the un-normalized target density, and its
+    //     gradient.
+    //   initial_step_size:  The leapfrog step size.
+    //   rng:  The random number generator used by the sampler.
+    explicit NoUTurnSampler(const dTarget &logf,
+                            double initial_step_size = 0.1,
+                            RNG *rng = nullptr);
+    explicit NoUTurnSampler(const Ptr<dTargetFun> &logf,
+                            double initial_step_size = 0.1,
+                            RNG *rng = nullptr);
+
+    // The trajectory stops growing after 2^max_tree_depth leapfrog steps,
+    // even if it has not made a U-turn.
+    int max_tree_depth() const { return max_tree_depth_; }
+    void set_max_tree_depth(int depth);
+
+    // The depth of the tree built by the most recent transition, and the
+    // number of leapfrog steps it took.
+    int last_tree_depth() const { return last_tree_depth_; }
+    int last_number_of_leapfrog_steps() const {
+      return last_number_of_leapfrog_steps_;
+    }
+
+   protected:
+    Vector transition(const Vector &old) override;
+
+   private:
+    // The state of the trajectory being built.
+    struct TreeStatistics {
+      TreeStatistics() : number_of_leapfrog_steps(0),
+                         sum_acceptance_probability(0),
+                         divergent(false) {}
+      int number_of_leapfrog_steps;
+      double sum_acceptance_probability;
+      bool divergent;
+    };
+
+    // Extend the trajectory by 2^depth leapfrog steps from 'point' in the
+    // direction given by 'sign'.
+    //
+    // Args:
+    //   depth:  The depth of the subtree to build.
+    //   point: On input the end of the trajectory.  On output the end of
+    //     the extended trajectory.
+    //   proposal: On output, a point sampled from the subtree in proportion
+    //     to its probability.
+    //   velocity_begin, velocity_end: On output, M^{-1} p at the first and
+    //     last points of the subtree.
+    //   momentum_sum: The sum of the momenta of the points in the subtree is
+    //     added to this argument.
+    //   momentum_begin, momentum_end: On output, the momenta at the first and
+    //     last points of the subtree.
+    //   initial_energy:  The Hamiltonian at the start of the transition.
+    //   sign:  +1 to integrate forward in time, -1 to integrate backward.
+    //   log_sum_weight: The log of the total probability of the points in
+    //     the subtree is log-added to this argument.
+    //   stats:  Accumulates diagnostics for the transition.
+    //
+    // Returns:
+    //   true if the subtree is valid: no divergence, and no U-turn within
+    //   the subtree.
+    bool build_tree(int depth, PhasePoint &point, PhasePoint &proposal,
+                    Vector &velocity_begin, Vector &velocity_end,
+                    Vector &momentum_sum, Vector &momentum_begin,
+                    Vector &momentum_end, double initial_energy, int sign,
+                    double &log_sum_weight, TreeStatistics &stats);
+
+    // The generalized no-U-turn criterion.  Returns true if the trajectory
+    // with total momentum 'momentum_sum', and with velocities
+    // 'velocity_begin' and 'velocity_end' at its ends, is still expanding.
+    static bool no_u_turn(const Vector &velocity_begin,
+                          const Vector &velocity_end,
+                          const Vector &momentum_sum);
+
+    int max_tree_depth_;
+    int last_tree_depth_;
+    int last_number_of_leapfrog_steps_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SAMPLERS_NO_U_TURN_SAMPLER_HPP_
@@ -77,7 +77,7 @@ namespace BOOM {
   void SliceSampler::set_random_direction() {
     random_direction_.resize(last_position_.size());
     for (uint i = 0; i < random_direction_.size(); ++i) {
-      random_direction_[i] = scale_ * rnorm();
+      random_direction_[i] = scale_ * rnorm_mt(rng());
     }
   }
 
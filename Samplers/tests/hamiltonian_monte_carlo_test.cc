@@ -0,0 +1,198 @@
+#include "gtest/gtest.h"
+#include "Samplers/HamiltonianMonteCarlo.hpp"
+#include "Samplers/NoUTurnSampler.hpp"
+#include "cpputil/math_utils.hpp"
+#include "stats/moments.hpp"
+#include "distributions.hpp"
+
+#include <utility>
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class HamiltonianMonteCarloTest : public ::testing::Test {
+   protected:
+    HamiltonianMonteCarloTest()
+        : mu_{1.0, -2.0},
+          sigma_(2) {
+      GlobalRng::rng.seed(8675309);
+      sigma_(0, 0) = 1.0;
+      sigma_(1, 1) = 4.0;
+      sigma_(0, 1) = sigma_(1, 0) = 1.6;
+      siginv_ = sigma_.inv();
+    }
+
+    // The log density of N(mu_, sigma_), up to a constant, and its gradient.
+    dTarget gaussian() const {
+      return [this](const Vector &x, Vector &gradient) {
+        Vector residual = x - mu_;
+        gradient = siginv_ * residual;
+        gradient *= -1;
+        return -0.5 * siginv_.Mdist(residual);
+      };
+    }
+
+    // Run 'sampler' for 'niter' iterations after its warmup period, starting
+    // from the origin, and check the draws against mu_ and sigma_.
+    void check_gaussian_draws(HamiltonianSamplerBase &sampler, int warmup,
+                              int niter) {
+      Vector theta(2, 0.0);
+      for (int i = 0; i < warmup; ++i) {
+        theta = sampler.draw(theta);
+      }
+      EXPECT_FALSE(sampler.warming_up());
+      Matrix draws(niter, 2);
+      for (int i = 0; i < niter; ++i) {
+        theta = sampler.draw(theta);
+        draws.row(i) = theta;
+      }
+      Vector sample_mean = mean(draws);
+      SpdMatrix sample_variance = var(draws);
+      for (int j = 0; j < 2; ++j) {
+        EXPECT_NEAR(sample_mean[j], mu_[j], .1 * sqrt(sigma_(j, j)))
+            << "mean " << j;
+        for (int k = 0; k < 2; ++k) {
+          EXPECT_NEAR(sample_variance(j, k), sigma_(j, k),
+                      .1 * sqrt(sigma_(j, j) * sigma_(k, k)))
+              << "variance (" << j << ", " << k << ")";
+        }
+      }
+    }
+
+    // Run 'sampler' through a warmup period of 'warmup' draws followed by
+    // 'niter' further draws.  Returns the average acceptance statistic over
+    // the second half of the warmup period, and over the draws after warmup.
+    std::pair<double, double> average_acceptance(
+        HamiltonianSamplerBase &sampler, int warmup, int niter) {
+      Vector theta(2, 0.0);
+      double warmup_total = 0;
+      for (int i = 0; i < warmup; ++i) {
+        theta = sampler.draw(theta);
+        if (2 * i >= warmup) {
+          warmup_total += sampler.last_acceptance_statistic();
+        }
+      }
+      double total = 0;
+      for (int i = 0; i < niter; ++i) {
+        theta = sampler.draw(theta);
+        total += sampler.last_acceptance_statistic();
+      }
+      return std::make_pair(warmup_total / (warmup - warmup / 2),
+                            total / niter);
+    }
+
+    Vector mu_;
+    SpdMatrix sigma_;
+    SpdMatrix siginv_;
+  };
+
+  TEST_F(HamiltonianMonteCarloTest, HmcRecoversCorrelatedGaussian) {
+    HamiltonianMonteCarlo sampler(gaussian(), 0.1, 5);
+    sampler.set_warmup(1000, HamiltonianSamplerBase::DENSE);
+    check_gaussian_draws(sampler, 1000, 5000);
+    // With a dense mass matrix the target is nearly spherical, so the
+    // adapted inverse mass matrix should resemble sigma_.
+    SpdMatrix inverse_mass = sampler.inverse_mass_matrix();
+    EXPECT_NEAR(inverse_mass(0, 1) / sqrt(inverse_mass(0, 0)
+                                          * inverse_mass(1, 1)),
+                0.8, .15);
+  }
+
+  TEST_F(HamiltonianMonteCarloTest, NutsRecoversCorrelatedGaussian) {
+    NoUTurnSampler sampler(gaussian());
+    sampler.set_warmup(1000, HamiltonianSamplerBase::DIAGONAL);
+    check_gaussian_draws(sampler, 1000, 5000);
+    EXPECT_GE(sampler.last_tree_depth(), 1);
+    EXPECT_LE(sampler.last_tree_depth(), sampler.max_tree_depth());
+  }
+
+  TEST_F(HamiltonianMonteCarloTest, DualAveragingHitsTargetAcceptanceRate) {
+    // Once the step size settles, the acceptance statistics seen during
+    // adaptation average to the target.  The final step size is an average
+    // of log step sizes, which is a little smaller than the step sizes
+    // visited, so the acceptance rate after warmup runs at or above the
+    // target.
+    for (double target : {0.6, 0.9}) {
+      HamiltonianMonteCarlo hmc(gaussian(), 0.1, 10);
+      hmc.set_warmup(1000, HamiltonianSamplerBase::IDENTITY, target);
+      std::pair<double, double> hmc_rates = average_acceptance(hmc, 1000, 2000);
+      EXPECT_NEAR(target, hmc_rates.first, .03) << "HMC target " << target;
+      EXPECT_GT(hmc_rates.second, target - .03) << "HMC target " << target;
+
+      NoUTurnSampler nuts(gaussian());
+      nuts.set_warmup(1000, HamiltonianSamplerBase::IDENTITY, target);
+      std::pair<double, double> nuts_rates =
+          average_acceptance(nuts, 1000, 2000);
+      EXPECT_NEAR(target, nuts_rates.first, .03) << "NUTS target " << target;
+      EXPECT_GT(nuts_rates.second, target - .03) << "NUTS target " << target;
+    }
+
+    // The step size recursion on its own: with an acceptance statistic that
+    // falls as the step size grows, the iterates settle where the statistic
+    // equals the target.
+    DualAveragingStepSize adaptation(0.75);
+    adaptation.restart(1.0);
+    double step_size = 1.0;
+    for (int i = 0; i < 2000; ++i) {
+      step_size = adaptation.update(exp(-step_size));
+    }
+    EXPECT_NEAR(-log(0.75), adaptation.final_step_size(), .02);
+  }
+
+  TEST_F(HamiltonianMonteCarloTest, RejectsZeroDensityProposals) {
+    // A standard normal truncated to x[0] < 0.5.  The log density is -infinity
+    // beyond the boundary.
+    dTarget truncated = [](const Vector &x, Vector &gradient) {
+      gradient = x;
+      gradient *= -1;
+      return x[0] < 0.5 ? -0.5 * x.normsq() : negative_infinity();
+    };
+
+    HamiltonianMonteCarlo hmc(truncated, 0.5, 5);
+    NoUTurnSampler nuts(truncated, 0.5);
+    for (HamiltonianSamplerBase *sampler :
+             std::vector<HamiltonianSamplerBase *>{&hmc, &nuts}) {
+      Vector theta(2, 0.0);
+      int rejections = 0;
+      for (int i = 0; i < 1000; ++i) {
+        Vector old = theta;
+        theta = sampler->draw(theta);
+        ASSERT_LT(theta[0], 0.5);
+        if (!sampler->last_draw_was_accepted()) {
+          ++rejections;
+          if (sampler == &hmc) {
+            EXPECT_TRUE(VectorEquals(old, theta));
+          }
+        }
+      }
+      EXPECT_GT(rejections, 0);
+    }
+  }
+
+  TEST_F(HamiltonianMonteCarloTest, RejectsDivergentProposals) {
+    // A leapfrog step longer than 2 standard deviations is unstable, so the
+    // energy error explodes along the trajectory.
+    dTarget standard_normal = [](const Vector &x, Vector &gradient) {
+      gradient = x;
+      gradient *= -1;
+      return -0.5 * x.normsq();
+    };
+    HamiltonianMonteCarlo hmc(standard_normal, 20.0, 20);
+    NoUTurnSampler nuts(standard_normal, 20.0);
+    for (HamiltonianSamplerBase *sampler :
+             std::vector<HamiltonianSamplerBase *>{&hmc, &nuts}) {
+      Vector theta = {0.3, -0.2};
+      for (int i = 0; i < 20; ++i) {
+        Vector old = theta;
+        theta = sampler->draw(theta);
+        EXPECT_TRUE(sampler->last_draw_diverged());
+        EXPECT_FALSE(sampler->last_draw_was_accepted());
+        EXPECT_TRUE(VectorEquals(old, theta));
+      }
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,61 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "TargetFun/AutoDiff.hpp"
+#include <algorithm>
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+  namespace AutoDiff {
+
+    namespace {
+      thread_local Tape *active_tape = nullptr;
+    }  // namespace
+
+    Tape *Tape::active() { return active_tape; }
+
+    void Tape::set_active(Tape *tape) { active_tape = tape; }
+
+    Vector Tape::gradient(int output, int number_of_inputs) const {
+      if (output < 0 || output >= size()) {
+        report_error("Output node is not on the tape.");
+      }
+      if (number_of_inputs > size()) {
+        report_error("More inputs than nodes on the tape.");
+      }
+      // Nodes are recorded in the order they are computed, so parents always
+      // precede their children, and a single backward sweep applies the
+      // chain rule.  The output may itself be one of the inputs (e.g. if f
+      // returns x[0]), in which case its gradient is a unit vector.
+      std::vector<double> adjoint(std::max(output + 1, number_of_inputs), 0.0);
+      adjoint[output] = 1.0;
+      for (int i = output; i >= number_of_inputs; --i) {
+        double weight = adjoint[i];
+        if (weight == 0) continue;
+        const Node &node(nodes_[i]);
+        for (int k = 0; k < 2; ++k) {
+          if (node.parent[k] >= 0) {
+            adjoint[node.parent[k]] += weight * node.partial[k];
+          }
+        }
+      }
+      return Vector(adjoint.begin(), adjoint.begin() + number_of_inputs);
+    }
+
+  }  // namespace AutoDiff
+}  // namespace BOOM
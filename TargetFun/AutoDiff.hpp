@@ -0,0 +1,465 @@
+#ifndef BOOM_TARGETFUN_AUTO_DIFF_HPP_
+#define BOOM_TARGETFUN_AUTO_DIFF_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "TargetFun/TargetFun.hpp"
+#include "Bmath/Bmath.hpp"
+
+// Automatic differentiation for functions written once as a template over the
+// scalar type.  A function object suitable for differentiation has a call
+// operator of the form
+//
+//   template <class Scalar>
+//   Scalar operator()(const std::vector<Scalar> &x) const;
+//
+// (a generic lambda taking 'const auto &x' also works).  The function can use
+// the arithmetic operators, comparisons, and the functions exp, log, log1p,
+// sqrt, square, pow, and lgamma.  It is evaluated with
+//
+//   * Scalar = double for plain function values,
+//   * Scalar = AutoDiff::Var to compute the gradient by reverse mode
+//     differentiation, which costs a small multiple of one function
+//     evaluation regardless of the dimension of x, and
+//   * Scalar = AutoDiff::HyperDual to compute the gradient and Hessian by
+//     forward mode differentiation, which costs O(dim(x)^2) per operation.
+//
+// Derivatives are exact up to rounding error, unlike the finite differences
+// in numopt/NumericalDerivatives.hpp.
+//
+// Example:
+//   auto f = [](const auto &x) { return exp(x[0]) * x[1] - square(x[1]); };
+//   Vector gradient;
+//   double value = AutoDiff::gradient(f, Vector{1.0, 2.0}, gradient);
+//
+// Control flow that depends on the values of the arguments is allowed (the
+// derivatives are those of the branch taken).  Use value_of() to get at the
+// underlying double.
+namespace BOOM {
+  namespace AutoDiff {
+
+    //=========================================================================
+    // A Tape records the operations performed on Var objects, so the chain
+    // rule can be applied in reverse.  Each node of the tape is the result of
+    // an operation with at most two arguments, and stores the partial
+    // derivatives of the result with respect to those arguments.
+    //
+    // Var objects record to the tape that is active in the current thread.
+    // Tapes are normally managed by AutoDiff::gradient.
+    class Tape {
+     public:
+      // Record a node, and return its index.  A negative parent index
+      // indicates that the node has fewer than two parents.
+      int record(int parent1, double partial1, int parent2 = -1,
+                 double partial2 = 0) {
+        nodes_.push_back({{parent1, parent2}, {partial1, partial2}});
+        return nodes_.size() - 1;
+      }
+
+      int size() const { return nodes_.size(); }
+      void clear() { nodes_.clear(); }
+
+      // Returns the derivatives of node 'output' with respect to nodes 0, 1,
+      // ..., number_of_inputs - 1.
+      Vector gradient(int output, int number_of_inputs) const;
+
+      // The tape that new Var operations record to in this thread, or
+      // nullptr.
+      static Tape *active();
+
+     private:
+      friend class ActiveTape;
+      static void set_active(Tape *tape);
+
+      struct Node {
+        int parent[2];
+        double partial[2];
+      };
+      std::vector<Node> nodes_;
+    };
+
+    // Makes a tape active for the lifetime of the ActiveTape object, and
+    // restores the previously active tape when it is destroyed.
+    class ActiveTape {
+     public:
+      explicit ActiveTape(Tape *tape) : previous_(Tape::active()) {
+        Tape::set_active(tape);
+      }
+      ~ActiveTape() { Tape::set_active(previous_); }
+      ActiveTape(const ActiveTape &rhs) = delete;
+      ActiveTape &operator=(const ActiveTape &rhs) = delete;
+
+     private:
+      Tape *previous_;
+    };
+
+    //=========================================================================
+    // A scalar for reverse mode differentiation.  A Var is either a constant,
+    // which is not recorded, or a reference to a node on the active tape.
+    class Var {
+     public:
+      // Constants.  Implicit conversion from double is intended.
+      Var() : value_(0), index_(-1) {}
+      Var(double value) : value_(value), index_(-1) {}  // NOLINT
+
+      // A value computed from other variables, which is stored in node
+      // 'index' of the active tape.
+      Var(double value, int index) : value_(value), index_(index) {}
+
+      // Create an independent variable on the active tape.
+      static Var independent(double value) {
+        return Var(value, Tape::active()->record(-1, 0));
+      }
+
+      double value() const { return value_; }
+      int index() const { return index_; }
+      bool is_constant() const { return index_ < 0; }
+
+      Var &operator+=(const Var &rhs);
+      Var &operator-=(const Var &rhs);
+      Var &operator*=(const Var &rhs);
+      Var &operator/=(const Var &rhs);
+
+     private:
+      double value_;
+      int index_;
+    };
+
+    namespace internal {
+      // The result of applying a function with derivative 'partial' to x.
+      inline Var unary(const Var &x, double value, double partial) {
+        if (x.is_constant()) return Var(value);
+        return Var(value, Tape::active()->record(x.index(), partial));
+      }
+
+      // The result of applying a function with partial derivatives 'dx' and
+      // 'dy' to (x, y).
+      inline Var binary(const Var &x, double dx, const Var &y, double dy,
+                        double value) {
+        if (x.is_constant()) return unary(y, value, dy);
+        if (y.is_constant()) return unary(x, value, dx);
+        return Var(value, Tape::active()->record(x.index(), dx, y.index(), dy));
+      }
+    }  // namespace internal
+
+    inline Var operator+(const Var &x, const Var &y) {
+      return internal::binary(x, 1.0, y, 1.0, x.value() + y.value());
+    }
+    inline Var operator-(const Var &x, const Var &y) {
+      return internal::binary(x, 1.0, y, -1.0, x.value() - y.value());
+    }
+    inline Var operator*(const Var &x, const Var &y) {
+      return internal::binary(x, y.value(), y, x.value(),
+                              x.value() * y.value());
+    }
+    inline Var operator/(const Var &x, const Var &y) {
+      double ratio = x.value() / y.value();
+      return internal::binary(x, 1.0 / y.value(), y, -ratio / y.value(),
+                              ratio);
+    }
+    inline Var operator-(const Var &x) {
+      return internal::unary(x, -x.value(), -1.0);
+    }
+
+    inline Var &Var::operator+=(const Var &rhs) { return *this = *this + rhs; }
+    inline Var &Var::operator-=(const Var &rhs) { return *this = *this - rhs; }
+    inline Var &Var::operator*=(const Var &rhs) { return *this = *this * rhs; }
+    inline Var &Var::operator/=(const Var &rhs) { return *this = *this / rhs; }
+
+    inline Var exp(const Var &x) {
+      double value = std::exp(x.value());
+      return internal::unary(x, value, value);
+    }
+    inline Var log(const Var &x) {
+      return internal::unary(x, std::log(x.value()), 1.0 / x.value());
+    }
+    inline Var log1p(const Var &x) {
+      return internal::unary(x, std::log1p(x.value()), 1.0 / (1 + x.value()));
+    }
+    inline Var sqrt(const Var &x) {
+      double value = std::sqrt(x.value());
+      return internal::unary(x, value, 0.5 / value);
+    }
+    inline Var square(const Var &x) {
+      return internal::unary(x, x.value() * x.value(), 2 * x.value());
+    }
+    inline Var pow(const Var &x, double power) {
+      return internal::unary(x, std::pow(x.value(), power),
+                             power * std::pow(x.value(), power - 1));
+    }
+    inline Var lgamma(const Var &x) {
+      return internal::unary(x, std::lgamma(x.value()),
+                             Rmath::digamma(x.value()));
+    }
+
+    //=========================================================================
+    // A scalar for forward mode differentiation to second order.  A
+    // HyperDual carries its value, along with its gradient and Hessian with
+    // respect to the independent variables.  Constants have empty gradients
+    // and Hessians, so operations involving them are cheap.
+    class HyperDual {
+     public:
+      HyperDual() : value_(0) {}
+      HyperDual(double value) : value_(value) {}  // NOLINT
+      HyperDual(double value, const Vector &gradient, const Matrix &hessian)
+          : value_(value), gradient_(gradient), hessian_(hessian) {}
+
+      // Independent variable number 'position' out of 'dimension'.
+      static HyperDual independent(double value, int position,
+                                   int dimension) {
+        Vector gradient(dimension, 0.0);
+        gradient[position] = 1.0;
+        return HyperDual(value, gradient, Matrix(dimension, dimension, 0.0));
+      }
+
+      double value() const { return value_; }
+      const Vector &gradient() const { return gradient_; }
+      const Matrix &hessian() const { return hessian_; }
+      bool is_constant() const { return gradient_.empty(); }
+
+      HyperDual &operator+=(const HyperDual &rhs);
+      HyperDual &operator-=(const HyperDual &rhs);
+      HyperDual &operator*=(const HyperDual &rhs);
+      HyperDual &operator/=(const HyperDual &rhs);
+
+     private:
+      double value_;
+      Vector gradient_;
+      Matrix hessian_;
+    };
+
+    namespace internal {
+      // The result of applying a function f to x, where 'value', 'd1' and
+      // 'd2' are f(x), f'(x) and f''(x).
+      inline HyperDual chain_rule(const HyperDual &x, double value, double d1,
+                                  double d2) {
+        if (x.is_constant()) return HyperDual(value);
+        Matrix hessian = x.hessian() * d1;
+        hessian.add_outer(x.gradient(), x.gradient(), d2);
+        return HyperDual(value, x.gradient() * d1, hessian);
+      }
+
+      // a * x + b * y for constants a and b.
+      inline HyperDual linear_combination(double a, const HyperDual &x,
+                                          double b, const HyperDual &y) {
+        double value = a * x.value() + b * y.value();
+        if (x.is_constant()) return chain_rule(y, value, b, 0);
+        if (y.is_constant()) return chain_rule(x, value, a, 0);
+        return HyperDual(value, a * x.gradient() + b * y.gradient(),
+                         a * x.hessian() + b * y.hessian());
+      }
+    }  // namespace internal
+
+    inline HyperDual operator+(const HyperDual &x, const HyperDual &y) {
+      return internal::linear_combination(1.0, x, 1.0, y);
+    }
+    inline HyperDual operator-(const HyperDual &x, const HyperDual &y) {
+      return internal::linear_combination(1.0, x, -1.0, y);
+    }
+    inline HyperDual operator-(const HyperDual &x) {
+      return internal::chain_rule(x, -x.value(), -1.0, 0.0);
+    }
+    inline HyperDual operator*(const HyperDual &x, const HyperDual &y) {
+      double value = x.value() * y.value();
+      if (x.is_constant()) return internal::chain_rule(y, value, x.value(), 0);
+      if (y.is_constant()) return internal::chain_rule(x, value, y.value(), 0);
+      Matrix hessian = x.value() * y.hessian() + y.value() * x.hessian();
+      hessian.add_outer(x.gradient(), y.gradient());
+      hessian.add_outer(y.gradient(), x.gradient());
+      return HyperDual(value, x.value() * y.gradient() + y.value() * x.gradient(),
+                       hessian);
+    }
+    inline HyperDual reciprocal(const HyperDual &x) {
+      double inverse = 1.0 / x.value();
+      return internal::chain_rule(x, inverse, -inverse * inverse,
+                                  2 * inverse * inverse * inverse);
+    }
+    inline HyperDual operator/(const HyperDual &x, const HyperDual &y) {
+      if (y.is_constant()) {
+        return internal::chain_rule(x, x.value() / y.value(), 1.0 / y.value(),
+                                    0);
+      }
+      return x * reciprocal(y);
+    }
+
+    inline HyperDual &HyperDual::operator+=(const HyperDual &rhs) {
+      return *this = *this + rhs;
+    }
+    inline HyperDual &HyperDual::operator-=(const HyperDual &rhs) {
+      return *this = *this - rhs;
+    }
+    inline HyperDual &HyperDual::operator*=(const HyperDual &rhs) {
+      return *this = *this * rhs;
+    }
+    inline HyperDual &HyperDual::operator/=(const HyperDual &rhs) {
+      return *this = *this / rhs;
+    }
+
+    inline HyperDual exp(const HyperDual &x) {
+      double value = std::exp(x.value());
+      return internal::chain_rule(x, value, value, value);
+    }
+    inline HyperDual log(const HyperDual &x) {
+      double inverse = 1.0 / x.value();
+      return internal::chain_rule(x, std::log(x.value()), inverse,
+                                  -inverse * inverse);
+    }
+    inline HyperDual log1p(const HyperDual &x) {
+      double inverse = 1.0 / (1 + x.value());
+      return internal::chain_rule(x, std::log1p(x.value()), inverse,
+                                  -inverse * inverse);
+    }
+    inline HyperDual sqrt(const HyperDual &x) {
+      double value = std::sqrt(x.value());
+      return internal::chain_rule(x, value, 0.5 / value,
+                                  -0.25 / (value * x.value()));
+    }
+    inline HyperDual square(const HyperDual &x) {
+      return internal::chain_rule(x, x.value() * x.value(), 2 * x.value(), 2);
+    }
+    inline HyperDual pow(const HyperDual &x, double power) {
+      return internal::chain_rule(
+          x, std::pow(x.value(), power),
+          power * std::pow(x.value(), power - 1),
+          power * (power - 1) * std::pow(x.value(), power - 2));
+    }
+    inline HyperDual lgamma(const HyperDual &x) {
+      return internal::chain_rule(x, std::lgamma(x.value()),
+                                  Rmath::digamma(x.value()),
+                                  Rmath::trigamma(x.value()));
+    }
+
+    //=========================================================================
+    // Access to the value of any of the scalar types, e.g. for control flow.
+    inline double value_of(double x) { return x; }
+    inline double value_of(const Var &x) { return x.value(); }
+    inline double value_of(const HyperDual &x) { return x.value(); }
+
+    // Comparisons act on values.
+#define BOOM_AUTODIFF_COMPARISON(OP)                                      \
+    inline bool operator OP(const Var &x, const Var &y) {                 \
+      return x.value() OP y.value();                                      \
+    }                                                                     \
+    inline bool operator OP(const Var &x, double y) {                     \
+      return x.value() OP y;                                              \
+    }                                                                     \
+    inline bool operator OP(double x, const Var &y) {                     \
+      return x OP y.value();                                              \
+    }                                                                     \
+    inline bool operator OP(const HyperDual &x, const HyperDual &y) {     \
+      return x.value() OP y.value();                                      \
+    }                                                                     \
+    inline bool operator OP(const HyperDual &x, double y) {               \
+      return x.value() OP y;                                              \
+    }                                                                     \
+    inline bool operator OP(double x, const HyperDual &y) {               \
+      return x OP y.value();                                              \
+    }
+
+    BOOM_AUTODIFF_COMPARISON(<)
+    BOOM_AUTODIFF_COMPARISON(<=)
+    BOOM_AUTODIFF_COMPARISON(>)
+    BOOM_AUTODIFF_COMPARISON(>=)
+#undef BOOM_AUTODIFF_COMPARISON
+
+    //=========================================================================
+    // Evaluate f at x, returning the function value and filling 'gradient'
+    // by reverse mode differentiation.
+    template <class F>
+    double gradient(const F &f, const Vector &x, Vector &gradient) {
+      Tape tape;
+      ActiveTape activate(&tape);
+      std::vector<Var> arguments;
+      arguments.reserve(x.size());
+      for (double xi : x) {
+        arguments.push_back(Var::independent(xi));
+      }
+      Var ans = f(arguments);
+      if (ans.is_constant()) {
+        gradient.resize(x.size());
+        gradient = 0.0;
+      } else {
+        gradient = tape.gradient(ans.index(), x.size());
+      }
+      return ans.value();
+    }
+
+    // Evaluate f at x, returning the function value and filling 'gradient'
+    // and 'hessian' by forward mode differentiation.
+    template <class F>
+    double hessian(const F &f, const Vector &x, Vector &gradient,
+                   Matrix &hessian) {
+      int dim = x.size();
+      std::vector<HyperDual> arguments;
+      arguments.reserve(dim);
+      for (int i = 0; i < dim; ++i) {
+        arguments.push_back(HyperDual::independent(x[i], i, dim));
+      }
+      HyperDual ans = f(arguments);
+      if (ans.is_constant()) {
+        gradient.resize(dim);
+        gradient = 0.0;
+        hessian.resize(dim, dim);
+        hessian = 0.0;
+      } else {
+        gradient = ans.gradient();
+        hessian = ans.hessian();
+      }
+      return ans.value();
+    }
+
+  }  // namespace AutoDiff
+
+  //===========================================================================
+  // A d2TargetFun whose derivatives are computed by automatic
+  // differentiation.  F is a function object with a templated call operator,
+  // as described above.
+  //
+  // Example:
+  //   auto logf = [](const auto &x) { return -0.5 * square(x[0] - 3); };
+  //   NEW(AutoDiffTargetFun<decltype(logf)>, target)(logf);
+  //   max_nd2(x, g, h, *target ...);
+  template <class F>
+  class AutoDiffTargetFun : public d2TargetFun {
+   public:
+    explicit AutoDiffTargetFun(const F &f) : f_(f) {}
+
+    double operator()(const Vector &x, Vector &gradient, Matrix &hessian,
+                      uint nderiv) const override {
+      if (nderiv == 0) {
+        return f_(std::vector<double>(x.begin(), x.end()));
+      } else if (nderiv == 1) {
+        return AutoDiff::gradient(f_, x, gradient);
+      } else {
+        return AutoDiff::hessian(f_, x, gradient, hessian);
+      }
+    }
+    using d2TargetFun::operator();
+
+   private:
+    F f_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_TARGETFUN_AUTO_DIFF_HPP_
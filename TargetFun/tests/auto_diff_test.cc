@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+#include "TargetFun/AutoDiff.hpp"
+#include "Models/Glm/GammaRegressionModel.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "numopt/NumericalDerivatives.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class AutoDiffTest : public ::testing::Test {
+   protected:
+    AutoDiffTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // A function exercising all the supported operations.
+  struct TestFunction {
+    template <class Scalar>
+    Scalar operator()(const std::vector<Scalar> &x) const {
+      using std::exp;
+      using std::log;
+      using std::log1p;
+      using std::sqrt;
+      using std::pow;
+      using std::lgamma;
+      using BOOM::square;
+      Scalar ans = exp(x[0]) * x[1] - x[2] / x[1];
+      ans += log(x[1] * x[2]) + log1p(x[0] * x[0]);
+      ans -= sqrt(x[2]) * pow(x[1], 2.5) + square(x[0] - x[2]);
+      ans += lgamma(x[1] + 1.0);
+      ans *= 0.5;
+      ans += 3.0 - x[0];
+      if (x[0] > 0) {
+        ans /= x[2];
+      }
+      return -ans;
+    }
+  };
+
+  TEST_F(AutoDiffTest, KnownDerivatives) {
+    auto f = [](const auto &x) { return x[0] * x[0] * x[1] + 3.0 * x[1]; };
+    Vector x = {2.0, 5.0};
+    Vector gradient;
+    EXPECT_DOUBLE_EQ(35.0, AutoDiff::gradient(f, x, gradient));
+    EXPECT_DOUBLE_EQ(20.0, gradient[0]);
+    EXPECT_DOUBLE_EQ(7.0, gradient[1]);
+
+    Matrix hessian;
+    gradient = 0.0;
+    EXPECT_DOUBLE_EQ(35.0, AutoDiff::hessian(f, x, gradient, hessian));
+    EXPECT_DOUBLE_EQ(20.0, gradient[0]);
+    EXPECT_DOUBLE_EQ(7.0, gradient[1]);
+    EXPECT_DOUBLE_EQ(10.0, hessian(0, 0));
+    EXPECT_DOUBLE_EQ(4.0, hessian(0, 1));
+    EXPECT_DOUBLE_EQ(4.0, hessian(1, 0));
+    EXPECT_DOUBLE_EQ(0.0, hessian(1, 1));
+
+    // A function that does not depend on its argument.
+    auto constant = [](const auto &x) { return decltype(x[0] + 1.0)(4.0); };
+    EXPECT_DOUBLE_EQ(4.0, AutoDiff::gradient(constant, x, gradient));
+    EXPECT_TRUE(VectorEquals(gradient, Vector(2, 0.0)));
+
+    // A function that returns one of its inputs unchanged.
+    auto first = [](const auto &x) { return x[0]; };
+    EXPECT_DOUBLE_EQ(2.0, AutoDiff::gradient(first, x, gradient));
+    EXPECT_TRUE(VectorEquals(gradient, Vector{1.0, 0.0}));
+    gradient = 0.0;
+    EXPECT_DOUBLE_EQ(2.0, AutoDiff::hessian(first, x, gradient, hessian));
+    EXPECT_TRUE(VectorEquals(gradient, Vector{1.0, 0.0}));
+    EXPECT_TRUE(MatrixEquals(hessian, Matrix(2, 2, 0.0)));
+  }
+
+  TEST_F(AutoDiffTest, MatchesNumericalDerivatives) {
+    TestFunction f;
+    for (const Vector &x : {Vector{0.3, 1.7, 2.2}, Vector{-0.4, 0.8, 1.3}}) {
+      Vector gradient;
+      Matrix hessian;
+      double value = f(std::vector<double>(x.begin(), x.end()));
+      EXPECT_NEAR(value, AutoDiff::gradient(f, x, gradient), 1e-12);
+      Vector forward_gradient;
+      EXPECT_NEAR(value, AutoDiff::hessian(f, x, forward_gradient, hessian),
+                  1e-12);
+      EXPECT_TRUE(VectorEquals(gradient, forward_gradient, 1e-10))
+          << "reverse: " << gradient << endl
+          << "forward: " << forward_gradient;
+
+      NumericalDerivatives numeric(
+          [&f](const Vector &x) {
+            return f(std::vector<double>(x.begin(), x.end()));
+          });
+      EXPECT_TRUE(VectorEquals(gradient, numeric.gradient(x), 1e-6))
+          << "auto diff: " << gradient << endl
+          << "numeric:   " << numeric.gradient(x);
+      EXPECT_TRUE(MatrixEquals(hessian, numeric.Hessian(x), 1e-3))
+          << "auto diff: " << endl << hessian
+          << "numeric:   " << endl << numeric.Hessian(x);
+    }
+  }
+
+  TEST_F(AutoDiffTest, TargetFun) {
+    TestFunction f;
+    NEW(AutoDiffTargetFun<TestFunction>, target)(f);
+    Vector x = {0.3, 1.7, 2.2};
+    Vector gradient(3);
+    Matrix hessian(3, 3);
+    double value = (*target)(x);
+    EXPECT_DOUBLE_EQ(value, (*target)(x, gradient));
+    EXPECT_DOUBLE_EQ(value, (*target)(x, gradient, hessian));
+    Vector reference_gradient;
+    Matrix reference_hessian;
+    AutoDiff::hessian(f, x, reference_gradient, reference_hessian);
+    EXPECT_TRUE(VectorEquals(gradient, reference_gradient));
+    EXPECT_TRUE(MatrixEquals(hessian, reference_hessian));
+  }
+
+  // The gamma regression log likelihood written as a template, checked
+  // against the analytic derivatives in GammaRegressionModel.
+  class GammaRegressionLogLikelihood {
+   public:
+    explicit GammaRegressionLogLikelihood(const GammaRegressionModel &model)
+        : model_(model) {}
+
+    template <class Scalar>
+    Scalar operator()(const std::vector<Scalar> &alpha_beta) const {
+      using std::exp;
+      using std::log;
+      using std::lgamma;
+      const Scalar &alpha(alpha_beta[0]);
+      Scalar ans = 0.0;
+      for (const auto &data_point : model_.dat()) {
+        const Vector &x(data_point->x());
+        double y = data_point->y();
+        Scalar eta = 0.0;
+        for (int j = 0; j < x.size(); ++j) {
+          eta += alpha_beta[j + 1] * x[j];
+        }
+        // log Ga(y | alpha, alpha / mu) with mu = exp(eta).
+        ans += alpha * (log(alpha) - eta) - lgamma(alpha)
+            + (alpha - 1.0) * log(y) - alpha * y * exp(-eta);
+      }
+      return ans;
+    }
+
+   private:
+    const GammaRegressionModel &model_;
+  };
+
+  TEST_F(AutoDiffTest, GammaRegression) {
+    Vector beta = {1.2, -0.4, 0.3};
+    GammaRegressionModel model(2.5, beta);
+    for (int i = 0; i < 200; ++i) {
+      Vector x = {1.0, rnorm(), rnorm()};
+      double y = model.sim(x);
+      model.add_data(new RegressionData(y, x));
+    }
+
+    Vector alpha_beta = {2.0, 1.0, -0.3, 0.2};
+    Vector analytic_gradient(4), gradient;
+    Matrix analytic_hessian(4, 4), hessian;
+    double analytic = model.Loglike(alpha_beta, analytic_gradient,
+                                    analytic_hessian, 2);
+
+    GammaRegressionLogLikelihood loglike(model);
+    EXPECT_NEAR(analytic, AutoDiff::gradient(loglike, alpha_beta, gradient),
+                1e-8);
+    EXPECT_TRUE(VectorEquals(gradient, analytic_gradient, 1e-8))
+        << "auto diff: " << gradient << endl
+        << "analytic:  " << analytic_gradient;
+
+    EXPECT_NEAR(analytic,
+                AutoDiff::hessian(loglike, alpha_beta, gradient, hessian),
+                1e-8);
+    EXPECT_TRUE(VectorEquals(gradient, analytic_gradient, 1e-8));
+    EXPECT_TRUE(MatrixEquals(hessian, analytic_hessian, 1e-8))
+        << "auto diff: " << endl << hessian
+        << "analytic:  " << endl << analytic_hessian;
+  }
+
+}  // namespace
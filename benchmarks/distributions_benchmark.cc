@@ -0,0 +1,116 @@
+// Benchmarks for the random variate generators that dominate the inner loops
+// of MCMC samplers.  Each benchmark uses its own seeded RNG, so the sequence
+// of variates is the same on every run.
+
+#include "benchmark/benchmark.h"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "distributions.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  void BM_Runif(benchmark::State &state) {
+    RNG rng(8675309);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(runif_mt(rng));
+    }
+  }
+  BENCHMARK(BM_Runif);
+
+  void BM_Rnorm(benchmark::State &state) {
+    RNG rng(8675309);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(rnorm_mt(rng, 0, 1));
+    }
+  }
+  BENCHMARK(BM_Rnorm);
+
+  // rgamma switches algorithms at shape = 1, so both regimes are timed.
+  // Shape 0.5 is typical of variance priors, and 50 of posteriors with lots
+  // of data.
+  void BM_Rgamma(benchmark::State &state) {
+    RNG rng(8675309);
+    double shape = state.range(0) / 10.0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(rgamma_mt(rng, shape, 1.0));
+    }
+  }
+  BENCHMARK(BM_Rgamma)->Arg(5)->Arg(20)->Arg(500);
+
+  void BM_Rbeta(benchmark::State &state) {
+    RNG rng(8675309);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(rbeta_mt(rng, 2.0, 3.0));
+    }
+  }
+  BENCHMARK(BM_Rbeta);
+
+  void BM_Rpois(benchmark::State &state) {
+    RNG rng(8675309);
+    double mean = state.range(0);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(rpois_mt(rng, mean));
+    }
+  }
+  BENCHMARK(BM_Rpois)->Arg(3)->Arg(100);
+
+  // The truncated normal draws used by probit data augmentation.  A cutpoint
+  // far in the tail exercises the rejection sampler.
+  void BM_RtruncNorm(benchmark::State &state) {
+    RNG rng(8675309);
+    double cutpoint = state.range(0);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(rtrun_norm_mt(rng, 0, 1, cutpoint, true));
+    }
+  }
+  BENCHMARK(BM_RtruncNorm)->Arg(0)->Arg(4);
+
+  void BM_Rmulti(benchmark::State &state) {
+    RNG rng(8675309);
+    Vector probs(state.range(0), 1.0 / state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(rmulti_mt(rng, probs));
+    }
+  }
+  BENCHMARK(BM_Rmulti)->Arg(3)->Arg(50);
+
+  void BM_Rmvn(benchmark::State &state) {
+    RNG rng(8675309);
+    int dim = state.range(0);
+    Vector mu(dim, 0.0);
+    SpdMatrix Sigma(dim, 1.0);
+    Sigma += 0.5;
+    for (auto _ : state) {
+      Vector draw = rmvn_mt(rng, mu, Sigma);
+      benchmark::DoNotOptimize(draw.data());
+    }
+  }
+  BENCHMARK(BM_Rmvn)->Arg(10)->Arg(50);
+
+  // Draws given a precision matrix, as in conjugate regression updates.
+  void BM_RmvnIvar(benchmark::State &state) {
+    RNG rng(8675309);
+    int dim = state.range(0);
+    Vector mu(dim, 0.0);
+    SpdMatrix precision(dim, 1.0);
+    precision += 0.5;
+    for (auto _ : state) {
+      Vector draw = rmvn_ivar_mt(rng, mu, precision);
+      benchmark::DoNotOptimize(draw.data());
+    }
+  }
+  BENCHMARK(BM_RmvnIvar)->Arg(10)->Arg(50);
+
+  void BM_Rwish(benchmark::State &state) {
+    RNG rng(8675309);
+    int dim = state.range(0);
+    SpdMatrix sumsq_inv(dim, 1.0);
+    for (auto _ : state) {
+      SpdMatrix draw = rWish_mt(rng, dim + 2.0, sumsq_inv);
+      benchmark::DoNotOptimize(draw.data());
+    }
+  }
+  BENCHMARK(BM_Rwish)->Arg(10)->Arg(50);
+
+}  // namespace
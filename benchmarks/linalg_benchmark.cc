@@ -0,0 +1,186 @@
+// Benchmarks for dense linear algebra.  Sizes span the range seen in
+// practice: small state vectors and regressions (10), moderately sized
+// regressions and multivariate models (50), and large ones (200).
+
+#include "benchmark/benchmark.h"
+#include "LinAlg/Cholesky.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "distributions/rng.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  // Inputs are generated from a fixed seed so every run times the same
+  // numbers.
+  Matrix random_matrix(int nrow, int ncol) {
+    RNG rng(8675309);
+    Matrix ans(nrow, ncol);
+    ans.randomize_gaussian(0, 1, rng);
+    return ans;
+  }
+
+  Vector random_vector(int dim) {
+    RNG rng(8675309);
+    Vector ans(dim);
+    ans.randomize_gaussian(0, 1, rng);
+    return ans;
+  }
+
+  // A well conditioned positive definite matrix.
+  SpdMatrix random_spd(int dim) {
+    SpdMatrix ans = random_matrix(2 * dim, dim).inner();
+    ans.diag() += 1.0;
+    return ans;
+  }
+
+  void BM_MatrixMatrixProduct(benchmark::State &state) {
+    int n = state.range(0);
+    Matrix A = random_matrix(n, n);
+    Matrix B = random_matrix(n, n);
+    for (auto _ : state) {
+      Matrix C = A * B;
+      benchmark::DoNotOptimize(C.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n * n);
+  }
+  BENCHMARK(BM_MatrixMatrixProduct)->Arg(10)->Arg(50)->Arg(200);
+
+  void BM_MatrixVectorProduct(benchmark::State &state) {
+    int n = state.range(0);
+    Matrix A = random_matrix(n, n);
+    Vector v = random_vector(n);
+    for (auto _ : state) {
+      Vector w = A * v;
+      benchmark::DoNotOptimize(w.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+  }
+  BENCHMARK(BM_MatrixVectorProduct)->Arg(10)->Arg(50)->Arg(200);
+
+  // X^T X for a tall data matrix, as in regression sufficient statistics.
+  void BM_InnerProduct(benchmark::State &state) {
+    int n = state.range(0);
+    Matrix X = random_matrix(10 * n, n);
+    for (auto _ : state) {
+      SpdMatrix xtx = X.inner();
+      benchmark::DoNotOptimize(xtx.data());
+    }
+  }
+  BENCHMARK(BM_InnerProduct)->Arg(10)->Arg(50)->Arg(200);
+
+  void BM_Cholesky(benchmark::State &state) {
+    int n = state.range(0);
+    SpdMatrix V = random_spd(n);
+    for (auto _ : state) {
+      Matrix L = V.chol();
+      benchmark::DoNotOptimize(L.data());
+    }
+  }
+  BENCHMARK(BM_Cholesky)->Arg(10)->Arg(50)->Arg(200);
+
+  void BM_SpdSolveVector(benchmark::State &state) {
+    int n = state.range(0);
+    SpdMatrix V = random_spd(n);
+    Vector b = random_vector(n);
+    for (auto _ : state) {
+      Vector x = V.solve(b);
+      benchmark::DoNotOptimize(x.data());
+    }
+  }
+  BENCHMARK(BM_SpdSolveVector)->Arg(10)->Arg(50)->Arg(200);
+
+  // Solving with a precomputed decomposition, as in repeated draws from the
+  // same posterior.
+  void BM_CholeskySolve(benchmark::State &state) {
+    int n = state.range(0);
+    Cholesky cholesky(random_spd(n));
+    Vector b = random_vector(n);
+    for (auto _ : state) {
+      Vector x = cholesky.solve(b);
+      benchmark::DoNotOptimize(x.data());
+    }
+  }
+  BENCHMARK(BM_CholeskySolve)->Arg(10)->Arg(50)->Arg(200);
+
+  void BM_SpdInverse(benchmark::State &state) {
+    int n = state.range(0);
+    SpdMatrix V = random_spd(n);
+    for (auto _ : state) {
+      SpdMatrix Vinv = V.inv();
+      benchmark::DoNotOptimize(Vinv.data());
+    }
+  }
+  BENCHMARK(BM_SpdInverse)->Arg(10)->Arg(50)->Arg(200);
+
+  void BM_AddOuter(benchmark::State &state) {
+    int n = state.range(0);
+    SpdMatrix V = random_spd(n);
+    Vector x = random_vector(n);
+    for (auto _ : state) {
+      V.add_outer(x, 1e-8);
+      benchmark::DoNotOptimize(V.data());
+    }
+  }
+  BENCHMARK(BM_AddOuter)->Arg(10)->Arg(50)->Arg(200);
+
+  // A * V * A^T, as in the Kalman filter variance update.
+  void BM_Sandwich(benchmark::State &state) {
+    int n = state.range(0);
+    Matrix A = random_matrix(n, n);
+    SpdMatrix V = random_spd(n);
+    for (auto _ : state) {
+      SpdMatrix ans = sandwich(A, V);
+      benchmark::DoNotOptimize(ans.data());
+    }
+  }
+  BENCHMARK(BM_Sandwich)->Arg(10)->Arg(50)->Arg(200);
+
+  // Arithmetic on views into the rows of a matrix, the pattern used by
+  // data-augmentation samplers that loop over observations.
+  void BM_VectorViewAxpy(benchmark::State &state) {
+    int n = state.range(0);
+    Matrix X = random_matrix(100, n);
+    Vector total(n, 0.0);
+    for (auto _ : state) {
+      for (int i = 0; i < X.nrow(); ++i) {
+        total.axpy(X.row(i), 1e-8);
+      }
+      benchmark::DoNotOptimize(total.data());
+    }
+    state.SetItemsProcessed(state.iterations() * X.nrow());
+  }
+  BENCHMARK(BM_VectorViewAxpy)->Arg(10)->Arg(50)->Arg(200);
+
+  void BM_VectorViewDot(benchmark::State &state) {
+    int n = state.range(0);
+    Matrix X = random_matrix(100, n);
+    Vector beta = random_vector(n);
+    for (auto _ : state) {
+      double total = 0;
+      for (int i = 0; i < X.nrow(); ++i) {
+        total += X.row(i).dot(beta);
+      }
+      benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * X.nrow());
+  }
+  BENCHMARK(BM_VectorViewDot)->Arg(10)->Arg(50)->Arg(200);
+
+  void BM_VectorViewArithmetic(benchmark::State &state) {
+    int n = state.range(0);
+    Matrix X = random_matrix(2, n);
+    VectorView x(X.row(0));
+    ConstVectorView y(X.row(1));
+    for (auto _ : state) {
+      x += y;
+      x *= 0.5;
+      x -= y;
+      benchmark::DoNotOptimize(X.data());
+    }
+  }
+  BENCHMARK(BM_VectorViewArithmetic)->Arg(10)->Arg(50)->Arg(200);
+
+}  // namespace
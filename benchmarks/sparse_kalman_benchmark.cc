@@ -0,0 +1,103 @@
+// Benchmarks for the sparse matrices used by the Kalman filter.  The
+// transition matrix is that of a typical structural time series model: a
+// local linear trend plus a seasonal component.  The number of seasons sets
+// the size of the state (7 for day of week, 52 for week of year).  Dense
+// versions of the same operations are included for reference.
+
+#include "benchmark/benchmark.h"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Models/StateSpace/Filters/SparseMatrix.hpp"
+#include "distributions/rng.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  BlockDiagonalMatrix transition_matrix(int number_of_seasons) {
+    BlockDiagonalMatrix ans;
+    ans.add_block(new LocalLinearTrendMatrix);
+    ans.add_block(new SeasonalStateSpaceMatrix(number_of_seasons));
+    return ans;
+  }
+
+  Vector random_state(int dim) {
+    RNG rng(8675309);
+    Vector ans(dim);
+    ans.randomize_gaussian(0, 1, rng);
+    return ans;
+  }
+
+  SpdMatrix random_state_variance(int dim) {
+    RNG rng(8675309);
+    Matrix X(2 * dim, dim);
+    X.randomize_gaussian(0, 1, rng);
+    SpdMatrix ans = X.inner();
+    ans.diag() += 1.0;
+    return ans;
+  }
+
+  void BM_SparseTransitionTimesVector(benchmark::State &state) {
+    BlockDiagonalMatrix T = transition_matrix(state.range(0));
+    Vector alpha = random_state(T.ncol());
+    for (auto _ : state) {
+      Vector next = T * alpha;
+      benchmark::DoNotOptimize(next.data());
+    }
+  }
+  BENCHMARK(BM_SparseTransitionTimesVector)->Arg(7)->Arg(52);
+
+  void BM_SparseTransitionTmult(benchmark::State &state) {
+    BlockDiagonalMatrix T = transition_matrix(state.range(0));
+    Vector r = random_state(T.nrow());
+    for (auto _ : state) {
+      Vector ans = T.Tmult(r);
+      benchmark::DoNotOptimize(ans.data());
+    }
+  }
+  BENCHMARK(BM_SparseTransitionTmult)->Arg(7)->Arg(52);
+
+  // P <- T P T', the most expensive step of the Kalman filter.
+  void BM_SparseSandwichInplace(benchmark::State &state) {
+    BlockDiagonalMatrix T = transition_matrix(state.range(0));
+    SpdMatrix P0 = random_state_variance(T.ncol());
+    SpdMatrix P(P0);
+    for (auto _ : state) {
+      P = P0;
+      T.sandwich_inplace(P);
+      benchmark::DoNotOptimize(P.data());
+    }
+  }
+  BENCHMARK(BM_SparseSandwichInplace)->Arg(7)->Arg(52);
+
+  void BM_DenseSandwich(benchmark::State &state) {
+    Matrix T = transition_matrix(state.range(0)).dense();
+    SpdMatrix P = random_state_variance(T.ncol());
+    for (auto _ : state) {
+      SpdMatrix ans = sandwich(T, P);
+      benchmark::DoNotOptimize(ans.data());
+    }
+  }
+  BENCHMARK(BM_DenseSandwich)->Arg(7)->Arg(52);
+
+  void BM_SparseTimesMatrix(benchmark::State &state) {
+    BlockDiagonalMatrix T = transition_matrix(state.range(0));
+    SpdMatrix P = random_state_variance(T.ncol());
+    for (auto _ : state) {
+      Matrix TP = T * P;
+      benchmark::DoNotOptimize(TP.data());
+    }
+  }
+  BENCHMARK(BM_SparseTimesMatrix)->Arg(7)->Arg(52);
+
+  void BM_SparseAddTo(benchmark::State &state) {
+    BlockDiagonalMatrix T = transition_matrix(state.range(0));
+    SpdMatrix P = random_state_variance(T.ncol());
+    for (auto _ : state) {
+      T.add_to(P);
+      benchmark::DoNotOptimize(P.data());
+    }
+  }
+  BENCHMARK(BM_SparseAddTo)->Arg(7)->Arg(52);
+
+}  // namespace
@@ -18,6 +18,9 @@
 */
 
 #include "cpputil/ThreadTools.hpp"
+#include <algorithm>
+#include <sstream>
+#include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
@@ -95,4 +98,55 @@ namespace BOOM {
     }
   }
 
+  void wait_for_jobs(std::vector<std::future<void>> &jobs,
+                     const std::string &description) {
+    std::vector<std::string> error_messages;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      try {
+        jobs[i].get();
+      } catch (std::exception &e) {
+        error_messages.push_back(e.what());
+      } catch (...) {
+        error_messages.push_back("Unknown exception.");
+      }
+    }
+    if (!error_messages.empty()) {
+      std::ostringstream err;
+      err << "Errors were encountered in " << error_messages.size() << " "
+          << description << ":\n";
+      for (const auto &message : error_messages) {
+        err << message << "\n";
+      }
+      report_error(err.str());
+    }
+  }
+
+  int number_of_blocks(const ThreadWorkerPool &pool, int n) {
+    if (pool.no_threads() || n <= 1) return 1;
+    return std::min<int>(pool.number_of_threads(), n);
+  }
+
+  void run_in_blocks(ThreadWorkerPool &pool, int n,
+                     const std::function<void(int, int, int)> &task,
+                     const std::string &description) {
+    int nblocks = number_of_blocks(pool, n);
+    if (nblocks == 1) {
+      task(0, 0, n);
+      return;
+    }
+    int chunk_size = n / nblocks;
+    int remainder = n % nblocks;
+    std::vector<std::future<void>> jobs;
+    jobs.reserve(nblocks);
+    int begin = 0;
+    for (int b = 0; b < nblocks; ++b) {
+      int end = begin + chunk_size + (b < remainder);
+      jobs.emplace_back(pool.submit([&task, b, begin, end]() {
+        task(b, begin, end);
+      }));
+      begin = end;
+    }
+    wait_for_jobs(jobs, description);
+  }
+
 }  // namespace BOOM
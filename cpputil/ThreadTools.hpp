@@ -26,7 +26,9 @@
 #include <future>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
+#include <vector>
 
 // The main object defined here is the ThreadWorkerPool.  Before defining that
 // object, we must first define some building blocks.
@@ -234,6 +236,38 @@ namespace BOOM {
     void worker_thread();
   };
 
+  //======================================================================
+  // Wait for each job in a collection to finish.  Exceptions thrown by the
+  // jobs are collected, and once all jobs have finished a single error
+  // listing them is reported through report_error.
+  //
+  // Args:
+  //   jobs: The futures returned by ThreadWorkerPool::submit().
+  //   description: Describes the jobs in the error message, which begins
+  //     "Errors were encountered in <number of failed jobs> <description>:".
+  void wait_for_jobs(std::vector<std::future<void>> &jobs,
+                     const std::string &description);
+
+  // The number of blocks run_in_blocks() divides n units of work into: one
+  // per thread in the pool, but no more than n, and 1 if the pool has no
+  // threads.
+  int number_of_blocks(const ThreadWorkerPool &pool, int n);
+
+  // Divide the units of work [0, n) into number_of_blocks(pool, n)
+  // contiguous blocks of nearly equal size, and run each block as a job on
+  // the pool.  A single block runs in the calling thread.
+  //
+  // Args:
+  //   pool: The pool that runs the blocks.
+  //   n: The number of units of work.
+  //   task: Called once per block as task(block, begin, end), where [begin,
+  //     end) is the range of work in the block.
+  //   description: Describes the blocks in the error message reported by
+  //     wait_for_jobs().
+  void run_in_blocks(ThreadWorkerPool &pool, int n,
+                     const std::function<void(int, int, int)> &task,
+                     const std::string &description);
+
 }  // namespace BOOM
 
 #endif  //  BOOM_CPPUTIL_THREAD_TOOLS_HPP_
@@ -20,6 +20,7 @@
 
 #include <cctype>
 #include <string>
+#include "cpputil/string_utils.hpp"
 #include "uint.hpp"
 
 namespace BOOM {
@@ -29,6 +30,10 @@ namespace BOOM {
   inline bool is_sign(char c) { return (c == '-' || c == '+'); }
 
   bool is_numeric(const std::string &s) {
+    return is_numeric(s.data(), s.data() + s.size());
+  }
+
+  bool is_numeric(const char *begin, const char *end) {
     // if all characters in s could be part of a numerical object
     // return true.  If any cannot return false.
 
@@ -36,8 +41,8 @@ namespace BOOM {
     unsigned ne = 0;
     unsigned ndigits = 0;
     bool last_was_e = false;
-    for (uint i = 0; i < s.size(); ++i) {
-      char c = s[i];
+    for (const char *pos = begin; pos != end; ++pos) {
+      char c = *pos;
       if (last_was_e && !is_sign(c)) return false;
 
       if (is_e(c)) {
@@ -49,7 +54,7 @@ namespace BOOM {
         ++ndot;
         if (ndot > 1) return false;
       } else if (is_sign(c)) {
-        if (i > 0 && last_was_e == false) return false;
+        if (pos != begin && last_was_e == false) return false;
       } else if (!isdigit(c)) {
         return false;
       } else {
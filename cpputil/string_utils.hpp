@@ -84,6 +84,10 @@ namespace BOOM {
 
   bool is_numeric(const std::string &s);
 
+  // The same test applied to the characters in [begin, end), for callers that
+  // hold a field in a larger buffer and want to avoid copying it.
+  bool is_numeric(const char *begin, const char *end);
+
   // Concatenate the contents in a vector of strings to a single string.
   //
   // Args:
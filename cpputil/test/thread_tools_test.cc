@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "cpputil/ThreadTools.hpp"
+#include "cpputil/report_error.hpp"
 #include "test_utils/test_utils.hpp"
 
 namespace {
@@ -69,4 +70,63 @@ namespace {
     // }
   }
 
+  // Blocks cover the range of work exactly once.
+  TEST(RunInBlocksTest, CoversRange) {
+    ThreadWorkerPool pool;
+    pool.set_number_of_threads(3);
+    EXPECT_EQ(3, number_of_blocks(pool, 10));
+    EXPECT_EQ(2, number_of_blocks(pool, 2));
+    EXPECT_EQ(1, number_of_blocks(pool, 0));
+
+    int n = 10;
+    std::vector<int> visits(n, 0);
+    std::vector<int> block_of(n, -1);
+    run_in_blocks(pool, n,
+                  [&](int block, int begin, int end) {
+                    for (int i = begin; i < end; ++i) {
+                      ++visits[i];
+                      block_of[i] = block;
+                    }
+                  },
+                  "test blocks");
+    EXPECT_EQ(std::vector<int>(n, 1), visits);
+    EXPECT_EQ(std::vector<int>({0, 0, 0, 0, 1, 1, 1, 2, 2, 2}), block_of);
+
+    // Without threads the work runs as one block in the calling thread.
+    ThreadWorkerPool empty_pool;
+    std::thread::id caller = std::this_thread::get_id();
+    run_in_blocks(empty_pool, n,
+                  [&](int block, int begin, int end) {
+                    EXPECT_EQ(0, block);
+                    EXPECT_EQ(0, begin);
+                    EXPECT_EQ(n, end);
+                    EXPECT_EQ(caller, std::this_thread::get_id());
+                  },
+                  "test blocks");
+  }
+
+  // Errors from all failing blocks are collected into a single error.
+  TEST(RunInBlocksTest, CollectsErrors) {
+    ThreadWorkerPool pool;
+    pool.set_number_of_threads(4);
+    std::vector<int> finished(4, 0);
+    try {
+      run_in_blocks(pool, 4,
+                    [&finished](int block, int begin, int end) {
+                      if (block % 2 == 1) {
+                        report_error("Block failed.");
+                      }
+                      finished[block] = 1;
+                    },
+                    "test blocks");
+      FAIL() << "Errors in the blocks were not reported.";
+    } catch (std::exception &e) {
+      std::string message = e.what();
+      EXPECT_NE(std::string::npos,
+                message.find("Errors were encountered in 2 test blocks:"))
+          << message;
+    }
+    EXPECT_EQ(std::vector<int>({1, 0, 1, 0}), finished);
+  }
+
 }  // namespace
@@ -0,0 +1,330 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "distributions/batch_draws.hpp"
+#include <cmath>
+#include <memory>
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // Tables for the 128 layer ziggurat.  x[i] is the right edge of layer i,
+    // and ratio[i] = x[i + 1] / x[i] is the fraction of layer i lying
+    // entirely under the density.  The constants are from Doornik (2005) "An
+    // improved ziggurat method to generate normal random samples".
+    struct ZigguratTables {
+      static const int number_of_layers = 128;
+      static constexpr double tail_start = 3.442619855899;
+      static constexpr double layer_area = 9.91256303526217e-3;
+
+      ZigguratTables() {
+        double f = exp(-0.5 * tail_start * tail_start);
+        x[0] = layer_area / f;
+        x[1] = tail_start;
+        x[number_of_layers] = 0;
+        for (int i = 2; i < number_of_layers; ++i) {
+          x[i] = sqrt(-2 * log(layer_area / x[i - 1] + f));
+          f = exp(-0.5 * x[i] * x[i]);
+        }
+        for (int i = 0; i < number_of_layers; ++i) {
+          ratio[i] = x[i + 1] / x[i];
+        }
+      }
+
+      double x[number_of_layers + 1];
+      double ratio[number_of_layers];
+    };
+
+    const ZigguratTables &ziggurat_tables() {
+      static const ZigguratTables tables;
+      return tables;
+    }
+
+    // A U(0, 1] deviate, which is safe to take the log of.
+    inline double positive_uniform(RNG &rng) { return 1.0 - rng(); }
+
+    // A draw from the standard normal tail beyond 'start', using Marsaglia's
+    // (1964) method.
+    double normal_tail(RNG &rng, double start, bool negative) {
+      double x, y;
+      do {
+        x = log(positive_uniform(rng)) / start;
+        y = log(positive_uniform(rng));
+      } while (-2 * y < x * x);
+      return negative ? x - start : start - x;
+    }
+
+    inline double ziggurat_normal(RNG &rng, const ZigguratTables &tables) {
+      while (true) {
+        // A single uniform supplies both the layer (its leading 7 bits) and
+        // the horizontal position within the layer (the remaining bits).
+        double scaled = rng() * ZigguratTables::number_of_layers;
+        int layer = static_cast<int>(scaled);
+        double u = 2 * (scaled - layer) - 1;
+        if (fabs(u) < tables.ratio[layer]) {
+          return u * tables.x[layer];
+        }
+        if (layer == 0) {
+          return normal_tail(rng, ZigguratTables::tail_start, u < 0);
+        }
+        double x = u * tables.x[layer];
+        double f0 = exp(-0.5 * (tables.x[layer] * tables.x[layer] - x * x));
+        double f1 = exp(
+            -0.5 * (tables.x[layer + 1] * tables.x[layer + 1] - x * x));
+        if (f1 + rng() * (f0 - f1) < 1.0) {
+          return x;
+        }
+      }
+    }
+
+    // A Gamma(a, 1) deviate with a >= 1.
+    //   d = a - 1/3 and c = 1 / sqrt(9 * d).
+    inline double marsaglia_tsang_gamma(RNG &rng, double d, double c,
+                                        const ZigguratTables &tables) {
+      while (true) {
+        double x, v;
+        do {
+          x = ziggurat_normal(rng, tables);
+          v = 1.0 + c * x;
+        } while (v <= 0);
+        v = v * v * v;
+        double u = positive_uniform(rng);
+        double xsq = x * x;
+        if (u < 1.0 - 0.0331 * xsq * xsq) return d * v;
+        if (log(u) < 0.5 * xsq + d * (1.0 - v + log(v))) return d * v;
+      }
+    }
+
+    // Gamma draws are generated by a functor so that the set up cost for a
+    // given shape parameter is paid once per batch.
+    class GammaGenerator {
+     public:
+      GammaGenerator(double a, double b)
+          : boost_(a < 1),
+            inverse_shape_(1.0 / a),
+            d_((boost_ ? a + 1 : a) - 1.0 / 3),
+            c_(1.0 / sqrt(9 * d_)),
+            scale_(1.0 / b),
+            tables_(ziggurat_tables()) {
+        if (a <= 0 || b <= 0) {
+          report_error("Gamma parameters must be positive.");
+        }
+      }
+
+      double operator()(RNG &rng) const {
+        double ans = marsaglia_tsang_gamma(rng, d_, c_, tables_);
+        if (boost_) {
+          ans *= pow(positive_uniform(rng), inverse_shape_);
+        }
+        return ans * scale_;
+      }
+
+     private:
+      bool boost_;
+      double inverse_shape_;
+      double d_;
+      double c_;
+      double scale_;
+      const ZigguratTables &tables_;
+    };
+
+    // Draws from the standard normal distribution truncated to (a, infinity).
+    class TruncatedNormalGenerator {
+     public:
+      explicit TruncatedNormalGenerator(double a)
+          : a_(a), tables_(ziggurat_tables()) {
+        if (a_ > 0) {
+          tail_sampler_.reset(new TnSampler(a_));
+        }
+      }
+
+      double operator()(RNG &rng) {
+        if (tail_sampler_) {
+          return tail_sampler_->draw(rng);
+        }
+        // At least half the normal distribution lies above a, so the
+        // expected number of rejections is at most one.
+        while (true) {
+          double z = ziggurat_normal(rng, tables_);
+          if (z > a_) return z;
+        }
+      }
+
+     private:
+      double a_;
+      const ZigguratTables &tables_;
+      std::unique_ptr<TnSampler> tail_sampler_;
+    };
+
+    inline double log_exponential(RNG &rng) {
+      return log(-log(positive_uniform(rng)));
+    }
+  }  // namespace
+
+  double rnorm_ziggurat_mt(RNG &rng) {
+    return ziggurat_normal(rng, ziggurat_tables());
+  }
+
+  //===========================================================================
+  void runif_batch_mt(RNG &rng, double *buffer, int n, double lo, double hi) {
+    double width = hi - lo;
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = rng();
+    }
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = lo + width * buffer[i];
+    }
+  }
+
+  void runif_batch_mt(RNG &rng, VectorView ans, double lo, double hi) {
+    double width = hi - lo;
+    for (double &el : ans) el = lo + width * rng();
+  }
+
+  //===========================================================================
+  void rnorm_batch_mt(RNG &rng, double *buffer, int n, double mu,
+                      double sigma) {
+    const ZigguratTables &tables(ziggurat_tables());
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = ziggurat_normal(rng, tables);
+    }
+    if (mu != 0 || sigma != 1) {
+      for (int i = 0; i < n; ++i) {
+        buffer[i] = mu + sigma * buffer[i];
+      }
+    }
+  }
+
+  void rnorm_batch_mt(RNG &rng, VectorView ans, double mu, double sigma) {
+    const ZigguratTables &tables(ziggurat_tables());
+    for (double &el : ans) el = mu + sigma * ziggurat_normal(rng, tables);
+  }
+
+  //===========================================================================
+  void rexp_batch_mt(RNG &rng, double *buffer, int n, double lambda) {
+    if (lambda <= 0) {
+      report_error("The exponential rate must be positive.");
+    }
+    // Filling the buffer first leaves a loop of log() calls with no
+    // dependencies between iterations.
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = positive_uniform(rng);
+    }
+    double scale = -1.0 / lambda;
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = scale * log(buffer[i]);
+    }
+  }
+
+  void rexp_batch_mt(RNG &rng, VectorView ans, double lambda) {
+    if (lambda <= 0) {
+      report_error("The exponential rate must be positive.");
+    }
+    double scale = -1.0 / lambda;
+    for (double &el : ans) el = scale * log(positive_uniform(rng));
+  }
+
+  //===========================================================================
+  // rlexp_mt rejects non-finite draws, which occur when U is 0 or 1.  Drawing
+  // U from (0, 1] rules out the first case.  The second has probability 2^-53
+  // and is handled by redrawing.
+  void rlexp_batch_mt(RNG &rng, double *buffer, int n, double loglam) {
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = positive_uniform(rng);
+    }
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = log(-log(buffer[i]));
+    }
+    for (int i = 0; i < n; ++i) {
+      while (!std::isfinite(buffer[i])) {
+        buffer[i] = log_exponential(rng);
+      }
+      buffer[i] -= loglam;
+    }
+  }
+
+  void rlexp_batch_mt(RNG &rng, VectorView ans, double loglam) {
+    for (double &el : ans) {
+      do {
+        el = log_exponential(rng);
+      } while (!std::isfinite(el));
+      el -= loglam;
+    }
+  }
+
+  //===========================================================================
+  void rgamma_batch_mt(RNG &rng, double *buffer, int n, double a, double b) {
+    GammaGenerator gamma(a, b);
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = gamma(rng);
+    }
+  }
+
+  void rgamma_batch_mt(RNG &rng, VectorView ans, double a, double b) {
+    GammaGenerator gamma(a, b);
+    for (double &el : ans) el = gamma(rng);
+  }
+
+  //===========================================================================
+  namespace {
+    // If both shape parameters are tiny then both gamma draws can underflow
+    // to zero.  In that case fall back on the Rmath generator.
+    inline double beta_from_gammas(RNG &rng, const GammaGenerator &x_gamma,
+                                   const GammaGenerator &y_gamma, double a,
+                                   double b) {
+      double x = x_gamma(rng);
+      double total = x + y_gamma(rng);
+      return total > 0 ? x / total : rbeta_mt(rng, a, b);
+    }
+  }  // namespace
+
+  void rbeta_batch_mt(RNG &rng, double *buffer, int n, double a, double b) {
+    GammaGenerator x_gamma(a, 1.0);
+    GammaGenerator y_gamma(b, 1.0);
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = beta_from_gammas(rng, x_gamma, y_gamma, a, b);
+    }
+  }
+
+  void rbeta_batch_mt(RNG &rng, VectorView ans, double a, double b) {
+    GammaGenerator x_gamma(a, 1.0);
+    GammaGenerator y_gamma(b, 1.0);
+    for (double &el : ans) el = beta_from_gammas(rng, x_gamma, y_gamma, a, b);
+  }
+
+  //===========================================================================
+  void rtrun_norm_batch_mt(RNG &rng, double *buffer, int n, double mu,
+                           double sigma, double cutpoint,
+                           bool positive_support) {
+    double sign = positive_support ? 1.0 : -1.0;
+    TruncatedNormalGenerator standard_draw(sign * (cutpoint - mu) / sigma);
+    for (int i = 0; i < n; ++i) {
+      buffer[i] = mu + sign * sigma * standard_draw(rng);
+    }
+  }
+
+  void rtrun_norm_batch_mt(RNG &rng, VectorView ans, double mu, double sigma,
+                           double cutpoint, bool positive_support) {
+    double sign = positive_support ? 1.0 : -1.0;
+    TruncatedNormalGenerator standard_draw(sign * (cutpoint - mu) / sigma);
+    for (double &el : ans) el = mu + sign * sigma * standard_draw(rng);
+  }
+
+}  // namespace BOOM
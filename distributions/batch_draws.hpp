@@ -0,0 +1,116 @@
+#ifndef BOOM_DISTRIBUTIONS_BATCH_DRAWS_HPP_
+#define BOOM_DISTRIBUTIONS_BATCH_DRAWS_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "distributions/rng.hpp"
+
+// Functions for filling a buffer with many independent draws from the same
+// distribution.  These are meant for data augmentation samplers that need
+// millions of variates per MCMC iteration.  The per-draw algorithms are chosen
+// for speed rather than for agreement with the Rmath generators, so
+// rnorm_batch_mt(rng, buffer, n) does NOT produce the same values as n calls
+// to rnorm_mt(rng).
+//
+// Each function has three forms: one that fills a raw buffer of n contiguous
+// doubles, one that fills a Vector, and one that fills a VectorView (which may
+// be strided).
+
+namespace BOOM {
+
+  // A standard normal deviate simulated using the ziggurat algorithm of
+  // Marsaglia and Tsang (2000), with the modifications of Doornik (2005).
+  // This is several times faster than rnorm_mt, which uses Kinderman and
+  // Ramage's method.
+  double rnorm_ziggurat_mt(RNG &rng);
+
+  // U(lo, hi) deviates.
+  void runif_batch_mt(RNG &rng, double *buffer, int n, double lo = 0,
+                      double hi = 1);
+  void runif_batch_mt(RNG &rng, VectorView ans, double lo = 0, double hi = 1);
+  inline void runif_batch_mt(RNG &rng, Vector &ans,
+                             double lo = 0, double hi = 1) {
+    runif_batch_mt(rng, ans.data(), ans.size(), lo, hi);
+  }
+
+  // N(mu, sigma^2) deviates, using the ziggurat algorithm.
+  void rnorm_batch_mt(RNG &rng, double *buffer, int n, double mu = 0,
+                      double sigma = 1);
+  void rnorm_batch_mt(RNG &rng, VectorView ans, double mu = 0,
+                      double sigma = 1);
+  inline void rnorm_batch_mt(RNG &rng, Vector &ans,
+                             double mu = 0, double sigma = 1) {
+    rnorm_batch_mt(rng, ans.data(), ans.size(), mu, sigma);
+  }
+
+  // Exponential deviates with rate 'lambda', using inversion.
+  void rexp_batch_mt(RNG &rng, double *buffer, int n, double lambda = 1);
+  void rexp_batch_mt(RNG &rng, VectorView ans, double lambda = 1);
+  inline void rexp_batch_mt(RNG &rng, Vector &ans, double lambda = 1) {
+    rexp_batch_mt(rng, ans.data(), ans.size(), lambda);
+  }
+
+  // Logarithms of exponential deviates with log rate 'loglam'.  See rlexp_mt.
+  void rlexp_batch_mt(RNG &rng, double *buffer, int n, double loglam = 0);
+  void rlexp_batch_mt(RNG &rng, VectorView ans, double loglam = 0);
+  inline void rlexp_batch_mt(RNG &rng, Vector &ans, double loglam = 0) {
+    rlexp_batch_mt(rng, ans.data(), ans.size(), loglam);
+  }
+
+  // Gamma deviates with shape 'a' and rate 'b' (mean a / b), using the method
+  // of Marsaglia and Tsang (2000) driven by ziggurat normals.  If a < 1 the
+  // draws are Gamma(a + 1) * U^(1/a).
+  void rgamma_batch_mt(RNG &rng, double *buffer, int n, double a = 1,
+                       double b = 1);
+  void rgamma_batch_mt(RNG &rng, VectorView ans, double a = 1, double b = 1);
+  inline void rgamma_batch_mt(RNG &rng, Vector &ans,
+                              double a = 1, double b = 1) {
+    rgamma_batch_mt(rng, ans.data(), ans.size(), a, b);
+  }
+
+  // Beta(a, b) deviates, computed as X / (X + Y) for independent gamma
+  // deviates X and Y.
+  void rbeta_batch_mt(RNG &rng, double *buffer, int n, double a = 1,
+                      double b = 1);
+  void rbeta_batch_mt(RNG &rng, VectorView ans, double a = 1, double b = 1);
+  inline void rbeta_batch_mt(RNG &rng, Vector &ans,
+                             double a = 1, double b = 1) {
+    rbeta_batch_mt(rng, ans.data(), ans.size(), a, b);
+  }
+
+  // Draws from the N(mu, sigma^2) distribution truncated to (cutpoint, infty)
+  // if 'positive_support' is true, or (-infty, cutpoint) if it is false.
+  // This is the batch version of rtrun_norm_mt.  The adaptive rejection
+  // sampler used in the tail is built once for the whole batch.
+  void rtrun_norm_batch_mt(RNG &rng, double *buffer, int n, double mu,
+                           double sigma, double cutpoint,
+                           bool positive_support);
+  void rtrun_norm_batch_mt(RNG &rng, VectorView ans, double mu, double sigma,
+                           double cutpoint, bool positive_support);
+  inline void rtrun_norm_batch_mt(RNG &rng, Vector &ans, double mu,
+                                  double sigma, double cutpoint,
+                                  bool positive_support) {
+    rtrun_norm_batch_mt(rng, ans.data(), ans.size(), mu, sigma, cutpoint,
+                        positive_support);
+  }
+
+}  // namespace BOOM
+
+#endif  // BOOM_DISTRIBUTIONS_BATCH_DRAWS_HPP_
@@ -0,0 +1,46 @@
+/*
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "distributions/parallel_rng.hpp"
+#include <vector>
+
+namespace BOOM {
+
+  void run_in_blocks(ThreadWorkerPool &pool, int n, RNG &seeding_rng,
+                     const std::function<void(int, int, int, RNG &)> &task,
+                     const std::string &description) {
+    int nblocks = number_of_blocks(pool, n);
+    if (nblocks == 1) {
+      task(0, 0, n, seeding_rng);
+      return;
+    }
+    std::vector<RNG> rngs;
+    rngs.reserve(nblocks);
+    for (int b = 0; b < nblocks; ++b) {
+      rngs.push_back(seeding_rng.split());
+    }
+    run_in_blocks(
+        pool, n,
+        [&task, &rngs](int block, int begin, int end) {
+          task(block, begin, end, rngs[block]);
+        },
+        description);
+  }
+
+}  // namespace BOOM
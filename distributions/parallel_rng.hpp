@@ -0,0 +1,49 @@
+#ifndef BOOM_DISTRIBUTIONS_PARALLEL_RNG_HPP_
+#define BOOM_DISTRIBUTIONS_PARALLEL_RNG_HPP_
+/*
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <functional>
+#include <string>
+#include "cpputil/ThreadTools.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // Divide the units of work [0, n) into blocks and run them on a pool, as
+  // the RNG-free run_in_blocks() in cpputil/ThreadTools.hpp does, but give
+  // each block its own random number stream.
+  //
+  // Args:
+  //   pool: The pool that runs the blocks.
+  //   n: The number of units of work.
+  //   seeding_rng: With a single block, this is the RNG passed to task.
+  //     Otherwise each block gets its own RNG split from seeding_rng, in
+  //     block order, so the streams do not depend on thread scheduling.
+  //   task: Called once per block as task(block, begin, end, rng), where
+  //     [begin, end) is the range of work in the block.
+  //   description: Describes the blocks in the error message reported if
+  //     any of them fail.
+  void run_in_blocks(ThreadWorkerPool &pool, int n, RNG &seeding_rng,
+                     const std::function<void(int, int, int, RNG &)> &task,
+                     const std::string &description);
+
+}  // namespace BOOM
+
+#endif  // BOOM_DISTRIBUTIONS_PARALLEL_RNG_HPP_
@@ -19,21 +19,99 @@
 
 #include "distributions/rng.hpp"
 #include <ctime>
+#include <sstream>
+#include <utility>
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
 
   RNG::RNG()
-      : generator_(std::random_device()())
+      : engine_(std::mt19937_64(std::random_device()()))
   {}
 
   RNG::RNG(RngIntType seed)
-      : generator_(seed)
+      : engine_(std::mt19937_64(seed))
   {}
 
+  RNG::RNG(RngIntType seed, Engine engine) {
+    if (engine == Engine::MERSENNE_TWISTER) {
+      engine_.emplace<std::mt19937_64>(seed);
+    } else {
+      engine_.emplace<Xoshiro256>(seed);
+    }
+  }
+
+  RNG::RNG(RNG &&rhs)
+      : engine_(std::move(rhs.engine_)),
+        dist_(rhs.dist_)
+  {
+    rhs.engine_.emplace<std::monostate>();
+  }
+
+  RNG &RNG::operator=(RNG &&rhs) {
+    if (&rhs != this) {
+      engine_ = std::move(rhs.engine_);
+      dist_ = rhs.dist_;
+      rhs.engine_.emplace<std::monostate>();
+    }
+    return *this;
+  }
+
   void RNG::seed() {
-    generator_.seed(std::random_device()());
+    seed(std::random_device()());
+  }
+
+  void RNG::seed(RngIntType seed) {
+    if (std::mt19937_64 *mt = std::get_if<std::mt19937_64>(&engine_)) {
+      mt->seed(seed);
+    } else {
+      xoshiro().seed(seed);
+    }
+  }
+
+  RNG::Engine RNG::engine() const {
+    if (std::holds_alternative<std::mt19937_64>(engine_)) {
+      return Engine::MERSENNE_TWISTER;
+    } else if (std::holds_alternative<Xoshiro256>(engine_)) {
+      return Engine::XOSHIRO;
+    }
+    wrong_engine("any");
+    return Engine::XOSHIRO;
+  }
+
+  std::mt19937_64 &RNG::generator() {
+    std::mt19937_64 *ans = std::get_if<std::mt19937_64>(&engine_);
+    if (!ans) wrong_engine("Mersenne twister");
+    return *ans;
+  }
+
+  void RNG::jump() {
+    xoshiro().jump();
+  }
+
+  RNG RNG::split() {
+    if (std::holds_alternative<std::mt19937_64>(engine_)) {
+      return RNG(seed_rng(*this), Engine::XOSHIRO);
+    }
+    RNG ans(*this);
+    xoshiro().jump();
+    return ans;
+  }
+
+  void RNG::wrong_engine(const char *requested) const {
+    if (std::holds_alternative<std::monostate>(engine_)) {
+      report_error("This RNG has been moved from, and has no engine.  "
+                   "Assign another RNG to it before using it.");
+    }
+    std::ostringstream err;
+    err << "The " << requested << " engine was requested from an RNG "
+        << "that uses the "
+        << (engine() == Engine::MERSENNE_TWISTER ? "Mersenne twister"
+                                                 : "xoshiro")
+        << " engine.";
+    report_error(err.str());
   }
 
   RNG::RngIntType seed_rng(RNG &rng) {
@@ -41,7 +119,10 @@ namespace BOOM {
     while (ans <= 2) {
       double u = runif_mt(rng) * static_cast<double>(
           std::numeric_limits<RNG::RngIntType>::max());
-      ans = lround(u);
+      // lround returns a signed long, which overflows when u >= 2^63.
+      // Values that large are already whole numbers, so they convert exactly.
+      ans = u < 9223372036854775808.0 ? lround(u)
+                                      : static_cast<RNG::RngIntType>(u);
     }
     return ans;
   }
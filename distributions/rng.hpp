@@ -22,34 +22,108 @@
 
 #include <random>
 #include <cstdint>
+#include <variant>
+#include "distributions/xoshiro.hpp"
 
 namespace BOOM {
   // A random number generator for simulating real valued U[0, 1) deviates.
+  //
+  // Two engines are available.  The default is std::mt19937_64, which is what
+  // BOOM has always used, so seeded results are unchanged from earlier
+  // versions.  The alternative is xoshiro256++ (see xoshiro.hpp), which has
+  // 32 bytes of state, is cheap to seed, and supports splitting into
+  // non-overlapping streams in constant time.
+  //
+  // For parallel work, obtain one stream per unit of work with split():
+  //   RNG master(seed, RNG::Engine::XOSHIRO);
+  //   std::vector<RNG> streams;
+  //   for (int i = 0; i < number_of_chunks; ++i) {
+  //     streams.push_back(master.split());
+  //   }
+  // If streams are tied to fixed units of work (e.g. blocks of data) rather
+  // than to threads, results are bit-for-bit identical regardless of the
+  // number of threads used to process them.
   class RNG {
    public:
     using RngIntType = std::uint_fast64_t;
 
+    enum class Engine { MERSENNE_TWISTER, XOSHIRO };
+
     // Seed with std::random_device.
     RNG();
 
     // Seed with a specified value.
     explicit RNG(RngIntType seed);
 
+    // Seed with a specified value, using the specified engine.
+    RNG(RngIntType seed, Engine engine);
+
+    RNG(const RNG &rhs) = default;
+    RNG &operator=(const RNG &rhs) = default;
+
+    // A moved-from RNG has no engine.  Drawing from it, seeding it, or asking
+    // for its engine is an error until another RNG is assigned to it.
+    RNG(RNG &&rhs);
+    RNG &operator=(RNG &&rhs);
+
     // Seed from a C++ standard random device, if one is present.
     void seed();
 
     // Seed using a specified value.
-    void seed(RngIntType seed) {generator_.seed(seed);}
+    void seed(RngIntType seed);
 
     // Simulate a U[0, 1) random deviate.
-    double operator()() {return dist_(generator_);}
-
-    std::mt19937_64 & generator() {return generator_;}
+    double operator()() {
+      if (std::mt19937_64 *mt = std::get_if<std::mt19937_64>(&engine_)) {
+        return dist_(*mt);
+      }
+      return xoshiro().uniform();
+    }
+
+    // Simulate a draw from one of the distributions in <random>, using
+    // whichever engine this RNG is built on.
+    template <class DISTRIBUTION>
+    typename DISTRIBUTION::result_type draw(DISTRIBUTION &distribution) {
+      if (std::mt19937_64 *mt = std::get_if<std::mt19937_64>(&engine_)) {
+        return distribution(*mt);
+      }
+      return distribution(xoshiro());
+    }
+
+    Engine engine() const;
+
+    // The underlying Mersenne twister.  It is an error to call this function
+    // on an RNG that uses the xoshiro engine.  Prefer draw().
+    std::mt19937_64 & generator();
+
+    // Advance the stream by 2^128 draws.  Only available with the xoshiro
+    // engine.
+    void jump();
+
+    // Returns a new RNG whose stream does not overlap that of *this.
+    //
+    // With the xoshiro engine the result is a copy of *this, and *this is then
+    // jumped ahead by 2^128 draws.  This is O(1), it consumes no random
+    // numbers, and successive calls produce a sequence of streams that depends
+    // only on the seed.  With the Mersenne twister engine the result is a
+    // xoshiro RNG seeded from a draw from *this.
+    RNG split();
 
    private:
-    // TODO(steve): once you can use c++17 in R and elsewhere replace this with
-    // a std::variant that will choose the fastest RNG for each implementation.
-    std::mt19937_64 generator_;
+    // The xoshiro engine.  Reports an error if *this uses the Mersenne
+    // twister or has been moved from.
+    Xoshiro256 &xoshiro() {
+      Xoshiro256 *ans = std::get_if<Xoshiro256>(&engine_);
+      if (!ans) wrong_engine("xoshiro");
+      return *ans;
+    }
+
+    // Report an error explaining why 'requested' is not the active engine.
+    void wrong_engine(const char *requested) const;
+
+    // Exactly one engine is in use, stored in place.  std::monostate marks an
+    // RNG that has been moved from.
+    std::variant<std::monostate, std::mt19937_64, Xoshiro256> engine_;
     std::uniform_real_distribution<double> dist_;
   };
 
@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "distributions/batch_draws.hpp"
+#include "LinAlg/Vector.hpp"
+#include "stats/moments.hpp"
+#include "test_utils/test_utils.hpp"
+#include <iostream>
+
+namespace {
+  using namespace BOOM;
+  using std::cout;
+  using std::endl;
+
+  class BatchDrawsTest : public ::testing::Test {
+   protected:
+    BatchDrawsTest() : rng_(8675309), n_(100000) {}
+    RNG rng_;
+    int n_;
+  };
+
+  TEST_F(BatchDrawsTest, Uniform) {
+    Vector draws(n_);
+    runif_batch_mt(rng_, draws.data(), n_, 2, 5);
+    EXPECT_GE(min(draws), 2.0);
+    EXPECT_LT(max(draws), 5.0);
+    EXPECT_NEAR(3.5, mean(draws), .02);
+    EXPECT_NEAR(9.0 / 12, var(draws), .02);
+  }
+
+  TEST_F(BatchDrawsTest, Normal) {
+    Vector draws(n_);
+    rnorm_batch_mt(rng_, draws.data(), n_, 3, 2);
+    EXPECT_NEAR(3.0, mean(draws), .03);
+    EXPECT_NEAR(2.0, sd(draws), .03);
+
+    // Check the distribution, including the tails, against the normal CDF.
+    rnorm_batch_mt(rng_, draws);
+    for (double cut : {-3.5, -2.0, -0.5, 0.0, 1.0, 3.0}) {
+      double fraction = 0;
+      for (double x : draws) fraction += (x <= cut);
+      fraction /= n_;
+      double p = pnorm(cut);
+      EXPECT_NEAR(p, fraction, 4 * sqrt(p * (1 - p) / n_) + 1e-4)
+          << "cut = " << cut;
+    }
+  }
+
+  TEST_F(BatchDrawsTest, Exponential) {
+    Vector draws(n_);
+    rexp_batch_mt(rng_, draws.data(), n_, 4.0);
+    EXPECT_GE(min(draws), 0.0);
+    EXPECT_NEAR(0.25, mean(draws), .005);
+
+    Vector log_draws(n_);
+    rlexp_batch_mt(rng_, log_draws.data(), n_, log(4.0));
+    EXPECT_NEAR(0.25, mean(exp(log_draws)), .005);
+  }
+
+  TEST_F(BatchDrawsTest, Gamma) {
+    Vector draws(n_);
+    for (double a : {0.3, 1.0, 4.5}) {
+      double b = 2.0;
+      rgamma_batch_mt(rng_, draws.data(), n_, a, b);
+      EXPECT_GT(min(draws), 0.0);
+      EXPECT_NEAR(a / b, mean(draws), 4 * sqrt(a / n_) / b) << "a = " << a;
+      EXPECT_NEAR(a / (b * b), var(draws), .05 * a / (b * b)) << "a = " << a;
+    }
+    EXPECT_THROW(rgamma_batch_mt(rng_, draws, -1.0, 1.0), std::exception);
+  }
+
+  TEST_F(BatchDrawsTest, Beta) {
+    Vector draws(n_);
+    double a = 2.0, b = 5.0;
+    rbeta_batch_mt(rng_, draws, a, b);
+    EXPECT_NEAR(a / (a + b), mean(draws), .005);
+    EXPECT_NEAR(a * b / (square(a + b) * (a + b + 1)), var(draws), .001);
+  }
+
+  TEST_F(BatchDrawsTest, TruncatedNormal) {
+    Vector draws(n_);
+    // The cutpoint is in the tail, so the adaptive rejection sampler is used.
+    double mu = -1.0, sigma = 1.5, cut = 2.0;
+    rtrun_norm_batch_mt(rng_, draws.data(), n_, mu, sigma, cut, true);
+    EXPECT_GT(min(draws), cut);
+    double expected_mean, expected_variance;
+    trun_norm_moments(mu, sigma, cut, true, &expected_mean,
+                      &expected_variance);
+    EXPECT_NEAR(expected_mean, mean(draws), .01);
+    EXPECT_NEAR(expected_variance, var(draws), .01);
+
+    // The cutpoint is below the mean, so simple rejection is used.
+    rtrun_norm_batch_mt(rng_, draws, mu, sigma, cut, false);
+    EXPECT_LT(max(draws), cut);
+    trun_norm_moments(mu, sigma, cut, false, &expected_mean,
+                      &expected_variance);
+    EXPECT_NEAR(expected_mean, mean(draws), .02);
+    EXPECT_NEAR(expected_variance, var(draws), .03);
+  }
+
+  TEST_F(BatchDrawsTest, StridedViews) {
+    Matrix draws(1000, 2);
+    rnorm_batch_mt(rng_, draws.row(0));
+    rnorm_batch_mt(rng_, draws.col(1));
+    EXPECT_NEAR(0.0, mean(draws.col(1)), .15);
+  }
+
+}  // namespace
@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "distributions/parallel_rng.hpp"
+#include "test_utils/test_utils.hpp"
+#include <vector>
+
+namespace {
+  using namespace BOOM;
+  using std::cout;
+  using std::endl;
+
+  // Each block gets its own RNG, split from the seeding RNG in block order.
+  TEST(ParallelRngTest, EachBlockGetsItsOwnStream) {
+    ThreadWorkerPool pool;
+    pool.set_number_of_threads(3);
+    int n = 10;
+    std::vector<int> visits(n, 0);
+    std::vector<double> first_draw(3, 0.0);
+    RNG seeding_rng(8675309);
+    run_in_blocks(pool, n, seeding_rng,
+                  [&](int block, int begin, int end, RNG &rng) {
+                    for (int i = begin; i < end; ++i) {
+                      ++visits[i];
+                    }
+                    first_draw[block] = rng();
+                  },
+                  "test blocks");
+    EXPECT_EQ(std::vector<int>(n, 1), visits);
+
+    RNG same_seed(8675309);
+    for (int b = 0; b < 3; ++b) {
+      RNG block_rng = same_seed.split();
+      EXPECT_DOUBLE_EQ(block_rng(), first_draw[b]) << "block " << b;
+    }
+    EXPECT_NE(first_draw[0], first_draw[1]);
+    EXPECT_NE(first_draw[1], first_draw[2]);
+  }
+
+  // Without threads the work runs as one block on the seeding RNG.
+  TEST(ParallelRngTest, SingleBlockUsesSeedingRng) {
+    ThreadWorkerPool empty_pool;
+    int n = 10;
+    RNG rng(17);
+    RNG same_rng(17);
+    double draw = 0;
+    run_in_blocks(empty_pool, n, rng,
+                  [&](int block, int begin, int end, RNG &block_rng) {
+                    EXPECT_EQ(0, block);
+                    EXPECT_EQ(0, begin);
+                    EXPECT_EQ(n, end);
+                    draw = block_rng();
+                  },
+                  "test blocks");
+    EXPECT_DOUBLE_EQ(same_rng(), draw);
+  }
+
+}  // namespace
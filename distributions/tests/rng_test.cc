@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "distributions/rng.hpp"
+#include "distributions/xoshiro.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "LinAlg/Vector.hpp"
+#include "stats/moments.hpp"
+#include "test_utils/test_utils.hpp"
+#include <functional>
+#include <future>
+#include <iostream>
+#include <set>
+
+namespace {
+  using namespace BOOM;
+  using std::cout;
+  using std::endl;
+
+  TEST(RngTest, MersenneTwisterStreamIsUnchanged) {
+    RNG rng(17);
+    EXPECT_TRUE(rng.engine() == RNG::Engine::MERSENNE_TWISTER);
+    std::mt19937_64 reference(17);
+    std::uniform_real_distribution<double> dist;
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_DOUBLE_EQ(dist(reference), rng());
+    }
+  }
+
+  TEST(RngTest, XoshiroUniform) {
+    RNG rng(8675309, RNG::Engine::XOSHIRO);
+    EXPECT_TRUE(rng.engine() == RNG::Engine::XOSHIRO);
+    Vector draws(100000);
+    for (int i = 0; i < draws.size(); ++i) {
+      draws[i] = rng();
+      ASSERT_GE(draws[i], 0.0);
+      ASSERT_LT(draws[i], 1.0);
+    }
+    EXPECT_NEAR(0.5, mean(draws), .01);
+    EXPECT_NEAR(1.0 / 12, var(draws), .005);
+
+    // Draws from the standard library distributions use the active engine.
+    Vector counts(1000);
+    for (int i = 0; i < counts.size(); ++i) {
+      counts[i] = rpois_mt(rng, 4.0);
+    }
+    EXPECT_NEAR(4.0, mean(counts), .3);
+
+    // Seeding resets the stream.
+    rng.seed(12);
+    double first = rng();
+    rng.seed(12);
+    EXPECT_DOUBLE_EQ(first, rng());
+  }
+
+  TEST(RngTest, CopiesAreIndependent) {
+    RNG rng(3, RNG::Engine::XOSHIRO);
+    RNG copy(rng);
+    EXPECT_DOUBLE_EQ(rng(), copy());
+
+    RNG mt(3);
+    RNG mt_copy(mt);
+    mt();
+    mt_copy = mt;
+    EXPECT_DOUBLE_EQ(mt(), mt_copy());
+    EXPECT_TRUE(mt_copy.engine() == RNG::Engine::MERSENNE_TWISTER);
+  }
+
+  // The jump polynomial is linear in the state, so jumping commutes with
+  // stepping the generator.
+  TEST(RngTest, JumpCommutesWithDraws) {
+    Xoshiro256 first(29);
+    Xoshiro256 second(first);
+    first.jump();
+    for (int i = 0; i < 10; ++i) {
+      first();
+      second();
+    }
+    second.jump();
+    EXPECT_TRUE(first == second);
+
+    Xoshiro256 third(29);
+    Xoshiro256 fourth(29);
+    third.long_jump();
+    fourth.jump();
+    EXPECT_TRUE(third != fourth);
+  }
+
+  TEST(RngTest, SplitIsReproducible) {
+    RNG master(101, RNG::Engine::XOSHIRO);
+    RNG stream0 = master.split();
+    RNG stream1 = master.split();
+
+    RNG check(101, RNG::Engine::XOSHIRO);
+    RNG check0 = check.split();
+    RNG check1 = check.split();
+
+    // The first stream starts where the master stream was.
+    RNG unsplit(101, RNG::Engine::XOSHIRO);
+    for (int i = 0; i < 5; ++i) {
+      double u = stream0();
+      EXPECT_DOUBLE_EQ(u, check0());
+      EXPECT_DOUBLE_EQ(u, unsplit());
+      EXPECT_DOUBLE_EQ(stream1(), check1());
+    }
+    EXPECT_NE(stream0(), stream1());
+
+    // Splitting a Mersenne twister produces a xoshiro stream.
+    RNG mt(101);
+    RNG split = mt.split();
+    EXPECT_TRUE(split.engine() == RNG::Engine::XOSHIRO);
+  }
+
+  // Seeds drawn from the upper half of the integer range used to overflow,
+  // giving about half of all split streams the same seed.
+  TEST(RngTest, SplitStreamsFromMersenneTwisterAreDistinct) {
+    RNG mt(3);
+    int nstreams = 5000;
+    Vector first_draws(nstreams);
+    std::set<RNG::RngIntType> seeds;
+    for (int i = 0; i < nstreams; ++i) {
+      RNG stream = mt.split();
+      first_draws[i] = stream();
+      seeds.insert(seed_rng(mt));
+    }
+    EXPECT_EQ(nstreams, seeds.size());
+    EXPECT_NEAR(0.5, mean(first_draws), .02);
+    EXPECT_NEAR(1.0 / 12, var(first_draws), .005);
+  }
+
+  // Streams assigned to units of work give the same answer regardless of the
+  // number of threads used to process them.
+  TEST(RngTest, ThreadCountDoesNotChangeResults) {
+    int number_of_chunks = 8;
+    auto simulate = [number_of_chunks](int nthreads) {
+      RNG master(42, RNG::Engine::XOSHIRO);
+      std::vector<RNG> streams;
+      for (int i = 0; i < number_of_chunks; ++i) {
+        streams.push_back(master.split());
+      }
+      Vector ans(number_of_chunks);
+      ThreadWorkerPool pool;
+      pool.set_number_of_threads(nthreads);
+      std::vector<std::future<void>> jobs;
+      for (int i = 0; i < number_of_chunks; ++i) {
+        std::function<void()> job = [&ans, &streams, i]() {
+          double total = 0;
+          for (int j = 0; j < 1000; ++j) total += rnorm_mt(streams[i]);
+          ans[i] = total;
+        };
+        if (pool.no_threads()) {
+          job();
+        } else {
+          jobs.emplace_back(pool.submit(job));
+        }
+      }
+      for (auto &job : jobs) job.get();
+      return ans;
+    };
+    Vector serial = simulate(0);
+    EXPECT_TRUE(VectorEquals(serial, simulate(2)));
+    EXPECT_TRUE(VectorEquals(serial, simulate(3)));
+  }
+
+  // The engine is stored in the RNG, so a moved-from RNG has none.  Using it
+  // is an error until another RNG is assigned to it.
+  TEST(RngTest, MovedFromRngIsAnError) {
+    for (RNG::Engine engine : {RNG::Engine::MERSENNE_TWISTER,
+                               RNG::Engine::XOSHIRO}) {
+      RNG rng(12, engine);
+      RNG reference(12, engine);
+      RNG moved(std::move(rng));
+      EXPECT_DOUBLE_EQ(reference(), moved());
+      EXPECT_THROW(rng(), std::exception);
+      EXPECT_THROW(rng.seed(3), std::exception);
+      EXPECT_THROW(rng.engine(), std::exception);
+      EXPECT_THROW(rng.split(), std::exception);
+
+      RNG assigned(1);
+      assigned = std::move(moved);
+      EXPECT_DOUBLE_EQ(reference(), assigned());
+      EXPECT_THROW(moved(), std::exception);
+
+      rng = RNG(12, engine);
+      EXPECT_TRUE(rng.engine() == engine);
+      EXPECT_DOUBLE_EQ(RNG(12, engine)(), rng());
+    }
+  }
+
+  TEST(RngTest, JumpRequiresXoshiro) {
+    RNG mt(1);
+    EXPECT_THROW(mt.jump(), std::exception);
+  }
+
+}  // namespace
@@ -0,0 +1,73 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "distributions/xoshiro.hpp"
+
+namespace BOOM {
+
+  namespace {
+    std::uint64_t splitmix64(std::uint64_t &x) {
+      std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+    // Coefficients of the jump polynomials published with the reference
+    // implementation.
+    const std::uint64_t jump_polynomial[4] = {
+      0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+      0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+
+    const std::uint64_t long_jump_polynomial[4] = {
+      0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+      0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+  }  // namespace
+
+  void Xoshiro256::seed(std::uint64_t seed) {
+    // splitmix64 never produces four consecutive zeros, so the state is never
+    // the forbidden all-zero state.
+    for (int i = 0; i < 4; ++i) {
+      state_[i] = splitmix64(seed);
+    }
+  }
+
+  void Xoshiro256::jump() { jump(jump_polynomial); }
+
+  void Xoshiro256::long_jump() { jump(long_jump_polynomial); }
+
+  void Xoshiro256::jump(const std::uint64_t *polynomial) {
+    std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; ++i) {
+      for (int b = 0; b < 64; ++b) {
+        if (polynomial[i] & (std::uint64_t(1) << b)) {
+          s0 ^= state_[0];
+          s1 ^= state_[1];
+          s2 ^= state_[2];
+          s3 ^= state_[3];
+        }
+        (*this)();
+      }
+    }
+    state_[0] = s0;
+    state_[1] = s1;
+    state_[2] = s2;
+    state_[3] = s3;
+  }
+
+}  // namespace BOOM
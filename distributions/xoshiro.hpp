@@ -0,0 +1,95 @@
+#ifndef BOOM_DISTRIBUTIONS_XOSHIRO_HPP_
+#define BOOM_DISTRIBUTIONS_XOSHIRO_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdint>
+
+namespace BOOM {
+
+  // The xoshiro256++ generator of Blackman and Vigna (2019), "Scrambled linear
+  // pseudorandom number generators".  The state is four 64-bit words, the
+  // period is 2^256 - 1, and the generator passes the BigCrush and PractRand
+  // test batteries.
+  //
+  // Unlike std::mt19937_64 (which carries 2.5KB of state) the generator is
+  // cheap to create and to seed, and it can be advanced by 2^128 or 2^192
+  // draws in constant time using jump() and long_jump().  Jumping is the
+  // recommended way to obtain non-overlapping streams for parallel work: 2^128
+  // streams of length 2^128 each.
+  //
+  // The class satisfies the C++ UniformRandomBitGenerator requirements, so it
+  // can be used with the distributions in <random>.
+  class Xoshiro256 {
+   public:
+    typedef std::uint64_t result_type;
+
+    // Seed the generator by expanding 'seed' with the splitmix64 generator, as
+    // recommended by the authors.
+    explicit Xoshiro256(std::uint64_t seed = 8675309) { this->seed(seed); }
+
+    void seed(std::uint64_t seed);
+
+    // The next 64 random bits.
+    result_type operator()() {
+      const std::uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+      const std::uint64_t t = state_[1] << 17;
+      state_[2] ^= state_[0];
+      state_[3] ^= state_[1];
+      state_[1] ^= state_[2];
+      state_[0] ^= state_[3];
+      state_[2] ^= t;
+      state_[3] = rotl(state_[3], 45);
+      return result;
+    }
+
+    // A U[0, 1) deviate built from the top 53 bits of the next draw.  Every
+    // representable multiple of 2^-53 in [0, 1) is equally likely.
+    double uniform() {
+      return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Advance the generator by 2^128 draws.
+    void jump();
+
+    // Advance the generator by 2^192 draws.
+    void long_jump();
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    bool operator==(const Xoshiro256 &rhs) const {
+      return state_[0] == rhs.state_[0] && state_[1] == rhs.state_[1]
+          && state_[2] == rhs.state_[2] && state_[3] == rhs.state_[3];
+    }
+    bool operator!=(const Xoshiro256 &rhs) const { return !(*this == rhs); }
+
+   private:
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+      return (x << k) | (x >> (64 - k));
+    }
+
+    // Apply the jump polynomial with the given coefficients.
+    void jump(const std::uint64_t *polynomial);
+
+    std::uint64_t state_[4];
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_DISTRIBUTIONS_XOSHIRO_HPP_
@@ -0,0 +1,100 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+// Measures the memory footprint and the cost of creating, cloning, and
+// destroying a large collection of DoubleData objects.
+//
+// Usage:  data_memory [number_of_objects]
+//
+// The default is 10 million objects.  Resident memory is read from
+// /proc/self/statm, so memory figures are only reported on Linux.
+
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "Models/DataTypes.hpp"
+#include "Models/Glm/Glm.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::cout;
+  using std::endl;
+
+  // Resident set size in bytes, or -1 if it cannot be determined.
+  long resident_memory() {
+    std::ifstream statm("/proc/self/statm");
+    long total_pages, resident_pages;
+    if (!(statm >> total_pages >> resident_pages)) {
+      return -1;
+    }
+    return resident_pages * sysconf(_SC_PAGESIZE);
+  }
+
+  double seconds_since(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  void report_memory(const char *label, long before, long after, long n) {
+    if (before < 0 || after < 0) return;
+    cout << label << ": " << (after - before) / (1024.0 * 1024.0) << " MB ("
+         << static_cast<double>(after - before) / n << " bytes per object)"
+         << endl;
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  long n = 10000000;
+  if (argc > 1) n = std::atol(argv[1]);
+
+  cout << "sizeof(DoubleData)     = " << sizeof(DoubleData) << endl
+       << "sizeof(VectorData)     = " << sizeof(VectorData) << endl
+       << "sizeof(RegressionData) = " << sizeof(RegressionData) << endl;
+
+  long baseline = resident_memory();
+  auto start = std::chrono::steady_clock::now();
+  std::vector<Ptr<DoubleData>> data;
+  data.reserve(n);
+  for (long i = 0; i < n; ++i) {
+    data.push_back(new DoubleData(i));
+  }
+  cout << "Created " << n << " objects in " << seconds_since(start)
+       << " seconds." << endl;
+  report_memory("Memory", baseline, resident_memory(), n);
+
+  start = std::chrono::steady_clock::now();
+  std::vector<Ptr<DoubleData>> copies;
+  copies.reserve(n);
+  for (const auto &el : data) {
+    copies.push_back(el->clone());
+  }
+  cout << "Cloned " << n << " objects in " << seconds_since(start)
+       << " seconds." << endl;
+
+  start = std::chrono::steady_clock::now();
+  copies.clear();
+  data.clear();
+  cout << "Destroyed " << 2 * n << " objects in " << seconds_since(start)
+       << " seconds." << endl;
+  return 0;
+}
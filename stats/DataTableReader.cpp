@@ -0,0 +1,590 @@
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "stats/DataTableReader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "cpputil/DefaultVnames.hpp"
+#include "cpputil/report_error.hpp"
+#include "cpputil/string_utils.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BOOM {
+
+  namespace {
+
+    void report_file_error(const std::string &operation,
+                           const std::string &filename) {
+      std::ostringstream err;
+      err << "Could not " << operation << " file " << filename << ": "
+          << std::strerror(errno);
+      report_error(err.str());
+    }
+
+    //-------------------------------------------------------------------------
+    // A read-only view of the contents of a file.  The file is memory mapped
+    // where that is supported, and read into memory otherwise.
+    class MappedFile {
+     public:
+      explicit MappedFile(const std::string &filename);
+      ~MappedFile();
+
+      MappedFile(const MappedFile &rhs) = delete;
+      MappedFile &operator=(const MappedFile &rhs) = delete;
+
+      const char *begin() const { return data_; }
+      const char *end() const { return data_ + size_; }
+
+     private:
+      const char *data_;
+      std::size_t size_;
+#ifndef _WIN32
+      void *mapped_address_;
+#else
+      std::string buffer_;
+#endif
+    };
+
+#ifndef _WIN32
+    MappedFile::MappedFile(const std::string &filename)
+        : data_(""), size_(0), mapped_address_(nullptr) {
+      int file_descriptor = ::open(filename.c_str(), O_RDONLY);
+      if (file_descriptor < 0) {
+        report_file_error("open", filename);
+      }
+      struct stat file_status;
+      if (fstat(file_descriptor, &file_status) != 0) {
+        ::close(file_descriptor);
+        report_file_error("examine", filename);
+      }
+      size_ = file_status.st_size;
+      if (size_ > 0) {
+        void *address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE,
+                             file_descriptor, 0);
+        if (address == MAP_FAILED) {
+          ::close(file_descriptor);
+          report_file_error("map", filename);
+        }
+        madvise(address, size_, MADV_SEQUENTIAL);
+        mapped_address_ = address;
+        data_ = static_cast<const char *>(address);
+      }
+      // The mapping remains valid after the file is closed.
+      ::close(file_descriptor);
+    }
+
+    MappedFile::~MappedFile() {
+      if (mapped_address_) {
+        munmap(mapped_address_, size_);
+      }
+    }
+#else
+    // Memory mapping is not supported on Windows, so the file is read into a
+    // buffer.
+    MappedFile::MappedFile(const std::string &filename) {
+      std::ifstream in(filename.c_str(), std::ios::binary);
+      if (!in) {
+        report_file_error("open", filename);
+      }
+      std::ostringstream contents;
+      contents << in.rdbuf();
+      buffer_ = contents.str();
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+    }
+
+    MappedFile::~MappedFile() {}
+#endif
+
+    //-------------------------------------------------------------------------
+    // The characters removed by trim_white_space.
+    inline bool is_white(char c) {
+      return c == ' ' || c == '\n' || c == '\t' || c == '\f' || c == '\r' ||
+          c == '\v';
+    }
+
+    inline bool is_quote(char c) { return c == '"' || c == '\''; }
+
+    inline bool is_blank(const char *begin, const char *end) {
+      for (; begin != end; ++begin) {
+        if (!is_white(*begin)) return false;
+      }
+      return true;
+    }
+
+    inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+    // A field is the range [begin, end) in the file's buffer.
+    struct Field {
+      const char *begin;
+      const char *end;
+    };
+
+    // Splits lines of text into fields without copying them.
+    class FieldTokenizer {
+     public:
+      explicit FieldTokenizer(const std::string &sep)
+          : delimited_(sep == "\t" ||
+                       !is_blank(sep.data(), sep.data() + sep.size())) {
+        std::fill(is_delimiter_, is_delimiter_ + 256, false);
+        for (char c : sep.empty() ? std::string(" ") : sep) {
+          is_delimiter_[static_cast<unsigned char>(c)] = true;
+        }
+      }
+
+      // Fill 'fields' with the fields in the line [begin, end), which excludes
+      // the end-of-line character.  'fields' is cleared first, and is reused
+      // from line to line so that splitting a line does not allocate.
+      void split(const char *begin, const char *end,
+                 std::vector<Field> &fields) const {
+        fields.clear();
+        if (delimited_) {
+          const char *start = begin;
+          while (true) {
+            const char *pos = field_end(start, end);
+            fields.push_back(trim(strip_quotes(Field{start, pos})));
+            if (pos == end) return;
+            start = pos + 1;
+          }
+        } else {
+          const char *start = begin;
+          while (true) {
+            while (start != end && is_delimiter(*start)) ++start;
+            if (start == end) return;
+            const char *pos = field_end(start, end);
+            fields.push_back(strip_quotes(Field{start, pos}));
+            start = pos;
+          }
+        }
+      }
+
+     private:
+      bool is_delimiter(char c) const {
+        return is_delimiter_[static_cast<unsigned char>(c)];
+      }
+
+      // Returns the position of the delimiter ending the field that begins at
+      // 'start', or 'end' if the field runs to the end of the line.  Delimiters
+      // between matching quotes are part of the field.
+      const char *field_end(const char *start, const char *end) const {
+        char open_quote = ' ';
+        for (const char *pos = start; pos != end; ++pos) {
+          if (open_quote != ' ') {
+            if (*pos == open_quote) open_quote = ' ';
+          } else if (is_quote(*pos)) {
+            open_quote = *pos;
+          } else if (is_delimiter(*pos)) {
+            return pos;
+          }
+        }
+        return end;
+      }
+
+      static Field strip_quotes(Field field) {
+        if (field.end - field.begin >= 2 && is_quote(*field.begin) &&
+            field.end[-1] == *field.begin) {
+          ++field.begin;
+          --field.end;
+        }
+        return field;
+      }
+
+      static Field trim(Field field) {
+        while (field.begin != field.end && is_white(*field.begin)) {
+          ++field.begin;
+        }
+        while (field.end != field.begin && is_white(field.end[-1])) {
+          --field.end;
+        }
+        return field;
+      }
+
+      bool delimited_;
+      bool is_delimiter_[256];
+    };
+
+    //-------------------------------------------------------------------------
+    const double powers_of_ten[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    // Convert the field [begin, end), which has passed is_numeric, to a
+    // double.  Most numbers in data files have a short significand and a
+    // small exponent.  Both the significand and the power of ten are then
+    // exactly representable, so one multiplication or division gives the
+    // correctly rounded result.  Other numbers are handed to strtod.
+    double parse_numeric(const char *begin, const char *end) {
+      const char *pos = begin;
+      bool negative = false;
+      if (pos != end && (*pos == '-' || *pos == '+')) {
+        negative = *pos == '-';
+        ++pos;
+      }
+      const int max_digits = 19;
+      std::uint64_t significand = 0;
+      int digits = 0;
+      int exponent = 0;
+      bool exact = true;
+      for (; pos != end && is_digit(*pos); ++pos) {
+        if (digits < max_digits) {
+          significand = 10 * significand + (*pos - '0');
+          if (significand > 0) ++digits;
+        } else {
+          exact = false;
+        }
+      }
+      if (pos != end && *pos == '.') {
+        for (++pos; pos != end && is_digit(*pos); ++pos) {
+          if (digits < max_digits) {
+            significand = 10 * significand + (*pos - '0');
+            if (significand > 0) ++digits;
+            --exponent;
+          } else {
+            exact = false;
+          }
+        }
+      }
+      if (pos != end && (*pos == 'e' || *pos == 'E')) {
+        ++pos;
+        bool negative_exponent = false;
+        if (pos != end && (*pos == '-' || *pos == '+')) {
+          negative_exponent = *pos == '-';
+          ++pos;
+        }
+        int power = 0;
+        for (; pos != end && is_digit(*pos); ++pos) {
+          if (power < 100000) power = 10 * power + (*pos - '0');
+        }
+        exponent += negative_exponent ? -power : power;
+      }
+
+      if (exact && significand <= (std::uint64_t(1) << 53) &&
+          exponent >= -22 && exponent <= 22) {
+        double value = static_cast<double>(significand);
+        if (exponent < 0) {
+          value /= powers_of_ten[-exponent];
+        } else {
+          value *= powers_of_ten[exponent];
+        }
+        return negative ? -value : value;
+      }
+      // The mapped file is not null terminated, so strtod needs a copy.
+      std::string field(begin, end);
+      return std::strtod(field.c_str(), nullptr);
+    }
+
+    //-------------------------------------------------------------------------
+    // The type of each field, and its position among the variables of that
+    // type.
+    struct ColumnLayout {
+      std::vector<std::string> names;
+      std::vector<VariableType> types;
+      std::vector<int> positions;
+      int number_of_numeric = 0;
+      int number_of_categorical = 0;
+    };
+
+    // The contents of a chunk of the file, stored by column.
+    struct ParsedChunk {
+      std::vector<std::vector<double>> numeric_data;
+
+      // Each categorical column is coded by order of first appearance in the
+      // chunk.  levels[j][k] is the label coded as k in categorical column j.
+      std::vector<std::vector<int>> categorical_codes;
+      std::vector<std::vector<std::string>> levels;
+
+      std::int64_t number_of_rows = 0;
+      std::int64_t number_of_lines = 0;
+
+      // Parsing stops at the first error.  error_line counts lines from the
+      // start of the chunk, starting from 1.
+      std::string error;
+      std::int64_t error_line = 0;
+    };
+
+    void parse_chunk(const char *begin, const char *end,
+                     const FieldTokenizer &tokenizer,
+                     const ColumnLayout &layout,
+                     ParsedChunk &chunk) {
+      size_t nfields = layout.types.size();
+      chunk.numeric_data.resize(layout.number_of_numeric);
+      chunk.categorical_codes.resize(layout.number_of_categorical);
+      chunk.levels.resize(layout.number_of_categorical);
+      std::vector<std::unordered_map<std::string, int>> dictionaries(
+          layout.number_of_categorical);
+
+      std::vector<Field> fields;
+      std::string label;
+      const char *line = begin;
+      while (line != end) {
+        const char *newline = static_cast<const char *>(
+            std::memchr(line, '\n', end - line));
+        const char *line_end = newline ? newline : end;
+        const char *next_line = newline ? newline + 1 : end;
+        ++chunk.number_of_lines;
+        if (is_blank(line, line_end)) {
+          line = next_line;
+          continue;
+        }
+        if (line_end[-1] == '\r') --line_end;
+
+        tokenizer.split(line, line_end, fields);
+        if (fields.size() != nfields) {
+          std::ostringstream err;
+          err << "Found " << fields.size() << " fields.  Previous lines had "
+              << nfields << " fields.";
+          chunk.error = err.str();
+          chunk.error_line = chunk.number_of_lines;
+          return;
+        }
+        for (size_t i = 0; i < nfields; ++i) {
+          const Field &field(fields[i]);
+          int position = layout.positions[i];
+          if (layout.types[i] == VariableType::numeric) {
+            if (!is_numeric(field.begin, field.end)) {
+              std::ostringstream err;
+              err << "Expected a numeric value in field number " << i + 1
+                  << " (" << layout.names[i] << ").  Got "
+                  << std::string(field.begin, field.end) << ".";
+              chunk.error = err.str();
+              chunk.error_line = chunk.number_of_lines;
+              return;
+            }
+            chunk.numeric_data[position].push_back(
+                parse_numeric(field.begin, field.end));
+          } else {
+            label.assign(field.begin, field.end);
+            std::unordered_map<std::string, int> &dictionary(
+                dictionaries[position]);
+            auto it = dictionary.find(label);
+            int code;
+            if (it == dictionary.end()) {
+              code = dictionary.size();
+              dictionary.emplace(label, code);
+              chunk.levels[position].push_back(label);
+            } else {
+              code = it->second;
+            }
+            chunk.categorical_codes[position].push_back(code);
+          }
+        }
+        ++chunk.number_of_rows;
+        line = next_line;
+      }
+    }
+
+    // Returns one past the end of the line beginning at 'line'.
+    const char *next_line(const char *line, const char *end) {
+      const char *newline = static_cast<const char *>(
+          std::memchr(line, '\n', end - line));
+      return newline ? newline + 1 : end;
+    }
+
+    // Returns the line [line, end of line) without its line terminator.
+    Field line_contents(const char *line, const char *end) {
+      const char *line_end = next_line(line, end);
+      if (line_end != line && line_end[-1] == '\n') --line_end;
+      if (line_end != line && line_end[-1] == '\r') --line_end;
+      return Field{line, line_end};
+    }
+
+  }  // namespace
+
+  //===========================================================================
+  DataTableReader::DataTableReader(bool header, const std::string &sep)
+      : header_(header),
+        sep_(sep),
+        type_sample_size_(100)
+  {}
+
+  void DataTableReader::set_number_of_threads(int nthreads) {
+    pool_.set_number_of_threads(nthreads <= 1 ? 0 : nthreads);
+  }
+
+  void DataTableReader::set_type_sample_size(int lines) {
+    if (lines < 1) {
+      report_error("The type sample must contain at least one line.");
+    }
+    type_sample_size_ = lines;
+  }
+
+  DataTable DataTableReader::read(const std::string &filename) {
+    MappedFile file(filename);
+    FieldTokenizer tokenizer(sep_);
+    std::vector<Field> fields;
+    const char *data_begin = file.begin();
+    const char *end = file.end();
+    std::int64_t lines_before_data = 0;
+
+    ColumnLayout layout;
+    if (header_ && data_begin != end) {
+      Field line = line_contents(data_begin, end);
+      tokenizer.split(line.begin, line.end, fields);
+      for (const Field &field : fields) {
+        layout.names.push_back(std::string(field.begin, field.end));
+      }
+      data_begin = next_line(data_begin, end);
+      lines_before_data = 1;
+    }
+
+    // Determine the variable types from a sample of the data.
+    std::vector<bool> numeric;
+    int sampled_lines = 0;
+    for (const char *line = data_begin;
+         line != end && sampled_lines < type_sample_size_;
+         line = next_line(line, end)) {
+      Field contents = line_contents(line, end);
+      if (is_blank(contents.begin, contents.end)) continue;
+      tokenizer.split(contents.begin, contents.end, fields);
+      if (layout.names.empty()) {
+        layout.names = default_vnames(fields.size());
+      }
+      if (fields.size() != layout.names.size()) {
+        // The line will be reported when the chunks are parsed.
+        continue;
+      }
+      numeric.resize(fields.size(), true);
+      for (size_t i = 0; i < fields.size(); ++i) {
+        if (numeric[i] && !is_numeric(fields[i].begin, fields[i].end)) {
+          numeric[i] = false;
+        }
+      }
+      ++sampled_lines;
+    }
+    if (sampled_lines == 0) {
+      // The file has no data, or no line with the right number of fields.
+      // Parse it anyway to report any malformed line.
+      numeric.resize(layout.names.size(), false);
+    }
+    for (size_t i = 0; i < layout.names.size(); ++i) {
+      if (numeric[i]) {
+        layout.types.push_back(VariableType::numeric);
+        layout.positions.push_back(layout.number_of_numeric++);
+      } else {
+        layout.types.push_back(VariableType::categorical);
+        layout.positions.push_back(layout.number_of_categorical++);
+      }
+    }
+
+    // Divide the data into one chunk per thread, at line boundaries.
+    int nchunks = pool_.no_threads() ? 1 : pool_.number_of_threads();
+    std::vector<const char *> chunk_begin(1, data_begin);
+    std::int64_t data_size = end - data_begin;
+    for (int c = 1; c < nchunks; ++c) {
+      const char *target = std::max(
+          data_begin + data_size * c / nchunks, chunk_begin.back());
+      chunk_begin.push_back(target == end ? end : next_line(target, end));
+    }
+    chunk_begin.push_back(end);
+
+    std::vector<ParsedChunk> chunks(nchunks);
+    if (nchunks == 1) {
+      parse_chunk(data_begin, end, tokenizer, layout, chunks[0]);
+    } else {
+      std::vector<std::future<void>> jobs;
+      jobs.reserve(nchunks);
+      for (int c = 0; c < nchunks; ++c) {
+        const char *begin = chunk_begin[c];
+        const char *chunk_end = chunk_begin[c + 1];
+        ParsedChunk *chunk = &chunks[c];
+        jobs.emplace_back(pool_.submit(
+            [begin, chunk_end, &tokenizer, &layout, chunk]() {
+              parse_chunk(begin, chunk_end, tokenizer, layout, *chunk);
+            }));
+      }
+      wait_for_jobs(jobs, "chunks of file " + filename);
+    }
+
+    // Report the first error in the file, if any.
+    std::int64_t nrows = 0;
+    std::int64_t line_number = lines_before_data;
+    for (const ParsedChunk &chunk : chunks) {
+      if (!chunk.error.empty()) {
+        std::ostringstream err;
+        err << "file: " << filename << " line number "
+            << line_number + chunk.error_line << ": " << chunk.error;
+        report_error(err.str());
+      }
+      line_number += chunk.number_of_lines;
+      nrows += chunk.number_of_rows;
+    }
+
+    // Assemble the columns, releasing the memory held by the chunks as each
+    // column is completed.
+    DataTable table;
+    if (nrows == 0) return table;
+    for (size_t i = 0; i < layout.types.size(); ++i) {
+      int position = layout.positions[i];
+      if (layout.types[i] == VariableType::numeric) {
+        Vector column(nrows);
+        auto it = column.begin();
+        for (ParsedChunk &chunk : chunks) {
+          std::vector<double> &values(chunk.numeric_data[position]);
+          it = std::copy(values.begin(), values.end(), it);
+          std::vector<double>().swap(values);
+        }
+        table.append_variable(column, layout.names[i]);
+      } else {
+        // Levels are sorted, as in CategoricalVariable's constructor.
+        std::vector<std::string> labels;
+        for (const ParsedChunk &chunk : chunks) {
+          labels.insert(labels.end(), chunk.levels[position].begin(),
+                        chunk.levels[position].end());
+        }
+        std::sort(labels.begin(), labels.end());
+        labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+        std::vector<int> values;
+        values.reserve(nrows);
+        for (ParsedChunk &chunk : chunks) {
+          const std::vector<std::string> &levels(chunk.levels[position]);
+          std::vector<int> recode(levels.size());
+          for (size_t k = 0; k < levels.size(); ++k) {
+            recode[k] = std::lower_bound(labels.begin(), labels.end(),
+                                         levels[k]) - labels.begin();
+          }
+          for (int code : chunk.categorical_codes[position]) {
+            values.push_back(recode[code]);
+          }
+          std::vector<int>().swap(chunk.categorical_codes[position]);
+        }
+        NEW(CatKey, key)(labels);
+        table.append_variable(CategoricalVariable(values, key),
+                              layout.names[i]);
+      }
+    }
+    return table;
+  }
+
+}  // namespace BOOM
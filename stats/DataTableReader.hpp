@@ -0,0 +1,81 @@
+#ifndef BOOM_STATS_DATA_TABLE_READER_HPP_
+#define BOOM_STATS_DATA_TABLE_READER_HPP_
+/*
+  Copyright (C) 2026 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <string>
+#include "stats/DataTable.hpp"
+#include "cpputil/ThreadTools.hpp"
+
+namespace BOOM {
+
+  // Reads a delimited text file into a DataTable.  The result is the table
+  // that DataTable::read_file would produce, but the reader is built for large
+  // files.
+  //
+  // The file is memory mapped rather than read through a stream, and the part
+  // of it following the header is divided into chunks at line boundaries, one
+  // chunk per thread.  Each chunk is parsed in its own thread.  Fields are
+  // located in place in the mapped file, numbers are converted without copying
+  // the field, and each categorical column is dictionary encoded as it is
+  // read, so the only strings created are the distinct levels of each
+  // categorical variable.  The dictionaries from the different chunks are
+  // merged at the end.
+  //
+  // Variable types are determined from a sample of lines at the start of the
+  // file.  A column is numeric if all its sampled values are numbers.
+  //
+  // Fields are split following the rules in StringSplitter: with a
+  // non-whitespace separator, empty fields are kept, quotes protect
+  // separators, and fields are stripped of their enclosing quotes and of
+  // surrounding white space.  With a whitespace separator, runs of spaces
+  // separate fields.  Unlike StringSplitter, an empty separator means spaces,
+  // and a quote at the start of a delimited field protects the separators
+  // inside it.  Quoted fields may not span lines.
+  class DataTableReader {
+   public:
+    // Args:
+    //   header: If 'true' then the first line of the file contains variable
+    //     names.  If 'false' the first line of the file is the first
+    //     observation, and variable names are generated automatically.
+    //   sep: The characters separating the fields in the data file.
+    explicit DataTableReader(bool header = false, const std::string &sep = "");
+
+    // Args:
+    //   nthreads: The number of threads to use.  If nthreads <= 1 the file is
+    //     parsed in the calling thread.
+    void set_number_of_threads(int nthreads);
+
+    // The number of non-blank lines at the start of the file used to
+    // determine the variable types.
+    void set_type_sample_size(int lines);
+
+    // Read the named file.  Errors in the file are reported through
+    // report_error, with the number of the offending line.
+    DataTable read(const std::string &filename);
+
+   private:
+    bool header_;
+    std::string sep_;
+    int type_sample_size_;
+    ThreadWorkerPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATS_DATA_TABLE_READER_HPP_
@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+#include "stats/DataTable.hpp"
+#include "stats/DataTableReader.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class DataTableReaderTest : public ::testing::Test {
+   protected:
+    DataTableReaderTest() : filename_("data_table_reader_test.csv") {
+      GlobalRng::rng.seed(8675309);
+    }
+    ~DataTableReaderTest() override { std::remove(filename_.c_str()); }
+
+    void write_file(const std::string &contents) {
+      std::ofstream out(filename_.c_str(), std::ios::binary);
+      out << contents;
+    }
+
+    // Expect 'fast' to hold the same variables and values as 'reference'.
+    void expect_same_table(const DataTable &reference, const DataTable &fast) {
+      ASSERT_EQ(reference.nvars(), fast.nvars());
+      ASSERT_EQ(reference.nobs(), fast.nobs());
+      EXPECT_EQ(reference.vnames(), fast.vnames());
+      for (int j = 0; j < reference.nvars(); ++j) {
+        ASSERT_EQ(reference.variable_type(j), fast.variable_type(j))
+            << "variable " << j;
+        if (reference.variable_type(j) == VariableType::numeric) {
+          Vector expected = reference.getvar(j);
+          Vector actual = fast.getvar(j);
+          for (int i = 0; i < expected.size(); ++i) {
+            // The values should agree to the last bit.
+            EXPECT_EQ(expected[i], actual[i]) << "row " << i << " variable "
+                                              << j;
+          }
+        } else {
+          CategoricalVariable expected = reference.get_nominal(j);
+          CategoricalVariable actual = fast.get_nominal(j);
+          EXPECT_EQ(expected.labels(), actual.labels());
+          for (int i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected[i]->value(), actual[i]->value())
+                << "row " << i << " variable " << j;
+          }
+        }
+      }
+    }
+
+    std::string filename_;
+  };
+
+  TEST_F(DataTableReaderTest, MatchesReadFile) {
+    DataTable autopref("stats/tests/autopref.txt", false, "\t");
+    DataTable cars("stats/tests/CarsClean.csv", true, ",");
+    for (int nthreads : {1, 3}) {
+      DataTableReader tab_reader(false, "\t");
+      tab_reader.set_number_of_threads(nthreads);
+      expect_same_table(autopref, tab_reader.read("stats/tests/autopref.txt"));
+
+      DataTableReader csv_reader(true, ",");
+      csv_reader.set_number_of_threads(nthreads);
+      expect_same_table(cars, csv_reader.read("stats/tests/CarsClean.csv"));
+    }
+  }
+
+  TEST_F(DataTableReaderTest, ParsesNumbersExactly) {
+    // Numbers with short and long significands and a range of exponents,
+    // written in the forms that DataTable recognizes as numeric.
+    std::ostringstream contents;
+    contents << "x,y,z,label\n";
+    int nrows = 1000;
+    for (int i = 0; i < nrows; ++i) {
+      double x = rnorm(0, 1000);
+      contents << std::setprecision(17) << x << ","
+               << std::setprecision(4) << x << ","
+               << std::scientific << std::setprecision(12) << rnorm() * 1e-30
+               << std::defaultfloat << ","
+               << (i % 3 == 0 ? "a" : i % 3 == 1 ? "\"b or c\"" : "d")
+               << "\n";
+      if (i % 100 == 0) contents << "   \n";
+    }
+    write_file(contents.str());
+
+    DataTable reference(filename_, true, ",");
+    DataTableReader reader(true, ",");
+    reader.set_number_of_threads(4);
+    DataTable fast = reader.read(filename_);
+    EXPECT_EQ(nrows, fast.nobs());
+    EXPECT_EQ(VariableType::numeric, fast.variable_type(2));
+    EXPECT_EQ(VariableType::categorical, fast.variable_type(3));
+    EXPECT_EQ(std::vector<std::string>({"a", "b or c", "d"}),
+              fast.get_nominal(3).labels());
+    for (int i = 0; i < nrows; ++i) {
+      EXPECT_EQ(reference.getvar(i, 0), fast.getvar(i, 0));
+      EXPECT_EQ(reference.getvar(i, 1), fast.getvar(i, 1));
+      EXPECT_EQ(reference.getvar(i, 2), fast.getvar(i, 2));
+    }
+  }
+
+  TEST_F(DataTableReaderTest, DiagnosesTypesFromSample) {
+    // The first value of 'b' looks numeric, but later values do not.
+    write_file("1 2\r\n"
+               "3 x\r\n"
+               "\r\n"
+               "5 '6 7'\r\n");
+    DataTableReader reader(false, " ");
+    DataTable table = reader.read(filename_);
+    EXPECT_EQ(3, table.nobs());
+    EXPECT_EQ(VariableType::numeric, table.variable_type(0));
+    EXPECT_EQ(VariableType::categorical, table.variable_type(1));
+    EXPECT_EQ("V.0", table.vnames()[0]);
+    EXPECT_DOUBLE_EQ(5.0, table.getvar(2, 0));
+    EXPECT_EQ("6 7", table.get_nominal(2, 1)->label());
+
+    // With a one line sample the same column is diagnosed as numeric, so the
+    // second line is an error.
+    reader.set_type_sample_size(1);
+    EXPECT_THROW(reader.read(filename_), std::exception);
+  }
+
+  TEST_F(DataTableReaderTest, QuotesProtectSeparators) {
+    write_file("1,\"a, b\",2\n"
+               "3, c ,4");
+    DataTableReader reader(false, ",");
+    DataTable table = reader.read(filename_);
+    EXPECT_EQ(2, table.nobs());
+    EXPECT_EQ(3, table.nvars());
+    EXPECT_EQ("a, b", table.get_nominal(0, 1)->label());
+    EXPECT_EQ("c", table.get_nominal(1, 1)->label());
+    EXPECT_DOUBLE_EQ(4.0, table.getvar(1, 2));
+  }
+
+  TEST_F(DataTableReaderTest, ReportsLineNumbers) {
+    std::ostringstream contents;
+    contents << "a,b\n";
+    for (int i = 0; i < 200; ++i) {
+      contents << i << "," << (i == 150 ? "1,2" : "3") << "\n";
+    }
+    write_file(contents.str());
+    DataTableReader reader(true, ",");
+    reader.set_number_of_threads(4);
+    try {
+      reader.read(filename_);
+      FAIL() << "A line with too many fields was not reported.";
+    } catch (std::exception &e) {
+      std::string message = e.what();
+      EXPECT_NE(std::string::npos, message.find("line number 152"))
+          << message;
+    }
+  }
+
+}  // namespace